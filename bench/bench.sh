@@ -0,0 +1,56 @@
+#!/bin/sh
+# *****************************************************************************
+# Filename:			bench.sh
+# Description:		Assembler throughput benchmark.
+# Copyright(c):
+# Author(s):
+# Created:			18 October 2026
+# Last modified:
+#
+# Usage:				bench.sh <asm8080> <gen_src> <run_bench> [<lines>...]
+#
+# Notes:				- Generate synthetic sources of each number of lines,
+#						  and report assembly throughput and peak RSS.
+#						- Generator options may be given in BENCH_GEN_OPTS
+#						  (e.g. "-l10 -i4 -f80"), assembler options in
+#						  BENCH_ASM_OPTS, and the number of runs in BENCH_RUNS.
+# *****************************************************************************
+
+if [ $# -lt 3 ]; then
+	echo "Usage: $0 <asm8080> <gen_src> <run_bench> [<lines>...]" >&2
+	exit 1
+fi
+
+# Tools are run from the work directory.  Make their paths absolute.
+abs()
+{
+	case $1 in
+		/*)	echo "$1" ;;
+		*)		echo "`pwd`/$1" ;;
+	esac
+}
+
+ASM=`abs "$1"`
+GEN=`abs "$2"`
+RUN=`abs "$3"`
+shift 3
+
+LINES=${*:-"5000 10000 20000 40000"}
+WORK=${TMPDIR:-/tmp}/asm8080-bench.$$
+
+mkdir -p "$WORK" || exit 1
+trap 'rm -rf "$WORK"' 0 1 2 15
+
+status=0
+
+for n in $LINES; do
+	echo "*** $n lines"
+
+	# Generator print "<lines> <bytes>".
+	set -- `cd "$WORK" && "$GEN" -n"$n" $BENCH_GEN_OPTS bench_$n` || exit 1
+
+	(cd "$WORK" && "$RUN" -r"${BENCH_RUNS:-5}" -L"$1" -B"$2" \
+		"$ASM" $BENCH_ASM_OPTS bench_$n.asm) || status=1
+done
+
+exit $status
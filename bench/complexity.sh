@@ -0,0 +1,208 @@
+#!/bin/sh
+# *****************************************************************************
+# Filename:			complexity.sh
+# Description:		Complexity harness (super-linear scaling detection).
+# Copyright(c):
+# Author(s):
+# Created:			18 October 2026
+# Last modified:
+#
+# Usage:				complexity.sh <asm8080> <run_bench> [<construct>...]
+#
+# Notes:				- For each construct, generate sources of growing size
+#						  (size doubled at each step), time the assembler on
+#						  each one (best of COMPLEXITY_RUNS runs, default: 3),
+#						  and fit the growth exponent "k" of "time = a * size^k"
+#						  (least squares on log-log).  Start-up time
+#						  (assembly of an empty source) is subtracted first.
+#						- A construct fails if its exponent is higher than
+#						  COMPLEXITY_EXP (default: 1.5).
+#						- Constructs are:
+#						    labels   : Label definitions and references.
+#						    db       : Long "DB" lists.
+#						    parens   : Deeply nested parentheses.
+#						    macros   : Macro calls.
+#						    includes : Nested include files.
+#						  Default is all of them.
+#						- COMPLEXITY_STEPS (default: 4) is the number of
+#						  sizes, and COMPLEXITY_SCALE (default: 1) multiply
+#						  the start size of each construct.
+# *****************************************************************************
+
+if [ $# -lt 2 ]; then
+	echo "Usage: $0 <asm8080> <run_bench> [<construct>...]" >&2
+	exit 1
+fi
+
+# Tools are run from the work directory.  Make their paths absolute.
+abs()
+{
+	case $1 in
+		/*)	echo "$1" ;;
+		*)		echo "`pwd`/$1" ;;
+	esac
+}
+
+ASM=`abs "$1"`
+RUN=`abs "$2"`
+shift 2
+
+CONSTRUCTS=${*:-"labels db parens macros includes"}
+EXP_MAX=${COMPLEXITY_EXP:-1.5}
+STEPS=${COMPLEXITY_STEPS:-4}
+SCALE=${COMPLEXITY_SCALE:-1}
+RUNS=${COMPLEXITY_RUNS:-3}
+
+WORK=${TMPDIR:-/tmp}/asm8080-complexity.$$
+
+mkdir -p "$WORK" || exit 1
+trap 'rm -rf "$WORK"' 0 1 2 15
+
+
+# Start size of a construct.
+start_size()
+{
+	case $1 in
+		labels)		echo 1000 ;;
+		db)			echo 1000 ;;
+		parens)		echo 1000 ;;
+		macros)		echo 250 ;;
+		includes)	echo 64 ;;
+		*)				echo 0 ;;
+	esac
+}
+
+
+# Generate "$WORK/<construct>.asm" of the given size.
+# An "ORG" is put every 512 lines, so code never wraps around 64K.
+gen()
+{
+	rm -f "$WORK"/*.asm
+
+	case $1 in
+		labels)
+			# Each label reference a label defined earlier.
+			awk -v n=$2 'BEGIN {
+				for (i = 0; i < n; i++) {
+					if (i % 512 == 0) printf("\tORG\t0\n");
+					printf("L%d:\tLXI\tH,L%d\n", i, int(i / 2));
+				}
+				printf("\tEND\n");
+			}' ;;
+
+		db)
+			awk -v n=$2 'BEGIN {
+				for (i = 0; i < n; i++) {
+					if (i % 512 == 0) printf("\tORG\t0\n");
+					printf("\tDB\t0");
+					for (j = 1; j < 48; j++) printf(",%d", j);
+					printf("\n");
+				}
+				printf("\tEND\n");
+			}' ;;
+
+		parens)
+			awk -v n=$2 'BEGIN {
+				for (i = 0; i < n; i++) {
+					if (i % 512 == 0) printf("\tORG\t0\n");
+					printf("\tMVI\tA,");
+					for (j = 0; j < 32; j++) printf("(");
+					printf("%d", i % 100);
+					for (j = 0; j < 32; j++) printf(")");
+					printf("\n");
+				}
+				printf("\tEND\n");
+			}' ;;
+
+		macros)
+			awk -v n=$2 'BEGIN {
+				printf("M0\tMACRO\n\tNOP\n\tINX\tH\n\tDCX\tH\n\tENDM\n");
+				for (i = 0; i < n; i++) {
+					if (i % 512 == 0) printf("\tORG\t0\n");
+					printf("\tM0\n");
+				}
+				printf("\tEND\n");
+			}' ;;
+
+		includes)
+			# Chains of 8 nested files.
+			(cd "$WORK" && awk -v n=$2 'BEGIN {
+				for (i = 0; i < n; i++) {
+					f = sprintf("inc%d.asm", i);
+					printf("\tNOP\n\tMVI\tA,%d\n", i % 100) > f;
+					if ((i % 8 != 7) && (i + 1 < n))
+						printf("\tINCLUDE\tinc%d.asm\n", i + 1) > f;
+					close(f);
+				}
+				for (i = 0; i < n; i += 8) {
+					if (i % 512 == 0) printf("\tORG\t0\n");
+					printf("\tINCLUDE\tinc%d.asm\n", i);
+				}
+				printf("\tEND\n");
+			}') ;;
+	esac > "$WORK/$1.asm"
+}
+
+
+# Best time of the assembly of "$WORK/<name>.asm" (seconds).
+run()
+{
+	(cd "$WORK" && "$RUN" -i -r$RUNS "$ASM" $1.asm 2> /dev/null) |
+		sed -n 's/^time: *best \([0-9.]*\) s.*/\1/p'
+}
+
+
+# Start-up time.
+printf "\tEND\n" > "$WORK/empty.asm"
+base=`run empty`
+
+echo "Start-up time: ${base:-0} s, maximum exponent: $EXP_MAX"
+
+status=0
+
+for c in $CONSTRUCTS; do
+	size=`start_size $c`
+
+	if [ $size -eq 0 ]; then
+		echo "*** Error: Unknown construct (\"$c\")!" >&2
+		status=1
+		continue
+	fi
+
+	size=`expr $size \* $SCALE`
+	points=
+
+	i=0
+	while [ $i -lt $STEPS ]; do
+		gen $c $size
+
+		# Timing of a source that does not assemble means nothing.
+		if (cd "$WORK" && "$ASM" $c.asm 2>&1 > /dev/null) | grep -q Error; then
+			echo "*** Error: \"$c\" source ($size) does not assemble!" >&2
+			status=1
+			break
+		fi
+
+		time=`run $c`
+		echo "  $c $size: ${time:-?} s"
+		points="$points $size ${time:-0}"
+
+		size=`expr $size \* 2`
+		i=`expr $i + 1`
+	done
+
+	# Least squares fit of log(time - start-up) on log(size).
+	echo $points | awk -v name=$c -v base=${base:-0} -v max=$EXP_MAX '{
+		for (i = 1; i < NF; i += 2) {
+			t = $(i + 1) - base;
+			if (t < 1e-4) t = 1e-4;
+			x = log($i); y = log(t);
+			n++; sx += x; sy += y; sxx += x * x; sxy += x * y;
+		}
+		k = (n * sxy - sx * sy) / (n * sxx - sx * sx);
+		printf("%s %s: exponent %.2f\n", (k > max) ? "FAIL" : "PASS", name, k);
+		exit (k > max);
+	}' || status=1
+done
+
+exit $status
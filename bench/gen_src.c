@@ -0,0 +1,668 @@
+/*	*************************************************************************
+ *	Module Name:	gen_src.c
+ *	Description:	Synthetic 8080 Source Generator (benchmark input).
+ *	Copyright(c):	See below...
+ *	Author(s):
+ *	Created:			18 October 2026
+ *	Last modified:
+ *
+ *	Notes:			- Generate a reproducible assembly source of N lines.
+ *						  Same options and same seed always give the same
+ *						  files, on any host.
+ *
+ *						- Usage:
+ *						  gen_src [-n<lines>] [-l<%>] [-m<%>] [-i<files>]
+ *						          [-t<bytes>] [-f<%>] [-s<seed>] <basename>
+ *
+ *						  -n : Number of lines (default: 10000).
+ *						  -l : Label density (% of lines, default: 5).
+ *						  -m : Macro use (% of lines, default: 2).
+ *						  -i : INCLUDE fan-out (number of include files,
+ *						       default: 0).
+ *						  -t : DB/DW table size (bytes, default: 64).
+ *						  -f : Forward references (% of references,
+ *						       default: 50).
+ *						  -s : Random seed (default: 1).
+ *
+ *						- Files written are "<basename>.asm", and
+ *						  "<basename>_<i>.asm" for include files.
+ *
+ *						- Number of lines and number of bytes to assemble
+ *						  are printed on "stdout" ("<lines> <bytes>").
+ *	************************************************************************* */
+
+/*
+ * Copyright (c) <2007-2017> Jay Cotton <lbmgmusic@gmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+
+/*	*************************************************************************
+ *	                              INCLUDE FILES
+ *	************************************************************************* */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+
+/*	*************************************************************************
+ *											  CONSTANTS
+ *	************************************************************************* */
+
+#define GEN_INCLUDES_MAX			64			/*	Maximum number of include files. */
+#define GEN_FN_SIZE_MAX				256		/*	Maximum file name size. */
+
+/*	- Program counter is moved back to "GEN_ORG" when it pass
+ *	  "GEN_PC_LIMIT", so any number of lines can be assembled.
+ *	*/
+#define GEN_ORG						0x0100
+#define GEN_PC_LIMIT					0xF000
+
+#define GEN_MACROS					4			/*	Number of macros defined. */
+#define GEN_TABLE_EVERY				200		/*	One table every N lines. */
+
+
+/*	*************************************************************************
+ *	                                VARIABLES
+ *	************************************************************************* */
+
+/*	Private variables.
+ *	****************** */
+
+/*	Options.
+ *	-------- */
+static long	gen_lines			= 10000;
+static int	gen_label_pct		= 5;
+static int	gen_macro_pct		= 2;
+static int	gen_includes		= 0;
+static int	gen_table_size		= 64;
+static int	gen_forward_pct	= 50;
+static unsigned long	gen_seed	= 1;
+
+/*	Generator state.
+ *	---------------- */
+static unsigned long	gen_rand_state;
+static long	gen_labels_total;			/*	Number of labels to define. */
+static long	gen_labels_defined;		/*	Number of labels defined so far. */
+static long	gen_pc;						/*	Estimated program counter. */
+static long	gen_bytes;					/*	Number of bytes generated. */
+static long	gen_lines_out;				/*	Number of lines written. */
+
+static const char	*gen_reg8[]		= {"A", "B", "C", "D", "E", "H", "L"};
+static const char	*gen_reg16[]	= {"B", "D", "H", "SP"};
+static const char	*gen_alu[]		=
+	{"ADD", "ADC", "SUB", "SBB", "ANA", "XRA", "ORA", "CMP"};
+static const char	*gen_alu_i[]	=
+	{"ADI", "ACI", "SUI", "SBI", "ANI", "XRI", "ORI", "CPI"};
+static const char	*gen_jump[]		=
+	{"JMP", "JNZ", "JZ", "JNC", "JC", "CALL", "CNZ", "CZ"};
+
+
+/*	*************************************************************************
+ *									  FUNCTIONS DECLARATION
+ *	************************************************************************* */
+
+static unsigned long gen_rand(void);
+static int gen_pick(int n);
+static int gen_chance(int pct);
+static void gen_label_ref(char *text);
+static void gen_line(FILE *fp, const char *label, const char *fmt, ...);
+static void gen_macros(FILE *fp);
+static void gen_table(FILE *fp, long *p_left);
+static void gen_instruction(FILE *fp);
+static void gen_body(FILE *fp, long lines);
+static int process_option(char *text);
+
+
+/*	*************************************************************************
+ *	                                FUNCTIONS
+ *	************************************************************************* */
+
+#include <stdarg.h>
+
+
+/*	*************************************************************************
+ *	Function name:	gen_rand
+ *	Description:	Pseudo-random number generator.
+ *	Author(s):
+ *	Created:			18 October 2026
+ *	Last modified:
+ *	Parameters:		void
+ *
+ *	Returns:			unsigned long:
+ *							Pseudo-random number (0 to 0x7FFF).
+ *
+ *	Globals:
+ *
+ *	Notes:			- "rand()" is not used, since its sequence depend on
+ *						  the C library.
+ *	************************************************************************* */
+
+static unsigned long gen_rand(void)
+{
+	gen_rand_state	= (gen_rand_state * 1103515245UL + 12345UL) & 0xFFFFFFFFUL;
+
+	return ((gen_rand_state >> 16) & 0x7FFF);
+}
+
+
+/*	*************************************************************************
+ *	Function name:	gen_pick
+ *	Description:	Pick a number from 0 to (n - 1).
+ *	Author(s):
+ *	Created:			18 October 2026
+ *	Last modified:
+ *	Parameters:		int n
+ *	Returns:			int
+ *	Globals:
+ *	Notes:
+ *	************************************************************************* */
+
+static int gen_pick(int n)
+{
+	return ((int) (gen_rand() % (unsigned long) n));
+}
+
+
+/*	*************************************************************************
+ *	Function name:	gen_chance
+ *	Description:	Return 1 with a probability of "pct" percent.
+ *	Author(s):
+ *	Created:			18 October 2026
+ *	Last modified:
+ *	Parameters:		int pct
+ *	Returns:			int
+ *	Globals:
+ *	Notes:
+ *	************************************************************************* */
+
+static int gen_chance(int pct)
+{
+	return (gen_pick(100) < pct);
+}
+
+
+/*	*************************************************************************
+ *	Function name:	gen_label_ref
+ *	Description:	Build a reference to a label.
+ *	Author(s):
+ *	Created:			18 October 2026
+ *	Last modified:
+ *
+ *	Parameters:		char *text:
+ *							Point to a buffer that receive the label name.
+ *
+ *	Returns:			void
+ *	Globals:
+ *
+ *	Notes:			- A forward reference use a label not defined yet.
+ *						  A backward reference use a label already defined.
+ *	************************************************************************* */
+
+static void gen_label_ref(char *text)
+{
+	long	left	= gen_labels_total - gen_labels_defined;
+	long	index;
+
+
+	if (	(left > 0) &&
+		  	((gen_labels_defined == 0) || gen_chance(gen_forward_pct)))
+	{
+		index	= gen_labels_defined + (long) (gen_rand() % (unsigned long) left);
+	}
+	else if (gen_labels_defined > 0)
+		index	= (long) (gen_rand() % (unsigned long) gen_labels_defined);
+	else
+	{
+		strcpy(text, "0");
+		return;
+	}
+
+	sprintf(text, "L%06ld", index);
+}
+
+
+/*	*************************************************************************
+ *	Function name:	gen_line
+ *	Description:	Write a source line.
+ *	Author(s):
+ *	Created:			18 October 2026
+ *	Last modified:
+ *
+ *	Parameters:		FILE *fp:
+ *							Source file.
+ *
+ *						const char *label:
+ *							Label (NULL if none).
+ *
+ *						const char *fmt:
+ *							"printf()" format of the rest of the line.
+ *
+ *	Returns:			void
+ *	Globals:
+ *	Notes:
+ *	************************************************************************* */
+
+static void gen_line(FILE *fp, const char *label, const char *fmt, ...)
+{
+	va_list	ap;
+
+
+	if (label != NULL)
+		fprintf(fp, "%s:", label);
+
+	fputc('\t', fp);
+
+	va_start(ap, fmt);
+	vfprintf(fp, fmt, ap);
+	va_end(ap);
+
+	fputc('\n', fp);
+	gen_lines_out++;
+}
+
+
+/*	*************************************************************************
+ *	Function name:	gen_macros
+ *	Description:	Define the macros used by the source.
+ *	Author(s):
+ *	Created:			18 October 2026
+ *	Last modified:
+ *	Parameters:		FILE *fp
+ *	Returns:			void
+ *	Globals:
+ *
+ *	Notes:			- Macros do not hold labels, since a label would be
+ *						  defined again on each use.
+ *	************************************************************************* */
+
+static void gen_macros(FILE *fp)
+{
+	int	i;
+
+
+	for (i = 0; i < GEN_MACROS; i++)
+	{
+		fprintf(fp, "GM%d\tMACRO\n", i);
+		fprintf(fp, "\tPUSH\tPSW\n");
+		fprintf(fp, "\tMVI\tA,%d\n", i);
+		fprintf(fp, "\tPOP\tPSW\n");
+		fprintf(fp, "\tENDM\n");
+		gen_lines_out	+= 5;
+	}
+}
+
+
+/*	*************************************************************************
+ *	Function name:	gen_table
+ *	Description:	Write a "DB" or "DW" table.
+ *	Author(s):
+ *	Created:			18 October 2026
+ *	Last modified:
+ *
+ *	Parameters:		FILE *fp:
+ *							Source file.
+ *
+ *						long *p_left:
+ *							Point to the number of lines left to write.
+ *
+ *	Returns:			void
+ *	Globals:
+ *	Notes:
+ *	************************************************************************* */
+
+static void gen_table(FILE *fp, long *p_left)
+{
+	int	words	= gen_chance(50);
+	int	per_line	= words ? 8 : 16;
+	int	left		= words ? (gen_table_size / 2) : gen_table_size;
+	char	text[200];
+
+
+	while ((left > 0) && (*p_left > 0))
+	{
+		int	n	= (left < per_line) ? left : per_line;
+		int	i;
+		char	*p_text	= text;
+
+
+		for (i = 0; i < n; i++)
+		{
+			if (words)
+				p_text	+= sprintf(p_text, "%s0%04XH", (i > 0) ? "," : "", gen_pick(0x10000));
+			else
+				p_text	+= sprintf(p_text, "%s%d", (i > 0) ? "," : "", gen_pick(256));
+		}
+
+		gen_line(fp, NULL, "%s\t%s", words ? "DW" : "DB", text);
+
+		gen_pc		+= words ? (2 * n) : n;
+		gen_bytes	+= words ? (2 * n) : n;
+		left			-= n;
+		(*p_left)--;
+	}
+}
+
+
+/*	*************************************************************************
+ *	Function name:	gen_instruction
+ *	Description:	Write an instruction line.
+ *	Author(s):
+ *	Created:			18 October 2026
+ *	Last modified:
+ *	Parameters:		FILE *fp
+ *	Returns:			void
+ *	Globals:
+ *	Notes:
+ *	************************************************************************* */
+
+static void gen_instruction(FILE *fp)
+{
+	char	label[16];
+	char	ref[16];
+	char	*p_label	= NULL;
+	int	size;
+
+
+	/*	Define a label.
+	 *	--------------- */
+	if ((gen_labels_defined < gen_labels_total) && gen_chance(gen_label_pct))
+	{
+		sprintf(label, "L%06ld", gen_labels_defined++);
+		p_label	= label;
+	}
+
+	switch (gen_pick(8))
+	{
+		case 0:
+			gen_line(	fp, p_label, "MOV\t%s,%s", gen_reg8[gen_pick(7)],
+				  		gen_reg8[gen_pick(7)]);
+			size	= 1;
+			break;
+
+		case 1:
+			gen_line(	fp, p_label, "MVI\t%s,0%02XH", gen_reg8[gen_pick(7)],
+				  		gen_pick(256));
+			size	= 2;
+			break;
+
+		case 2:
+			gen_label_ref(ref);
+			gen_line(fp, p_label, "LXI\t%s,%s", gen_reg16[gen_pick(4)], ref);
+			size	= 3;
+			break;
+
+		case 3:
+		case 4:
+			gen_label_ref(ref);
+			gen_line(fp, p_label, "%s\t%s", gen_jump[gen_pick(8)], ref);
+			size	= 3;
+			break;
+
+		case 5:
+			gen_line(fp, p_label, "%s\t%s", gen_alu[gen_pick(8)], gen_reg8[gen_pick(7)]);
+			size	= 1;
+			break;
+
+		case 6:
+			gen_line(fp, p_label, "%s\t%d", gen_alu_i[gen_pick(8)], gen_pick(256));
+			size	= 2;
+			break;
+
+		default:
+			gen_line(fp, p_label, "INX\t%s", gen_reg16[gen_pick(4)]);
+			size	= 1;
+			break;
+	}
+
+	gen_pc		+= size;
+	gen_bytes	+= size;
+}
+
+
+/*	*************************************************************************
+ *	Function name:	gen_body
+ *	Description:	Write source lines.
+ *	Author(s):
+ *	Created:			18 October 2026
+ *	Last modified:
+ *
+ *	Parameters:		FILE *fp:
+ *							Source file.
+ *
+ *						long lines:
+ *							Number of lines to write.
+ *
+ *	Returns:			void
+ *	Globals:
+ *	Notes:
+ *	************************************************************************* */
+
+static void gen_body(FILE *fp, long lines)
+{
+	while (lines > 0)
+	{
+		/*	Keep program counter in range.
+		 *	------------------------------ */
+		if (gen_pc >= GEN_PC_LIMIT)
+		{
+			gen_line(fp, NULL, "ORG\t0%04XH", GEN_ORG);
+			gen_pc	= GEN_ORG;
+			lines--;
+		}
+		/*	Table.
+		 *	------ */
+		else if ((gen_table_size > 0) && (gen_pick(GEN_TABLE_EVERY) == 0))
+			gen_table(fp, &lines);
+		/*	Macro use (3 lines, 5 bytes).
+		 *	----------------------------- */
+		else if (gen_chance(gen_macro_pct))
+		{
+			gen_line(fp, NULL, "GM%d", gen_pick(GEN_MACROS));
+			gen_pc		+= 5;
+			gen_bytes	+= 5;
+			lines--;
+		}
+		/*	Comment.
+		 *	-------- */
+		else if (gen_chance(3))
+		{
+			fprintf(fp, "; Comment, line %ld.\n", gen_lines_out + 1);
+			gen_lines_out++;
+			lines--;
+		}
+		/*	Instruction.
+		 *	------------ */
+		else
+		{
+			gen_instruction(fp);
+			lines--;
+		}
+	}
+}
+
+
+/*	*************************************************************************
+ *	Function name:	process_option
+ *	Description:	Process a command line option.
+ *	Author(s):
+ *	Created:			18 October 2026
+ *	Last modified:
+ *
+ *	Parameters:		char *text:
+ *							Option ("-x<value>").
+ *
+ *	Returns:			int:
+ *							-1	: Operation failed.
+ *							0	: Operation successfull.
+ *
+ *	Globals:
+ *	Notes:
+ *	************************************************************************* */
+
+static int process_option(char *text)
+{
+	char	*p_end;
+	long	value	= strtol(text + 2, &p_end, 10);
+
+
+	if ((text[2] == '\0') || (*p_end != '\0') || (value < 0))
+		return (-1);
+
+	switch (text[1])
+	{
+		case 'n':	gen_lines		= value;						break;
+		case 'l':	gen_label_pct	= (int) value;				break;
+		case 'm':	gen_macro_pct	= (int) value;				break;
+		case 'i':	gen_includes	= (int) value;				break;
+		case 't':	gen_table_size	= (int) value;				break;
+		case 'f':	gen_forward_pct	= (int) value;			break;
+		case 's':	gen_seed			= (unsigned long) value;	break;
+		default:		return (-1);
+	}
+
+	return (0);
+}
+
+
+/*	*************************************************************************
+ *	Function name:	main
+ *	Description:	Main Function.
+ *	Author(s):
+ *	Created:			18 October 2026
+ *	Last modified:
+ *
+ *	Parameters:		int argc:
+ *							...
+ *
+ *						char *argv[]:
+ *							...
+ *
+ *	Returns:			int:
+ *							EXIT_SUCCESS or EXIT_FAILURE.
+ *
+ *	Globals:
+ *	Notes:
+ *	************************************************************************* */
+
+int main(int argc, char *argv[])
+{
+	char	fn[GEN_FN_SIZE_MAX];
+	char	*basename	= NULL;
+	FILE	*fp;
+	long	body;
+	long	part;
+	int	i;
+
+
+	for (i = 1; i < argc; i++)
+	{
+		if (argv[i][0] != '-')
+			basename	= argv[i];
+		else if (process_option(argv[i]) == -1)
+		{
+			fprintf(stderr, "*** Error: Bad option (\"%s\")!\n", argv[i]);
+			return (EXIT_FAILURE);
+		}
+	}
+
+	if (	(basename == NULL) || (strlen(basename) > (GEN_FN_SIZE_MAX - 16)) ||
+		  	(gen_includes > GEN_INCLUDES_MAX) || (gen_label_pct > 100) ||
+			(gen_macro_pct > 100) || (gen_forward_pct > 100))
+	{
+		fprintf(	stderr,
+			  		"Usage: gen_src [-n<lines>] [-l<%%>] [-m<%%>] [-i<files>] "
+					"[-t<bytes>] [-f<%%>] [-s<seed>] <basename>\n");
+
+		return (EXIT_FAILURE);
+	}
+
+	gen_rand_state		= gen_seed;
+	gen_labels_total	= (gen_lines * gen_label_pct) / 100;
+	gen_pc				= GEN_ORG;
+
+	sprintf(fn, "%s.asm", basename);
+
+	if ((fp = fopen(fn, "w")) == NULL)
+	{
+		fprintf(stderr, "*** Error: Can't create \"%s\"!\n", fn);
+		return (EXIT_FAILURE);
+	}
+
+	/*	Header: origin, and macros.
+	 *	--------------------------- */
+	gen_line(fp, NULL, "ORG\t0%04XH", GEN_ORG);
+	gen_macros(fp);
+
+	/*	- Lines left (minus "INCLUDE" and "END" lines) are shared
+	 *	  between the main file and include files.
+	 *	*/
+	body	= gen_lines - gen_lines_out - gen_includes - 1;
+
+	if (body < 0)
+		body	= 0;
+
+	part	= body / (gen_includes + 1);
+
+	for (i = 0; i < gen_includes; i++)
+	{
+		char	fn_inc[GEN_FN_SIZE_MAX];
+		FILE	*fp_inc;
+
+		sprintf(fn_inc, "%s_%d.asm", basename, i);
+
+		if ((fp_inc = fopen(fn_inc, "w")) == NULL)
+		{
+			fprintf(stderr, "*** Error: Can't create \"%s\"!\n", fn_inc);
+			fclose(fp);
+			return (EXIT_FAILURE);
+		}
+
+		/*	- Main file include name without directory, since the
+		 *	  assembler is run from the generated files directory.
+		 *	*/
+		gen_line(	fp, NULL, "INCLUDE\t%s",
+			  		(strrchr(fn_inc, '/') != NULL) ? strrchr(fn_inc, '/') + 1 : fn_inc);
+
+		gen_body(fp_inc, part);
+		fclose(fp_inc);
+	}
+
+	gen_body(fp, body - (part * gen_includes));
+
+	/*	Labels not used yet are defined at end, so all forward
+	 *	references can be resolved.
+	 *	------------------------------------------------------- */
+	while (gen_labels_defined < gen_labels_total)
+	{
+		fprintf(fp, "L%06ld:\n", gen_labels_defined++);
+		gen_lines_out++;
+	}
+
+	gen_line(fp, NULL, "END");
+	fclose(fp);
+
+	printf("%ld %ld\n", gen_lines_out, gen_bytes);
+
+	return (EXIT_SUCCESS);
+}
+
+
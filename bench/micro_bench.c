@@ -0,0 +1,541 @@
+/*	*************************************************************************
+ *	Module Name:	micro_bench.c
+ *	Description:	Assembler Hot Functions Microbenchmarks.
+ *	Copyright(c):	See below...
+ *	Author(s):
+ *	Created:			18 October 2026
+ *	Last modified:
+ *
+ *	Notes:			- Time, in tight loops:
+ *						  - "exp_parser()" on representative operands.
+ *						  - "FindLabel()" with 1k, 10k and 100k symbols.
+ *						  - "src_line_parser()" on each instruction class.
+ *						  - "extract_byte()" on each numeric base.
+ *						  - "ProcessDumpHex()" on a full 64K image.
+ *
+ *						- Each test is calibrated to run about
+ *						  "MB_SAMPLE_NS" per sample, and "MB_SAMPLES"
+ *						  samples are taken.  Mean, standard deviation and
+ *						  minimum are printed, in ns/op.
+ *
+ *						- The assembler modules are linked in, without
+ *						  "asm8080.c" (its "main()").
+ *
+ *						- POSIX only (needs "clock_gettime()").
+ *	************************************************************************* */
+
+/*
+ * Copyright (c) <2007-2017> Jay Cotton <lbmgmusic@gmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+
+/*	*************************************************************************
+ *	                              INCLUDE FILES
+ *	************************************************************************* */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <time.h>
+
+#include "project.h"
+#include "err_code.h"		/*	Error Codes. */
+#include "util.h"
+#include "exp_parser.h"
+#include "mem.h"
+#include "main.h"
+
+
+/*	*************************************************************************
+ *											  CONSTANTS
+ *	************************************************************************* */
+
+#define MB_SAMPLES					15				/*	Samples per test. */
+#define MB_SAMPLE_NS					20000000.0	/*	Sample duration (20 ms). */
+#define MB_SYMBOLS_MAX				100000		/*	Largest symbols table. */
+
+
+/*	*************************************************************************
+ *	                                 TYPEDEF
+ *	************************************************************************* */
+
+/*	Operation to time.  Do it "n" times.
+ *	------------------------------------ */
+typedef void (*mb_op_t) (const char *arg, long n);
+
+
+/*	*************************************************************************
+ *	                                VARIABLES
+ *	************************************************************************* */
+
+/*	Private variables.
+ *	****************** */
+
+/*	Results go there, so the compiler can not remove the work.
+ *	*/
+static volatile long	mb_sink;
+
+/*	Symbols table used by "FindLabel()" test.
+ *	----------------------------------------- */
+static SYMBOL	*mb_symbols			= NULL;
+static SYMBOL	*mb_symbols_tail	= NULL;
+static long		mb_symbols_cnt		= 0;
+
+static const char	*mb_expressions[]	=
+{
+	"1234H",
+	"LABEL1",
+	"LABEL1+2",
+	"$+3",
+	"'A'+1",
+	"HIGH LABEL2",
+	"(LABEL1 SHR 8) AND 0FFH",
+	"10000000B OR 01H",
+	NULL
+};
+
+static const char	*mb_lines[]	=
+{
+	"MOV\tA,B",
+	"MVI\tC,12H",
+	"LXI\tH,LABEL1",
+	"ADD\tM",
+	"ADI\t10",
+	"JNZ\tLABEL2",
+	"CALL\tLABEL1",
+	"PUSH\tPSW",
+	"INX\tSP",
+	"RST\t7",
+	"IN\t10H",
+	"NOP",
+	NULL
+};
+
+static const char	*mb_numbers[]	=
+{
+	"123",
+	"123D",
+	"0FFH",
+	"377Q",
+	"377O",
+	"10101010B",
+	"'A'",
+	NULL
+};
+
+
+/*	*************************************************************************
+ *									  FUNCTIONS DECLARATION
+ *	************************************************************************* */
+
+static double mb_now(void);
+static void mb_run(const char *name, const char *arg, mb_op_t op);
+static void mb_exp_parser(const char *arg, long n);
+static void mb_find_label(const char *arg, long n);
+static void mb_src_line_parser(const char *arg, long n);
+static void mb_extract_byte(const char *arg, long n);
+static void mb_dump_hex(const char *arg, long n);
+static void mb_symbols_grow(long count);
+
+
+/*	*************************************************************************
+ *	                                FUNCTIONS
+ *	************************************************************************* */
+
+/*	*************************************************************************
+ *	Function name:	mb_now
+ *	Description:	Get current time.
+ *	Author(s):
+ *	Created:			18 October 2026
+ *	Last modified:
+ *	Parameters:		void
+ *
+ *	Returns:			double:
+ *							Monotonic time, in nanoseconds.
+ *
+ *	Globals:
+ *	Notes:
+ *	************************************************************************* */
+
+static double mb_now(void)
+{
+	struct timespec	ts;
+
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+
+	return (((double) ts.tv_sec * 1e9) + (double) ts.tv_nsec);
+}
+
+
+/*	*************************************************************************
+ *	Function name:	mb_run
+ *	Description:	Time an operation, and print the result.
+ *	Author(s):
+ *	Created:			18 October 2026
+ *	Last modified:
+ *
+ *	Parameters:		const char *name:
+ *							Test name.
+ *
+ *						const char *arg:
+ *							Operation argument.
+ *
+ *						mb_op_t op:
+ *							Operation.
+ *
+ *	Returns:			void
+ *	Globals:
+ *
+ *	Notes:			- Number of operations per sample is doubled until
+ *						  a sample last "MB_SAMPLE_NS".
+ *	************************************************************************* */
+
+static void mb_run(const char *name, const char *arg, mb_op_t op)
+{
+	double	sample[MB_SAMPLES];
+	char		text[32];
+	double	mean	= 0;
+	double	var	= 0;
+	double	min;
+	double	t;
+	long		n;
+	int		i;
+
+
+	/*	Calibrate.
+	 *	---------- */
+	for (n = 1; ; n *= 2)
+	{
+		t	= mb_now();
+		op(arg, n);
+
+		if ((mb_now() - t) >= (MB_SAMPLE_NS / 4))
+			break;
+	}
+
+	n	*= 4;
+
+	/*	Take samples.
+	 *	------------- */
+	for (i = 0; i < MB_SAMPLES; i++)
+	{
+		t				= mb_now();
+		op(arg, n);
+		sample[i]	= (mb_now() - t) / n;
+		mean			+= sample[i];
+	}
+
+	mean	/= MB_SAMPLES;
+	min	= sample[0];
+
+	for (i = 0; i < MB_SAMPLES; i++)
+	{
+		var	+= (sample[i] - mean) * (sample[i] - mean);
+
+		if (sample[i] < min)
+			min	= sample[i];
+	}
+
+	var	/= (MB_SAMPLES - 1);
+
+	/*	Display argument on one column.
+	 *	------------------------------- */
+	strncpy(text, arg, sizeof (text) - 1);
+	text[sizeof (text) - 1]	= '\0';
+
+	for (i = 0; text[i] != '\0'; i++)
+	{
+		if (text[i] == '\t')
+			text[i]	= ' ';
+	}
+
+	printf(	"%-18s %-28s %12.1f ns/op  +/- %9.1f  (min %12.1f)\n",
+		  		name, text, mean, sqrt(var), min);
+}
+
+
+/*	*************************************************************************
+ *	Function name:	mb_exp_parser
+ *	Description:	Evaluate an expression "n" times.
+ *	Author(s):
+ *	Created:			18 October 2026
+ *	Last modified:
+ *	Parameters:		const char *arg, long n
+ *	Returns:			void
+ *	Globals:
+ *
+ *	Notes:			- Expression text is altered by the parser.  So, it is
+ *						  copied before each call.  Copy cost is included in
+ *						  the result.
+ *	************************************************************************* */
+
+static void mb_exp_parser(const char *arg, long n)
+{
+	char	text[EQUATION_SIZE_MAX];
+
+	while (n-- > 0)
+	{
+		strcpy(text, arg);
+		mb_sink	+= exp_parser(text);
+	}
+}
+
+
+/*	*************************************************************************
+ *	Function name:	mb_find_label
+ *	Description:	Look for symbols "n" times.
+ *	Author(s):
+ *	Created:			18 October 2026
+ *	Last modified:
+ *	Parameters:		const char *arg, long n
+ *	Returns:			void
+ *	Globals:
+ *
+ *	Notes:			- Symbols looked for are spread over the whole table.
+ *						  So, on average, half the table is walked.
+ *	************************************************************************* */
+
+static void mb_find_label(const char *arg, long n)
+{
+	char				label[32];
+	unsigned long	index	= 1;
+
+	(void) arg;
+
+	while (n-- > 0)
+	{
+		index	= (index * 1103515245UL + 12345UL) & 0x7FFFFFFFUL;
+
+		sprintf(label, "S%06lu", index % (unsigned long) mb_symbols_cnt);
+		mb_sink	+= (FindLabel(label) != NULL);
+	}
+}
+
+
+/*	*************************************************************************
+ *	Function name:	mb_src_line_parser
+ *	Description:	Parse and encode a source line "n" times.
+ *	Author(s):
+ *	Created:			18 October 2026
+ *	Last modified:
+ *	Parameters:		const char *arg, long n
+ *	Returns:			void
+ *	Globals:
+ *
+ *	Notes:			- The line (an opcode, without label) is copied before
+ *						  each call.  Copy cost is included in the result.
+ *	************************************************************************* */
+
+static void mb_src_line_parser(const char *arg, long n)
+{
+	char	text[SRC_LINE_WIDTH_MAX];
+
+	while (n-- > 0)
+	{
+		sprintf(text, "\t%s", arg);
+		mb_sink	+= src_line_parser(text);
+	}
+}
+
+
+/*	*************************************************************************
+ *	Function name:	mb_extract_byte
+ *	Description:	Convert a number "n" times.
+ *	Author(s):
+ *	Created:			18 October 2026
+ *	Last modified:
+ *	Parameters:		const char *arg, long n
+ *	Returns:			void
+ *	Globals:
+ *	Notes:
+ *	************************************************************************* */
+
+static void mb_extract_byte(const char *arg, long n)
+{
+	char	text[32];
+
+	while (n-- > 0)
+	{
+		strcpy(text, arg);
+		mb_sink	+= extract_byte(text);
+	}
+}
+
+
+/*	*************************************************************************
+ *	Function name:	mb_dump_hex
+ *	Description:	Dump the whole 64K image in Intel hex format "n" times.
+ *	Author(s):
+ *	Created:			18 October 2026
+ *	Last modified:
+ *	Parameters:		const char *arg, long n
+ *	Returns:			void
+ *	Globals:
+ *	Notes:			- Output goes to "/dev/null".
+ *	************************************************************************* */
+
+static void mb_dump_hex(const char *arg, long n)
+{
+	(void) arg;
+
+	target.pc_org	= 0x0000;
+	target.addr		= 0x10000;
+
+	while (n-- > 0)
+		ProcessDumpHex(0);
+}
+
+
+/*	*************************************************************************
+ *	Function name:	mb_symbols_grow
+ *	Description:	Grow "FindLabel()" test symbols table.
+ *	Author(s):
+ *	Created:			18 October 2026
+ *	Last modified:
+ *
+ *	Parameters:		long count:
+ *							New number of symbols.
+ *
+ *	Returns:			void
+ *	Globals:
+ *
+ *	Notes:			- Table is built the way "AddLabel()" does (empty node
+ *						  at end), but nodes are appended directly, since
+ *						  "AddLabel()" walk the whole table on each call.
+ *	************************************************************************* */
+
+static void mb_symbols_grow(long count)
+{
+	char	label[32];
+
+
+	if (mb_symbols == NULL)
+	{
+		mb_symbols			= (SYMBOL *) calloc(1, sizeof (SYMBOL));
+		mb_symbols_tail	= mb_symbols;
+	}
+
+	while (mb_symbols_cnt < count)
+	{
+		sprintf(label, "S%06ld", mb_symbols_cnt);
+
+		mb_symbols_tail->Symbol_Name	= strdup(label);
+		mb_symbols_tail->Symbol_Value	= (int) (mb_symbols_cnt & 0xFFFF);
+		mb_symbols_tail->Symbol_Type	= SYMBOL_LABEL;
+		mb_symbols_tail->next			= calloc(1, sizeof (SYMBOL));
+		mb_symbols_tail					= (SYMBOL *) mb_symbols_tail->next;
+
+		if (mb_symbols_tail == NULL)
+		{
+			fprintf(stderr, "*** Error %d: Can't allocate memory!\n", EC_CAM);
+			exit(EXIT_FAILURE);
+		}
+
+		mb_symbols_cnt++;
+	}
+}
+
+
+/*	*************************************************************************
+ *	Function name:	main
+ *	Description:	Main Function.
+ *	Author(s):
+ *	Created:			18 October 2026
+ *	Last modified:
+ *	Parameters:		void
+ *
+ *	Returns:			int:
+ *							EXIT_SUCCESS or EXIT_FAILURE.
+ *
+ *	Globals:
+ *	Notes:
+ *	************************************************************************* */
+
+int main(void)
+{
+	SYMBOL	*symbols_asm;
+	char		label[32];
+	long		count;
+	int		i;
+
+
+	/*	Same initialization as the assembler.
+	 *	------------------------------------- */
+	if_true[0]	= 1;
+
+	Symbols			= (SYMBOL *) mem_calloc(MT_SYMBOLS, 1, sizeof (SYMBOL));
+	ByteWordStack	= (STACK *) mem_calloc(MT_STACK, 1, sizeof (STACK));
+	in_fn[0]			= "micro_bench";
+	hex				= fopen("/dev/null", "w");
+
+	if ((Symbols == NULL) || (ByteWordStack == NULL) || (hex == NULL))
+	{
+		fprintf(stderr, "*** Error %d: Can't allocate memory!\n", EC_CAM);
+		return (EXIT_FAILURE);
+	}
+
+	/*	- Labels used by expressions and source lines.  Define them on
+	 *	  assembler pass #1, then work as on assembler pass #2.
+	 *	*/
+	asm_pass		= 0;
+	target.pc	= 0x1234;
+	process_label("LABEL1");
+	target.pc	= 0x5678;
+	process_label("LABEL2");
+
+	asm_pass		= 1;
+	target.pc	= 0x0100;
+	target.addr	= 0x0100;
+
+	for (i = 0; mb_expressions[i] != NULL; i++)
+		mb_run("exp_parser", mb_expressions[i], mb_exp_parser);
+
+	for (i = 0; mb_lines[i] != NULL; i++)
+		mb_run("src_line_parser", mb_lines[i], mb_src_line_parser);
+
+	for (i = 0; mb_numbers[i] != NULL; i++)
+		mb_run("extract_byte", mb_numbers[i], mb_extract_byte);
+
+	mb_run("ProcessDumpHex", "64K", mb_dump_hex);
+
+	/*	Symbols table lookups.
+	 *	---------------------- */
+	symbols_asm	= Symbols;
+
+	for (count = 1000; count <= MB_SYMBOLS_MAX; count *= 10)
+	{
+		mb_symbols_grow(count);
+		Symbols	= mb_symbols;
+
+		sprintf(label, "%ld symbols", count);
+		mb_run("FindLabel", label, mb_find_label);
+	}
+
+	Symbols	= symbols_asm;
+
+	fclose(hex);
+	hex	= NULL;
+
+	return (EXIT_SUCCESS);
+}
+
+
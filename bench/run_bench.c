@@ -0,0 +1,262 @@
+/*	*************************************************************************
+ *	Module Name:	run_bench.c
+ *	Description:	Assembler Throughput Benchmark.
+ *	Copyright(c):	See below...
+ *	Author(s):
+ *	Created:			18 October 2026
+ *	Last modified:
+ *
+ *	Notes:			- Usage:
+ *						  run_bench [-r<runs>] [-L<lines>] [-B<bytes>] [-i]
+ *						            <command> [<arguments>...]
+ *
+ *						  -r : Number of runs (default: 5).
+ *						  -i : Ignore command exit status.
+ *						  -L : Number of source lines assembled.
+ *						  -B : Number of bytes emitted.
+ *
+ *						- Run the command (usually the assembler), and print
+ *						  best and mean time, lines/second, bytes/second
+ *						  and peak RSS (resident set size) of the command.
+ *
+ *						- POSIX only (needs "fork()" and "getrusage()").
+ *	************************************************************************* */
+
+/*
+ * Copyright (c) <2007-2017> Jay Cotton <lbmgmusic@gmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+
+/*	*************************************************************************
+ *	                              INCLUDE FILES
+ *	************************************************************************* */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <sys/time.h>
+#include <sys/resource.h>
+#include <sys/types.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+
+/*	*************************************************************************
+ *									  FUNCTIONS DECLARATION
+ *	************************************************************************* */
+
+static double time_now(void);
+static double run_once(char *argv[]);
+
+
+/*	*************************************************************************
+ *	                                VARIABLES
+ *	************************************************************************* */
+
+/*	Private variables.
+ *	****************** */
+
+static int	ignore_status	= 0;		/*	"-i" option. */
+
+
+/*	*************************************************************************
+ *	                                FUNCTIONS
+ *	************************************************************************* */
+
+/*	*************************************************************************
+ *	Function name:	time_now
+ *	Description:	Get current time.
+ *	Author(s):
+ *	Created:			18 October 2026
+ *	Last modified:
+ *	Parameters:		void
+ *
+ *	Returns:			double:
+ *							Time, in seconds.
+ *
+ *	Globals:
+ *	Notes:
+ *	************************************************************************* */
+
+static double time_now(void)
+{
+	struct timeval	tv;
+
+	gettimeofday(&tv, NULL);
+
+	return ((double) tv.tv_sec + ((double) tv.tv_usec / 1e6));
+}
+
+
+/*	*************************************************************************
+ *	Function name:	run_once
+ *	Description:	Run the command once.
+ *	Author(s):
+ *	Created:			18 October 2026
+ *	Last modified:
+ *
+ *	Parameters:		char *argv[]:
+ *							Command and its arguments (NULL terminated).
+ *
+ *	Returns:			double:
+ *							- Elapsed time, in seconds.
+ *							- (-1) if command failed.
+ *
+ *	Globals:			int ignore_status
+ *	Notes:			- Command output is discarded.
+ *	************************************************************************* */
+
+static double run_once(char *argv[])
+{
+	double	start	= time_now();
+	pid_t		pid;
+	int		status;
+
+
+	if ((pid = fork()) < 0)
+		return (-1);
+
+	if (pid == 0)
+	{
+		if (freopen("/dev/null", "w", stdout) == NULL)
+			_exit(127);
+
+		execvp(argv[0], argv);
+		_exit(127);
+	}
+
+	if (waitpid(pid, &status, 0) != pid)
+		return (-1);
+
+	if (!WIFEXITED(status) || (WEXITSTATUS(status) == 127))
+		return (-1);
+
+	if ((WEXITSTATUS(status) != 0) && (ignore_status == 0))
+		return (-1);
+
+	return (time_now() - start);
+}
+
+
+/*	*************************************************************************
+ *	Function name:	main
+ *	Description:	Main Function.
+ *	Author(s):
+ *	Created:			18 October 2026
+ *	Last modified:
+ *
+ *	Parameters:		int argc:
+ *							...
+ *
+ *						char *argv[]:
+ *							...
+ *
+ *	Returns:			int:
+ *							EXIT_SUCCESS or EXIT_FAILURE.
+ *
+ *	Globals:
+ *	Notes:
+ *	************************************************************************* */
+
+int main(int argc, char *argv[])
+{
+	struct rusage	usage;
+
+	long		runs	= 5;
+	long		lines	= 0;
+	long		bytes	= 0;
+	double	best	= 0;
+	double	total	= 0;
+	long		rss;
+	long		n;
+	int		i;
+
+
+	/*	Options.
+	 *	-------- */
+	for (i = 1; (i < argc) && (argv[i][0] == '-'); i++)
+	{
+		switch (argv[i][1])
+		{
+			case 'r':	runs	= strtol(argv[i] + 2, NULL, 10);	break;
+			case 'L':	lines	= strtol(argv[i] + 2, NULL, 10);	break;
+			case 'B':	bytes	= strtol(argv[i] + 2, NULL, 10);	break;
+			case 'i':	ignore_status	= 1;								break;
+
+			default:
+				fprintf(stderr, "*** Error: Bad option (\"%s\")!\n", argv[i]);
+				return (EXIT_FAILURE);
+		}
+	}
+
+	if ((i >= argc) || (runs < 1))
+	{
+		fprintf(	stderr,
+			  		"Usage: run_bench [-r<runs>] [-L<lines>] [-B<bytes>] [-i] "
+					"<command> [<arguments>...]\n");
+
+		return (EXIT_FAILURE);
+	}
+
+	/*	Runs.
+	 *	----- */
+	for (n = 0; n < runs; n++)
+	{
+		double	t	= run_once(&argv[i]);
+
+		if (t < 0)
+		{
+			fprintf(stderr, "*** Error: \"%s\" failed!\n", argv[i]);
+			return (EXIT_FAILURE);
+		}
+
+		if ((n == 0) || (t < best))
+			best	= t;
+
+		total	+= t;
+	}
+
+	/*	- Peak RSS of all runs.  "ru_maxrss" is in kilobytes, except
+	 *	  on Mac OS X (bytes).
+	 *	*/
+	getrusage(RUSAGE_CHILDREN, &usage);
+	rss	= (long) usage.ru_maxrss;
+
+#ifdef __APPLE__
+	rss	/= 1024;
+#endif
+
+	/*	Report.
+	 *	------- */
+	printf("%-12s %ld lines, %ld bytes, %ld runs\n", "input:", lines, bytes, runs);
+	printf("%-12s best %.4f s, mean %.4f s\n", "time:", best, total / runs);
+
+	if (best > 0)
+	{
+		printf(	"%-12s %.0f lines/s, %.0f bytes/s\n", "throughput:",
+			  		lines / best, bytes / best);
+	}
+
+	printf("%-12s %ld KB\n", "peak RSS:", rss);
+
+	return (EXIT_SUCCESS);
+}
+
+
@@ -0,0 +1,75 @@
+/*	*************************************************************************
+ *	Module Name:	asm8080.c
+ *	Description:	Intel 8080 Assembler program entry point.
+ *	Copyright(c):	See below...
+ *	Author(s):
+ *	Created:			18 October 2026
+ *	Last modified:
+ *
+ *	Notes:			- Only "main()" is here.  The assembler itself is in
+ *						  "main.c" and the other modules, so programs like the
+ *						  microbenchmarks ("bench/micro_bench.c") can link
+ *						  it in.
+ *	************************************************************************* */
+
+/*
+ * Copyright (c) <2007-2017> Jay Cotton <lbmgmusic@gmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+
+/*	*************************************************************************
+ *	                              INCLUDE FILES
+ *	************************************************************************* */
+
+#include "project.h"
+#include "main.h"
+
+
+/*	*************************************************************************
+ *	                           FUNCTIONS DEFINITION
+ *	************************************************************************* */
+
+
+/*	*************************************************************************
+ *	Function name:	main
+ *	Description:	Main function.
+ *	Author(s):
+ *	Created:			18 October 2026
+ *	Last modified:
+ *
+ *	Parameters:		int argc:
+ *							Number of command line arguments.
+ *
+ *						char *argv[]:
+ *							Command line arguments.
+ *
+ *	Returns:			int:
+ *							0 if successful, (-1) otherwise.
+ *
+ *	Globals:
+ *	Notes:
+ *	************************************************************************* */
+
+int main(int argc, char *argv[])
+{
+	return (asm_main(argc, argv));
+}
+
@@ -47,6 +47,11 @@
 #include "exp_parser.h"
 #include "main.h"
 #include "msg.h"
+#include "mem.h"
+#include "stats.h"
+#include "trace.h"
+#include "cycles.h"
+#include "codegen.h"
 #include "asm_dir.h"
 
 
@@ -78,6 +83,12 @@ static int proc_set(char *label, char *equation);
 static int proc_org(char *, char *);
 static int is_endm_present(char *string);
 static int proc_end(char *, char *);
+static int proc_cycles(char *label, char *equation);
+static int proc_delay(char *label, char *equation);
+static int proc_cmul(char *label, char *equation);
+static int proc_cdiv(char *label, char *equation);
+static int get_codegen_operands(char *equation, int *p_reg, long *p_k, int *p_by_size);
+static int push_codegen(void);
 
 
 /*	*************************************************************************
@@ -97,7 +108,9 @@ const keyword_t	asm_dir[] =
 	{"ORG", proc_org},	{"DS", proc_ds},
 	{"IF", proc_if},	{"ENDM", proc_endm},
 	{"ELSE", proc_else},	{"ENDIF", proc_endif},
-	{"SET", proc_set},
+	{"SET", proc_set},	{"CYCLES", proc_cycles},
+	{"DELAY", proc_delay},	{"CMUL", proc_cmul},
+	{"CDIV", proc_cdiv},
 	{0, NULL}
 };
 
@@ -245,7 +258,7 @@ static int proc_endif(char *label, char *equation)
  *	Description:
  *	Author(s):		Jay Cotton, Claude Sylvain
  *	Created:			2007
- *	Last modified:	27 April 2013
+ *	Last modified:	18 October 2026
  *
  *	Parameters:		char *label:
  *							...
@@ -308,7 +321,7 @@ static int proc_db(char *label, char *equation)
 					}
 
 					LStack->word	= *(equation++);
-					LStack->next	= (STACK *) calloc(1, sizeof(STACK));
+					LStack->next	= (STACK *) mem_calloc(MT_STACK, 1, sizeof(STACK));
 					LStack			= (STACK *) LStack->next;
 				}
 
@@ -340,13 +353,16 @@ static int proc_db(char *label, char *equation)
 				break;
 
 			default:
-				value		= exp_parser(equation);
+				/*	- On assembler pass #1, only the number of elements
+				 *	  matters.  Do not evaluate the element.
+				 *	*/
+				value		= (asm_pass == 0) ? 0 : exp_parser(equation);
 				equation	= AdvanceTo(equation, ',');
 
 				/*	Stock value and make space in stack.
 				 *	------------------------------------ */	
 				LStack->word	= value & 0xff;
-				LStack->next	= (STACK *) calloc(1, sizeof(STACK));
+				LStack->next	= (STACK *) mem_calloc(MT_STACK, 1, sizeof(STACK));
 				LStack			= (STACK *) LStack->next;
 
 				value				= 0;
@@ -363,7 +379,7 @@ static int proc_db(char *label, char *equation)
  *	Description:
  *	Author(s):		Jay Cotton, Claude Sylvain
  *	Created:			2007
- *	Last modified:	27 April 2013
+ *	Last modified:	18 October 2026
  *
  *	Parameters:		char *label:
  *							...
@@ -434,7 +450,7 @@ static int proc_dw(char *label, char *equation)
 					else
 					{
 						LStack->word	+= *(equation++);
-						LStack->next	= (STACK *) calloc(1, sizeof(STACK));
+						LStack->next	= (STACK *) mem_calloc(MT_STACK, 1, sizeof(STACK));
 						LStack			= (STACK *) LStack->next;
 					}
 
@@ -446,7 +462,7 @@ static int proc_dw(char *label, char *equation)
 			 	 *	----------------------------------------------------- */	 
 				if ((pos & 1) != 0)
 				{
-					LStack->next	= (STACK *) calloc(1, sizeof(STACK));
+					LStack->next	= (STACK *) mem_calloc(MT_STACK, 1, sizeof(STACK));
 					LStack			= (STACK *) LStack->next;
 				}
 
@@ -479,13 +495,16 @@ static int proc_dw(char *label, char *equation)
 				break;
 
 			default:
-				value		= exp_parser(equation);
+				/*	- On assembler pass #1, only the number of elements
+				 *	  matters.  Do not evaluate the element.
+				 *	*/
+				value		= (asm_pass == 0) ? 0 : exp_parser(equation);
 				equation = AdvanceTo(equation, ',');
 
 				/*	Stock value and make space in stack.
 				 *	------------------------------------ */	
 				LStack->word	= value;
-				LStack->next	= (STACK *) calloc(1, sizeof(STACK));
+				LStack->next	= (STACK *) mem_calloc(MT_STACK, 1, sizeof(STACK));
 				LStack			= (STACK *) LStack->next;
 
 				break;
@@ -591,8 +610,8 @@ static int proc_include(char *label, char *equation)
 
 	/*	Allocate memory.
 	 *	---------------- */	
-	p_name 		= (char *) malloc(PROC_INCLUDE_TEXT_SIZE_MAX);
-	p_name_path = (char *) malloc(PROC_INCLUDE_TEXT_SIZE_MAX);
+	p_name 		= (char *) mem_alloc(MT_FILES, PROC_INCLUDE_TEXT_SIZE_MAX);
+	p_name_path = (char *) mem_alloc(MT_FILES, PROC_INCLUDE_TEXT_SIZE_MAX);
 
 	/*	Go further more only if able to allocate memory.
 	 *	------------------------------------------------ */
@@ -602,8 +621,8 @@ static int proc_include(char *label, char *equation)
 
 		/*	Free allocated memory.
 		 *	---------------------- */	
-		free(p_name);
-		free(p_name_path);
+		mem_free(p_name);
+		mem_free(p_name_path);
 
 		return (LIST_ONLY);
 	}
@@ -644,8 +663,8 @@ static int proc_include(char *label, char *equation)
 
 			/*	Free allocated memory.
 			 *	---------------------- */	
-			free(p_name);
-			free(p_name_path);
+			mem_free(p_name);
+			mem_free(p_name_path);
 
 			return (LIST_ONLY);
 		}
@@ -670,8 +689,8 @@ static int proc_include(char *label, char *equation)
 
 				/*	Free allocated memory.
 				 *	---------------------- */	
-				free(p_name);
-				free(p_name_path);
+				mem_free(p_name);
+				mem_free(p_name_path);
 
 				return (LIST_ONLY);
 			}
@@ -686,8 +705,8 @@ static int proc_include(char *label, char *equation)
 
 			/*	Free allocated memory.
 			 *	---------------------- */	
-			free(p_name);
-			free(p_name_path);
+			mem_free(p_name);
+			mem_free(p_name_path);
 
 			return (LIST_ONLY);
 		}
@@ -710,8 +729,8 @@ static int proc_include(char *label, char *equation)
 
 				/*	Free allocated memory.
 				 *	---------------------- */	
-				free(p_name);
-				free(p_name_path);
+				mem_free(p_name);
+				mem_free(p_name_path);
 
 				return (LIST_ONLY);
 			}
@@ -749,7 +768,7 @@ static int proc_include(char *label, char *equation)
 		{
 			/*	Allocate memory for the input file name.
 			 *	*/	
-			in_fn[file_level]	= (char *) malloc(strlen(p_name_path) + 1);
+			in_fn[file_level]	= (char *) mem_alloc(MT_FILES, strlen(p_name_path) + 1);
 
 			/*	Check for memory allocation error.
 			 *	--------------------------------- */	
@@ -757,6 +776,11 @@ static int proc_include(char *label, char *equation)
 			{
 				strcpy(in_fn[file_level], p_name_path);	/*	Save input file name. */
 				codeline[file_level]	= 0;
+
+				if (asm_pass == 1)
+					STATS_COUNT(SC_INCLUDES, 1);
+
+				trace_begin("include", in_fn[file_level]);
 			}
 			else
 			{
@@ -775,8 +799,8 @@ static int proc_include(char *label, char *equation)
 
 	/*	Free allocated memory.
 	 *	---------------------- */	
-	free(p_name);
-	free(p_name_path);
+	mem_free(p_name);
+	mem_free(p_name_path);
 
 	return (LIST_ONLY);
 }
@@ -821,7 +845,7 @@ static int proc_local(char *label, char *equation)
  *	Description:	Process "EQU" assembler directive.
  *	Author(s):		Jay Cotton, Claude Sylvain
  *	Created:			2007
- *	Last modified:	27 December 2011
+ *	Last modified:	18 October 2026
  *
  *	Parameters:		char *label:
  *							...
@@ -839,16 +863,12 @@ static int proc_local(char *label, char *equation)
 static int proc_equ(char *label, char *equation)
 {
 SYMBOL	*Local;
-int	tmp;
+int	tmp	= 0;
 
 	/*	Don't do anything, if code section is desactivated.
 	 *	*/
 	if (util_is_cs_enable() == 0)	return (LIST_ONLY);
 
-	tmp = exp_parser(equation);
-
-	check_oor(tmp, 0xFFFF);		/*	Check Operand Over Range. */
-
 	/*	If in first assembly pass, add and initialize label.
 	 *	---------------------------------------------------- */	
 	if (asm_pass == 0)
@@ -862,6 +882,18 @@ int	tmp;
 		 *	---------------------- */	
 		if (Local != NULL)
 		{
+			/*	- On layout passes following the first one, evaluate
+			 *	  the expression again, with the new "$" value.
+			 *	----------------------------------------------------- */
+			if (	(asm_iter > 0) && (Local->equ_expr != NULL) &&
+				  	(strcmp(in_fn[file_level], Local->src_filename) == 0) &&
+					(codeline[file_level] == Local->code_line))
+			{
+				Local->equ_pc		= target.pc;
+				Local->equ_state	= EQU_PENDING;
+
+				exp_parser_equ(Local);
+			}
 #if 0
 			/*	If previously defined as a "SET", we can re-define it.
 			 *	------------------------------------------------------ */	
@@ -885,8 +917,26 @@ int	tmp;
 
 				if (Local)
 				{
-					Local->Symbol_Value	= tmp;
 					Local->Symbol_Type	= SYMBOL_NAME_EQU;
+
+					/*	- Keep expression, and evaluate it now if all used
+					 *	  symbols are defined.  Otherwise, it will be
+					 *	  evaluated on first use of the symbol (see
+					 *	  "exp_parser.c").  So, forward referenced symbols
+					 *	  can be used.
+					 *	------------------------------------------------- */
+					Local->equ_expr	= (char *) mem_alloc(MT_SYMBOLS, strlen(equation) + 1);
+
+					if (Local->equ_expr != NULL)
+					{
+						strcpy(Local->equ_expr, equation);
+						Local->equ_pc		= target.pc;
+						Local->equ_state	= EQU_PENDING;
+
+						exp_parser_equ(Local);
+					}
+					else
+						Local->Symbol_Value	= exp_parser(equation);
 				}
 			}
 		}
@@ -898,6 +948,10 @@ int	tmp;
 	 *	------------------------------------------------------- */	
 	else
 	{
+		tmp = exp_parser(equation);
+
+		check_oor(tmp, 0xFFFF);		/*	Check Operand Over Range. */
+
 		/*	- Notes: Since we are in assembler second pass, if no
 		 *	  symbol is found, an error message is displayed.
 	 	 *	------------------------------------------------------ */	 
@@ -917,6 +971,15 @@ int	tmp;
 				if (	(strcmp(in_fn[file_level], Local->src_filename) == 0) &&
 					  	(codeline[file_level] == Local->code_line))
 				{
+					/*	- Circular definitions are found on assembler
+					 *	  pass #1, but reported here.
+					 *	--------------------------------------------- */
+					if (Local->equ_state == EQU_CIRCULAR)
+					{
+						msg_error_s(	"Circular \"EQU\" definition!", EC_CED,
+							  				label);
+					}
+
 					/*	If there is a phasing error.
 					 *	---------------------------- */	
 #if 0
@@ -952,7 +1015,7 @@ int	tmp;
 				 *	************************ */
 
 				Local->src_filename	=
-					(char *) realloc(Local->src_filename, strlen(in_fn[file_level]) + 1);
+					(char *) mem_realloc(MT_SYMBOLS, Local->src_filename, strlen(in_fn[file_level]) + 1);
 
 				if (Local->src_filename != NULL)
 				{
@@ -1047,7 +1110,7 @@ static int proc_set(char *label, char *equation)
 				 *	************************ */
 
 				Local->src_filename	=
-					(char *) realloc(Local->src_filename, strlen(in_fn[file_level]) + 1);
+					(char *) mem_realloc(MT_SYMBOLS, Local->src_filename, strlen(in_fn[file_level]) + 1);
 
 				if (Local->src_filename != NULL)
 				{
@@ -1140,7 +1203,7 @@ static int proc_set(char *label, char *equation)
 					 *	************************ */
 
 					Local->src_filename	=
-						(char *) realloc(Local->src_filename, strlen(in_fn[file_level]) + 1);
+						(char *) mem_realloc(MT_SYMBOLS, Local->src_filename, strlen(in_fn[file_level]) + 1);
 
 					if (Local->src_filename != NULL)
 					{
@@ -1315,7 +1378,7 @@ static int proc_macro(char *label, char *equation)
 
 	/*	Allocate memory for macro file name.
 	 *	*/
-	fn_macro	= (char *) malloc(strlen(label) + 3);
+	fn_macro	= (char *) mem_alloc(MT_MACROS, strlen(label) + 3);
 
 	/*	If able to allocate memory for macro file name...
 	 *	------------------------------------------------- */	
@@ -1335,7 +1398,7 @@ static int proc_macro(char *label, char *equation)
 		if (fp_macro == NULL)
 		{
 			msg_error("Can't allocate memory!", EC_CAM);
-			free(fn_macro);
+			mem_free(fn_macro);
 			fn_macro	= NULL;
 		}
 	}
@@ -1467,11 +1530,11 @@ static int proc_endm(char *label, char *equation)
 
 	/*	Allocate memory for macro name.
 	 *	*/
-	macro_name	= (char *) malloc(fn_macro_len + 1);
+	macro_name	= (char *) mem_alloc(MT_MACROS, fn_macro_len + 1);
 
 	/*	Allocate memory for the line buffer.
 	 *	*/
-	p_text	= (char *) malloc(SRC_LINE_WIDTH_MAX);	
+	p_text	= (char *) mem_alloc(MT_MACROS, SRC_LINE_WIDTH_MAX);	
 
 	/*	If able to allocate memory for the line buffer, go further more...
 	 *	------------------------------------------------------------------ */
@@ -1543,18 +1606,428 @@ static int proc_endm(char *label, char *equation)
 	else
 		msg_error("Can't allocate memory!", EC_CAM);
 
-	free(macro_name);
-	free(p_text);
+	mem_free(macro_name);
+	mem_free(p_text);
 
 	/*	Free memory allocated for macro file name.
 	 *	------------------------------------------ */	
-	free(fn_macro);
+	mem_free(fn_macro);
 	fn_macro	= NULL;
 
 	return (LIST_ONLY);
 }
 
 
+/*	*************************************************************************
+ *	Function name:	proc_cycles
+ *	Description:	"CYCLES" assembler directive processing.
+ *	Author(s):
+ *	Created:			18 October 2026
+ *	Last modified:
+ *
+ *	Parameters:		char *label:
+ *							...
+ *
+ *						char *equation:
+ *							"<from>,<to>,<min>,<max>".
+ *
+ *	Returns:			int:
+ *							...
+ *
+ *	Globals:
+ *
+ *	Notes:			- "CYCLES" is not a standard Intel 8080 assembler
+ *						  directive.
+ *						- Cycles from <from> to <to> (not included) must be
+ *						  <min> to <max>.  The budget is checked when the
+ *						  whole program is assembled (see "cycles.c").
+ *	************************************************************************* */
+
+static int proc_cycles(char *label, char *equation)
+{
+	int	value[4];
+	int	i;
+	int	not_found;
+
+
+	/*	Don't do anything, if code section is desactivated.
+	 *	*/
+	if (util_is_cs_enable() == 0)	return (LIST_ONLY);
+
+	process_label(label);
+
+	/*	- On assembler pass #1, only make sure opcode addresses
+	 *	  will be recorded on assembler pass #2.
+	 *	*/
+	if (asm_pass == 0)
+	{
+		if (cycles_init() == -1)
+			msg_error("Memory allocation error!", EC_MAE);
+
+		return (LIST_ONLY);
+	}
+
+	not_found	= exp_parser_not_found();
+
+	for (i = 0; i < 4; i++)
+	{
+		equation	= AdvanceToAscii(equation);
+
+		if ((*equation == '\0') || (*equation == ';'))
+		{
+			msg_error("Missing field!", EC_MF);
+			return (LIST_ONLY);
+		}
+
+		value[i]	= exp_parser(equation);
+		equation	= AdvanceTo(equation, ',');
+
+		if (*equation == ',')
+			equation++;
+	}
+
+	/*	- A name not found was already reported.  Don't check a budget
+	 *	  made of wrong values.
+	 *	*/
+	if (exp_parser_not_found() != not_found)
+		return (LIST_ONLY);
+
+	if ((value[2] < 0) || (value[3] < value[2]))
+	{
+		msg_error("Bad cycles budget!", EC_BCB);
+		return (LIST_ONLY);
+	}
+
+	if (cycles_budget(value[0], value[1], value[2], value[3]) == -1)
+		msg_error("Memory allocation error!", EC_MAE);
+
+	return (LIST_ONLY);
+}
+
+
+/*	*************************************************************************
+ *	Function name:	proc_delay
+ *	Description:	"DELAY" assembler directive processing.
+ *	Author(s):
+ *	Created:			18 October 2026
+ *	Last modified:
+ *
+ *	Parameters:		char *label:
+ *							...
+ *
+ *						char *equation:
+ *							"<cycles>[,<register>]".
+ *
+ *	Returns:			int:
+ *							...
+ *
+ *	Globals:
+ *
+ *	Notes:			- "DELAY" is not a standard Intel 8080 assembler
+ *						  directive.
+ *						- Generate the smallest sequence that take exactly
+ *						  <cycles> cycles (see "codegen.c").  Only
+ *						  <register> and the flags may change.
+ *						- As for "DS", <cycles> must be known on assembler
+ *						  pass #1, since it set the size of the sequence.
+ *	************************************************************************* */
+
+static int proc_delay(char *label, char *equation)
+{
+	long	cycles;
+	int	reg	= -1;
+
+
+	/*	Don't do anything, if code section is desactivated.
+	 *	*/
+	if (util_is_cs_enable() == 0)	return (LIST_ONLY);
+
+	process_label(label);
+
+	equation	= AdvanceToAscii(equation);
+
+	if ((*equation == '\0') || (*equation == ';'))
+	{
+		msg_error("Missing field!", EC_MF);
+		return (LIST_ONLY);
+	}
+
+	cycles	= exp_parser(equation);
+	equation	= AdvanceTo(equation, ',');
+
+	if (*equation == ',')
+	{
+		if (	((reg = codegen_reg(equation + 1)) == -1) ||
+				(*AdvanceTo(equation + 1, ',') == ','))
+		{
+			msg_error("Bad delay register!", EC_BDLR);
+			return (LIST_ONLY);
+		}
+	}
+
+	switch (codegen_delay(cycles, reg, target.pc))
+	{
+		case -3:
+			msg_error("Memory allocation error!", EC_MAE);
+			return (LIST_ONLY);
+
+		case -2:
+			msg_error(	(reg >= 0) ?
+							"Can't generate delay (too short: 1 to 3 and 6 cycles)!" :
+							"Can't generate delay (too short: 1 to 3, 6, 7 and 11 cycles without register)!",
+							EC_CGD);
+
+			return (LIST_ONLY);
+
+		case -1:
+			msg_error("Can't generate delay (cycles out of range: 0 to 65535)!", EC_CGD);
+			return (LIST_ONLY);
+
+		default:
+			break;
+	}
+
+	/*	Generated cycles are counted again (generator check).
+	 *	*/
+	if ((asm_pass == 1) && (codegen_cycles() != cycles))
+		msg_error("Can't generate delay (generated cycles differ)!", EC_CGD);
+
+	return (push_codegen());
+}
+
+
+/*	*************************************************************************
+ *	Function name:	proc_cmul
+ *	Description:	"CMUL" assembler directive processing.
+ *	Author(s):
+ *	Created:			18 October 2026
+ *	Last modified:
+ *
+ *	Parameters:		char *label:
+ *							...
+ *
+ *						char *equation:
+ *							"<register>,<constant>[,SIZE]".
+ *
+ *	Returns:			int:
+ *							...
+ *
+ *	Globals:
+ *
+ *	Notes:			- "CMUL" is not a standard Intel 8080 assembler
+ *						  directive.
+ *						- Generate the fastest (or smallest, with "SIZE")
+ *						  multiplication of "HL" ("H") or "A" by
+ *						  <constant> (see "codegen.c").
+ *						- As for "DS", <constant> must be known on assembler
+ *						  pass #1.
+ *	************************************************************************* */
+
+static int proc_cmul(char *label, char *equation)
+{
+	long	k;
+	int	reg;
+	int	by_size;
+
+
+	/*	Don't do anything, if code section is desactivated.
+	 *	*/
+	if (util_is_cs_enable() == 0)	return (LIST_ONLY);
+
+	process_label(label);
+
+	if (get_codegen_operands(equation, &reg, &k, &by_size) == -1)
+		return (LIST_ONLY);
+
+	if (codegen_mul(reg, k, by_size, target.pc) == -1)
+	{
+		msg_error("Bad code generator operand!", EC_BCGO);
+		return (LIST_ONLY);
+	}
+
+	return (push_codegen());
+}
+
+
+/*	*************************************************************************
+ *	Function name:	proc_cdiv
+ *	Description:	"CDIV" assembler directive processing.
+ *	Author(s):
+ *	Created:			18 October 2026
+ *	Last modified:
+ *
+ *	Parameters:		char *label:
+ *							...
+ *
+ *						char *equation:
+ *							"<register>,<constant>".
+ *
+ *	Returns:			int:
+ *							...
+ *
+ *	Globals:
+ *
+ *	Notes:			- "CDIV" is not a standard Intel 8080 assembler
+ *						  directive.
+ *						- Generate an unsigned division of "HL" ("H") or "A"
+ *						  by <constant>, a power of 2 (see "codegen.c").
+ *	************************************************************************* */
+
+static int proc_cdiv(char *label, char *equation)
+{
+	long	k;
+	int	reg;
+	int	by_size;
+
+
+	/*	Don't do anything, if code section is desactivated.
+	 *	*/
+	if (util_is_cs_enable() == 0)	return (LIST_ONLY);
+
+	process_label(label);
+
+	if (get_codegen_operands(equation, &reg, &k, &by_size) == -1)
+		return (LIST_ONLY);
+
+	if (codegen_div(reg, k, target.pc) == -1)
+	{
+		msg_error("Bad code generator operand!", EC_BCGO);
+		return (LIST_ONLY);
+	}
+
+	return (push_codegen());
+}
+
+
+/*	*************************************************************************
+ *	Function name:	get_codegen_operands
+ *	Description:	Get "CMUL" and "CDIV" operands.
+ *	Author(s):
+ *	Created:			18 October 2026
+ *	Last modified:
+ *
+ *	Parameters:		char *equation:
+ *							"<register>,<constant>[,SIZE]".
+ *
+ *						int *p_reg:
+ *							Register (CODEGEN_REG_H or CODEGEN_REG_A).
+ *
+ *						long *p_k:
+ *							Constant.
+ *
+ *						int *p_by_size:
+ *							1 if "SIZE" is there, 0 otherwise.
+ *
+ *	Returns:			int:
+ *							-1	: Error (already reported).
+ *							0	: Success.
+ *
+ *	Globals:
+ *	Notes:
+ *	************************************************************************* */
+
+static int get_codegen_operands(char *equation, int *p_reg, long *p_k, int *p_by_size)
+{
+	char	mode[8];
+	int	i;
+
+
+	*p_by_size	= 0;
+
+	equation	= AdvanceToAscii(equation);
+
+	if ((*equation == '\0') || (*equation == ';'))
+	{
+		msg_error("Missing field!", EC_MF);
+		return (-1);
+	}
+
+	*p_reg	= codegen_reg(equation);
+
+	if ((*p_reg != CODEGEN_REG_H) && (*p_reg != CODEGEN_REG_A))
+	{
+		msg_error("Bad code generator operand!", EC_BCGO);
+		return (-1);
+	}
+
+	equation	= AdvanceTo(equation, ',');
+
+	if (*equation == ',')
+		equation	= AdvanceToAscii(equation + 1);
+
+	if ((*equation == '\0') || (*equation == ';'))
+	{
+		msg_error("Missing field!", EC_MF);
+		return (-1);
+	}
+
+	*p_k			= exp_parser(equation);
+	equation		= AdvanceTo(equation, ',');
+
+	if (*equation != ',')
+		return (0);
+
+	/*	Mode.
+	 *	----- */
+	equation	= AdvanceToAscii(equation + 1);
+
+	for (i = 0; (i < (int) sizeof (mode) - 1) && isalpha((int) equation[i]); i++)
+		mode[i]	= toupper((int) equation[i]);
+
+	mode[i]	= '\0';
+
+	if (strcmp(mode, "SIZE") == 0)
+		*p_by_size	= 1;
+	else if (strcmp(mode, "SPEED") != 0)
+	{
+		msg_error("Bad code generator operand!", EC_BCGO);
+		return (-1);
+	}
+
+	return (0);
+}
+
+
+/*	*************************************************************************
+ *	Function name:	push_codegen
+ *	Description:	Stock generated code.
+ *	Author(s):
+ *	Created:			18 October 2026
+ *	Last modified:
+ *	Parameters:		void
+ *
+ *	Returns:			int:
+ *							LIST_CODE.
+ *
+ *	Globals:
+ *
+ *	Notes:			- Bytes are stocked as "DB" does, and instructions
+ *						  are recorded for cycles analysis on assembler
+ *						  pass #2.
+ *	************************************************************************* */
+
+static int push_codegen(void)
+{
+	STACK		*LStack	= ByteWordStack;
+	uint8_t	code[CODEGEN_SIZE_MAX];
+	int		size		= codegen_code(code);
+	int		i;
+
+
+	for (i = 0; i < size; i++)
+	{
+		LStack->word	= code[i];
+		LStack->next	= (STACK *) mem_calloc(MT_STACK, 1, sizeof(STACK));
+		LStack			= (STACK *) LStack->next;
+	}
+
+	if (asm_pass == 1)
+		codegen_note();
+
+	return (LIST_CODE);
+}
+
+
 /*	*************************************************************************
  *	Function name:	asm_dir_cleanup
  *	Description:	"asm_dir" module Cleanup.
@@ -1579,11 +2052,119 @@ void asm_dir_cleanup(void)
 
 	/*	Free memory allocated for macro file name.
 	 *	------------------------------------------ */	
-	free(fn_macro);
+	mem_free(fn_macro);
 	fn_macro	= NULL;
 }
 
 
+/*	*************************************************************************
+ *	Function name:	asm_dir_list_size
+ *	Description:	Get the size of a "DB" or "DW" List, without evaluating it.
+ *	Author(s):
+ *	Created:			18 October 2026
+ *	Last modified:
+ *
+ *	Parameters:		const keyword_t *p_dir:
+ *							Point to the "asm_dir[]" entry of the directive.
+ *
+ *						char *equation:
+ *							List of elements (strings, labels, or digits).
+ *
+ *	Returns:			int:
+ *							- Number of bytes the list will take.
+ *							- (-1) if directive is not "DB" or "DW".
+ *
+ *	Globals:
+ *
+ *	Notes:			- Walk the list the same way "proc_db()" and "proc_dw()"
+ *						  do, but only count elements.  Do not use any global
+ *						  variable, so it can be called concurrently (see
+ *						  "layout.c").
+ *	************************************************************************* */
+
+int asm_dir_list_size(const keyword_t *p_dir, char *equation)
+{
+	int	is_dw;
+	int	count	= 0;		/*	Number of bytes (DB) or words (DW). */
+
+
+	if (p_dir->fnc == proc_db)
+		is_dw	= 0;
+	else if (p_dir->fnc == proc_dw)
+		is_dw	= 1;
+	else
+		return (-1);
+
+	while (*equation != '\0')
+	{
+		switch (*equation)
+		{
+			case '\'':
+#if LANG_EXTENSION
+			case '\"':
+#endif
+			{
+				int				pos			= 0;	/*	Number of characters. */
+				unsigned char	in_quote		= 1;	/*	Not in Quote. */
+
+				equation++;			/* Select next characters. */
+
+				while (*equation)
+				{
+#if LANG_EXTENSION
+					if ((*equation == '\'') || (*equation == '\"'))
+#else
+					if (*equation == '\'')
+#endif
+					{
+						in_quote	= 0;
+						break;
+					}
+
+					equation++;
+					pos++;
+				}
+
+				/*	"DW" pack 2 characters per word.
+				 *	*/
+				count	+= (is_dw != 0) ? ((pos + 1) / 2) : pos;
+
+				if (!in_quote)
+					equation++;		/*	Select next character. */
+
+				break;
+			}
+
+			/*	Bypass some characters.
+			 *	----------------------- */
+			case '+':
+				if (is_dw == 0)
+				{
+					count++;
+					equation	= AdvanceTo(equation, ',');
+				}
+				else
+					equation++;
+
+				break;
+
+			case ',':
+			case ' ':
+			case '\t':
+				equation++;
+				break;
+
+			default:
+				count++;
+				equation	= AdvanceTo(equation, ',');
+				break;
+		}
+	}
+
+	return ((is_dw != 0) ? (count * 2) : count);
+}
+
+
 
 
 
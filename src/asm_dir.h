@@ -65,6 +65,7 @@ extern int	inside_macro;
  *	************************************************************************* */
 
 void asm_dir_cleanup(void);
+int asm_dir_list_size(const keyword_t *p_dir, char *equation);
 
 
 
@@ -0,0 +1,1163 @@
+/*	*************************************************************************
+ *	Module Name:	codegen.c
+ *	Description:	Code Generators ("DELAY", "CMUL" and "CDIV" directives).
+ *	Copyright(c):	See below...
+ *	Author(s):
+ *	Created:			18 October 2026
+ *	Last modified:
+ *
+ *	Notes:			- Generators fill a sequence of instructions, that the
+ *						  calling directive emit ("codegen_code()"), list
+ *						  ("codegen_list()") and record for the cycles
+ *						  analysis ("codegen_note()").
+ *						- Instruction sizes and cycles come from "OpCodes[]".
+ *						- Generators are only called by the main thread
+ *						  (directives are layout barriers).
+ *	************************************************************************* */
+
+/*
+ * Copyright (c) <2007-2017> Jay Cotton <lbmgmusic@gmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+
+/*	*************************************************************************
+ *	                              INCLUDE FILES
+ *	************************************************************************* */
+
+#include <stdio.h>
+#include <ctype.h>
+#include <stdlib.h>
+
+#include "project.h"
+#include "mem.h"
+#include "opcode.h"
+#include "cycles.h"
+#include "profile.h"
+#include "codegen.h"
+
+
+/*	*************************************************************************
+ *											  CONSTANTS
+ *	************************************************************************* */
+
+#define CODEGEN_COST_MAX			0x7FFFFFFF	/*	Not possible. */
+#define CODEGEN_LOOP_MAX			256			/*	Turns of a "DCR" loop. */
+
+/*	Opcodes.
+ *	-------- */
+#define OP_MVI						0x06			/*	+ (register << 3). */
+#define OP_DCR						0x05			/*	+ (register << 3). */
+#define OP_MOV_R_M					0x46			/*	+ (register << 3). */
+#define OP_JNZ						0xC2
+#define OP_RLC						0x07
+#define OP_RRC						0x0F
+#define OP_RAR						0x1F
+#define OP_ANI						0xE6
+#define OP_ORA_A					0xB7
+#define OP_MOV_A_H				0x7C
+#define OP_MOV_A_L				0x7D
+#define OP_MOV_H_A				0x67
+#define OP_MOV_L_A				0x6F
+#define OP_MOV_L_H				0x6C
+#define OP_MVI_H					0x26
+
+/*	- Number of divisors of a "CMUL" constant.  Notes: 120 is the
+ *	  highest number of divisors of a 16-bit number.
+ *	*/
+#define CODEGEN_DIVISOR_MAX		128
+
+/*	- Weight of cycles and bytes, when cost is compared.  Notes:
+ *	  The other one only break ties.
+ *	*/
+#define CODEGEN_WEIGHT				1000
+
+/*	- Index of the filler that need a register, in "delay_filler[]".
+ *	*/
+#define DELAY_FILLER_REG			4
+
+
+/*	*************************************************************************
+ *	                                 TYPEDEF
+ *	************************************************************************* */
+
+/*	Generated instruction.
+ *	---------------------- */
+struct codegen_inst_t
+{
+	uint8_t	code[3];
+	uint8_t	size;
+	long		count;			/*	Number of times executed. */
+};
+
+/*	"DELAY" filler: Instructions without side effect.
+ *	------------------------------------------------- */
+struct codegen_filler_t
+{
+	uint8_t	code[2];
+	uint8_t	num;				/*	Number of instructions. */
+};
+
+
+/*	"CMUL" operations, for a register.
+ *	---------------------------------- */
+struct codegen_mul_t
+{
+	uint8_t	zero[3];			/*	Result is 0. */
+	uint8_t	dbl;				/*	Double. */
+	uint8_t	add;				/*	Add the saved value. */
+	uint8_t	save[2];			/*	Save the value. */
+	int		save_num;		/*	Number of "save" instructions. */
+	uint8_t	byte[3];			/*	Multiply by 256 (move low byte to high). */
+	int		byte_num;		/*	Number of "byte" instructions (0: none). */
+	long		k_max;			/*	Highest constant. */
+};
+
+
+/*	*************************************************************************
+ *	                                  CONST
+ *	************************************************************************* */
+
+/*	- Fillers.  Notes: "PUSH"/"POP" and "XTHL"/"XTHL" use the
+ *	  stack, but leave registers, flags and memory unchanged.
+ *	--------------------------------------------------------- */
+static const struct codegen_filler_t	delay_filler[] =
+{
+	{{0x00, 0x00}, 1},			/*	NOP. */
+	{{0x7F, 0x00}, 1},			/*	MOV A,A. */
+	{{0xC5, 0xC1}, 2},			/*	PUSH B / POP B. */
+	{{0xE3, 0xE3}, 2},			/*	XTHL / XTHL. */
+	{{OP_MOV_R_M, 0x00}, 1}		/*	MOV r,M (clobber "r"). */
+};
+
+/*	- "CMUL" operations.  "HL" use "DE" to save its value, and
+ *	  "A" use "B".
+ *	---------------------------------------------------------- */
+static const struct codegen_mul_t	mul_op_h	=
+{
+	{0x21, 0x00, 0x00},		/*	LXI H,0. */
+	0x29,							/*	DAD H. */
+	0x19,							/*	DAD D. */
+	{0x54, 0x5D}, 2,			/*	MOV D,H / MOV E,L. */
+	{0x65, 0x2E, 0x00}, 2,	/*	MOV H,L / MVI L,0. */
+	0xFFFF
+};
+
+static const struct codegen_mul_t	mul_op_a	=
+{
+	{0xAF, 0x00, 0x00},		/*	XRA A. */
+	0x87,							/*	ADD A. */
+	0x80,							/*	ADD B. */
+	{0x47, 0x00}, 1,			/*	MOV B,A. */
+	{0x00, 0x00, 0x00}, 0,
+	0xFF
+};
+
+
+/*	*************************************************************************
+ *	                                VARIABLES
+ *	************************************************************************* */
+
+/*	Private variables.
+ *	****************** */
+
+static struct codegen_inst_t	gen_inst[CODEGEN_INST_MAX];
+static int							gen_num	= 0;		/*	Number of instructions. */
+static int							gen_pc	= 0;		/*	Address of the first one. */
+
+
+/*	*************************************************************************
+ *									  FUNCTIONS DECLARATION
+ *	************************************************************************* */
+
+static int gen_add(const uint8_t *p_code, long count);
+static long gen_weight(const uint8_t *p_code, int num, int by_size);
+static int delay_fill(long cycles, int reg);
+static long mul_binary(long f, long w_dbl, long w_add);
+static void mul_emit(	const struct codegen_mul_t *p_mul, const long *div,
+							const int *from, int i);
+static void div_rotate(int n);
+
+
+/*	*************************************************************************
+ *	                                FUNCTIONS
+ *	************************************************************************* */
+
+/*	*************************************************************************
+ *	Function name:	gen_add
+ *	Description:	Add an instruction to the generated sequence.
+ *	Author(s):
+ *	Created:			18 October 2026
+ *	Last modified:
+ *
+ *	Parameters:		const uint8_t *p_code:
+ *							Instruction bytes.
+ *
+ *						long count:
+ *							Number of times the instruction is executed.
+ *
+ *	Returns:			int:
+ *							- Address of the instruction.
+ *							- (-1) if sequence is full, or opcode is not valid.
+ *
+ *	Globals:
+ *	Notes:
+ *	************************************************************************* */
+
+static int gen_add(const uint8_t *p_code, long count)
+{
+	const opcode_t				*p_opcode	= opcode_decode(p_code[0], NULL);
+	struct codegen_inst_t	*p_inst		= &gen_inst[gen_num];
+	int							addr			= gen_pc;
+	int							i;
+
+
+	if ((gen_num >= CODEGEN_INST_MAX) || (p_opcode == NULL))
+		return (-1);
+
+	for (i = 0; i < gen_num; i++)
+		addr	+= gen_inst[i].size;
+
+	memcpy(p_inst->code, p_code, p_opcode->size);
+
+	p_inst->size	= p_opcode->size;
+	p_inst->count	= count;
+
+	gen_num++;
+
+	return (addr & 0xFFFF);
+}
+
+
+/*	*************************************************************************
+ *	Function name:	gen_weight
+ *	Description:	Get the cost of single byte instructions.
+ *	Author(s):
+ *	Created:			18 October 2026
+ *	Last modified:
+ *
+ *	Parameters:		const uint8_t *p_code:
+ *							Opcodes.
+ *
+ *						int num:
+ *							Number of opcodes.
+ *
+ *						int by_size:
+ *							- 0: Cycles first, then bytes.
+ *							- 1: Bytes first, then cycles.
+ *
+ *	Returns:			long:
+ *							Cost.
+ *
+ *	Globals:
+ *	Notes:
+ *	************************************************************************* */
+
+static long gen_weight(const uint8_t *p_code, int num, int by_size)
+{
+	uint8_t	cyc[2];
+	long		cycles	= 0;
+	long		size		= 0;
+	int		i;
+
+
+	for (i = 0; i < num; i++)
+	{
+		size		+= opcode_decode(p_code[i], cyc)->size;
+		cycles	+= cyc[0];
+	}
+
+	return ((by_size != 0) ?	(size * CODEGEN_WEIGHT) + cycles :
+										(cycles * CODEGEN_WEIGHT) + size);
+}
+
+
+/*	*************************************************************************
+ *	Function name:	delay_fill
+ *	Description:	Add loops and fillers of an exact number of cycles.
+ *	Author(s):
+ *	Created:			18 October 2026
+ *	Last modified:
+ *
+ *	Parameters:		long cycles:
+ *							Number of cycles.
+ *
+ *						int reg:
+ *							- Register the loops and fillers can clobber
+ *							  (with the flags).
+ *							- (-1) if no register, neither flag, can change.
+ *
+ *	Returns:			int:
+ *							-3	: Memory allocation error.
+ *							-2	: No sequence (too short, or too long for
+ *								  the instructions left).
+ *							0	: Success.
+ *
+ *	Globals:
+ *
+ *	Notes:			- The smallest sequence (in bytes) is added:
+ *						  <j> loops (with a register only) and fillers.
+ *						- A loop is "MVI r,<k>" / "DCR r" / "JNZ" (k = 1 to
+ *						  256 turns).
+ *						- Fillers are found by dynamic programming on the
+ *						  number of cycles.
+ *	************************************************************************* */
+
+static int delay_fill(long cycles, int reg)
+{
+	uint8_t			code[3];
+	uint8_t			cyc[2];
+	int				filler_cyc[sizeof (delay_filler) / sizeof (delay_filler[0])];
+	int				filler_num;
+	int				inst_max		= CODEGEN_INST_MAX - gen_num;
+	int				loop_cyc;		/*	Loop fixed cycles ("MVI"). */
+	int				turn_cyc;		/*	Cycles of one turn ("DCR" and "JNZ"). */
+	int				*cost;			/*	Filler bytes, by cycles. */
+	uint8_t			*choice;			/*	Last filler, by cycles. */
+	long				best			= CODEGEN_COST_MAX;
+	long				best_j		= 0;
+	long				best_k		= 0;
+	long				j;
+	long				k;
+	long				c;
+	int				f;
+
+
+	/*	Cycles, from "OpCodes[]".
+	 *	------------------------- */
+	filler_num	= (reg >= 0) ? DELAY_FILLER_REG + 1 : DELAY_FILLER_REG;
+
+	for (f = 0; f < filler_num; f++)
+	{
+		int	i;
+
+		filler_cyc[f]	= 0;
+
+		for (i = 0; i < delay_filler[f].num; i++)
+		{
+			opcode_decode(delay_filler[f].code[i] | ((f == DELAY_FILLER_REG) ? (reg << 3) : 0), cyc);
+			filler_cyc[f]	+= cyc[0];
+		}
+	}
+
+	opcode_decode(OP_MVI, cyc);
+	loop_cyc	= cyc[0];
+	opcode_decode(OP_DCR, cyc);
+	turn_cyc	= cyc[0];
+	opcode_decode(OP_JNZ, cyc);
+	turn_cyc	+= cyc[1];
+
+	/*	Fillers: Smallest number of bytes for each number of cycles.
+	 *	------------------------------------------------------------ */
+	cost		= (int *) mem_alloc(MT_CODEGEN, (cycles + 1) * sizeof (int));
+	choice	= (uint8_t *) mem_alloc(MT_CODEGEN, (cycles + 1) * sizeof (uint8_t));
+
+	if ((cost == NULL) || (choice == NULL))
+	{
+		mem_free(cost);
+		mem_free(choice);
+
+		return (-3);
+	}
+
+	cost[0]	= 0;
+
+	for (c = 1; c <= cycles; c++)
+	{
+		cost[c]	= CODEGEN_COST_MAX;
+
+		for (f = 0; f < filler_num; f++)
+		{
+			if (	(c >= filler_cyc[f]) && (cost[c - filler_cyc[f]] != CODEGEN_COST_MAX) &&
+					(cost[c - filler_cyc[f]] + delay_filler[f].num < cost[c]))
+			{
+				cost[c]		= cost[c - filler_cyc[f]] + delay_filler[f].num;
+				choice[c]	= (uint8_t) f;
+			}
+		}
+	}
+
+	/*	- Loops: <j> loops, <k> turns in all.  Notes: Each loop take
+	 *	  6 bytes, and each filler instruction 1 byte.
+	 *	------------------------------------------------------------ */
+	if (cost[cycles] <= inst_max)
+		best	= cost[cycles];
+
+	for (j = 1; (reg >= 0) && (j * 3 < inst_max); j++)
+	{
+		for (k = j; k <= j * CODEGEN_LOOP_MAX; k++)
+		{
+			c	= cycles - (j * loop_cyc) - (k * turn_cyc);
+
+			if (c < 0)
+				break;
+
+			if (	(cost[c] != CODEGEN_COST_MAX) && (j * 6 + cost[c] < best) &&
+					(j * 3 + cost[c] <= inst_max))
+			{
+				best		= j * 6 + cost[c];
+				best_j	= j;
+				best_k	= k;
+			}
+		}
+	}
+
+	/*	Generate.
+	 *	--------- */
+	if (best != CODEGEN_COST_MAX)
+	{
+		for (j = 0; j < best_j; j++)
+		{
+			int	addr;
+
+			k	= (best_k / best_j) + ((j < (best_k % best_j)) ? 1 : 0);
+
+			code[0]	= OP_MVI | (reg << 3);
+			code[1]	= (uint8_t) (k & 0xFF);
+			gen_add(code, 1);
+
+			code[0]	= OP_DCR | (reg << 3);
+			addr		= gen_add(code, k);
+
+			code[0]	= OP_JNZ;
+			code[1]	= (uint8_t) (addr & 0xFF);
+			code[2]	= (uint8_t) (addr >> 8);
+			gen_add(code, k);
+		}
+
+		for (c = cycles - (best_j * loop_cyc) - (best_k * turn_cyc); c > 0; c -= filler_cyc[f])
+		{
+			int	i;
+
+			f	= choice[c];
+
+			for (i = 0; i < delay_filler[f].num; i++)
+			{
+				code[0]	= delay_filler[f].code[i] | ((f == DELAY_FILLER_REG) ? (reg << 3) : 0);
+				gen_add(code, 1);
+			}
+		}
+	}
+
+	mem_free(cost);
+	mem_free(choice);
+
+	return ((best != CODEGEN_COST_MAX) ? 0 : -2);
+}
+
+
+/*	*************************************************************************
+ *	Function name:	mul_binary
+ *	Description:	Get the cost of the binary method.
+ *	Author(s):
+ *	Created:			18 October 2026
+ *	Last modified:
+ *
+ *	Parameters:		long f:
+ *							Factor (1 or more).
+ *
+ *						long w_dbl:
+ *							Cost of "double".
+ *
+ *						long w_add:
+ *							Cost of "add".
+ *
+ *	Returns:			long:
+ *							Cost.
+ *
+ *	Globals:
+ *
+ *	Notes:			- Value is saved first.  Then, after the highest bit
+ *						  of <f>, each bit is a "double", and each bit set
+ *						  also an "add".
+ *	************************************************************************* */
+
+static long mul_binary(long f, long w_dbl, long w_add)
+{
+	long	cost	= 0;
+
+	for (; f > 1; f >>= 1)
+		cost	+= w_dbl + (((f & 1) != 0) ? w_add : 0);
+
+	return (cost);
+}
+
+
+/*	*************************************************************************
+ *	Function name:	mul_emit
+ *	Description:	Generate a "CMUL" sequence.
+ *	Author(s):
+ *	Created:			18 October 2026
+ *	Last modified:
+ *
+ *	Parameters:		const struct codegen_mul_t *p_mul:
+ *							Register operations.
+ *
+ *						const long *div:
+ *							Divisors of the constant.
+ *
+ *						const int *from:
+ *							Divisor each divisor is computed from.
+ *
+ *						int i:
+ *							Index of the divisor to compute.
+ *
+ *	Returns:			void
+ *	Globals:
+ *	Notes:			- Recursive (depth is at most 16).
+ *	************************************************************************* */
+
+static void mul_emit(	const struct codegen_mul_t *p_mul, const long *div,
+							const int *from, int i)
+{
+	long	f;
+	int	bit;
+
+
+	if (i == 0)
+		return;
+
+	mul_emit(p_mul, div, from, from[i]);
+
+	f	= div[i] / div[from[i]];
+
+	/*	- Multiplying by 256 move the low byte to the high byte.
+	 *	*/
+	if ((f == 256) && (p_mul->byte_num > 0))
+	{
+		gen_add(&p_mul->byte[0], 1);
+		gen_add(&p_mul->byte[1], 1);
+		return;
+	}
+
+	/*	- Doubling doesn't need to save the value.
+	 *	*/
+	if (f != 2)
+	{
+		gen_add(&p_mul->save[0], 1);
+
+		if (p_mul->save_num > 1)
+			gen_add(&p_mul->save[1], 1);
+	}
+
+	for (bit = 0; (f >> (bit + 1)) != 0; bit++)
+		;
+
+	while (--bit >= 0)
+	{
+		gen_add(&p_mul->dbl, 1);
+
+		if (((f >> bit) & 1) != 0)
+			gen_add(&p_mul->add, 1);
+	}
+}
+
+
+/*	*************************************************************************
+ *	Function name:	div_rotate
+ *	Description:	Generate "A" shift right ("CDIV").
+ *	Author(s):
+ *	Created:			18 October 2026
+ *	Last modified:
+ *
+ *	Parameters:		int n:
+ *							Number of bits (1 to 7).
+ *
+ *	Returns:			void
+ *	Globals:
+ *
+ *	Notes:			- Rotate, then mask bits rotated in.  Rotating left
+ *						  <8 - n> bits is the same as rotating right <n>
+ *						  bits.
+ *	************************************************************************* */
+
+static void div_rotate(int n)
+{
+	uint8_t	code[2];
+	int		i;
+
+
+	code[0]	= (n <= 4) ? OP_RRC : OP_RLC;
+
+	for (i = (n <= 4) ? n : 8 - n; i > 0; i--)
+		gen_add(code, 1);
+
+	code[0]	= OP_ANI;
+	code[1]	= (uint8_t) (0xFF >> n);
+	gen_add(code, 1);
+}
+
+
+/*	*************************************************************************
+ *	Function name:	codegen_reg
+ *	Description:	Decode a register operand of a generator directive.
+ *	Author(s):
+ *	Created:			18 October 2026
+ *	Last modified:
+ *
+ *	Parameters:		const char *text:
+ *							Operand.
+ *
+ *	Returns:			int:
+ *							- Register code ("B" = 0, ..., "L" = 5, "A" = 7).
+ *							- (-1) if this is not an 8-bit register ("M" is
+ *							  not accepted).
+ *
+ *	Globals:
+ *	Notes:			- Register can be followed by another operand (',').
+ *	************************************************************************* */
+
+int codegen_reg(const char *text)
+{
+	static const char	*reg8_name	= "BCDEHLMA";
+
+	const char	*p;
+	int			c;
+
+
+	while (isspace((int) *text))
+		text++;
+
+	c	= toupper((int) *text++);
+
+	if ((c == '\0') || (c == 'M') || ((p = strchr(reg8_name, c)) == NULL))
+		return (-1);
+
+	while (isspace((int) *text))
+		text++;
+
+	if ((*text != '\0') && (*text != ';') && (*text != ','))
+		return (-1);
+
+	return ((int) (p - reg8_name));
+}
+
+
+/*	*************************************************************************
+ *	Function name:	codegen_delay
+ *	Description:	Generate a delay of an exact number of cycles.
+ *	Author(s):
+ *	Created:			18 October 2026
+ *	Last modified:
+ *
+ *	Parameters:		long cycles:
+ *							Number of cycles (0 to CODEGEN_DELAY_MAX).
+ *
+ *						int reg:
+ *							- Register the delay can clobber (with the flags),
+ *							  see "codegen_reg()".
+ *							- (-1) if no register, neither flag, can change.
+ *
+ *						int pc:
+ *							Address of the delay.
+ *
+ *	Returns:			int:
+ *							-3	: Memory allocation error.
+ *							-2	: No sequence (too short).
+ *							-1	: Number of cycles out of range.
+ *							0	: Success.
+ *
+ *	Globals:
+ *
+ *	Notes:			- See "delay_fill()".
+ *						- Without register, loops use "B", saved with the
+ *						  flags ("PUSH PSW" / "PUSH B" ... "POP B" /
+ *						  "POP PSW"), if that is smaller than fillers only.
+ *	************************************************************************* */
+
+int codegen_delay(long cycles, int reg, int pc)
+{
+	static const uint8_t	save_code[]		= {0xF5, 0xC5};	/*	PUSH PSW / PUSH B. */
+	static const uint8_t	restore_code[]	= {0xC1, 0xF1};	/*	POP B / POP PSW. */
+
+	struct codegen_inst_t	fill[CODEGEN_INST_MAX];
+	uint8_t						cyc[2];
+	long							save_cyc		= 0;
+	int							fill_size	= -1;		/*	Fillers only (bytes). */
+	int							fill_num		= 0;
+	int							size;
+	int							status;
+	int							i;
+
+
+	gen_num	= 0;
+	gen_pc	= pc & 0xFFFF;
+
+	if ((cycles < 0) || (cycles > CODEGEN_DELAY_MAX))
+		return (-1);
+
+	if (reg >= 0)
+		return (delay_fill(cycles, reg));
+
+	/*	Fillers only.
+	 *	------------- */
+	if ((status = delay_fill(cycles, -1)) == -3)
+		return (-3);
+
+	if (status == 0)
+	{
+		for (fill_size = 0, i = 0; i < gen_num; i++)
+			fill_size	+= gen_inst[i].size;
+
+		fill_num	= gen_num;
+		memcpy(fill, gen_inst, gen_num * sizeof (struct codegen_inst_t));
+	}
+
+	/*	Loops on a saved register.
+	 *	-------------------------- */
+	for (i = 0; i < 2; i++)
+	{
+		opcode_decode(save_code[i], cyc);
+		save_cyc	+= cyc[0];
+		opcode_decode(restore_code[i], cyc);
+		save_cyc	+= cyc[0];
+	}
+
+	gen_num	= 0;
+
+	if (cycles >= save_cyc)
+	{
+		for (i = 0; i < 2; i++)
+			gen_add(&save_code[i], 1);
+
+		if ((status = delay_fill(cycles - save_cyc, 0)) == -3)
+			return (-3);
+
+		if ((status == 0) && (gen_num + 2 <= CODEGEN_INST_MAX))
+		{
+			for (i = 0; i < 2; i++)
+				gen_add(&restore_code[i], 1);
+
+			for (size = 0, i = 0; i < gen_num; i++)
+				size	+= gen_inst[i].size;
+
+			if ((fill_size < 0) || (size < fill_size))
+				return (0);
+		}
+	}
+
+	/*	Fillers only are smaller.
+	 *	------------------------- */
+	if (fill_size < 0)
+	{
+		gen_num	= 0;
+		return (-2);
+	}
+
+	gen_num	= fill_num;
+	memcpy(gen_inst, fill, gen_num * sizeof (struct codegen_inst_t));
+
+	return (0);
+}
+
+
+/*	*************************************************************************
+ *	Function name:	codegen_mul
+ *	Description:	Generate a multiplication by a constant.
+ *	Author(s):
+ *	Created:			18 October 2026
+ *	Last modified:
+ *
+ *	Parameters:		int reg:
+ *							CODEGEN_REG_H ("HL") or CODEGEN_REG_A.
+ *
+ *						long k:
+ *							Constant (0 to 0FFFFh for "HL", 0 to 0FFh
+ *							for "A").
+ *
+ *						int by_size:
+ *							- 0: Fewest cycles (then bytes).
+ *							- 1: Fewest bytes (then cycles).
+ *
+ *						int pc:
+ *							Address of the sequence.
+ *
+ *	Returns:			int:
+ *							-1	: Constant out of range.
+ *							0	: Success.
+ *
+ *	Globals:
+ *
+ *	Notes:			- "HL" change "DE", and "A" change "B".  Flags
+ *						  change.
+ *						- A sequence is a chain of divisors of <k>: Each
+ *						  one is computed from a smaller one, doubling it,
+ *						  multiplying it by 256 ("HL" only, moving "L" to
+ *						  "H"), or saving it then multiplying it by the
+ *						  quotient using the binary method.  The cheapest
+ *						  chain is found by dynamic programming on the
+ *						  divisors.
+ *	************************************************************************* */
+
+int codegen_mul(int reg, long k, int by_size, int pc)
+{
+	const struct codegen_mul_t	*p_mul	= (reg == CODEGEN_REG_A) ? &mul_op_a : &mul_op_h;
+
+	long	div[CODEGEN_DIVISOR_MAX];
+	long	cost[CODEGEN_DIVISOR_MAX];
+	int	from[CODEGEN_DIVISOR_MAX];
+	long	w_dbl;
+	long	w_add;
+	long	w_save;
+	long	w_byte;
+	long	c;
+	int	num		= 0;
+	int	i;
+	int	j;
+
+
+	gen_num	= 0;
+	gen_pc	= pc & 0xFFFF;
+
+	if ((k < 0) || (k > p_mul->k_max))
+		return (-1);
+
+	if (k == 0)
+	{
+		gen_add(p_mul->zero, 1);
+		return (0);
+	}
+
+	w_dbl		= gen_weight(&p_mul->dbl, 1, by_size);
+	w_add		= gen_weight(&p_mul->add, 1, by_size);
+	w_save	= gen_weight(p_mul->save, p_mul->save_num, by_size);
+	w_byte	= gen_weight(p_mul->byte, p_mul->byte_num, by_size);
+
+	for (i = 1; i <= k; i++)
+	{
+		if ((k % i) == 0)
+			div[num++]	= i;
+	}
+
+	cost[0]	= 0;
+
+	for (i = 1; i < num; i++)
+	{
+		cost[i]	= CODEGEN_COST_MAX;
+
+		for (j = 0; j < i; j++)
+		{
+			if ((div[i] % div[j]) != 0)
+				continue;
+
+			if (div[i] == div[j] * 2)
+				c	= cost[j] + w_dbl;
+			else if ((div[i] == div[j] * 256) && (p_mul->byte_num > 0))
+				c	= cost[j] + w_byte;
+			else
+				c	= cost[j] + w_save + mul_binary(div[i] / div[j], w_dbl, w_add);
+
+			if (c < cost[i])
+			{
+				cost[i]	= c;
+				from[i]	= j;
+			}
+		}
+	}
+
+	mul_emit(p_mul, div, from, num - 1);
+
+	return (0);
+}
+
+
+/*	*************************************************************************
+ *	Function name:	codegen_div
+ *	Description:	Generate an unsigned division by a constant.
+ *	Author(s):
+ *	Created:			18 October 2026
+ *	Last modified:
+ *
+ *	Parameters:		int reg:
+ *							CODEGEN_REG_H ("HL") or CODEGEN_REG_A.
+ *
+ *						long k:
+ *							Constant (a power of 2, up to 8000h for "HL",
+ *							and 80h for "A").
+ *
+ *						int pc:
+ *							Address of the sequence.
+ *
+ *	Returns:			int:
+ *							-1	: Constant is not supported.
+ *							0	: Success.
+ *
+ *	Globals:
+ *
+ *	Notes:			- "HL" change "A".  Flags change.
+ *						- "HL" is shifted right one bit at a time through
+ *						  "A", but a byte at a time for 8 bits and more.
+ *	************************************************************************* */
+
+int codegen_div(int reg, long k, int pc)
+{
+	static const uint8_t	hl_shift[]	=
+	{
+		OP_ORA_A, OP_MOV_A_H, OP_RAR, OP_MOV_H_A, OP_MOV_A_L, OP_RAR, OP_MOV_L_A
+	};
+
+	uint8_t	code[2];
+	int		n;
+	int		i;
+
+
+	gen_num	= 0;
+	gen_pc	= pc & 0xFFFF;
+
+	for (n = 0; (n < 16) && ((1L << n) < k); n++)
+		;
+
+	if ((k < 1) || ((1L << n) != k) || (n > ((reg == CODEGEN_REG_A) ? 7 : 15)))
+		return (-1);
+
+	if (reg == CODEGEN_REG_A)
+	{
+		if (n > 0)
+			div_rotate(n);
+	}
+	else if (n < 8)
+	{
+		for (; n > 0; n--)
+		{
+			for (i = 0; i < (int) sizeof (hl_shift); i++)
+				gen_add(&hl_shift[i], 1);
+		}
+	}
+	else
+	{
+		code[0]	= OP_MOV_L_H;
+		gen_add(code, 1);
+
+		code[0]	= OP_MVI_H;
+		code[1]	= 0x00;
+		gen_add(code, 1);
+
+		if (n > 8)
+		{
+			code[0]	= OP_MOV_A_L;
+			gen_add(code, 1);
+
+			div_rotate(n - 8);
+
+			code[0]	= OP_MOV_L_A;
+			gen_add(code, 1);
+		}
+	}
+
+	return (0);
+}
+
+
+/*	*************************************************************************
+ *	Function name:	codegen_code
+ *	Description:	Get the generated bytes.
+ *	Author(s):
+ *	Created:			18 October 2026
+ *	Last modified:
+ *
+ *	Parameters:		uint8_t *p_code:
+ *							Bytes (CODEGEN_SIZE_MAX bytes).
+ *
+ *	Returns:			int:
+ *							Number of bytes.
+ *
+ *	Globals:
+ *	Notes:
+ *	************************************************************************* */
+
+int codegen_code(uint8_t *p_code)
+{
+	int	size	= 0;
+	int	i;
+
+	for (i = 0; i < gen_num; i++)
+	{
+		memcpy(p_code + size, gen_inst[i].code, gen_inst[i].size);
+		size	+= gen_inst[i].size;
+	}
+
+	return (size);
+}
+
+
+/*	*************************************************************************
+ *	Function name:	codegen_cycles
+ *	Description:	Count the cycles of the generated sequence.
+ *	Author(s):
+ *	Created:			18 October 2026
+ *	Last modified:
+ *	Parameters:		void
+ *
+ *	Returns:			long:
+ *							Number of cycles.
+ *
+ *	Globals:
+ *
+ *	Notes:			- Counted from "OpCodes[]" again, to verify the
+ *						  generator.  A conditional jump executed <n> times
+ *						  is taken <n> - 1 times.
+ *	************************************************************************* */
+
+long codegen_cycles(void)
+{
+	const opcode_t	*p_opcode;
+	uint8_t			cyc[2];
+	long				total	= 0;
+	int				i;
+
+
+	for (i = 0; i < gen_num; i++)
+	{
+		p_opcode	= opcode_decode(gen_inst[i].code[0], cyc);
+
+		if (p_opcode->flow == OF_JUMP_COND)
+			total	+= (cyc[1] * (gen_inst[i].count - 1)) + cyc[0];
+		else
+			total	+= cyc[0] * gen_inst[i].count;
+	}
+
+	return (total);
+}
+
+
+/*	*************************************************************************
+ *	Function name:	codegen_note
+ *	Description:	Record the generated instructions for cycles analysis.
+ *	Author(s):
+ *	Created:			18 October 2026
+ *	Last modified:
+ *	Parameters:		void
+ *	Returns:			void
+ *	Globals:			int cycles_enable
+ *
+ *	Notes:			- Loops get their "@LOOP" bound.
+ *	************************************************************************* */
+
+void codegen_note(void)
+{
+	const opcode_t	*p_opcode;
+	char				text[32];
+	int				addr	= gen_pc;
+	int				i;
+
+
+	if (cycles_enable == 0)
+		return;
+
+	for (i = 0; i < gen_num; i++)
+	{
+		p_opcode	= opcode_decode(gen_inst[i].code[0], NULL);
+
+		if (p_opcode->flow == OF_JUMP_COND)
+			sprintf(text, "; @LOOP %ld", gen_inst[i].count);
+		else
+			*text	= '\0';
+
+		cycles_note(addr, p_opcode, text);
+		addr	= (addr + gen_inst[i].size) & 0xFFFF;
+	}
+}
+
+
+/*	*************************************************************************
+ *	Function name:	codegen_list
+ *	Description:	List the generated instructions.
+ *	Author(s):
+ *	Created:			18 October 2026
+ *	Last modified:
+ *
+ *	Parameters:		FILE *fp:
+ *							Listing file.
+ *
+ *						int print_inc:
+ *							Print instruction number of cycles ("-P").
+ *
+ *	Returns:			void
+ *	Globals:
+ *
+ *	Notes:			- Same format as assembled instructions, without
+ *						  source line number.  Number of times executed
+ *						  is in comment.
+ *	************************************************************************* */
+
+void codegen_list(FILE *fp, int print_inc)
+{
+	char		text[OPCODE_DISASM_SIZE_MAX + 24];
+	char		str_inc[16];
+	char		str_prof[PROFILE_COLUMN_SIZE];
+	uint8_t	cyc[2];
+	int		addr	= gen_pc;
+	int		size	= 0;
+	int		i;
+
+
+	for (i = 0; i < gen_num; i++)
+	{
+		struct codegen_inst_t	*p_inst	= &gen_inst[i];
+
+		*text	= '\t';
+		opcode_disasm(p_inst->code, text + 1);
+
+		if (p_inst->count > 1)
+			sprintf(text + strlen(text), "\t; x%ld", p_inst->count);
+
+		if (print_inc != 0)
+		{
+			opcode_decode(p_inst->code[0], cyc);
+
+			if (cyc[0] == cyc[1])
+				sprintf(str_inc, "%2d    ", cyc[0]);
+			else
+				sprintf(str_inc, "%2d/%2d ", cyc[0], cyc[1]);
+		}
+		else
+			*str_inc	= '\0';
+
+		profile_column(str_prof, addr, p_inst->size, p_inst->code[0]);
+
+		switch (p_inst->size)
+		{
+			case 1:
+				fprintf(	fp, "%6s %s%s%04X %02X\t\t%s\n", "", str_inc, str_prof, addr,
+							p_inst->code[0], text);
+				break;
+
+			case 2:
+				fprintf(	fp, "%6s %s%s%04X %02X %02X\t%s\n", "", str_inc, str_prof, addr,
+							p_inst->code[0], p_inst->code[1], text);
+				break;
+
+			default:
+				fprintf(	fp, "%6s %s%s%04X %02X %02X %02X\t%s\n", "", str_inc, str_prof, addr,
+							p_inst->code[0], p_inst->code[1], p_inst->code[2], text);
+				break;
+		}
+
+		addr	= (addr + p_inst->size) & 0xFFFF;
+		size	+= p_inst->size;
+	}
+
+	fprintf(	fp, "%6s %s%s    \t\t\t; %ld cycles, %d byte%s.\n", "",
+				(print_inc != 0) ? "      " : "", profile_gap(), codegen_cycles(), size,
+				(size != 1) ? "s" : "");
+}
+
+
+
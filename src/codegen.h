@@ -0,0 +1,83 @@
+/*	*************************************************************************
+ *	Module Name:	codegen.h
+ *	Description:	Code Generators ("DELAY", "CMUL" and "CDIV" directives).
+ *	Copyright(c):	See below...
+ *	Author(s):
+ *	Created:			18 October 2026
+ *	Last modified:
+ *	Notes:
+ *	************************************************************************* */
+
+/*
+ * Copyright (c) <2007-2017> Jay Cotton <lbmgmusic@gmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+
+
+/*	*************************************************************************
+ *	************************************************************************* */
+
+#ifndef _CODEGEN_H
+#define _CODEGEN_H
+
+
+/*	*************************************************************************
+ *	                              INCLUDE FILES
+ *	************************************************************************* */
+
+#include <stdio.h>
+
+#include "project.h"
+
+
+/*	*************************************************************************
+ *											  CONSTANTS
+ *	************************************************************************* */
+
+#define CODEGEN_INST_MAX			64			/*	Generated instructions. */
+#define CODEGEN_SIZE_MAX			(CODEGEN_INST_MAX * 3)	/*	Generated bytes. */
+#define CODEGEN_DELAY_MAX			65535		/*	Longest "DELAY" (cycles). */
+
+/*	Registers (see "codegen_reg()").
+ *	-------------------------------- */
+#define CODEGEN_REG_H				4			/*	"H" ("HL" pair, for "CMUL"/"CDIV"). */
+#define CODEGEN_REG_A				7
+
+
+/*	*************************************************************************
+ *	                          FUNCTIONS DECLARATION
+ *	************************************************************************* */
+
+int codegen_reg(const char *text);
+int codegen_delay(long cycles, int reg, int pc);
+int codegen_mul(int reg, long k, int by_size, int pc);
+int codegen_div(int reg, long k, int pc);
+int codegen_code(uint8_t *p_code);
+long codegen_cycles(void);
+void codegen_note(void);
+void codegen_list(FILE *fp, int print_inc);
+
+
+
+#endif
+
+
+
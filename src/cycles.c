@@ -0,0 +1,1931 @@
+/*	*************************************************************************
+ *	Module Name:	cycles.c
+ *	Description:	Static Cycles Analysis ("--cycles" option).
+ *	Copyright(c):	See below...
+ *	Author(s):
+ *	Created:			18 October 2026
+ *	Last modified:
+ *
+ *	Notes:			- Opcode addresses are recorded on assembler pass #2
+ *						  ("cycles_note()").  After assembly, a control flow
+ *						  graph is followed from "Image[]", using the cycles
+ *						  of "OpCodes[]" (not taken / taken for conditional
+ *						  instructions), and the best and worst case number
+ *						  of cycles is computed between two labels, or from
+ *						  the entry of a routine to its return.
+ *						- Called routines are analyzed once, and their
+ *						  cycles are added at each call.
+ *						- Loop bounds come from annotations, in the comment
+ *						  of the jump that close the loop:
+ *						    "; @LOOP <n>" or "; @LOOP <min>,<max>"
+ *						  The loop body (from the jump target to the jump)
+ *						  runs <min> to <max> times.
+ *						- "--latency" option follow each "DI" up to the "EI"
+ *						  that end the interrupts disabled region.
+ *						- "CYCLES" directive budgets are recorded on pass #2,
+ *						  and checked when the whole program is assembled
+ *						  ("cycles_check()").
+ *	************************************************************************* */
+
+/*
+ * Copyright (c) <2007-2017> Jay Cotton <lbmgmusic@gmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+
+/*	*************************************************************************
+ *	                              INCLUDE FILES
+ *	************************************************************************* */
+
+#include <stdio.h>
+#include <ctype.h>
+#include <stdlib.h>
+
+#include "project.h"
+#include "err_code.h"		/*	Error Codes. */
+#include "war_code.h"		/*	Warning Codes. */
+#include "util.h"
+#include "main.h"
+#include "msg.h"
+#include "mem.h"
+#include "opcode.h"
+#include "cycles.h"
+
+
+/*	*************************************************************************
+ *											  CONSTANTS
+ *	************************************************************************* */
+
+#define CYCLES_ADDR_NUM			0x10000		/*	Number of addresses. */
+#define CYCLES_MEMO_SIZE_MIN		1024			/*	Memo entries, first allocation. */
+#define CYCLES_LOOP_MAX			0xFFFF		/*	Maximum loop bound. */
+#define CYCLES_FN_SIZE_MAX		128			/*	File name size, in reports. */
+#define CYCLES_DEPTH_MAX			2048			/*	Nested evaluations, at most. */
+
+/*	Node flags.
+ *	----------- */
+#define CN_INST					0x01			/*	Opcode address. */
+#define CN_LOOP					0x02			/*	Jump with a loop bound. */
+#define CN_ROUTINE				0x04			/*	Called. */
+
+/*	Routine analysis state.
+ *	----------------------- */
+#define RT_NONE					0
+#define RT_BUSY					1
+#define RT_DONE					2
+
+
+/*	*************************************************************************
+ *	                                 TYPEDEF
+ *	************************************************************************* */
+
+/*	One node per address.
+ *	--------------------- */
+struct cycles_node_t
+{
+	uint8_t						flags;			/*	See "CN_x". */
+	uint8_t						rt_state;		/*	See "RT_x". */
+	uint16_t						loop_min;		/*	Loop bound (with "CN_LOOP"). */
+	uint16_t						loop_max;
+	int							back;				/*	Loop header: closing jump (or -1). */
+	int							memo;				/*	Last memo entry (or -1). */
+	int							line;				/*	Source line. */
+	int							file;				/*	Source file (see "file_name"). */
+	struct cycles_result_t	rt;				/*	Routine result. */
+};
+
+/*	- Memo entry: Result from an address, in one analysis frame.
+ *	- Notes: Entries are a stack.  Entries of a frame are removed
+ *	  when the frame is done.
+ *	------------------------------------------------------------- */
+struct cycles_memo_t
+{
+	int							prev;				/*	Previous entry of the address. */
+	int							addr;
+	int							frame;			/*	Frame ID. */
+	int							done;				/*	0: In progress. */
+	struct cycles_result_t	res;
+};
+
+/*	- Analysis frame.  Paths end at "stop" (or at a return if "stop"
+ *	  is -1).
+ *	---------------------------------------------------------------- */
+struct cycles_frame_t
+{
+	int								id;
+	int								stop;
+	int								header;		/*	Loop header handled (or -1). */
+	int								back;			/*	Closing jump not taken (or -1). */
+	int								ei;			/*	1: Paths end at "EI". */
+	const struct cycles_frame_t	*parent;		/*	NULL for a routine. */
+};
+
+/*	"--cycles" option arguments.
+ *	---------------------------- */
+struct cycles_spec_t
+{
+	char						*text;
+	struct cycles_spec_t	*next;
+};
+
+/*	"CYCLES" directive budgets.
+ *	--------------------------- */
+struct cycles_budget_t
+{
+	int							from;
+	int							to;
+	long							min;
+	long							max;
+	char							*fn;				/*	Source file name. */
+	int							line;				/*	Source line. */
+	struct cycles_budget_t	*next;
+};
+
+
+/*	*************************************************************************
+ *	                                  CONST
+ *	************************************************************************* */
+
+/*	- Problem description, by status (with the problem address).
+ *	  Notes: Must match "enum cycles_status_t".
+ *	------------------------------------------------------------ */
+static const char	*status_fmt[] =
+{
+	"",
+	"Call to %04Xh not counted",
+	"Loop without bound at %04Xh",
+	"Return with interrupts disabled at %04Xh",
+	"Recursive call to %04Xh",
+	"Indirect jump at %04Xh",
+	"Not an opcode at %04Xh",
+	"Too many branches nested at %04Xh",
+	"No path to the end"
+};
+
+
+/*	*************************************************************************
+ *	                                VARIABLES
+ *	************************************************************************* */
+
+/*	Public variables.
+ *	***************** */
+
+int	cycles_enable	= 0;
+int	cycles_errors	= 0;
+
+
+/*	Private variables.
+ *	****************** */
+
+static struct cycles_node_t	*cycles_node	= NULL;
+
+static struct cycles_memo_t	*cycles_memo	= NULL;
+static int							memo_num			= 0;
+static int							memo_size		= 0;
+
+static int							frame_id			= 0;
+static int							eval_depth		= 0;		/*	Nested "cycles_eval()". */
+
+static struct cycles_spec_t	*spec_first		= NULL;
+static struct cycles_spec_t	*spec_last		= NULL;
+
+static struct cycles_budget_t	*budget_first	= NULL;
+static struct cycles_budget_t	*budget_last	= NULL;
+
+/*	- Source file names.  Index 0 is the main source file
+ *	  ("in_fn[0]"), that is not copied.
+ *	*/
+static char							**file_name		= NULL;
+static int							file_num			= 1;
+static int							file_size		= 0;
+
+static long							latency_max		= -1;		/*	"--latency" option. */
+
+
+/*	*************************************************************************
+ *									  FUNCTIONS DECLARATION
+ *	************************************************************************* */
+
+static void res_set(	struct cycles_result_t *p_res, long long best,
+	  						long long worst, enum cycles_status_t status, int where);
+static void res_seq(struct cycles_result_t *p_res, const struct cycles_result_t *p_next);
+static void res_alt(struct cycles_result_t *p_res, const struct cycles_result_t *p_alt);
+static void res_add(struct cycles_result_t *p_res, int cyc);
+static int image_word(int addr);
+static int header_active(const struct cycles_frame_t *p_frame, int addr);
+static int back_skipped(const struct cycles_frame_t *p_frame, int addr);
+static void cycles_eval(	const struct cycles_frame_t *p_frame, int addr,
+	  							struct cycles_result_t *p_res);
+static void cycles_walk(	const struct cycles_frame_t *p_frame, int addr,
+	  							struct cycles_result_t *p_res);
+static void cycles_run(	struct cycles_frame_t *p_frame, int addr,
+	  							struct cycles_result_t *p_res);
+static void cycles_loop(	const struct cycles_frame_t *p_frame, int addr,
+	  							struct cycles_result_t *p_res);
+static void cycles_call(int addr, struct cycles_result_t *p_res);
+static void cycles_prepare(void);
+static const char *label_name(int addr);
+static void print_result(FILE *fp, const char *name, const struct cycles_result_t *p_res);
+static int file_index(void);
+static void node_location(int addr, char *buf);
+static void latency_check(void);
+static void latency_report(FILE *fp);
+
+
+/*	*************************************************************************
+ *	                                FUNCTIONS
+ *	************************************************************************* */
+
+/*	*************************************************************************
+ *	Function name:	res_set
+ *	Description:	Set a Result.
+ *	Author(s):
+ *	Created:			18 October 2026
+ *	Last modified:
+ *
+ *	Parameters:		struct cycles_result_t *p_res:
+ *							Result.
+ *
+ *						long long best, long long worst:
+ *							Best and worst case, in cycles.
+ *
+ *						enum cycles_status_t status:
+ *							Status.
+ *
+ *						int where:
+ *							Address of the problem, if any.
+ *
+ *	Returns:			void
+ *	Globals:
+ *	Notes:
+ *	************************************************************************* */
+
+static void res_set(	struct cycles_result_t *p_res, long long best,
+	  						long long worst, enum cycles_status_t status, int where)
+{
+	p_res->best		= best;
+	p_res->worst	= worst;
+	p_res->status	= status;
+	p_res->where	= where;
+}
+
+
+/*	*************************************************************************
+ *	Function name:	res_seq
+ *	Description:	Add a Result that follow (sequence).
+ *	Author(s):
+ *	Created:			18 October 2026
+ *	Last modified:
+ *
+ *	Parameters:		struct cycles_result_t *p_res:
+ *							Result, updated.
+ *
+ *						const struct cycles_result_t *p_next:
+ *							Result of what follow.
+ *
+ *	Returns:			void
+ *	Globals:
+ *	Notes:			- Most severe status is kept.
+ *	************************************************************************* */
+
+static void res_seq(struct cycles_result_t *p_res, const struct cycles_result_t *p_next)
+{
+	if (p_res->status == CS_NOPATH)
+		return;
+
+	if (p_next->status == CS_NOPATH)
+	{
+		*p_res	= *p_next;
+		return;
+	}
+
+	p_res->best		+= p_next->best;
+	p_res->worst	+= p_next->worst;
+
+	if (p_next->status > p_res->status)
+	{
+		p_res->status	= p_next->status;
+		p_res->where	= p_next->where;
+	}
+}
+
+
+/*	*************************************************************************
+ *	Function name:	res_alt
+ *	Description:	Merge an Alternative Result (branch).
+ *	Author(s):
+ *	Created:			18 October 2026
+ *	Last modified:
+ *
+ *	Parameters:		struct cycles_result_t *p_res:
+ *							Result, updated.
+ *
+ *						const struct cycles_result_t *p_alt:
+ *							Result of the other branch.
+ *
+ *	Returns:			void
+ *	Globals:
+ *	Notes:			- A branch without path is ignored.
+ *	************************************************************************* */
+
+static void res_alt(struct cycles_result_t *p_res, const struct cycles_result_t *p_alt)
+{
+	if (p_alt->status == CS_NOPATH)
+		return;
+
+	if (p_res->status == CS_NOPATH)
+	{
+		*p_res	= *p_alt;
+		return;
+	}
+
+	if (p_alt->best < p_res->best)
+		p_res->best		= p_alt->best;
+
+	if (p_alt->worst > p_res->worst)
+		p_res->worst	= p_alt->worst;
+
+	if (p_alt->status > p_res->status)
+	{
+		p_res->status	= p_alt->status;
+		p_res->where	= p_alt->where;
+	}
+}
+
+
+/*	*************************************************************************
+ *	Function name:	res_add
+ *	Description:	Add cycles to a Result.
+ *	Author(s):
+ *	Created:			18 October 2026
+ *	Last modified:
+ *
+ *	Parameters:		struct cycles_result_t *p_res:
+ *							Result, updated.
+ *
+ *						int cyc:
+ *							Number of cycles.
+ *
+ *	Returns:			void
+ *	Globals:
+ *	Notes:
+ *	************************************************************************* */
+
+static void res_add(struct cycles_result_t *p_res, int cyc)
+{
+	if (p_res->status != CS_NOPATH)
+	{
+		p_res->best		+= cyc;
+		p_res->worst	+= cyc;
+	}
+}
+
+
+/*	*************************************************************************
+ *	Function name:	image_word
+ *	Description:	Read the 16-bit operand of an instruction.
+ *	Author(s):
+ *	Created:			18 October 2026
+ *	Last modified:
+ *
+ *	Parameters:		int addr:
+ *							Instruction address.
+ *
+ *	Returns:			int:
+ *							Operand.
+ *
+ *	Globals:			char Image[]
+ *	Notes:
+ *	************************************************************************* */
+
+static int image_word(int addr)
+{
+	return (	(uint8_t) Image[(addr + 1) & 0xFFFF] |
+				((uint8_t) Image[(addr + 2) & 0xFFFF] << 8));
+}
+
+
+/*	*************************************************************************
+ *	Function name:	header_active
+ *	Description:	Tell if a loop header is handled by a frame.
+ *	Author(s):
+ *	Created:			18 October 2026
+ *	Last modified:
+ *
+ *	Parameters:		const struct cycles_frame_t *p_frame:
+ *							Current frame.
+ *
+ *						int addr:
+ *							Loop header address.
+ *
+ *	Returns:			int:
+ *							0: Loop is not handled yet.
+ *							1: Loop is handled by this frame or a parent.
+ *
+ *	Globals:
+ *	Notes:
+ *	************************************************************************* */
+
+static int header_active(const struct cycles_frame_t *p_frame, int addr)
+{
+	for (; p_frame != NULL; p_frame = p_frame->parent)
+	{
+		if (p_frame->header == addr)
+			return (1);
+	}
+
+	return (0);
+}
+
+
+/*	*************************************************************************
+ *	Function name:	back_skipped
+ *	Description:	Tell if a loop closing jump must not be taken.
+ *	Author(s):
+ *	Created:			18 October 2026
+ *	Last modified:
+ *
+ *	Parameters:		const struct cycles_frame_t *p_frame:
+ *							Current frame.
+ *
+ *						int addr:
+ *							Jump address.
+ *
+ *	Returns:			int:
+ *							0: Jump can be taken.
+ *							1: Last turn of this loop (in this frame or a
+ *								parent).
+ *
+ *	Globals:
+ *	Notes:
+ *	************************************************************************* */
+
+static int back_skipped(const struct cycles_frame_t *p_frame, int addr)
+{
+	for (; p_frame != NULL; p_frame = p_frame->parent)
+	{
+		if (p_frame->back == addr)
+			return (1);
+	}
+
+	return (0);
+}
+
+
+/*	*************************************************************************
+ *	Function name:	cycles_eval
+ *	Description:	Evaluate cycles from an address (memoized).
+ *	Author(s):
+ *	Created:			18 October 2026
+ *	Last modified:
+ *
+ *	Parameters:		const struct cycles_frame_t *p_frame:
+ *							Current frame.
+ *
+ *						int addr:
+ *							Address.
+ *
+ *						struct cycles_result_t *p_res:
+ *							Result.
+ *
+ *	Returns:			void
+ *	Globals:
+ *	Notes:			- Reaching an address that is still in progress
+ *						  in the same frame is a loop without bound.
+ *						- Each branch, call and loop nests a call.  Nesting
+ *						  is limited to CYCLES_DEPTH_MAX, so the stack can't
+ *						  overflow on large programs.
+ *	************************************************************************* */
+
+static void cycles_eval(	const struct cycles_frame_t *p_frame, int addr,
+	  							struct cycles_result_t *p_res)
+{
+	int	m	= cycles_node[addr].memo;
+	int	k;
+
+
+	if (addr == p_frame->stop)
+	{
+		res_set(p_res, 0, 0, CS_OK, 0);
+		return;
+	}
+
+	if ((m >= 0) && (cycles_memo[m].frame == p_frame->id))
+	{
+		if (cycles_memo[m].done != 0)
+			*p_res	= cycles_memo[m].res;
+		else
+			res_set(p_res, 0, 0, CS_UNBOUNDED, addr);
+
+		return;
+	}
+
+	if (eval_depth >= CYCLES_DEPTH_MAX)
+	{
+		res_set(p_res, 0, 0, CS_DEEP, addr);
+		return;
+	}
+
+	/*	Push a memo entry.
+	 *	------------------ */
+	if (memo_num >= memo_size)
+	{
+		int							size	= (memo_size > 0) ?
+			  									memo_size * 2 : CYCLES_MEMO_SIZE_MIN;
+		struct cycles_memo_t	*p		= (struct cycles_memo_t *)
+			mem_realloc(MT_CYCLES, cycles_memo, size * sizeof (struct cycles_memo_t));
+
+		if (p == NULL)
+		{
+			res_set(p_res, 0, 0, CS_NOPATH, addr);
+			return;
+		}
+
+		cycles_memo	= p;
+		memo_size	= size;
+	}
+
+	k								= memo_num++;
+	cycles_memo[k].prev		= m;
+	cycles_memo[k].addr		= addr;
+	cycles_memo[k].frame		= p_frame->id;
+	cycles_memo[k].done		= 0;
+	cycles_node[addr].memo	= k;
+
+	eval_depth++;
+	cycles_walk(p_frame, addr, p_res);
+	eval_depth--;
+
+	/*	Notes: "cycles_memo" may have been reallocated.
+	 *	*/
+	cycles_memo[k].res		= *p_res;
+	cycles_memo[k].done		= 1;
+}
+
+
+/*	*************************************************************************
+ *	Function name:	cycles_walk
+ *	Description:	Follow instructions from an address.
+ *	Author(s):
+ *	Created:			18 October 2026
+ *	Last modified:
+ *
+ *	Parameters:		const struct cycles_frame_t *p_frame:
+ *							Current frame.
+ *
+ *						int addr:
+ *							Address.
+ *
+ *						struct cycles_result_t *p_res:
+ *							Result.
+ *
+ *	Returns:			void
+ *	Globals:			char Image[]
+ *
+ *	Notes:			- Straight line code (and calls) is followed in a
+ *						  loop.  Branches are evaluated by "cycles_eval()".
+ *	************************************************************************* */
+
+static void cycles_walk(	const struct cycles_frame_t *p_frame, int addr,
+	  							struct cycles_result_t *p_res)
+{
+	const opcode_t				*p_opcode;
+	struct cycles_result_t	res;
+	struct cycles_result_t	alt;
+	uint8_t						cyc[2];
+	int							start	= addr;
+	int							next;
+	int							n;
+
+
+	res_set(p_res, 0, 0, CS_OK, 0);
+
+	for (n = 0; n < CYCLES_ADDR_NUM; n++)
+	{
+		if (addr == p_frame->stop)
+			return;
+
+		/*	- Loop header.  Once handled, the header is processed as
+		 *	  any other address.
+		 *	-------------------------------------------------------- */
+		if ((cycles_node[addr].back >= 0) && (header_active(p_frame, addr) == 0))
+		{
+			if (addr == start)
+				cycles_loop(p_frame, addr, &res);
+			else
+				cycles_eval(p_frame, addr, &res);
+
+			res_seq(p_res, &res);
+			return;
+		}
+
+		if (	((cycles_node[addr].flags & CN_INST) == 0) ||
+				((p_opcode = opcode_decode(Image[addr], cyc)) == NULL))
+		{
+			res_set(&res, 0, 0, CS_DATA, addr);
+			res_seq(p_res, &res);
+			return;
+		}
+
+		next	= (addr + p_opcode->size) & 0xFFFF;
+
+		switch (p_opcode->flow)
+		{
+			case OF_JUMP:
+				res_add(p_res, cyc[0]);
+
+				/*	Closing jump of a loop, on its last iteration.
+				 *	---------------------------------------------- */
+				if (back_skipped(p_frame, addr) != 0)
+					res_set(&res, 0, 0, CS_NOPATH, addr);
+				else
+					cycles_eval(p_frame, image_word(addr), &res);
+
+				res_seq(p_res, &res);
+				return;
+
+			case OF_JUMP_COND:
+				cycles_eval(p_frame, next, &res);
+				res_add(&res, cyc[0]);
+
+				if (back_skipped(p_frame, addr) == 0)
+				{
+					cycles_eval(p_frame, image_word(addr), &alt);
+					res_add(&alt, cyc[1]);
+					res_alt(&res, &alt);
+				}
+
+				res_seq(p_res, &res);
+				return;
+
+			case OF_CALL:
+			case OF_CALL_COND:
+			case OF_RST:
+				cycles_call(	(p_opcode->flow == OF_RST) ?
+					  				((uint8_t) Image[addr] & 0x38) : image_word(addr),
+									&alt);
+
+				res_add(&alt, cyc[1]);
+
+				/*	Conditional call not taken.
+				 *	--------------------------- */
+				if (p_opcode->flow == OF_CALL_COND)
+				{
+					res_set(&res, cyc[0], cyc[0], CS_OK, 0);
+					res_alt(&res, &alt);
+				}
+				else
+					res	= alt;
+
+				res_seq(p_res, &res);
+
+				if (p_res->status == CS_NOPATH)
+					return;
+
+				addr	= next;
+				break;
+
+			case OF_RET:
+			case OF_HLT:
+				res_add(p_res, cyc[0]);
+
+				/*	- Only a routine end on a return.  The caller of an
+				 *	  interrupts disabled region is not known.
+				 *	--------------------------------------------------- */
+				if ((p_frame->ei != 0) && (p_opcode->flow == OF_RET))
+				{
+					res_set(&res, 0, 0, CS_RETURN, addr);
+					res_seq(p_res, &res);
+				}
+				else if (p_frame->stop >= 0)
+					res_set(p_res, 0, 0, CS_NOPATH, addr);
+
+				return;
+
+			case OF_RET_COND:
+				cycles_eval(p_frame, next, &res);
+				res_add(&res, cyc[0]);
+
+				if (p_frame->ei != 0)
+					res_set(&alt, cyc[1], cyc[1], CS_RETURN, addr);
+				else if (p_frame->stop < 0)
+					res_set(&alt, cyc[1], cyc[1], CS_OK, 0);
+				else
+					res_set(&alt, 0, 0, CS_NOPATH, addr);
+
+				res_alt(&res, &alt);
+				res_seq(p_res, &res);
+				return;
+
+			/*	End of an interrupts disabled region.
+			 *	------------------------------------- */
+			case OF_EI:
+				res_add(p_res, cyc[0]);
+
+				if (p_frame->ei != 0)
+					return;
+
+				addr	= next;
+				break;
+
+			case OF_PCHL:
+				res_set(&res, 0, 0, CS_INDIRECT, addr);
+				res_seq(p_res, &res);
+				return;
+
+			default:
+				res_add(p_res, cyc[0]);
+				addr	= next;
+				break;
+		}
+	}
+
+	/*	All addresses were executed.  This is an endless loop.
+	 *	------------------------------------------------------ */
+	res_set(&res, 0, 0, CS_UNBOUNDED, start);
+	res_seq(p_res, &res);
+}
+
+
+/*	*************************************************************************
+ *	Function name:	cycles_run
+ *	Description:	Run an analysis frame.
+ *	Author(s):
+ *	Created:			18 October 2026
+ *	Last modified:
+ *
+ *	Parameters:		struct cycles_frame_t *p_frame:
+ *							Frame (ID is set here).
+ *
+ *						int addr:
+ *							Start address.
+ *
+ *						struct cycles_result_t *p_res:
+ *							Result.
+ *
+ *	Returns:			void
+ *	Globals:
+ *	Notes:			- Memo entries of the frame are removed when done.
+ *	************************************************************************* */
+
+static void cycles_run(	struct cycles_frame_t *p_frame, int addr,
+	  							struct cycles_result_t *p_res)
+{
+	int	mark	= memo_num;
+
+	p_frame->id	= ++frame_id;
+
+	cycles_eval(p_frame, addr, p_res);
+
+	while (memo_num > mark)
+	{
+		memo_num--;
+		cycles_node[cycles_memo[memo_num].addr].memo	= cycles_memo[memo_num].prev;
+	}
+}
+
+
+/*	*************************************************************************
+ *	Function name:	cycles_loop
+ *	Description:	Evaluate a loop with a bound.
+ *	Author(s):
+ *	Created:			18 October 2026
+ *	Last modified:
+ *
+ *	Parameters:		const struct cycles_frame_t *p_frame:
+ *							Current frame.
+ *
+ *						int addr:
+ *							Loop header (target of the closing jump).
+ *
+ *						struct cycles_result_t *p_res:
+ *							Result.
+ *
+ *	Returns:			void
+ *	Globals:
+ *
+ *	Notes:			- The loop body runs <n> times: <n> - 1 times from
+ *						  the header to the closing jump taken, and once
+ *						  from the header to the end point without taking
+ *						  the closing jump.
+ *	************************************************************************* */
+
+static void cycles_loop(	const struct cycles_frame_t *p_frame, int addr,
+	  							struct cycles_result_t *p_res)
+{
+	struct cycles_frame_t	around;
+	struct cycles_frame_t	exit;
+	struct cycles_result_t	res;
+	struct cycles_node_t		*p_back	= &cycles_node[cycles_node[addr].back];
+	uint8_t						cyc[2];
+
+
+	/*	One turn: From header to the closing jump, taken.
+	 *	------------------------------------------------- */
+	around.stop		= cycles_node[addr].back;
+	around.header	= addr;
+	around.back		= -1;
+	around.ei		= p_frame->ei;
+	around.parent	= p_frame;
+
+	if (around.stop == addr)
+		res_set(&res, 0, 0, CS_OK, 0);
+	else
+		cycles_run(&around, addr, &res);
+
+	opcode_decode(Image[around.stop], cyc);
+	res_add(&res, cyc[1]);
+
+	/*	Last turn, and what follow.
+	 *	--------------------------- */
+	exit.stop		= p_frame->stop;
+	exit.header		= addr;
+	exit.back		= around.stop;
+	exit.ei			= p_frame->ei;
+	exit.parent		= p_frame;
+
+	cycles_run(&exit, addr, p_res);
+
+	if (res.status == CS_NOPATH)
+		return;
+
+	res.best		*= p_back->loop_min - 1;
+	res.worst	*= p_back->loop_max - 1;
+
+	res_seq(&res, p_res);
+	*p_res	= res;
+}
+
+
+/*	*************************************************************************
+ *	Function name:	cycles_call
+ *	Description:	Evaluate a routine (from its entry to its return).
+ *	Author(s):
+ *	Created:			18 October 2026
+ *	Last modified:
+ *
+ *	Parameters:		int addr:
+ *							Routine address.
+ *
+ *						struct cycles_result_t *p_res:
+ *							Result.
+ *
+ *	Returns:			void
+ *	Globals:
+ *	Notes:			- Result is kept, so each routine is analyzed once.
+ *						- A routine outside the program is not counted.
+ *	************************************************************************* */
+
+static void cycles_call(int addr, struct cycles_result_t *p_res)
+{
+	struct cycles_node_t		*p_node	= &cycles_node[addr];
+	struct cycles_frame_t	frame;
+
+
+	if ((p_node->flags & CN_INST) == 0)
+	{
+		res_set(p_res, 0, 0, CS_EXTERN, addr);
+		return;
+	}
+
+	if (p_node->rt_state == RT_DONE)
+	{
+		*p_res	= p_node->rt;
+		return;
+	}
+
+	if (p_node->rt_state == RT_BUSY)
+	{
+		res_set(p_res, 0, 0, CS_RECURSION, addr);
+		return;
+	}
+
+	p_node->rt_state	= RT_BUSY;
+
+	frame.stop		= -1;
+	frame.header	= -1;
+	frame.back		= -1;
+	frame.ei			= 0;
+	frame.parent	= NULL;
+
+	cycles_run(&frame, addr, p_res);
+
+	p_node->rt			= *p_res;
+	p_node->rt_state	= RT_DONE;
+}
+
+
+/*	*************************************************************************
+ *	Function name:	cycles_prepare
+ *	Description:	Prepare the analysis (loop headers, routines).
+ *	Author(s):
+ *	Created:			18 October 2026
+ *	Last modified:
+ *	Parameters:		void
+ *	Returns:			void
+ *	Globals:			char Image[]
+ *	Notes:
+ *	************************************************************************* */
+
+static void cycles_prepare(void)
+{
+	const opcode_t	*p_opcode;
+	int				addr;
+	int				target;
+
+
+	for (addr = 0; addr < CYCLES_ADDR_NUM; addr++)
+	{
+		cycles_node[addr].flags		&= ~CN_ROUTINE;
+		cycles_node[addr].rt_state	= RT_NONE;
+		cycles_node[addr].back		= -1;
+		cycles_node[addr].memo		= -1;
+	}
+
+	for (addr = 0; addr < CYCLES_ADDR_NUM; addr++)
+	{
+		if (	((cycles_node[addr].flags & CN_INST) == 0) ||
+				((p_opcode = opcode_decode(Image[addr], NULL)) == NULL))
+		{
+			continue;
+		}
+
+		switch (p_opcode->flow)
+		{
+			/*	- Loop closing jump.  Notes: Only one loop bound
+			 *	  per header is used.
+			 *	------------------------------------------------ */
+			case OF_JUMP:
+			case OF_JUMP_COND:
+				target	= image_word(addr);
+
+				if (	((cycles_node[addr].flags & CN_LOOP) != 0) &&
+						(cycles_node[target].back < 0))
+				{
+					cycles_node[target].back	= addr;
+				}
+
+				break;
+
+			case OF_CALL:
+			case OF_CALL_COND:
+				cycles_node[image_word(addr)].flags	|= CN_ROUTINE;
+				break;
+
+			case OF_RST:
+				cycles_node[(uint8_t) Image[addr] & 0x38].flags	|= CN_ROUTINE;
+				break;
+
+			default:
+				break;
+		}
+	}
+
+	frame_id		= 0;
+	memo_num		= 0;
+	eval_depth	= 0;
+}
+
+
+/*	*************************************************************************
+ *	Function name:	label_name
+ *	Description:	Find the name of a label.
+ *	Author(s):
+ *	Created:			18 October 2026
+ *	Last modified:
+ *
+ *	Parameters:		int addr:
+ *							Label value.
+ *
+ *	Returns:			const char *:
+ *							- Label name.
+ *							- NULL if there is no label at this address.
+ *
+ *	Globals:			SYMBOL *Symbols
+ *	Notes:
+ *	************************************************************************* */
+
+static const char *label_name(int addr)
+{
+	SYMBOL	*local	= Symbols;
+
+	while ((local != NULL) && (local->next != NULL))
+	{
+		if ((local->Symbol_Type == SYMBOL_LABEL) && (local->Symbol_Value == addr))
+			return (local->Symbol_Name);
+
+		local	= (SYMBOL *) local->next;
+	}
+
+	return (NULL);
+}
+
+
+/*	*************************************************************************
+ *	Function name:	print_result
+ *	Description:	Print one line of the report.
+ *	Author(s):
+ *	Created:			18 October 2026
+ *	Last modified:
+ *
+ *	Parameters:		FILE *fp:
+ *							Report file.
+ *
+ *						const char *name:
+ *							Routine or labels.
+ *
+ *						const struct cycles_result_t *p_res:
+ *							Result.
+ *
+ *	Returns:			void
+ *	Globals:
+ *	Notes:			- Cycles are printed only if they are bounds.
+ *	************************************************************************* */
+
+static void print_result(FILE *fp, const char *name, const struct cycles_result_t *p_res)
+{
+	fprintf(fp, "%-31s ", name);
+
+	if (p_res->status <= CS_EXTERN)
+		fprintf(fp, "%9lld %9lld", p_res->best, p_res->worst);
+	else
+		fprintf(fp, "%9s %9s", "-", "-");
+
+	if (p_res->status != CS_OK)
+	{
+		fprintf(fp, "  ");
+		fprintf(fp, status_fmt[p_res->status], p_res->where);
+	}
+
+	fprintf(fp, "\n");
+}
+
+
+/*	*************************************************************************
+ *	Function name:	file_index
+ *	Description:	Get the index of the current source file name.
+ *	Author(s):
+ *	Created:			18 October 2026
+ *	Last modified:
+ *	Parameters:		void
+ *
+ *	Returns:			int:
+ *							Index in "file_name" (0 if unknown).
+ *
+ *	Globals:			char *in_fn[]
+ *						int file_level
+ *
+ *	Notes:			- Lines of include files are always assembled by the
+ *						  main thread (includes are layout barriers), so
+ *						  "file_name" is only changed by the main thread.
+ *	************************************************************************* */
+
+static int file_index(void)
+{
+	const char	*fn	= in_fn[file_level];
+	char			**p;
+	int			i;
+
+
+	if ((file_level == 0) || (fn == NULL))
+		return (0);
+
+	for (i = file_num - 1; i > 0; i--)
+	{
+		if (strcmp(file_name[i], fn) == 0)
+			return (i);
+	}
+
+	if (file_num >= file_size)
+	{
+		int	size	= (file_size > 0) ? file_size * 2 : 8;
+
+		if ((p = (char **) mem_realloc(MT_CYCLES, file_name, size * sizeof (char *))) == NULL)
+			return (0);
+
+		file_name	= p;
+		file_size	= size;
+	}
+
+	if ((file_name[file_num] = (char *) mem_alloc(MT_CYCLES, strlen(fn) + 1)) == NULL)
+		return (0);
+
+	strcpy(file_name[file_num], fn);
+
+	return (file_num++);
+}
+
+
+/*	*************************************************************************
+ *	Function name:	node_location
+ *	Description:	Format the source location of an opcode.
+ *	Author(s):
+ *	Created:			18 October 2026
+ *	Last modified:
+ *
+ *	Parameters:		int addr:
+ *							Opcode address.
+ *
+ *						char *buf:
+ *							Location text (CYCLES_FN_SIZE_MAX + 16 bytes).
+ *
+ *	Returns:			void
+ *	Globals:
+ *	Notes:
+ *	************************************************************************* */
+
+static void node_location(int addr, char *buf)
+{
+	int			file	= cycles_node[addr].file;
+	const char	*fn		= (file > 0) ? file_name[file] : in_fn[0];
+
+	sprintf(	buf, "\"%.*s\" @%d", CYCLES_FN_SIZE_MAX, (fn != NULL) ? fn : "",
+				cycles_node[addr].line);
+}
+
+
+/*	*************************************************************************
+ *	Function name:	latency_check
+ *	Description:	Check interrupts disabled regions ("--latency <max>").
+ *	Author(s):
+ *	Created:			18 October 2026
+ *	Last modified:
+ *	Parameters:		void
+ *	Returns:			void
+ *	Globals:			int cycles_errors
+ *
+ *	Notes:			- Errors are reported at the "DI" source line.
+ *	************************************************************************* */
+
+static void latency_check(void)
+{
+	const opcode_t				*p_opcode;
+	struct cycles_frame_t	frame;
+	struct cycles_result_t	res;
+	char							msg[160];
+	char							reason[64];
+	int							addr;
+	int							file;
+
+
+	cycles_prepare();
+
+	for (addr = 0; addr < CYCLES_ADDR_NUM; addr++)
+	{
+		if (	((cycles_node[addr].flags & CN_INST) == 0) ||
+				((p_opcode = opcode_decode(Image[addr], NULL)) == NULL) ||
+				(p_opcode->flow != OF_DI))
+		{
+			continue;
+		}
+
+		frame.stop		= -1;
+		frame.header	= -1;
+		frame.back		= -1;
+		frame.ei			= 1;
+		frame.parent	= NULL;
+
+		cycles_run(&frame, addr, &res);
+
+		if (res.status > CS_EXTERN)
+		{
+			sprintf(reason, status_fmt[res.status], res.where);
+			sprintf(msg, "Can't compute interrupt latency (%s)!", reason);
+		}
+		else if (res.worst > latency_max)
+		{
+			sprintf(	msg, "Interrupt latency too long (%lld cycles, maximum %ld)!",
+						res.worst, latency_max);
+		}
+		else
+			continue;
+
+		file	= cycles_node[addr].file;
+
+		msg_error_at(	msg, (res.status > CS_EXTERN) ? EC_CCC : EC_ILTL,
+							(file > 0) ? file_name[file] : in_fn[0], cycles_node[addr].line);
+
+		cycles_errors++;
+	}
+}
+
+
+/*	*************************************************************************
+ *	Function name:	latency_report
+ *	Description:	Print interrupts disabled regions ("--latency" option).
+ *	Author(s):
+ *	Created:			18 October 2026
+ *	Last modified:
+ *
+ *	Parameters:		FILE *fp:
+ *							Report file.
+ *
+ *	Returns:			void
+ *	Globals:			char Image[]
+ *
+ *	Notes:			- A region goes from a "DI" to the "EI" that follow
+ *						  (both included).  An interrupt is accepted only
+ *						  after the instruction that follow "EI", so the
+ *						  longest instruction is also reported.
+ *	************************************************************************* */
+
+static void latency_report(FILE *fp)
+{
+	struct cycles_frame_t	frame;
+	struct cycles_result_t	res;
+	const opcode_t				*p_opcode;
+	char							buf[CYCLES_FN_SIZE_MAX + 32];
+	char							loc[CYCLES_FN_SIZE_MAX + 16];
+	uint8_t						cyc[2];
+	int							longest	= -1;
+	int							longest_cyc	= 0;
+	int							addr;
+
+
+	fprintf(fp, "\n");
+	fprintf(fp, "%-31s %9s %9s  %s\n", "Interrupts disabled (DI..EI)", "Best", "Worst", "Notes");
+	fprintf(fp, "%-31s %9s %9s  %s\n", "----------------------------", "----", "-----", "-----");
+
+	cycles_prepare();
+
+	for (addr = 0; addr < CYCLES_ADDR_NUM; addr++)
+	{
+		if (	((cycles_node[addr].flags & CN_INST) == 0) ||
+				((p_opcode = opcode_decode(Image[addr], cyc)) == NULL))
+		{
+			continue;
+		}
+
+		if (cyc[1] > longest_cyc)
+		{
+			longest		= addr;
+			longest_cyc	= cyc[1];
+		}
+
+		if (p_opcode->flow != OF_DI)
+			continue;
+
+		frame.stop		= -1;
+		frame.header	= -1;
+		frame.back		= -1;
+		frame.ei			= 1;
+		frame.parent	= NULL;
+
+		cycles_run(&frame, addr, &res);
+
+		node_location(addr, loc);
+		sprintf(buf, "%04Xh %s", addr, loc);
+		print_result(fp, buf, &res);
+	}
+
+	if (longest >= 0)
+	{
+		node_location(longest, loc);
+
+		fprintf(	fp, "\nLongest instruction: %d cycles (%04Xh %s).\n",
+					longest_cyc, longest, loc);
+	}
+
+	if (latency_max > 0)
+		fprintf(fp, "Maximum interrupts disabled region: %ld cycles.\n", latency_max);
+}
+
+
+/*	*************************************************************************
+ *	Function name:	cycles_init
+ *	Description:	Initialize the module (allocate address nodes).
+ *	Author(s):
+ *	Created:			18 October 2026
+ *	Last modified:
+ *	Parameters:		void
+ *
+ *	Returns:			int:
+ *							-1	: Memory allocation error.
+ *							0	: Success.
+ *
+ *	Globals:			int cycles_enable
+ *	Notes:			- Can be called more than once.
+ *						- Called by "--cycles" option, and by "CYCLES"
+ *						  directive on assembler pass #1 (opcode addresses
+ *						  must be recorded on pass #2).
+ *	************************************************************************* */
+
+int cycles_init(void)
+{
+	int	addr;
+
+	if (cycles_node != NULL)
+		return (0);
+
+	cycles_node	= (struct cycles_node_t *)
+		mem_calloc(MT_CYCLES, CYCLES_ADDR_NUM, sizeof (struct cycles_node_t));
+
+	if (cycles_node == NULL)
+		return (-1);
+
+	for (addr = 0; addr < CYCLES_ADDR_NUM; addr++)
+	{
+		cycles_node[addr].back	= -1;
+		cycles_node[addr].memo	= -1;
+	}
+
+	cycles_enable	= 1;
+
+	return (0);
+}
+
+
+/*	*************************************************************************
+ *	Function name:	cycles_option
+ *	Description:	Add a "--cycles" option argument.
+ *	Author(s):
+ *	Created:			18 October 2026
+ *	Last modified:
+ *
+ *	Parameters:		const char *spec:
+ *							- "all": All routines (called addresses).
+ *							- "<label>": Routine at <label>.
+ *							- "<label1>,<label2>": From <label1> to <label2>.
+ *
+ *	Returns:			int:
+ *							-1	: Memory allocation error.
+ *							0	: Success.
+ *
+ *	Globals:
+ *	Notes:
+ *	************************************************************************* */
+
+int cycles_option(const char *spec)
+{
+	struct cycles_spec_t	*p_spec;
+
+	if (cycles_init() == -1)
+		return (-1);
+
+	p_spec	= (struct cycles_spec_t *) mem_alloc(MT_OPTIONS, sizeof (struct cycles_spec_t));
+
+	if (p_spec == NULL)
+		return (-1);
+
+	p_spec->text	= (char *) mem_alloc(MT_OPTIONS, strlen(spec) + 1);
+	p_spec->next	= NULL;
+
+	if (p_spec->text == NULL)
+	{
+		mem_free(p_spec);
+		return (-1);
+	}
+
+	strcpy(p_spec->text, spec);
+
+	if (spec_last != NULL)
+		spec_last->next	= p_spec;
+	else
+		spec_first			= p_spec;
+
+	spec_last	= p_spec;
+
+	return (0);
+}
+
+
+/*	*************************************************************************
+ *	Function name:	cycles_latency_option
+ *	Description:	Set the "--latency" option.
+ *	Author(s):
+ *	Created:			18 October 2026
+ *	Last modified:
+ *
+ *	Parameters:		long max:
+ *							- Maximum cycles of an interrupts disabled region.
+ *							- 0: Report only.
+ *
+ *	Returns:			int:
+ *							-1	: Memory allocation error.
+ *							0	: Success.
+ *
+ *	Globals:
+ *	Notes:
+ *	************************************************************************* */
+
+int cycles_latency_option(long max)
+{
+	if (cycles_init() == -1)
+		return (-1);
+
+	latency_max	= max;
+
+	return (0);
+}
+
+
+/*	*************************************************************************
+ *	Function name:	cycles_note
+ *	Description:	Record an opcode, and its loop bound annotation.
+ *	Author(s):
+ *	Created:			18 October 2026
+ *	Last modified:
+ *
+ *	Parameters:		int addr:
+ *							Opcode address.
+ *
+ *						const opcode_t *p_opcode:
+ *							"OpCodes[]" entry of the opcode.
+ *
+ *						const char *text:
+ *							Source line.
+ *
+ *	Returns:			void
+ *	Globals:
+ *	Notes:			- Called on assembler pass #2, possibly by assembler
+ *						  threads ("-j" option).  Each call only write the
+ *						  node of its own address.
+ *	************************************************************************* */
+
+void cycles_note(int addr, const opcode_t *p_opcode, const char *text)
+{
+	struct cycles_node_t	*p_node;
+	const char				*p_text	= text;
+	const char				*p_key;
+	char						*p_end;
+	long						min;
+	long						max;
+
+
+	if (cycles_node == NULL)
+		return;
+
+	p_node			= &cycles_node[addr & 0xFFFF];
+	p_node->flags	= (p_node->flags & ~CN_LOOP) | CN_INST;
+	p_node->line	= codeline[file_level];
+	p_node->file	= file_index();
+
+	/*	Search for "@LOOP" at the beginning of a comment.
+	 *	------------------------------------------------- */
+	while ((p_text = strchr(p_text, ';')) != NULL)
+	{
+		p_text++;
+
+		while (isspace((int) *p_text))
+			p_text++;
+
+		for (p_key = "@LOOP"; *p_key != '\0'; p_key++, p_text++)
+		{
+			if (toupper((int) *p_text) != *p_key)
+				break;
+		}
+
+		if (*p_key == '\0')
+			break;
+	}
+
+	if (p_text == NULL)
+		return;
+
+	if ((p_opcode->flow != OF_JUMP) && (p_opcode->flow != OF_JUMP_COND))
+	{
+		msg_warning("Loop bound on a non-jump instruction!", WC_LBNJ);
+		return;
+	}
+
+	/*	"<n>" or "<min>,<max>".
+	 *	----------------------- */
+	min	= strtol(p_text, &p_end, 10);
+	max	= min;
+
+	if ((p_end != p_text) && (*p_end == ','))
+	{
+		p_text	= p_end + 1;
+		max		= strtol(p_text, &p_end, 10);
+	}
+
+	while (isspace((int) *p_end))
+		p_end++;
+
+	if (	(p_end == p_text) || (*p_end != '\0') || (min < 1) || (max < min) ||
+			(max > CYCLES_LOOP_MAX))
+	{
+		msg_warning("Bad loop bound!", WC_BLB);
+		return;
+	}
+
+	p_node->loop_min	= (uint16_t) min;
+	p_node->loop_max	= (uint16_t) max;
+	p_node->flags		|= CN_LOOP;
+}
+
+
+/*	*************************************************************************
+ *	Function name:	cycles_source
+ *	Description:	Get the source location of an opcode.
+ *	Author(s):
+ *	Created:			18 October 2026
+ *	Last modified:
+ *
+ *	Parameters:		int addr:
+ *							Opcode address.
+ *
+ *						int *p_line:
+ *							Source line (filled).
+ *
+ *	Returns:			const char *:
+ *							- Source file name.
+ *							- NULL if no opcode was recorded at this address.
+ *
+ *	Globals:			char *in_fn[]
+ *	Notes:			- Must be called after assembler pass #2.
+ *	************************************************************************* */
+
+const char *cycles_source(int addr, int *p_line)
+{
+	const struct cycles_node_t	*p_node;
+
+	if (cycles_node == NULL)
+		return (NULL);
+
+	p_node	= &cycles_node[addr & 0xFFFF];
+
+	if ((p_node->flags & CN_INST) == 0)
+		return (NULL);
+
+	*p_line	= p_node->line;
+
+	return ((p_node->file > 0) ? file_name[p_node->file] : in_fn[0]);
+}
+
+
+/*	*************************************************************************
+ *	Function name:	cycles_budget
+ *	Description:	Record a "CYCLES" directive budget.
+ *	Author(s):
+ *	Created:			18 October 2026
+ *	Last modified:
+ *
+ *	Parameters:		int from:
+ *							Start address.
+ *
+ *						int to:
+ *							End address (not included).
+ *
+ *						long min, long max:
+ *							Budget, in cycles.
+ *
+ *	Returns:			int:
+ *							-1	: Memory allocation error.
+ *							0	: Success.
+ *
+ *	Globals:			char *in_fn[]
+ *						int codeline[]
+ *						int file_level
+ *
+ *	Notes:			- Source location is kept for the error message.
+ *	************************************************************************* */
+
+int cycles_budget(int from, int to, long min, long max)
+{
+	struct cycles_budget_t	*p_budget;
+	const char					*fn	= (in_fn[file_level] != NULL) ? in_fn[file_level] : "";
+
+
+	p_budget	= (struct cycles_budget_t *) mem_alloc(MT_CYCLES, sizeof (struct cycles_budget_t));
+
+	if (p_budget == NULL)
+		return (-1);
+
+	if ((p_budget->fn = (char *) mem_alloc(MT_CYCLES, strlen(fn) + 1)) == NULL)
+	{
+		mem_free(p_budget);
+		return (-1);
+	}
+
+	strcpy(p_budget->fn, fn);
+
+	p_budget->from		= from & 0xFFFF;
+	p_budget->to		= to & 0xFFFF;
+	p_budget->min		= min;
+	p_budget->max		= max;
+	p_budget->line		= codeline[file_level];
+	p_budget->next		= NULL;
+
+	if (budget_last != NULL)
+		budget_last->next	= p_budget;
+	else
+		budget_first		= p_budget;
+
+	budget_last	= p_budget;
+
+	return (0);
+}
+
+
+/*	*************************************************************************
+ *	Function name:	cycles_check
+ *	Description:	Check "CYCLES" directive budgets.
+ *	Author(s):
+ *	Created:			18 October 2026
+ *	Last modified:
+ *	Parameters:		void
+ *	Returns:			void
+ *	Globals:			int cycles_errors
+ *
+ *	Notes:			- Must be called at the end of assembler pass #2.
+ *						- Budgets are released once checked.
+ *						- Also check "--latency <max>" option.
+ *						- A budget is violated if the best case is lower
+ *						  than <min>, or the worst case is higher than
+ *						  <max>.
+ *	************************************************************************* */
+
+void cycles_check(void)
+{
+	struct cycles_budget_t	*p_budget;
+	struct cycles_result_t	res;
+	char							msg[160];
+	char							reason[64];
+
+
+	if (cycles_node == NULL)
+		return;
+
+	while ((p_budget = budget_first) != NULL)
+	{
+		cycles_between(p_budget->from, p_budget->to, &res);
+
+		if (res.status > CS_EXTERN)
+		{
+			sprintf(reason, status_fmt[res.status], res.where);
+
+			sprintf(	msg, "Can't compute cycles from %04Xh to %04Xh (%s)!",
+						p_budget->from, p_budget->to, reason);
+
+			msg_error_at(msg, EC_CCC, p_budget->fn, p_budget->line);
+			cycles_errors++;
+		}
+		else if ((res.best < p_budget->min) || (res.worst > p_budget->max))
+		{
+			sprintf(	msg, "Cycles budget violated (%lld..%lld, budget %ld..%ld)!",
+						res.best, res.worst, p_budget->min, p_budget->max);
+
+			msg_error_at(msg, EC_CBV, p_budget->fn, p_budget->line);
+			cycles_errors++;
+		}
+
+		budget_first	= p_budget->next;
+
+		mem_free(p_budget->fn);
+		mem_free(p_budget);
+	}
+
+	budget_last	= NULL;
+
+	if (latency_max > 0)
+		latency_check();
+}
+
+
+/*	*************************************************************************
+ *	Function name:	cycles_between
+ *	Description:	Analyze cycles between two addresses.
+ *	Author(s):
+ *	Created:			18 October 2026
+ *	Last modified:
+ *
+ *	Parameters:		int from:
+ *							Start address.
+ *
+ *						int to:
+ *							End address (not included).
+ *
+ *						struct cycles_result_t *p_result:
+ *							Result.
+ *
+ *	Returns:			void
+ *	Globals:
+ *	Notes:			- Must be called after assembler pass #2.
+ *	************************************************************************* */
+
+void cycles_between(int from, int to, struct cycles_result_t *p_result)
+{
+	struct cycles_frame_t	frame;
+
+	cycles_prepare();
+
+	frame.stop		= to & 0xFFFF;
+	frame.header	= -1;
+	frame.back		= -1;
+	frame.ei			= 0;
+	frame.parent	= NULL;
+
+	cycles_run(&frame, from & 0xFFFF, p_result);
+}
+
+
+/*	*************************************************************************
+ *	Function name:	cycles_routine
+ *	Description:	Analyze cycles of a routine (from entry to return).
+ *	Author(s):
+ *	Created:			18 October 2026
+ *	Last modified:
+ *
+ *	Parameters:		int addr:
+ *							Routine address.
+ *
+ *						struct cycles_result_t *p_result:
+ *							Result.
+ *
+ *	Returns:			void
+ *	Globals:
+ *	Notes:			- Must be called after assembler pass #2.
+ *	************************************************************************* */
+
+void cycles_routine(int addr, struct cycles_result_t *p_result)
+{
+	cycles_prepare();
+	cycles_call(addr & 0xFFFF, p_result);
+}
+
+
+/*	*************************************************************************
+ *	Function name:	cycles_report
+ *	Description:	Print the "--cycles" option report.
+ *	Author(s):
+ *	Created:			18 October 2026
+ *	Last modified:
+ *
+ *	Parameters:		FILE *fp:
+ *							Report file.
+ *
+ *	Returns:			void
+ *	Globals:
+ *	Notes:			- Unknown labels are also reported on "stderr".
+ *	************************************************************************* */
+
+void cycles_report(FILE *fp)
+{
+	struct cycles_spec_t		*p_spec;
+	struct cycles_result_t	res;
+	char							buf[LABEL_SIZE_MAX * 2 + 16];
+	const char					*p_name;
+	SYMBOL						*p_from;
+	SYMBOL						*p_to;
+	char							*p_comma;
+	int							addr;
+
+
+	if ((cycles_node == NULL) || ((spec_first == NULL) && (latency_max < 0)))
+		return;
+
+	fprintf(fp, "\n\n");
+	fprintf(fp, "*******************************************************************************\n");
+	fprintf(fp, "                                Cycles analysis\n");
+	fprintf(fp, "*******************************************************************************\n");
+
+	if (latency_max >= 0)
+		latency_report(fp);
+
+	if (spec_first != NULL)
+	{
+		fprintf(fp, "\n");
+		fprintf(fp, "%-31s %9s %9s  %s\n", "Routines / Labels", "Best", "Worst", "Notes");
+		fprintf(fp, "%-31s %9s %9s  %s\n", "-----------------", "----", "-----", "-----");
+	}
+
+	for (p_spec = spec_first; p_spec != NULL; p_spec = p_spec->next)
+	{
+		/*	All routines.
+		 *	------------- */
+		if (strcmp(p_spec->text, "all") == 0)
+		{
+			cycles_prepare();
+
+			for (addr = 0; addr < CYCLES_ADDR_NUM; addr++)
+			{
+				if ((cycles_node[addr].flags & (CN_ROUTINE | CN_INST)) != (CN_ROUTINE | CN_INST))
+					continue;
+
+				p_name	= label_name(addr);
+
+				sprintf(buf, "%.*s (%04Xh)", LABEL_SIZE_MAX, (p_name != NULL) ? p_name : "?", addr);
+				cycles_call(addr, &res);
+				print_result(fp, buf, &res);
+			}
+
+			continue;
+		}
+
+		/*	"<label>" or "<label1>,<label2>".
+		 *	--------------------------------- */
+		if (strlen(p_spec->text) >= sizeof (buf))
+			p_spec->text[sizeof (buf) - 1]	= '\0';
+
+		strcpy(buf, p_spec->text);
+
+		if ((p_comma = strchr(buf, ',')) != NULL)
+			*p_comma++	= '\0';
+
+		p_from	= FindLabel(buf);
+		p_to		= (p_comma != NULL) ? FindLabel(p_comma) : NULL;
+
+		if ((p_from == NULL) || ((p_comma != NULL) && (p_to == NULL)))
+		{
+			p_name	= (p_from == NULL) ? buf : p_comma;
+
+			fprintf(	stderr,
+				  		"*** Error %d: Unknown label in \"--cycles\" option (\"%s\")!\n",
+						EC_ULIC, p_name);
+
+			fprintf(fp, "%-31s Unknown label (\"%s\")\n", p_spec->text, p_name);
+			continue;
+		}
+
+		if (p_comma != NULL)
+		{
+			cycles_between(p_from->Symbol_Value, p_to->Symbol_Value, &res);
+			sprintf(buf, "%s .. %s", p_from->Symbol_Name, p_to->Symbol_Name);
+		}
+		else
+		{
+			cycles_routine(p_from->Symbol_Value, &res);
+			sprintf(buf, "%s (%04Xh)", p_from->Symbol_Name, p_from->Symbol_Value & 0xFFFF);
+		}
+
+		print_result(fp, buf, &res);
+	}
+}
+
+
+/*	*************************************************************************
+ *	Function name:	cycles_cleanup
+ *	Description:	Release module memory.
+ *	Author(s):
+ *	Created:			18 October 2026
+ *	Last modified:
+ *	Parameters:		void
+ *	Returns:			void
+ *	Globals:
+ *	Notes:
+ *	************************************************************************* */
+
+void cycles_cleanup(void)
+{
+	struct cycles_spec_t		*p_spec;
+	struct cycles_budget_t	*p_budget;
+
+	while ((p_spec = spec_first) != NULL)
+	{
+		spec_first	= p_spec->next;
+
+		mem_free(p_spec->text);
+		mem_free(p_spec);
+	}
+
+	spec_last	= NULL;
+
+	while ((p_budget = budget_first) != NULL)
+	{
+		budget_first	= p_budget->next;
+
+		mem_free(p_budget->fn);
+		mem_free(p_budget);
+	}
+
+	budget_last	= NULL;
+
+	while (file_num > 1)
+		mem_free(file_name[--file_num]);
+
+	mem_free(file_name);
+
+	file_name		= NULL;
+	file_size		= 0;
+	latency_max		= -1;
+
+	mem_free(cycles_memo);
+	mem_free(cycles_node);
+
+	cycles_memo		= NULL;
+	cycles_node		= NULL;
+	memo_num			= 0;
+	memo_size		= 0;
+	cycles_enable	= 0;
+}
+
+
+
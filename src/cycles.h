@@ -0,0 +1,109 @@
+/*	*************************************************************************
+ *	Module Name:	cycles.h
+ *	Description:	Static Cycles Analysis ("--cycles" option).
+ *	Copyright(c):	See below...
+ *	Author(s):
+ *	Created:			18 October 2026
+ *	Last modified:
+ *	Notes:
+ *	************************************************************************* */
+
+/*
+ * Copyright (c) <2007-2017> Jay Cotton <lbmgmusic@gmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+
+
+/*	*************************************************************************
+ *	************************************************************************* */
+
+#ifndef _CYCLES_H
+#define _CYCLES_H
+
+
+/*	*************************************************************************
+ *	                              INCLUDE FILES
+ *	************************************************************************* */
+
+#include "project.h"
+#include "opcode.h"
+
+
+/*	*************************************************************************
+ *	                                 TYPEDEF
+ *	************************************************************************* */
+
+/*	Analysis status (by increasing severity).
+ *	----------------------------------------- */
+enum cycles_status_t
+{
+	CS_OK,						/*	Best and worst cycles are exact bounds. */
+	CS_EXTERN,					/*	Call outside the program (not counted). */
+	CS_UNBOUNDED,				/*	Loop without bound annotation. */
+	CS_RETURN,					/*	Return with interrupts disabled. */
+	CS_RECURSION,				/*	Recursive call. */
+	CS_INDIRECT,				/*	Indirect jump ("PCHL"). */
+	CS_DATA,						/*	Reach something that is not an opcode. */
+	CS_DEEP,						/*	Too many branches nested (see "cycles.c"). */
+	CS_NOPATH					/*	No path to the end point. */
+};
+
+/*	Analysis result.
+ *	---------------- */
+struct cycles_result_t
+{
+	long long				best;			/*	Best case, in cycles. */
+	long long				worst;		/*	Worst case, in cycles. */
+	enum cycles_status_t	status;
+	int						where;		/*	Address of the problem, if any. */
+};
+
+
+/*	*************************************************************************
+ *	                                VARIABLES
+ *	************************************************************************* */
+
+extern int	cycles_enable;		/*	Opcode addresses are recorded. */
+extern int	cycles_errors;		/*	"CYCLES" directive budgets violated. */
+
+
+/*	*************************************************************************
+ *	                          FUNCTIONS DECLARATION
+ *	************************************************************************* */
+
+int cycles_init(void);
+int cycles_option(const char *spec);
+int cycles_latency_option(long max);
+void cycles_note(int addr, const opcode_t *p_opcode, const char *text);
+const char *cycles_source(int addr, int *p_line);
+int cycles_budget(int from, int to, long min, long max);
+void cycles_check(void);
+void cycles_between(int from, int to, struct cycles_result_t *p_result);
+void cycles_routine(int addr, struct cycles_result_t *p_result);
+void cycles_report(FILE *fp);
+void cycles_cleanup(void);
+
+
+
+#endif
+
+
+
@@ -0,0 +1,1283 @@
+/*	*************************************************************************
+ *	Module Name:	depth.c
+ *	Description:	Worst-Case Stack Depth Analysis ("--stack" option).
+ *	Copyright(c):	See below...
+ *	Author(s):
+ *	Created:			18 October 2026
+ *	Last modified:
+ *
+ *	Notes:			- Opcode addresses come from the cycles analysis
+ *						  ("cycles_source()").  After assembly, the code is
+ *						  followed from "Image[]" for each routine (target of
+ *						  "CALL" or "RST"), and the most bytes it uses on the
+ *						  stack ("PUSH", "POP", "INX SP", "DCX SP", and the
+ *						  routines it calls) is kept.  Routines are analyzed
+ *						  once.
+ *						- Depths are in bytes, below the stack pointer at
+ *						  routine entry (its return address not included).
+ *						- What can't be followed (indirect jump, "SPHL",
+ *						  recursive call) needs a bound, in the comment of
+ *						  the instruction: "; @STACK <n>".
+ *	************************************************************************* */
+
+/*
+ * Copyright (c) <2007-2017> Jay Cotton <lbmgmusic@gmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+
+/*	*************************************************************************
+ *	                              INCLUDE FILES
+ *	************************************************************************* */
+
+#include <stdio.h>
+#include <ctype.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "project.h"
+#include "err_code.h"		/*	Error Codes. */
+#include "war_code.h"		/*	Warning Codes. */
+#include "util.h"
+#include "main.h"
+#include "msg.h"
+#include "mem.h"
+#include "opcode.h"
+#include "cycles.h"
+#include "depth.h"
+
+
+/*	*************************************************************************
+ *											  CONSTANTS
+ *	************************************************************************* */
+
+#define DEPTH_ADDR_NUM			0x10000		/*	Number of addresses. */
+#define DEPTH_WORK_SIZE_MIN	256			/*	Work entries, first allocation. */
+#define DEPTH_BOUND_MAX			0xFFFF		/*	Maximum "@STACK" bound. */
+#define DEPTH_FN_SIZE_MAX		128			/*	File name size, in reports. */
+#define DEPTH_VECTOR_NUM		8				/*	Restart (interrupt) vectors. */
+
+/*	Node flags.
+ *	----------- */
+#define DN_BOUND					0x01			/*	"@STACK" bound. */
+#define DN_REACHED				0x02			/*	Reached from another opcode. */
+#define DN_FALL					0x04			/*	Reached from the opcode before. */
+#define DN_ROUTINE				0x08			/*	Called. */
+#define DN_SITE					0x10			/*	Needs a bound. */
+
+/*	Routine analysis state.
+ *	----------------------- */
+#define RT_NONE					0
+#define RT_BUSY					1
+#define RT_DONE					2
+
+/*	Opcodes.
+ *	-------- */
+#define OP_LXI_SP					0x31
+#define OP_INX_SP					0x33
+#define OP_DCX_SP					0x3B
+#define OP_SPHL					0xF9
+#define OP_PUSH_MASK				0xCF		/*	"PUSH" / "POP", register pair field. */
+#define OP_PUSH					0xC5
+#define OP_POP						0xC1
+
+
+/*	*************************************************************************
+ *	                                 TYPEDEF
+ *	************************************************************************* */
+
+/*	Analysis status (by increasing severity).
+ *	----------------------------------------- */
+enum depth_status_t
+{
+	DS_OK,						/*	Depth is an exact bound. */
+	DS_EXTERN,					/*	Call outside the program (return address only). */
+	DS_RETURN,					/*	Return with bytes left on the stack. */
+	DS_LOOP,						/*	Loop that changes the stack. */
+	DS_SPHL,						/*	Stack pointer loaded from "HL". */
+	DS_RECURSION,				/*	Recursive call. */
+	DS_INDIRECT,				/*	Indirect jump ("PCHL"). */
+	DS_DATA,						/*	Reach something that is not an opcode. */
+	DS_MEMORY					/*	Memory allocation error. */
+};
+
+/*	Analysis result.
+ *	---------------- */
+struct depth_result_t
+{
+	int						worst;		/*	Worst case, in bytes. */
+	enum depth_status_t	status;
+	int						where;		/*	Address of the problem, if any. */
+};
+
+/*	One node per address.
+ *	--------------------- */
+struct depth_node_t
+{
+	uint8_t					flags;		/*	See "DN_x". */
+	uint8_t					rt_state;	/*	See "RT_x". */
+	uint16_t					bound;		/*	"@STACK" bound (with "DN_BOUND"). */
+	int						mark;			/*	Walk that last reached this address. */
+	int						depth;		/*	Depth there, in this walk. */
+	struct depth_result_t	rt;			/*	Routine result. */
+};
+
+/*	Path still to follow.
+ *	--------------------- */
+struct depth_work_t
+{
+	int	addr;
+	int	depth;
+};
+
+
+/*	*************************************************************************
+ *	                                  CONST
+ *	************************************************************************* */
+
+/*	- Problem description, by status (with the problem address).
+ *	  Notes: Must match "enum depth_status_t".
+ *	------------------------------------------------------------ */
+static const char	*status_fmt[] =
+{
+	"",
+	"Call to %04Xh counted as return address only",
+	"Stack not balanced at return %04Xh",
+	"Loop changes the stack at %04Xh",
+	"Stack pointer loaded from HL at %04Xh",
+	"Recursive call at %04Xh",
+	"Indirect jump at %04Xh",
+	"Not an opcode at %04Xh",
+	"Can't allocate memory at %04Xh"
+};
+
+
+/*	*************************************************************************
+ *	                                VARIABLES
+ *	************************************************************************* */
+
+/*	Public variables.
+ *	***************** */
+
+int	depth_enable	= 0;		/*	"--stack" option. */
+
+
+/*	Private variables.
+ *	****************** */
+
+static char						*depth_spec		= NULL;		/*	"all", or labels. */
+static struct depth_node_t	*depth_node		= NULL;
+
+static struct depth_work_t	*depth_work		= NULL;
+static int						work_num			= 0;
+static int						work_size		= 0;
+
+static int						walk_id			= 0;
+
+
+/*	*************************************************************************
+ *									  FUNCTIONS DECLARATION
+ *	************************************************************************* */
+
+static void res_set(struct depth_result_t *p_res, int worst, enum depth_status_t status, int where);
+static void res_merge(struct depth_result_t *p_res, enum depth_status_t status, int where);
+static int image_word(int addr);
+static int is_inst(int addr);
+static int work_push(int addr, int depth);
+static int call_use(int site, int target, struct depth_result_t *p_res);
+static int step(int id, int addr, int *p_depth, struct depth_result_t *p_res);
+static void walk(int entry, struct depth_result_t *p_res);
+static void routine(int addr);
+static void prepare(void);
+static const char *label_name(int addr);
+static void location(int addr, char *buf);
+static void print_result(FILE *fp, const char *name, const struct depth_result_t *p_res);
+static void print_entry(FILE *fp, int addr, struct depth_result_t *p_res);
+static void print_sites(FILE *fp);
+
+
+/*	*************************************************************************
+ *	                                FUNCTIONS
+ *	************************************************************************* */
+
+/*	*************************************************************************
+ *	Function name:	res_set
+ *	Description:	Set a result.
+ *	Author(s):
+ *	Created:			18 October 2026
+ *	Last modified:
+ *
+ *	Parameters:		struct depth_result_t *p_res:
+ *							Result.
+ *
+ *						int worst:
+ *							Worst case, in bytes.
+ *
+ *						enum depth_status_t status:
+ *							Status.
+ *
+ *						int where:
+ *							Address of the problem.
+ *
+ *	Returns:			void
+ *	Globals:
+ *	Notes:
+ *	************************************************************************* */
+
+static void res_set(struct depth_result_t *p_res, int worst, enum depth_status_t status, int where)
+{
+	p_res->worst	= worst;
+	p_res->status	= status;
+	p_res->where	= where;
+}
+
+
+/*	*************************************************************************
+ *	Function name:	res_merge
+ *	Description:	Add a problem to a result.
+ *	Author(s):
+ *	Created:			18 October 2026
+ *	Last modified:
+ *
+ *	Parameters:		struct depth_result_t *p_res:
+ *							Result.
+ *
+ *						enum depth_status_t status:
+ *							Status.
+ *
+ *						int where:
+ *							Address of the problem.
+ *
+ *	Returns:			void
+ *	Globals:
+ *	Notes:			- The most severe problem is kept.
+ *	************************************************************************* */
+
+static void res_merge(struct depth_result_t *p_res, enum depth_status_t status, int where)
+{
+	if (status > p_res->status)
+	{
+		p_res->status	= status;
+		p_res->where	= where;
+	}
+}
+
+
+/*	*************************************************************************
+ *	Function name:	image_word
+ *	Description:	Read the 16-bit operand of an instruction.
+ *	Author(s):
+ *	Created:			18 October 2026
+ *	Last modified:
+ *
+ *	Parameters:		int addr:
+ *							Instruction address.
+ *
+ *	Returns:			int:
+ *							Operand.
+ *
+ *	Globals:			char Image[]
+ *	Notes:
+ *	************************************************************************* */
+
+static int image_word(int addr)
+{
+	return (	(uint8_t) Image[(addr + 1) & 0xFFFF] |
+				((uint8_t) Image[(addr + 2) & 0xFFFF] << 8));
+}
+
+
+/*	*************************************************************************
+ *	Function name:	is_inst
+ *	Description:	Tell if an opcode was assembled at an address.
+ *	Author(s):
+ *	Created:			18 October 2026
+ *	Last modified:
+ *
+ *	Parameters:		int addr:
+ *							Address.
+ *
+ *	Returns:			int:
+ *							0: Data, or nothing.
+ *							1: Opcode.
+ *
+ *	Globals:			char Image[]
+ *	Notes:
+ *	************************************************************************* */
+
+static int is_inst(int addr)
+{
+	int	line;
+
+	return (	(cycles_source(addr, &line) != NULL) &&
+				(opcode_decode(Image[addr], NULL) != NULL));
+}
+
+
+/*	*************************************************************************
+ *	Function name:	work_push
+ *	Description:	Add a path to follow.
+ *	Author(s):
+ *	Created:			18 October 2026
+ *	Last modified:
+ *
+ *	Parameters:		int addr:
+ *							Path start address.
+ *
+ *						int depth:
+ *							Depth at this address.
+ *
+ *	Returns:			int:
+ *							-1	: Memory allocation error.
+ *							0	: Success.
+ *
+ *	Globals:
+ *	Notes:
+ *	************************************************************************* */
+
+static int work_push(int addr, int depth)
+{
+	if (work_num >= work_size)
+	{
+		int						size	= (work_size > 0) ? work_size * 2 : DEPTH_WORK_SIZE_MIN;
+		struct depth_work_t	*p		= (struct depth_work_t *)
+			mem_realloc(MT_DEPTH, depth_work, size * sizeof (struct depth_work_t));
+
+		if (p == NULL)
+			return (-1);
+
+		depth_work	= p;
+		work_size	= size;
+	}
+
+	depth_work[work_num].addr		= addr;
+	depth_work[work_num].depth		= depth;
+	work_num++;
+
+	return (0);
+}
+
+
+/*	*************************************************************************
+ *	Function name:	call_use
+ *	Description:	Get the stack bytes used by a call.
+ *	Author(s):
+ *	Created:			18 October 2026
+ *	Last modified:
+ *
+ *	Parameters:		int site:
+ *							Call address.
+ *
+ *						int target:
+ *							Routine address.
+ *
+ *						struct depth_result_t *p_res:
+ *							Routine result (filled).
+ *
+ *	Returns:			int:
+ *							Bytes, return address included.
+ *
+ *	Globals:
+ *	Notes:			- A "@STACK" bound replace the analysis.
+ *	************************************************************************* */
+
+static int call_use(int site, int target, struct depth_result_t *p_res)
+{
+	struct depth_node_t	*p_node	= &depth_node[target];
+
+	res_set(p_res, 0, DS_OK, 0);
+
+	if ((depth_node[site].flags & DN_BOUND) != 0)
+		return (depth_node[site].bound);
+
+	if (is_inst(target) == 0)
+	{
+		res_set(p_res, 0, DS_EXTERN, target);
+		return (2);
+	}
+
+	if (p_node->rt_state == RT_BUSY)
+	{
+		res_set(p_res, 0, DS_RECURSION, site);
+		depth_node[site].flags	|= DN_SITE;
+
+		return (2);
+	}
+
+	if (p_node->rt_state == RT_NONE)
+		routine(target);
+
+	*p_res	= p_node->rt;
+
+	return (2 + p_res->worst);
+}
+
+
+/*	*************************************************************************
+ *	Function name:	step
+ *	Description:	Follow one instruction.
+ *	Author(s):
+ *	Created:			18 October 2026
+ *	Last modified:
+ *
+ *	Parameters:		int id:
+ *							Walk ID.
+ *
+ *						int addr:
+ *							Instruction address.
+ *
+ *						int *p_depth:
+ *							Depth before the instruction (updated).
+ *
+ *						struct depth_result_t *p_res:
+ *							Walk result (updated).
+ *
+ *	Returns:			int:
+ *							- Next address.
+ *							- -1 at the end of the path.
+ *
+ *	Globals:			char Image[]
+ *	Notes:			- Branches are added to the paths to follow.
+ *	************************************************************************* */
+
+static int step(int id, int addr, int *p_depth, struct depth_result_t *p_res)
+{
+	struct depth_node_t		*p_node	= &depth_node[addr];
+	struct depth_result_t	res;
+	const opcode_t				*p_opcode;
+	int							byte		= (uint8_t) Image[addr];
+	int							next;
+	int							use;
+
+
+	/*	Already reached in this walk.
+	 *	----------------------------- */
+	if (p_node->mark == id)
+	{
+		if (p_node->depth != *p_depth)
+			res_merge(p_res, DS_LOOP, addr);
+
+		return (-1);
+	}
+
+	p_node->mark	= id;
+	p_node->depth	= *p_depth;
+
+	if (*p_depth > p_res->worst)
+		p_res->worst	= *p_depth;
+
+	if (is_inst(addr) == 0)
+	{
+		res_merge(p_res, DS_DATA, addr);
+		return (-1);
+	}
+
+	p_opcode	= opcode_decode(byte, NULL);
+	next		= (addr + p_opcode->size) & 0xFFFF;
+
+	switch (p_opcode->flow)
+	{
+		case OF_JUMP:
+			return (image_word(addr));
+
+		case OF_JUMP_COND:
+			if (work_push(image_word(addr), *p_depth) == -1)
+				res_merge(p_res, DS_MEMORY, addr);
+
+			return (next);
+
+		case OF_CALL:
+		case OF_CALL_COND:
+		case OF_RST:
+			use	= call_use(	addr, (p_opcode->flow == OF_RST) ?
+				  					(byte & 0x38) : image_word(addr), &res);
+
+			if (*p_depth + use > p_res->worst)
+				p_res->worst	= *p_depth + use;
+
+			res_merge(p_res, res.status, res.where);
+
+			return (next);
+
+		case OF_RET:
+		case OF_RET_COND:
+			if (*p_depth != 0)
+				res_merge(p_res, DS_RETURN, addr);
+
+			return ((p_opcode->flow == OF_RET) ? -1 : next);
+
+		case OF_PCHL:
+			if ((p_node->flags & DN_BOUND) == 0)
+			{
+				res_merge(p_res, DS_INDIRECT, addr);
+				p_node->flags	|= DN_SITE;
+			}
+			else if (*p_depth + p_node->bound > p_res->worst)
+				p_res->worst	= *p_depth + p_node->bound;
+
+			return (-1);
+
+		case OF_HLT:
+			return (-1);
+
+		default:
+			break;
+	}
+
+	/*	Stack pointer changes.
+	 *	---------------------- */
+	if ((byte & OP_PUSH_MASK) == OP_PUSH)
+		*p_depth	+= 2;
+	else if ((byte & OP_PUSH_MASK) == OP_POP)
+		*p_depth	-= 2;
+	else if (byte == OP_DCX_SP)
+		*p_depth	+= 1;
+	else if (byte == OP_INX_SP)
+		*p_depth	-= 1;
+	else if (byte == OP_LXI_SP)
+		*p_depth	= 0;							/*	New stack. */
+	else if (byte == OP_SPHL)
+	{
+		if ((p_node->flags & DN_BOUND) == 0)
+		{
+			res_merge(p_res, DS_SPHL, addr);
+			p_node->flags	|= DN_SITE;
+
+			return (-1);
+		}
+
+		*p_depth	= p_node->bound;
+	}
+
+	if (*p_depth > p_res->worst)
+		p_res->worst	= *p_depth;
+
+	return (next);
+}
+
+
+/*	*************************************************************************
+ *	Function name:	walk
+ *	Description:	Follow all paths from an address.
+ *	Author(s):
+ *	Created:			18 October 2026
+ *	Last modified:
+ *
+ *	Parameters:		int entry:
+ *							Start address (depth 0).
+ *
+ *						struct depth_result_t *p_res:
+ *							Result.
+ *
+ *	Returns:			void
+ *	Globals:
+ *
+ *	Notes:			- Paths of a walk are on top of the work stack, so
+ *						  a walk can start another one (called routine).
+ *						- A called routine may mark addresses of its
+ *						  caller again.  They are then followed once more.
+ *	************************************************************************* */
+
+static void walk(int entry, struct depth_result_t *p_res)
+{
+	int	base	= work_num;
+	int	id		= ++walk_id;
+	int	addr;
+	int	depth;
+
+
+	res_set(p_res, 0, DS_OK, 0);
+
+	if (work_push(entry, 0) == -1)
+	{
+		res_merge(p_res, DS_MEMORY, entry);
+		return;
+	}
+
+	while (work_num > base)
+	{
+		work_num--;
+		addr	= depth_work[work_num].addr;
+		depth	= depth_work[work_num].depth;
+
+		do
+			addr	= step(id, addr, &depth, p_res);
+		while (addr >= 0);
+	}
+}
+
+
+/*	*************************************************************************
+ *	Function name:	routine
+ *	Description:	Analyze a routine (from its entry to its returns).
+ *	Author(s):
+ *	Created:			18 October 2026
+ *	Last modified:
+ *
+ *	Parameters:		int addr:
+ *							Routine address.
+ *
+ *	Returns:			void
+ *	Globals:
+ *	Notes:			- Result is kept in the routine node.
+ *	************************************************************************* */
+
+static void routine(int addr)
+{
+	struct depth_node_t		*p_node	= &depth_node[addr];
+	struct depth_result_t	res;
+
+	p_node->rt_state	= RT_BUSY;
+
+	walk(addr, &res);
+
+	p_node->rt			= res;
+	p_node->rt_state	= RT_DONE;
+}
+
+
+/*	*************************************************************************
+ *	Function name:	prepare
+ *	Description:	Prepare the analysis (routines, entry points).
+ *	Author(s):
+ *	Created:			18 October 2026
+ *	Last modified:
+ *	Parameters:		void
+ *	Returns:			void
+ *	Globals:			char Image[]
+ *	Notes:
+ *	************************************************************************* */
+
+static void prepare(void)
+{
+	const opcode_t	*p_opcode;
+	int				addr;
+	int				next;
+	int				target;
+
+
+	for (addr = 0; addr < DEPTH_ADDR_NUM; addr++)
+	{
+		depth_node[addr].flags		&= DN_BOUND;
+		depth_node[addr].rt_state	= RT_NONE;
+		depth_node[addr].mark		= 0;
+	}
+
+	for (addr = 0; addr < DEPTH_ADDR_NUM; addr++)
+	{
+		if (is_inst(addr) == 0)
+			continue;
+
+		p_opcode	= opcode_decode(Image[addr], NULL);
+		next		= (addr + p_opcode->size) & 0xFFFF;
+		target	= image_word(addr);
+
+		switch (p_opcode->flow)
+		{
+			case OF_JUMP:
+				depth_node[target].flags	|= DN_REACHED;
+				break;
+
+			case OF_JUMP_COND:
+				depth_node[target].flags	|= DN_REACHED;
+				depth_node[next].flags		|= DN_REACHED | DN_FALL;
+				break;
+
+			case OF_CALL:
+			case OF_CALL_COND:
+				depth_node[target].flags	|= DN_REACHED | DN_ROUTINE;
+				depth_node[next].flags		|= DN_REACHED | DN_FALL;
+				break;
+
+			case OF_RST:
+				target	= (uint8_t) Image[addr] & 0x38;
+
+				depth_node[target].flags	|= DN_REACHED | DN_ROUTINE;
+				depth_node[next].flags		|= DN_REACHED | DN_FALL;
+				break;
+
+			case OF_RET:
+			case OF_PCHL:
+			case OF_HLT:
+				break;
+
+			default:
+				depth_node[next].flags		|= DN_REACHED | DN_FALL;
+				break;
+		}
+	}
+
+	walk_id	= 0;
+	work_num	= 0;
+}
+
+
+/*	*************************************************************************
+ *	Function name:	label_name
+ *	Description:	Find the name of a label.
+ *	Author(s):
+ *	Created:			18 October 2026
+ *	Last modified:
+ *
+ *	Parameters:		int addr:
+ *							Label value.
+ *
+ *	Returns:			const char *:
+ *							- Label name.
+ *							- NULL if there is no label at this address.
+ *
+ *	Globals:			SYMBOL *Symbols
+ *	Notes:
+ *	************************************************************************* */
+
+static const char *label_name(int addr)
+{
+	SYMBOL	*local	= Symbols;
+
+	while ((local != NULL) && (local->next != NULL))
+	{
+		if ((local->Symbol_Type == SYMBOL_LABEL) && (local->Symbol_Value == addr))
+			return (local->Symbol_Name);
+
+		local	= (SYMBOL *) local->next;
+	}
+
+	return (NULL);
+}
+
+
+/*	*************************************************************************
+ *	Function name:	location
+ *	Description:	Format the source location of an opcode.
+ *	Author(s):
+ *	Created:			18 October 2026
+ *	Last modified:
+ *
+ *	Parameters:		int addr:
+ *							Opcode address.
+ *
+ *						char *buf:
+ *							Location text (DEPTH_FN_SIZE_MAX + 16 bytes).
+ *
+ *	Returns:			void
+ *	Globals:
+ *	Notes:
+ *	************************************************************************* */
+
+static void location(int addr, char *buf)
+{
+	int			line	= 0;
+	const char	*fn	= cycles_source(addr, &line);
+
+	sprintf(buf, "\"%.*s\" @%d", DEPTH_FN_SIZE_MAX, (fn != NULL) ? fn : "", line);
+}
+
+
+/*	*************************************************************************
+ *	Function name:	print_result
+ *	Description:	Print one line of the report.
+ *	Author(s):
+ *	Created:			18 October 2026
+ *	Last modified:
+ *
+ *	Parameters:		FILE *fp:
+ *							Report file.
+ *
+ *						const char *name:
+ *							Entry point or routine.
+ *
+ *						const struct depth_result_t *p_res:
+ *							Result.
+ *
+ *	Returns:			void
+ *	Globals:
+ *	Notes:			- Depth is printed only if it is a bound.
+ *	************************************************************************* */
+
+static void print_result(FILE *fp, const char *name, const struct depth_result_t *p_res)
+{
+	fprintf(fp, "%-31s ", name);
+
+	if (p_res->status <= DS_RETURN)
+		fprintf(fp, "%9d", p_res->worst);
+	else
+		fprintf(fp, "%9s", "-");
+
+	if (p_res->status != DS_OK)
+	{
+		fprintf(fp, "  ");
+		fprintf(fp, status_fmt[p_res->status], p_res->where);
+	}
+
+	fprintf(fp, "\n");
+}
+
+
+/*	*************************************************************************
+ *	Function name:	print_entry
+ *	Description:	Analyze and print an entry point.
+ *	Author(s):
+ *	Created:			18 October 2026
+ *	Last modified:
+ *
+ *	Parameters:		FILE *fp:
+ *							Report file.
+ *
+ *						int addr:
+ *							Entry point address.
+ *
+ *						struct depth_result_t *p_res:
+ *							Result (filled).
+ *
+ *	Returns:			void
+ *	Globals:
+ *	Notes:			- Restart vectors are named "RST <n>".
+ *	************************************************************************* */
+
+static void print_entry(FILE *fp, int addr, struct depth_result_t *p_res)
+{
+	char			buf[LABEL_SIZE_MAX + 32];
+	const char	*p_name	= label_name(addr);
+
+
+	if (((addr & 0x38) == addr) && ((depth_node[addr].flags & DN_FALL) == 0))
+	{
+		if (p_name != NULL)
+			sprintf(buf, "RST %d %.*s (%04Xh)", addr >> 3, LABEL_SIZE_MAX, p_name, addr);
+		else
+			sprintf(buf, "RST %d (%04Xh)", addr >> 3, addr);
+	}
+	else
+		sprintf(buf, "%.*s (%04Xh)", LABEL_SIZE_MAX, (p_name != NULL) ? p_name : "?", addr);
+
+	/*	A routine is analyzed once.
+	 *	--------------------------- */
+	if (depth_node[addr].rt_state == RT_NONE)
+		routine(addr);
+
+	*p_res	= depth_node[addr].rt;
+
+	print_result(fp, buf, p_res);
+}
+
+
+/*	*************************************************************************
+ *	Function name:	print_sites
+ *	Description:	Print the instructions that need a "@STACK" bound.
+ *	Author(s):
+ *	Created:			18 October 2026
+ *	Last modified:
+ *
+ *	Parameters:		FILE *fp:
+ *							Report file.
+ *
+ *	Returns:			void
+ *	Globals:			char Image[]
+ *	Notes:
+ *	************************************************************************* */
+
+static void print_sites(FILE *fp)
+{
+	char			loc[DEPTH_FN_SIZE_MAX + 16];
+	const char	*p_name;
+	int			byte;
+	int			target;
+	int			addr;
+	int			num		= 0;
+
+
+	for (addr = 0; addr < DEPTH_ADDR_NUM; addr++)
+	{
+		if ((depth_node[addr].flags & DN_SITE) == 0)
+			continue;
+
+		if (num++ == 0)
+			fprintf(fp, "\nNeeds a bound (\"; @STACK <n>\" comment):\n");
+
+		location(addr, loc);
+		fprintf(fp, "  %04Xh %s: ", addr, loc);
+
+		byte	= (uint8_t) Image[addr];
+
+		if (opcode_decode(byte, NULL)->flow == OF_PCHL)
+			fprintf(fp, "Indirect jump (\"PCHL\").\n");
+		else if (byte == OP_SPHL)
+			fprintf(fp, "Stack pointer loaded from HL (\"SPHL\").\n");
+		else
+		{
+			target	= (opcode_decode(byte, NULL)->flow == OF_RST) ?
+						  (byte & 0x38) : image_word(addr);
+			p_name	= label_name(target);
+
+			fprintf(	fp, "Call graph cycle, call to %.*s (%04Xh).\n", LABEL_SIZE_MAX,
+						(p_name != NULL) ? p_name : "?", target);
+		}
+	}
+}
+
+
+/*	*************************************************************************
+ *	Function name:	depth_option
+ *	Description:	Set the "--stack" option entry points.
+ *	Author(s):
+ *	Created:			18 October 2026
+ *	Last modified:
+ *
+ *	Parameters:		const char *spec:
+ *							"all", or labels ("<label1>,<label2>,...").
+ *
+ *	Returns:			int:
+ *							-1	: Memory allocation error.
+ *							0	: Success.
+ *
+ *	Globals:			int depth_enable
+ *
+ *	Notes:			- Labels are looked up after assembly.
+ *						- Opcode addresses come from the cycles analysis,
+ *						  so it is enabled.
+ *	************************************************************************* */
+
+int depth_option(const char *spec)
+{
+	if (cycles_init() == -1)
+		return (-1);
+
+	if (depth_node == NULL)
+	{
+		depth_node	= (struct depth_node_t *)
+			mem_calloc(MT_DEPTH, DEPTH_ADDR_NUM, sizeof (struct depth_node_t));
+
+		if (depth_node == NULL)
+			return (-1);
+	}
+
+	mem_free(depth_spec);
+
+	if ((depth_spec = (char *) mem_alloc(MT_OPTIONS, strlen(spec) + 1)) == NULL)
+		return (-1);
+
+	strcpy(depth_spec, spec);
+
+	/*	Decoding tables must not be built by assembler threads.
+	 *	------------------------------------------------------- */
+	opcode_decode(0, NULL);
+
+	depth_enable	= 1;
+
+	return (0);
+}
+
+
+/*	*************************************************************************
+ *	Function name:	depth_note
+ *	Description:	Record a "@STACK" bound (assembler pass #2).
+ *	Author(s):
+ *	Created:			18 October 2026
+ *	Last modified:
+ *
+ *	Parameters:		int addr:
+ *							Opcode address.
+ *
+ *						const opcode_t *p_opcode:
+ *							Opcode.
+ *
+ *						const char *text:
+ *							Source line (for the "@STACK" bound).
+ *
+ *	Returns:			void
+ *	Globals:
+ *
+ *	Notes:			- "; @STACK <n>" is the number of bytes used below the
+ *						  stack pointer by a call (return address included),
+ *						  or by the targets of an indirect jump.  After
+ *						  "SPHL", it is the depth of the new stack pointer.
+ *	************************************************************************* */
+
+void depth_note(int addr, const opcode_t *p_opcode, const char *text)
+{
+	struct depth_node_t	*p_node;
+	const char				*p_text	= text;
+	const char				*p_key;
+	char						*p_end;
+	long						bound;
+
+
+	if (depth_node == NULL)
+		return;
+
+	p_node			= &depth_node[addr & 0xFFFF];
+	p_node->flags	&= ~DN_BOUND;
+
+	/*	Search for "@STACK" at the beginning of a comment.
+	 *	-------------------------------------------------- */
+	while ((p_text = strchr(p_text, ';')) != NULL)
+	{
+		p_text++;
+
+		while (isspace((int) *p_text))
+			p_text++;
+
+		for (p_key = "@STACK"; *p_key != '\0'; p_key++, p_text++)
+		{
+			if (toupper((int) *p_text) != *p_key)
+				break;
+		}
+
+		if (*p_key == '\0')
+			break;
+	}
+
+	if (p_text == NULL)
+		return;
+
+	switch (p_opcode->flow)
+	{
+		case OF_CALL:
+		case OF_CALL_COND:
+		case OF_RST:
+		case OF_PCHL:
+			break;
+
+		default:
+			if (p_opcode->base != OP_SPHL)
+			{
+				msg_warning("Stack bound on an instruction that does not need one!", WC_SBNN);
+				return;
+			}
+
+			break;
+	}
+
+	bound	= strtol(p_text, &p_end, 10);
+
+	while (isspace((int) *p_end))
+		p_end++;
+
+	if ((p_end == p_text) || (*p_end != '\0') || (bound < 0) || (bound > DEPTH_BOUND_MAX))
+	{
+		msg_warning("Bad stack bound!", WC_BSB);
+		return;
+	}
+
+	p_node->bound	= (uint16_t) bound;
+	p_node->flags	|= DN_BOUND;
+}
+
+
+/*	*************************************************************************
+ *	Function name:	depth_report
+ *	Description:	Print the "--stack" option report.
+ *	Author(s):
+ *	Created:			18 October 2026
+ *	Last modified:
+ *
+ *	Parameters:		FILE *fp:
+ *							Report file.
+ *
+ *	Returns:			void
+ *	Globals:
+ *
+ *	Notes:			- Must be called after assembler pass #2.
+ *						- Entry points are the restart vectors with code
+ *						  (not reached from the opcode before), and the
+ *						  labels of the option, or all opcodes not reached
+ *						  from others ("all").
+ *						- Unknown labels are also reported on "stderr".
+ *	************************************************************************* */
+
+void depth_report(FILE *fp)
+{
+	struct depth_result_t	res;
+	char							*p_name;
+	char							*p_next;
+	char							*p_end;
+	SYMBOL						*p_symbol;
+	int							base			= -1;		/*	Worst entry point. */
+	int							intr			= -1;		/*	Worst interrupt. */
+	int							base_ok		= 1;
+	int							intr_ok		= 1;
+	int							addr;
+	int							v;
+
+
+	if ((depth_enable == 0) || (depth_node == NULL))
+		return;
+
+	prepare();
+
+	fprintf(fp, "\n\n");
+	fprintf(fp, "*******************************************************************************\n");
+	fprintf(fp, "                            Stack depth analysis\n");
+	fprintf(fp, "*******************************************************************************\n");
+	fprintf(fp, "\n");
+	fprintf(fp, "%-31s %9s  %s\n", "Entry points", "Bytes", "Notes");
+	fprintf(fp, "%-31s %9s  %s\n", "------------", "-----", "-----");
+
+	/*	Restart vectors.  Vector 0 is the reset entry point.
+	 *	---------------------------------------------------- */
+	for (v = 0; v < DEPTH_VECTOR_NUM; v++)
+	{
+		addr	= v * 8;
+
+		if (	(is_inst(addr) == 0) ||
+				((v > 0) && ((depth_node[addr].flags & DN_FALL) != 0)))
+		{
+			continue;
+		}
+
+		print_entry(fp, addr, &res);
+
+		if (v == 0)
+		{
+			base		= res.worst;
+			base_ok	= (res.status <= DS_RETURN);
+		}
+		else
+		{
+			if (res.worst > intr)
+				intr	= res.worst;
+
+			intr_ok	= intr_ok && (res.status <= DS_RETURN);
+		}
+	}
+
+	/*	Other entry points.
+	 *	------------------- */
+	if (strcmp(depth_spec, "all") == 0)
+	{
+		for (addr = 0; addr < DEPTH_ADDR_NUM; addr++)
+		{
+			if (	(is_inst(addr) == 0) ||
+					((depth_node[addr].flags & DN_REACHED) != 0) ||
+					(((addr & 0x38) == addr) && ((depth_node[addr].flags & DN_FALL) == 0)))
+			{
+				continue;
+			}
+
+			print_entry(fp, addr, &res);
+
+			if (res.worst > base)
+				base	= res.worst;
+
+			base_ok	= base_ok && (res.status <= DS_RETURN);
+		}
+	}
+	else
+	{
+		p_end	= depth_spec + strlen(depth_spec);
+
+		for (p_name = depth_spec; p_name != NULL; p_name = p_next)
+		{
+			if ((p_next = strchr(p_name, ',')) != NULL)
+				*p_next++	= '\0';
+
+			if ((p_symbol = FindLabel(p_name)) == NULL)
+			{
+				fprintf(	stderr,
+					  		"*** Error %d: Unknown label in \"--stack\" option (\"%s\")!\n",
+							EC_ULIS, p_name);
+
+				fprintf(fp, "%-31s Unknown label\n", p_name);
+				continue;
+			}
+
+			print_entry(fp, p_symbol->Symbol_Value & 0xFFFF, &res);
+
+			if (res.worst > base)
+				base	= res.worst;
+
+			base_ok	= base_ok && (res.status <= DS_RETURN);
+		}
+
+		/*	Restore the option text.
+		 *	------------------------ */
+		for (p_name = depth_spec; p_name < p_end; p_name++)
+		{
+			if (*p_name == '\0')
+				*p_name	= ',';
+		}
+	}
+
+	/*	- An interrupt can happen at the worst depth of the program.
+	 *	  The processor push the return address.
+	 *	*/
+	if ((base >= 0) && (intr >= 0))
+	{
+		if ((base_ok != 0) && (intr_ok != 0))
+			fprintf(fp, "\nWorst case, with one interrupt: %d bytes.\n", base + 2 + intr);
+		else
+			fprintf(fp, "\nWorst case, with one interrupt: not known (see notes).\n");
+	}
+
+	/*	Routines (call graph).
+	 *	---------------------- */
+	fprintf(fp, "\n");
+	fprintf(fp, "%-31s %9s  %s\n", "Routines", "Bytes", "Notes");
+	fprintf(fp, "%-31s %9s  %s\n", "--------", "-----", "-----");
+
+	for (addr = 0; addr < DEPTH_ADDR_NUM; addr++)
+	{
+		char			buf[LABEL_SIZE_MAX + 16];
+		const char	*p_label;
+
+		if (((depth_node[addr].flags & DN_ROUTINE) == 0) || (is_inst(addr) == 0))
+			continue;
+
+		if (depth_node[addr].rt_state == RT_NONE)
+			routine(addr);
+
+		p_label	= label_name(addr);
+
+		sprintf(buf, "%.*s (%04Xh)", LABEL_SIZE_MAX, (p_label != NULL) ? p_label : "?", addr);
+		print_result(fp, buf, &depth_node[addr].rt);
+	}
+
+	print_sites(fp);
+}
+
+
+/*	*************************************************************************
+ *	Function name:	depth_cleanup
+ *	Description:	Release module memory.
+ *	Author(s):
+ *	Created:			18 October 2026
+ *	Last modified:
+ *	Parameters:		void
+ *	Returns:			void
+ *	Globals:
+ *	Notes:
+ *	************************************************************************* */
+
+void depth_cleanup(void)
+{
+	mem_free(depth_spec);
+	mem_free(depth_node);
+	mem_free(depth_work);
+
+	depth_spec		= NULL;
+	depth_node		= NULL;
+	depth_work		= NULL;
+	work_num			= 0;
+	work_size		= 0;
+	depth_enable	= 0;
+}
+
+
+
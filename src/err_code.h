@@ -98,6 +98,25 @@
 #define EC_MQ				53		/*	Missing Quote. */
 #define EC_SCNBE			54		/*	String Can Not Be Evaluated. */
 #define EC_MRCBUBDS		55		/*	'M' Register Can't Be Used Both as Destination and Source. */
+#define EC_BJO				56		/*	Bad "-j" Option. */
+#define EC_CED				57		/*	Circular "EQU" Definition. */
+#define EC_BMO				58		/*	Bad "-m" Option. */
+#define EC_MOA				59		/*	Missing Option Argument. */
+#define EC_COTF			60		/*	Can't Open Trace File. */
+#define EC_BBO				61		/*	Bad "--bench" Option. */
+#define EC_ULIC			62		/*	Unknown Label In "--cycles" option. */
+#define EC_BCB				63		/*	Bad Cycles Budget. */
+#define EC_CBV				64		/*	Cycles Budget Violated. */
+#define EC_CCC				65		/*	Can't Compute Cycles. */
+#define EC_BLO				66		/*	Bad "--latency" Option. */
+#define EC_ILTL			67		/*	Interrupt Latency Too Long. */
+#define EC_BDLR			68		/*	Bad "DELAY" Register. */
+#define EC_CGD				69		/*	Can't Generate Delay. */
+#define EC_BCGO			70		/*	Bad Code Generator Operand. */
+#define EC_BRO				71		/*	Bad "--run" Option. */
+#define EC_BRIO			72		/*	Bad "--run-io" Option. */
+#define EC_BTF				73		/*	Bad Trace File. */
+#define EC_ULIS			74		/*	Unknown Label In "--stack" option. */
 
 
 
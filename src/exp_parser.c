@@ -11,7 +11,7 @@
  *	Copyright(c):	See below...
  *	Author(s):		Claude Sylvain
  *	Created:			27 December 2010
- *	Last modified:	20 May 2013
+ *	Last modified:	18 October 2026
  *
  *	Notes:		- This module implement an expression parser using
  *			  DAL (Direct Algebraic Logic) format.
@@ -79,6 +79,8 @@
 #include "util.h"
 #include "main.h"
 #include "msg.h"
+#include "mem.h"
+#include "stats.h"
 #include "exp_parser.h"
 
 
@@ -200,6 +202,7 @@ static int add_stack(void);
 static int remove_stack(void);
 static int dalep(char *text);
 static void eval(void);
+static int get_symbol_value(SYMBOL *p_symbol);
 
 
 /*	*************************************************************************
@@ -212,10 +215,23 @@ static void eval(void);
 /*	- Expression Parser Stack.
  *	- Notes: This is the static base stack.  All other stacks
  *	  are dynamically created as needed.
+ *	- Notes: One stack per thread.  Base stack is selected by
+ *	  "exp_parser()", since the address of a thread local variable
+ *	  can not be used as initializer.
+ *	*/
+static THREAD_LOCAL struct ep_stack_t	ep_stack;
+
+static THREAD_LOCAL struct ep_stack_t	*p_ep_stack	= NULL;
+
+/*	- Number of symbols not found since beginning of assembly.  Used
+ *	  to know if an "EQU" value is final.
  *	*/
-static struct ep_stack_t	ep_stack;
+static THREAD_LOCAL int	symbols_not_found	= 0;
 
-static struct ep_stack_t	*p_ep_stack	= &ep_stack;
+/*	- When not 0, "EQU" values are final, even if some symbols are not
+ *	  found (see "exp_parser_resolve_equ()").
+ *	*/
+static int	equ_final	= 0;
 
 
 /*	*************************************************************************
@@ -296,7 +312,7 @@ struct operator_t *p_operator = (struct operator_t *) operator;
 
 	*text_bp = 0;
 
-	p_text = (char *) malloc(strlen(text) + 1);
+	p_text = (char *) mem_alloc(MT_EXP, strlen(text) + 1);
 
 	if (p_text == NULL)
 	{
@@ -346,7 +362,7 @@ struct operator_t *p_operator = (struct operator_t *) operator;
 	else
 		rv = (p_operator->op);
 
-	free(p_text);		/*	Free allocated memory. */
+	mem_free(p_text);		/*	Free allocated memory. */
 
 	return (rv);
 }
@@ -749,7 +765,7 @@ int	rv	= -1;
 	/*	Create a new stack.
 	 *	*/	
 	struct ep_stack_t	*p_ep_stack_new =
-		(struct ep_stack_t *) malloc(sizeof (struct ep_stack_t));
+		(struct ep_stack_t *) mem_alloc(MT_EXP, sizeof (struct ep_stack_t));
 
 	/*	If stack creation was successfull...
 	 *	------------------------------------ */	
@@ -803,7 +819,7 @@ static int remove_stack(void)
 	if (p_ep_stack != &ep_stack)
 	{
 		p_ep_stack_prev	= p_ep_stack->prev;	/*	Memoryse previous stack address. */
-		free(p_ep_stack);			/*	Free current stack. */
+		mem_free(p_ep_stack);			/*	Free current stack. */
 
 		/*	Set current stack address to the previous stack address.
 		 *	*/
@@ -1300,11 +1316,12 @@ dalep_01:
 
 							if (!Local)
 							{
+								symbols_not_found++;
 								msg_error_s("Label not found!", EC_LNF, label);
 								return (0);
 							}
 
-							push(Local->Symbol_Value);
+							push(get_symbol_value(Local));
 							eval();
 						}
 #if 0
@@ -1329,6 +1346,193 @@ dalep_01:
 }
 
 
+/*	*************************************************************************
+ *	Function name:	get_symbol_value
+ *	Description:	Get Symbol Value, evaluating "EQU" expression if needed.
+ *	Author(s):
+ *	Created:			18 October 2026
+ *	Last modified:
+ *
+ *	Parameters:		SYMBOL *p_symbol:
+ *							Symbol to get the value from.
+ *
+ *	Returns:			int:
+ *							Symbol value.
+ *
+ *	Globals:
+ *
+ *	Notes:			- "EQU" expressions are kept unevaluated by "proc_equ()",
+ *						  and evaluated here, on first use.  Symbols used by
+ *						  the expression are evaluated the same way
+ *						  (recursively), so "EQU" chains are resolved in any
+ *						  order.
+ *						- Value is remembered only if all used symbols are
+ *						  found.  Otherwise, expression will be evaluated
+ *						  again on next use (a forward referenced label may
+ *						  not be defined yet, on assembler pass #1).
+ *						- An "EQU" that depend on itself is marked
+ *						  EQU_CIRCULAR, and its value is 0.
+ *	************************************************************************* */
+
+static int get_symbol_value(SYMBOL *p_symbol)
+{
+	int	not_found	= symbols_not_found;
+	int	pc				= target.pc;
+	int	value;
+
+
+	switch (p_symbol->equ_state)
+	{
+		case EQU_PENDING:
+			break;
+
+		/*	Circular definition.  Give up.
+		 *	------------------------------ */
+		case EQU_RESOLVING:
+			p_symbol->equ_state	= EQU_CIRCULAR;
+			symbols_not_found++;
+
+			msg_error_s(	"Circular \"EQU\" definition!", EC_CED,
+				  				p_symbol->Symbol_Name);
+
+			return (0);
+
+		default:
+			return (p_symbol->Symbol_Value);
+	}
+
+	p_symbol->equ_state	= EQU_RESOLVING;
+
+	/*	- Evaluate expression on a new stack, with "$" as it was at the
+	 *	  "EQU" definition.
+	 *	---------------------------------------------------------------- */
+	target.pc	= p_symbol->equ_pc;
+
+	if (add_stack() != -1)
+	{
+		value	= dalep(p_symbol->equ_expr);
+		remove_stack();
+	}
+	else
+		value	= 0;
+
+	target.pc	= pc;
+
+	check_oor(value, 0xFFFF);		/*	Check Operand Over Range. */
+
+	p_symbol->Symbol_Value	= value;
+
+	/*	Circular definition found while evaluating.
+	 *	------------------------------------------- */
+	if (p_symbol->equ_state == EQU_CIRCULAR)
+	{
+		p_symbol->Symbol_Value	= 0;
+		value							= 0;
+	}
+	/*	Remember value, if final.
+	 *	------------------------- */
+	else if (	(not_found == symbols_not_found) || (equ_final != 0) ||
+			  		(asm_pass == 1))
+	{
+		p_symbol->equ_state	= EQU_RESOLVED;
+	}
+	else
+		p_symbol->equ_state	= EQU_PENDING;
+
+	return (value);
+}
+
+
+/*	*************************************************************************
+ *	Function name:	exp_parser_equ
+ *	Description:	Evaluate an "EQU" expression at its definition.
+ *	Author(s):
+ *	Created:			18 October 2026
+ *	Last modified:
+ *
+ *	Parameters:		SYMBOL *p_symbol:
+ *							"EQU" symbol, just defined (EQU_PENDING).
+ *
+ *	Returns:			void
+ *	Globals:
+ *
+ *	Notes:			- If all used symbols are defined, value is final, and
+ *						  "SET" symbols are used with their value at the
+ *						  definition.  Otherwise (forward reference), the
+ *						  expression stays pending until first use.
+ *	************************************************************************* */
+
+void exp_parser_equ(SYMBOL *p_symbol)
+{
+	if (p_ep_stack == NULL)
+		p_ep_stack	= &ep_stack;
+
+	get_symbol_value(p_symbol);
+}
+
+
+/*	*************************************************************************
+ *	Function name:	exp_parser_resolve_equ
+ *	Description:	Evaluate all "EQU" expressions not evaluated yet.
+ *	Author(s):
+ *	Created:			18 October 2026
+ *	Last modified:
+ *	Parameters:		void
+ *	Returns:			void
+ *	Globals:
+ *
+ *	Notes:			- Called at end of assembler pass #1, when all labels
+ *						  are known.  So, symbols values do not change during
+ *						  assembler pass #2 (that can be done concurrently,
+ *						  see "layout.c").
+ *	************************************************************************* */
+
+void exp_parser_resolve_equ(void)
+{
+	SYMBOL	*Local	= Symbols;
+
+
+	if (p_ep_stack == NULL)
+		p_ep_stack	= &ep_stack;
+
+	equ_final	= 1;
+
+	while (Local->next != NULL)
+	{
+		if (Local->equ_state == EQU_PENDING)
+			get_symbol_value(Local);
+
+		Local	= (SYMBOL *) Local->next;
+	}
+
+	equ_final	= 0;
+}
+
+
+/*	*************************************************************************
+ *	Function name:	exp_parser_not_found
+ *	Description:	Get the number of symbols not found.
+ *	Author(s):
+ *	Created:			18 October 2026
+ *	Last modified:
+ *	Parameters:		void
+ *
+ *	Returns:			int:
+ *							Number of symbols not found since beginning of
+ *							assembly (by this thread).
+ *
+ *	Globals:
+ *
+ *	Notes:			- Compare the values before and after "exp_parser()"
+ *						  to know if an expression used an unknown name.
+ *	************************************************************************* */
+
+int exp_parser_not_found(void)
+{
+	return (symbols_not_found);
+}
+
+
 /*	*************************************************************************
  *	Function name:	exp_parser
  *	Description:	Expression Parser main entry point.
@@ -1349,6 +1553,11 @@ dalep_01:
 
 int exp_parser(char *text)
 {
+	STATS_COUNT(SC_EXP_PARSER, 1);
+
+	if (p_ep_stack == NULL)
+		p_ep_stack	= &ep_stack;
+
 p_ep_stack->level	= 0;
 
 	return (dalep(text));
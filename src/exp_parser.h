@@ -52,6 +52,9 @@
 int extract_byte(char *text);
 int extract_word(char *text);
 int exp_parser(char *text);
+void exp_parser_equ(SYMBOL *p_symbol);
+void exp_parser_resolve_equ(void);
+int exp_parser_not_found(void);
 
 
 
@@ -0,0 +1,1294 @@
+/*	*************************************************************************
+ *	Module Name:	layout.c
+ *	Description:	Parallel Layout (assembler pass #1).
+ *	Copyright(c):	See below...
+ *	Author(s):
+ *	Created:			18 October 2026
+ *	Last modified:
+ *
+ *	Notes:			- On assembler pass #1, only the size of each source
+ *						  line matters.  Most lines (opcodes, "DB", "DW") can
+ *						  be sized without knowing the program counter, so
+ *						  sizing is done concurrently, by chunks of lines, and
+ *						  addresses are assigned with a prefix sum.
+ *
+ *						- Lines that depend on the layout ("ORG", "DS",
+ *						  "EQU", "SET", conditionals, macros, includes...)
+ *						  are "barriers".  Barriers are processed
+ *						  sequentially, by the regular "do_asm_line()".
+ *	************************************************************************* */
+
+/*
+ * Copyright (c) <2007-2017> Jay Cotton <lbmgmusic@gmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+
+/*	*************************************************************************
+ *	                              INCLUDE FILES
+ *	************************************************************************* */
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "project.h"
+
+#if USE_PTHREAD
+#include <pthread.h>
+#include <unistd.h>
+#endif
+
+#include "err_code.h"
+#include "main.h"
+#include "msg.h"
+#include "mem.h"
+#include "util.h"
+#include "asm_dir.h"
+#include "opcode.h"
+#include "layout.h"
+
+
+/*	*************************************************************************
+ *											  CONSTANTS
+ *	************************************************************************* */
+
+/*	Layout Line Flags.
+ *	------------------ */
+#define LLF_BARRIER					0x01		/*	Must be processed sequentially. */
+#define LLF_LABEL						0x02		/*	Have a label to define. */
+
+
+/*	*************************************************************************
+ *	                                 TYPEDEF
+ *	************************************************************************* */
+
+/*	Source line, as seen by the layout.
+ *	----------------------------------- */
+struct layout_line_t
+{
+	char	*text;			/*	Source line (as read by "fgets()"). */
+	char	*label;			/*	Label/name, if any (NULL otherwise). */
+	int	size;				/*	Size, in bytes. */
+	int	rel;				/*	Offset from the last barrier. */
+	int	flags;			/*	LLF_xxx. */
+};
+
+/*	Chunk of source lines, processed by one thread.
+ *	----------------------------------------------- */
+struct layout_chunk_t
+{
+	struct layout_line_t	*p_line;		/*	First line of the chunk. */
+	int	lines;							/*	Number of lines. */
+	int	first_barrier;					/*	First barrier index (-1 if none). */
+	int	sum;								/*	Size after the last barrier. */
+	int	carry;							/*	Size carried from previous chunks. */
+};
+
+/*	Chunk of source lines, assembled by one thread (assembler pass #2).
+ *	------------------------------------------------------------------- */
+struct layout_task_t
+{
+	struct layout_line_t	*p_line;		/*	First line of the chunk. */
+	int	first;							/*	Index of the first line. */
+	int	lines;							/*	Number of lines. */
+	TARG	target;							/*	Program Counter (in/out). */
+	STACK	*p_stack;						/*	Bytes/Words stack root. */
+	FILE	*fp_list;						/*	Listing fragment (NULL if none). */
+	FILE	*fp_msg;							/*	Messages fragment. */
+};
+
+
+/*	*************************************************************************
+ *	                                VARIABLES
+ *	************************************************************************* */
+
+/*	Private variables.
+ *	****************** */
+
+/*	- Source lines, kept from assembler pass #1 to assembler pass #2.
+ *	  Line sizes and kinds do not depend on the assembler pass.
+ *	*/
+static struct layout_line_t	*layout_line	= NULL;
+static char	*layout_text	= NULL;
+static int	layout_lines	= 0;
+
+
+/*	*************************************************************************
+ *									  FUNCTIONS DECLARATION
+ *	************************************************************************* */
+
+static char *layout_load(size_t *p_size);
+static int layout_split(	const char *p_buf, size_t size,
+	  							struct layout_line_t **pp_line, char **pp_text);
+static void layout_classify(struct layout_line_t *p_line, char *p_label,
+									 char *p_string, char *p_string_uc,
+									 char *p_equation);
+static void *layout_scan(void *arg);
+static void *layout_fix(void *arg);
+static void layout_run(	void *p_task, size_t task_size, int tasks,
+	  							void *(*fnc) (void *));
+static int layout_chunks(int lines, int threads);
+static int layout_prepare(	int threads, struct layout_line_t **pp_line,
+	  								char **pp_text);
+static void layout_release(struct layout_line_t *p_line, int lines, char *p_text);
+static void layout_walk(struct layout_line_t *p_line, int lines);
+static void *layout_encode(void *arg);
+static void layout_copy(FILE *fp_src, FILE *fp_dst);
+static void layout_emit_run(	struct layout_line_t *p_line, int first,
+	  									int lines, int threads);
+static void layout_emit(struct layout_line_t *p_line, int lines, int threads);
+
+
+/*	*************************************************************************
+ *	                           FUNCTIONS DEFINITION
+ *	************************************************************************* */
+
+
+/*	*************************************************************************
+ *	Function name:	layout_load
+ *	Description:	Load the main source file in memory.
+ *	Author(s):
+ *	Created:			18 October 2026
+ *	Last modified:
+ *
+ *	Parameters:		size_t *p_size:
+ *							Point to a variable that receive the file size.
+ *
+ *	Returns:			char *:
+ *							- Point to the file content (a '\0' is added).
+ *							- NULL if operation failed.
+ *
+ *	Globals:
+ *	Notes:
+ *	************************************************************************* */
+
+static char *layout_load(size_t *p_size)
+{
+	char		*p_buf;
+	long		size;
+
+
+	if (fseek(in_fp[0], 0, SEEK_END) != 0)
+		return (NULL);
+
+	size	= ftell(in_fp[0]);
+
+	fseek(in_fp[0], 0, SEEK_SET);
+
+	if (size < 0)
+		return (NULL);
+
+	if ((p_buf = (char *) mem_alloc(MT_LAYOUT, (size_t) size + 1)) == NULL)
+		return (NULL);
+
+	*p_size			= fread(p_buf, 1, (size_t) size, in_fp[0]);
+	p_buf[*p_size]	= '\0';
+
+	return (p_buf);
+}
+
+
+
+/*	*************************************************************************
+ *	Function name:	layout_split
+ *	Description:	Split a loaded source file into lines.
+ *	Author(s):
+ *	Created:			18 October 2026
+ *	Last modified:
+ *
+ *	Parameters:		const char *p_buf:
+ *							Source file content.
+ *
+ *						size_t size:
+ *							Size of the source file content.
+ *
+ *						struct layout_line_t **pp_line:
+ *							Point to a variable that receive the lines array.
+ *
+ *						char **pp_text:
+ *							- Point to a variable that receive the buffer
+ *							  holding all the lines text.
+ *
+ *	Returns:			int:
+ *							- Number of lines.
+ *							- (-1) if operation failed.
+ *
+ *	Globals:
+ *
+ *	Notes:			- Lines are cut the same way "do_asm_files()" does,
+ *						  using "fgets()" and a "SRC_LINE_WIDTH_MAX" buffer.
+ *						  This keep "codeline[]" in phase with the source
+ *						  file.
+ *	************************************************************************* */
+
+static int layout_split(	const char *p_buf, size_t size,
+	  							struct layout_line_t **pp_line, char **pp_text)
+{
+	struct layout_line_t	*p_line;
+	char		*p_text;
+	size_t	pos;
+	int		lines	= 1;
+
+
+	/*	Count lines (last line may not end with a New Line).
+	 *	---------------------------------------------------- */
+	for (pos = 0; pos < size; pos++)
+	{
+		if (p_buf[pos] == '\n')
+			lines++;
+	}
+
+	p_line	= (struct layout_line_t *)
+		mem_calloc(MT_LAYOUT, (size_t) lines, sizeof (struct layout_line_t));
+
+	p_text	= (char *) mem_alloc(MT_LAYOUT, size + (size_t) lines);
+
+	if ((p_line == NULL) || (p_text == NULL))
+	{
+		mem_free(p_line);
+		mem_free(p_text);
+
+		return (-1);
+	}
+
+	*pp_line	= p_line;
+	*pp_text	= p_text;
+	lines		= 0;
+	pos		= 0;
+
+	while (pos < size)
+	{
+		size_t	len	= 0;
+
+		p_line[lines++].text	= p_text;
+
+		/*	- Copy up to End Of Line, like "fgets()" does (New Line
+		 *	  character included).
+		 *	------------------------------------------------------- */
+		while ((pos < size) && (len < (SRC_LINE_WIDTH_MAX - 1)))
+		{
+			len++;
+
+			if ((*(p_text++) = p_buf[pos++]) == '\n')
+				break;
+		}
+
+		*(p_text++)	= '\0';
+
+		/*	- If line is too long, bypass remaining of source line, like
+		 *	  "do_asm_files()" does.
+		 *	------------------------------------------------------------ */
+		if ((len == (SRC_LINE_WIDTH_MAX - 1)) && (p_text[-2] != '\n'))
+		{
+			while ((pos < size) && (p_buf[pos++] != '\n'))
+				;
+		}
+	}
+
+	return (lines);
+}
+
+
+/*	*************************************************************************
+ *	Function name:	layout_classify
+ *	Description:	Find the size and the kind of a source line.
+ *	Author(s):
+ *	Created:			18 October 2026
+ *	Last modified:
+ *
+ *	Parameters:		struct layout_line_t *p_line:
+ *							Source line to classify.
+ *
+ *						char *p_label:
+ *						char *p_string:
+ *						char *p_string_uc:
+ *						char *p_equation:
+ *							Work buffers, for "src_line_split()".
+ *
+ *	Returns:			void
+ *	Globals:
+ *
+ *	Notes:			- Can be called concurrently.  Do not modify any global
+ *						  variable.
+ *	************************************************************************* */
+
+static void layout_classify(struct layout_line_t *p_line, char *p_label,
+									 char *p_string, char *p_string_uc,
+									 char *p_equation)
+{
+	const keyword_t	*p_keyword;
+	const opcode_t		*p_opcode;
+	char		*p_text	= p_line->text;
+	size_t	str_len	= strlen(p_text);
+
+
+	p_line->size	= 0;
+	p_line->flags	= 0;
+	p_line->label	= NULL;
+
+	/*	Do not count New Line character.
+	 *	-------------------------------- */
+	if ((str_len > 0) && (p_text[str_len - 1] == '\n'))
+		str_len--;
+
+	/*	- Same rule as "do_asm_line()": empty lines and CP/M end of
+	 *	  file mark are not parsed.
+	 *	----------------------------------------------------------- */
+	if ((str_len < 1) || ((str_len <= 2) && (*p_text == 0x1A)))
+		return;
+
+	switch (src_line_split(p_text, p_label, p_string, p_string_uc, p_equation))
+	{
+		case SLS_COMMENT:
+		case SLS_SPECIAL:
+			return;
+
+		case SLS_LABEL:
+			break;
+
+		default:
+			/*	Assembler directive?
+			 *	-------------------- */
+			for (p_keyword = asm_dir; p_keyword->Name != NULL; p_keyword++)
+			{
+				if (strcmp(p_keyword->Name, p_string_uc) == 0)
+					break;
+			}
+
+			if (p_keyword->Name != NULL)
+			{
+				/*	- Only "DB" and "DW" are sized here.  All other
+				 *	  assembler directives are barriers.
+				 *	*/
+				if ((p_line->size = asm_dir_list_size(p_keyword, p_equation)) < 0)
+				{
+					p_line->size	= 0;
+					p_line->flags	= LLF_BARRIER;
+
+					return;
+				}
+
+				break;
+			}
+
+			/*	Opcode?
+			 *	------- */
+			for (p_opcode = OpCodes; p_opcode->Name != NULL; p_opcode++)
+			{
+				if (strcmp(p_opcode->Name, p_string_uc) == 0)
+					break;
+			}
+
+			/*	Probably a macro.  This is a barrier.
+			 *	------------------------------------- */
+			if (p_opcode->Name == NULL)
+			{
+				p_line->flags	= LLF_BARRIER;
+				return;
+			}
+
+			p_line->size	= p_opcode->size;
+			break;
+	}
+
+	/*	Keep the label, if any.
+	 *	----------------------- */
+	if (*p_label != '\0')
+	{
+		p_line->label	= (char *) mem_alloc(MT_LAYOUT, strlen(p_label) + 1);
+
+		/*	- On memory allocation error, let "do_asm_line()" handle
+		 *	  the line.
+		 *	-------------------------------------------------------- */
+		if (p_line->label != NULL)
+		{
+			strcpy(p_line->label, p_label);
+			p_line->flags	= LLF_LABEL;
+		}
+		else
+			p_line->flags	= LLF_BARRIER;
+	}
+}
+
+
+/*	*************************************************************************
+ *	Function name:	layout_scan
+ *	Description:	Classify the lines of a chunk (layout phase #1).
+ *	Author(s):
+ *	Created:			18 October 2026
+ *	Last modified:
+ *
+ *	Parameters:		void *arg:
+ *							Point to the chunk (struct layout_chunk_t).
+ *
+ *	Returns:			void *:
+ *							NULL.
+ *
+ *	Globals:
+ *
+ *	Notes:			- Compute offset of each line, from the last barrier
+ *						  of the chunk (or from the beginning of the chunk).
+ *	************************************************************************* */
+
+static void *layout_scan(void *arg)
+{
+	struct layout_chunk_t	*p_chunk	= (struct layout_chunk_t *) arg;
+	struct layout_line_t		*p_line	= p_chunk->p_line;
+
+	char	label[LABEL_SIZE_MAX];
+	char	string[SRC_LINE_KEYWORD_SIZE];
+	char	string_uc[SRC_LINE_KEYWORD_SIZE];
+	char	equation[EQUATION_SIZE_MAX];
+
+	int	i;
+	int	rel	= 0;
+
+
+	p_chunk->first_barrier	= -1;
+
+	for (i = 0; i < p_chunk->lines; i++, p_line++)
+	{
+		layout_classify(p_line, label, string, string_uc, equation);
+
+		p_line->rel	= rel;
+
+		if ((p_line->flags & LLF_BARRIER) != 0)
+		{
+			if (p_chunk->first_barrier < 0)
+				p_chunk->first_barrier	= i;
+
+			rel	= 0;
+		}
+		else
+			rel	+= p_line->size;
+	}
+
+	p_chunk->sum	= rel;
+
+	return (NULL);
+}
+
+
+/*	*************************************************************************
+ *	Function name:	layout_fix
+ *	Description:	Add carry to the lines of a chunk (layout phase #2).
+ *	Author(s):
+ *	Created:			18 October 2026
+ *	Last modified:
+ *
+ *	Parameters:		void *arg:
+ *							Point to the chunk (struct layout_chunk_t).
+ *
+ *	Returns:			void *:
+ *							NULL.
+ *
+ *	Globals:
+ *
+ *	Notes:			- Only lines up to the first barrier of the chunk
+ *						  are relative to previous chunks.
+ *	************************************************************************* */
+
+static void *layout_fix(void *arg)
+{
+	struct layout_chunk_t	*p_chunk	= (struct layout_chunk_t *) arg;
+	struct layout_line_t		*p_line	= p_chunk->p_line;
+
+	int	i;
+	int	last	= p_chunk->first_barrier;
+
+
+	if (last < 0)
+		last	= p_chunk->lines - 1;
+
+	for (i = 0; i <= last; i++, p_line++)
+		p_line->rel	+= p_chunk->carry;
+
+	return (NULL);
+}
+
+
+/*	*************************************************************************
+ *	Function name:	layout_run
+ *	Description:	Run a function on all tasks, concurrently.
+ *	Author(s):
+ *	Created:			18 October 2026
+ *	Last modified:
+ *
+ *	Parameters:		void *p_task:
+ *							Tasks array.
+ *
+ *						size_t task_size:
+ *							Size of one task, in bytes.
+ *
+ *						int tasks:
+ *							Number of tasks.
+ *
+ *						void *(*fnc) (void *):
+ *							Function to run on each task.
+ *
+ *	Returns:			void
+ *	Globals:
+ *
+ *	Notes:			- First task is processed by the calling thread.
+ *						- If a thread can not be created, its task is
+ *						  processed by the calling thread.
+ *	************************************************************************* */
+
+static void layout_run(	void *p_task, size_t task_size, int tasks,
+	  							void *(*fnc) (void *))
+{
+	char	*p_base	= (char *) p_task;
+	int	i;
+
+#if USE_PTHREAD
+	pthread_t	thread[LAYOUT_THREADS_MAX];
+	int			started[LAYOUT_THREADS_MAX];
+
+	for (i = 1; i < tasks; i++)
+	{
+		started[i]	=
+			(pthread_create(&thread[i], NULL, fnc, p_base + (i * task_size)) == 0);
+	}
+
+	fnc(p_base);
+
+	for (i = 1; i < tasks; i++)
+	{
+		if (started[i])
+			pthread_join(thread[i], NULL);
+		else
+			fnc(p_base + (i * task_size));
+	}
+#else
+	for (i = 0; i < tasks; i++)
+		fnc(p_base + (i * task_size));
+#endif
+}
+
+
+/*	*************************************************************************
+ *	Function name:	layout_chunks
+ *	Description:	Get the number of chunks to use for a lines range.
+ *	Author(s):
+ *	Created:			18 October 2026
+ *	Last modified:
+ *
+ *	Parameters:		int lines:
+ *							Number of lines.
+ *
+ *						int threads:
+ *							Maximum number of threads.
+ *
+ *	Returns:			int:
+ *							Number of chunks (at least 1).
+ *
+ *	Globals:
+ *	Notes:
+ *	************************************************************************* */
+
+static int layout_chunks(int lines, int threads)
+{
+	int	chunks	= lines / LAYOUT_CHUNK_LINES_MIN;
+
+	if (chunks > threads)
+		chunks	= threads;
+
+	if (chunks > LAYOUT_THREADS_MAX)
+		chunks	= LAYOUT_THREADS_MAX;
+
+	if (chunks < 1)
+		chunks	= 1;
+
+	return (chunks);
+}
+
+
+/*	*************************************************************************
+ *	Function name:	layout_prepare
+ *	Description:	Load, split and classify the main source file.
+ *	Author(s):
+ *	Created:			18 October 2026
+ *	Last modified:
+ *
+ *	Parameters:		int threads:
+ *							Maximum number of threads to use.
+ *
+ *						struct layout_line_t **pp_line:
+ *							Point to a variable that receive the lines array.
+ *
+ *						char **pp_text:
+ *							- Point to a variable that receive the buffer
+ *							  holding all the lines text.
+ *
+ *	Returns:			int:
+ *							- Number of lines.
+ *							- (-1) if operation failed.  In that case, main
+ *							  source file is rewinded.
+ *
+ *	Globals:
+ *
+ *	Notes:			- On return, "rel" of each line is the offset from the
+ *						  last barrier.
+ *	************************************************************************* */
+
+static int layout_prepare(	int threads, struct layout_line_t **pp_line,
+	  								char **pp_text)
+{
+	struct layout_chunk_t	chunk[LAYOUT_THREADS_MAX];
+
+	char		*p_buf;
+	size_t	size;
+	int		lines;
+	int		chunks;
+	int		i;
+
+
+	if ((p_buf = layout_load(&size)) == NULL)
+	{
+		fseek(in_fp[0], 0, SEEK_SET);
+		return (-1);
+	}
+
+	lines	= layout_split(p_buf, size, pp_line, pp_text);
+	mem_free(p_buf);
+
+	if (lines < 0)
+	{
+		fseek(in_fp[0], 0, SEEK_SET);
+		return (-1);
+	}
+
+	/*	Share lines between chunks.
+	 *	--------------------------- */
+	chunks	= layout_chunks(lines, threads);
+
+	for (i = 0; i < chunks; i++)
+	{
+		int	first	= (int) (((long) lines * i) / chunks);
+		int	last	= (int) (((long) lines * (i + 1)) / chunks);
+
+		chunk[i].p_line	= *pp_line + first;
+		chunk[i].lines		= last - first;
+		chunk[i].carry		= 0;
+	}
+
+	/*	Phase #1: Classify lines, and get offsets inside chunks.
+	 *	-------------------------------------------------------- */
+	layout_run(chunk, sizeof (chunk[0]), chunks, layout_scan);
+
+	/*	Carry sizes from chunk to chunk.
+	 *	-------------------------------- */
+	for (i = 1; i < chunks; i++)
+	{
+		chunk[i].carry	= chunk[i - 1].sum;
+
+		if (chunk[i - 1].first_barrier < 0)
+			chunk[i].carry	+= chunk[i - 1].carry;
+	}
+
+	/*	Phase #2: Make offsets relative to the last barrier.
+	 *	---------------------------------------------------- */
+	if (chunks > 1)
+		layout_run(chunk, sizeof (chunk[0]), chunks, layout_fix);
+
+	return (lines);
+}
+
+
+/*	*************************************************************************
+ *	Function name:	layout_release
+ *	Description:	Free resources allocated by "layout_prepare()".
+ *	Author(s):
+ *	Created:			18 October 2026
+ *	Last modified:
+ *
+ *	Parameters:		struct layout_line_t *p_line:
+ *							Lines array.
+ *
+ *						int lines:
+ *							Number of lines.
+ *
+ *						char *p_text:
+ *							Buffer holding all the lines text.
+ *
+ *	Returns:			void
+ *	Globals:
+ *	Notes:
+ *	************************************************************************* */
+
+static void layout_release(struct layout_line_t *p_line, int lines, char *p_text)
+{
+	int	i;
+
+	for (i = 0; i < lines; i++)
+		mem_free(p_line[i].label);
+
+	mem_free(p_line);
+	mem_free(p_text);
+}
+
+
+/*	*************************************************************************
+ *	Function name:	layout_walk
+ *	Description:	Assign addresses, and process barriers.
+ *	Author(s):
+ *	Created:			18 October 2026
+ *	Last modified:
+ *
+ *	Parameters:		struct layout_line_t *p_line:
+ *							Lines array.
+ *
+ *						int lines:
+ *							Number of lines.
+ *
+ *	Returns:			void
+ *	Globals:
+ *
+ *	Notes:			- Address of a line is "base + rel", where "base" is
+ *						  the address following the last barrier.
+ *						- While a macro is being defined, all lines are
+ *						  processed sequentially.
+ *	************************************************************************* */
+
+static void layout_walk(struct layout_line_t *p_line, int lines)
+{
+	char	text[SRC_LINE_WIDTH_MAX];
+	int	i;
+	int	base	= target.addr;
+
+
+	for (i = 0; i < lines; i++, p_line++)
+	{
+		int	macro		= (fp_macro != NULL) || (inside_macro != 0);
+		int	rel_next;
+		int	cs_on;
+
+		/*	Nothing to do with this line.
+		 *	----------------------------- */
+		if ((p_line->flags == 0) && !macro)
+			continue;
+
+		codeline[0]	= i + 1;
+		cs_on			= util_is_cs_enable();
+
+		rel_next	= ((p_line->flags & LLF_BARRIER) != 0) ?
+			0 : (p_line->rel + p_line->size);
+
+		/*	Sequential processing.
+		 *	---------------------- */
+		if (((p_line->flags & LLF_BARRIER) != 0) || macro)
+		{
+			int	status;
+
+			if ((cs_on != 0) && !macro)
+				set_pc(base + p_line->rel);
+
+			/*	Line is kept for assembler pass #2.  Work on a copy.
+			 *	*/
+			strcpy(text, p_line->text);
+			status	= do_asm_line(text);
+
+			/*	- If an include file or a macro was openned, assemble
+			 *	  it now.
+			 *	----------------------------------------------------- */
+			if ((status != PROCESSED_END) && (file_level > 0))
+				status	= do_asm_files(1);
+
+			if (status == PROCESSED_END)
+				return;
+
+			base	= target.addr - rel_next;
+		}
+		/*	Define label.
+		 *	------------- */
+		else if (cs_on != 0)
+		{
+			set_pc(base + p_line->rel);
+			process_label(p_line->label);
+		}
+	}
+
+	/*	End of main source file.
+	 *	------------------------ */
+	codeline[0]	= lines + 1;
+	do_asm_end();
+}
+
+
+/*	*************************************************************************
+ *	Function name:	layout_encode
+ *	Description:	Assemble the lines of a chunk (assembler pass #2).
+ *	Author(s):
+ *	Created:			18 October 2026
+ *	Last modified:
+ *
+ *	Parameters:		void *arg:
+ *							Point to the chunk (struct layout_task_t).
+ *
+ *	Returns:			void *:
+ *							NULL.
+ *
+ *	Globals:
+ *
+ *	Notes:			- Listing and messages go to the chunk own files.
+ *						  They are put back in order by "layout_emit_run()".
+ *						- Thread local variables of the calling thread are
+ *						  restored on exit, since the first chunk is
+ *						  assembled by the main thread.
+ *	************************************************************************* */
+
+static void *layout_encode(void *arg)
+{
+	struct layout_task_t	*p_task	= (struct layout_task_t *) arg;
+	struct layout_line_t	*p_line	= p_task->p_line;
+
+	char	text[SRC_LINE_WIDTH_MAX];
+
+	FILE	*list_save		= list;
+	FILE	*fp_msg_save	= fp_msg;
+	STACK	*stack_save		= ByteWordStack;
+	TARG	target_save		= target;
+
+	int	i;
+
+
+	list				= p_task->fp_list;
+	fp_msg			= p_task->fp_msg;
+	ByteWordStack	= p_task->p_stack;
+	target			= p_task->target;
+
+	for (i = 0; i < p_task->lines; i++, p_line++)
+	{
+		codeline[0]	= p_task->first + i + 1;
+
+		strcpy(text, p_line->text);
+		do_asm_line(text);
+	}
+
+	p_task->target	= target;
+
+	list				= list_save;
+	fp_msg			= fp_msg_save;
+	ByteWordStack	= stack_save;
+	target			= target_save;
+
+	return (NULL);
+}
+
+
+/*	*************************************************************************
+ *	Function name:	layout_copy
+ *	Description:	Copy a temporary file to another file.
+ *	Author(s):
+ *	Created:			18 October 2026
+ *	Last modified:
+ *
+ *	Parameters:		FILE *fp_src:
+ *							Source file.  Closed on exit.
+ *
+ *						FILE *fp_dst:
+ *							Destination file.
+ *
+ *	Returns:			void
+ *	Globals:
+ *	Notes:
+ *	************************************************************************* */
+
+static void layout_copy(FILE *fp_src, FILE *fp_dst)
+{
+	char		buf[4096];
+	size_t	n;
+
+
+	rewind(fp_src);
+
+	while ((n = fread(buf, 1, sizeof (buf), fp_src)) > 0)
+		fwrite(buf, 1, n, fp_dst);
+
+	fclose(fp_src);
+}
+
+
+/*	*************************************************************************
+ *	Function name:	layout_emit_run
+ *	Description:	Assemble a run of lines without barrier.
+ *	Author(s):
+ *	Created:			18 October 2026
+ *	Last modified:
+ *
+ *	Parameters:		struct layout_line_t *p_line:
+ *							Lines array.
+ *
+ *						int first:
+ *							Index of the first line of the run.
+ *
+ *						int lines:
+ *							Number of lines in the run.
+ *
+ *						int threads:
+ *							Maximum number of threads to use.
+ *
+ *	Returns:			void
+ *	Globals:
+ *
+ *	Notes:			- Without barrier, the address of each line is known
+ *						  from the line sizes.  So, the run is cut in chunks
+ *						  assembled concurrently, each chunk writing its own
+ *						  "Image[]" range.
+ *						- Run is assembled sequentially if it is too small,
+ *						  or if it would overflow the 64K address space
+ *						  (chunks could then overlap).
+ *	************************************************************************* */
+
+static void layout_emit_run(	struct layout_line_t *p_line, int first,
+	  									int lines, int threads)
+{
+	struct layout_task_t	task[LAYOUT_THREADS_MAX];
+	struct layout_line_t	*p_first	= p_line + first;
+	struct layout_line_t	*p_last	= p_first + lines - 1;
+
+	int	chunks	= layout_chunks(lines, threads);
+	int	cs_on		= util_is_cs_enable();
+	int	size		= 0;
+	int	i;
+
+
+	if (cs_on != 0)
+		size	= p_last->rel + p_last->size - p_first->rel;
+
+	/*	Create chunks listing/messages files.
+	 *	------------------------------------- */
+	if (	(chunks > 1) && (target.addr >= 0) &&
+			((target.addr + size) <= 0x10000))
+	{
+		for (i = 0; i < chunks; i++)
+		{
+			task[i].fp_msg		= tmpfile();
+			task[i].fp_list	= (list != NULL) ? tmpfile() : NULL;
+			task[i].p_stack	= (STACK *) mem_calloc(MT_STACK, 1, sizeof (STACK));
+
+			if (	(task[i].fp_msg == NULL) || (task[i].p_stack == NULL) ||
+					((list != NULL) && (task[i].fp_list == NULL)))
+			{
+				/*	Not able to go concurrent.  Clean up.
+				 *	------------------------------------- */
+				do
+				{
+					if (task[i].fp_msg != NULL)	fclose(task[i].fp_msg);
+					if (task[i].fp_list != NULL)	fclose(task[i].fp_list);
+					mem_free(task[i].p_stack);
+				} while (--i >= 0);
+
+				chunks	= 1;
+				break;
+			}
+		}
+	}
+	else
+		chunks	= 1;
+
+	/*	Sequential processing.
+	 *	---------------------- */
+	if (chunks == 1)
+	{
+		char	text[SRC_LINE_WIDTH_MAX];
+
+		for (i = 0; i < lines; i++)
+		{
+			codeline[0]	= first + i + 1;
+
+			strcpy(text, p_first[i].text);
+			do_asm_line(text);
+		}
+
+		return;
+	}
+
+	/*	Share lines between chunks, and set chunks start address.
+	 *	--------------------------------------------------------- */
+	for (i = 0; i < chunks; i++)
+	{
+		int	chunk_first	= (int) (((long) lines * i) / chunks);
+		int	chunk_last	= (int) (((long) lines * (i + 1)) / chunks);
+
+		task[i].p_line		= p_first + chunk_first;
+		task[i].first		= first + chunk_first;
+		task[i].lines		= chunk_last - chunk_first;
+		task[i].target		= target;
+
+		if (cs_on != 0)
+			task[i].target.addr	+= task[i].p_line->rel - p_first->rel;
+
+		task[i].target.pc				= task[i].target.addr & 0xFFFF;
+		task[i].target.pc_lowest	= 0xFFFF;
+		task[i].target.pc_highest	= 0;
+	}
+
+	layout_run(task, sizeof (task[0]), chunks, layout_encode);
+
+	/*	- Put listing and messages back in order, and merge program
+	 *	  counter information.
+	 *	----------------------------------------------------------- */
+	for (i = 0; i < chunks; i++)
+	{
+		if (task[i].target.pc_lowest < target.pc_lowest)
+			target.pc_lowest	= task[i].target.pc_lowest;
+
+		if (task[i].target.pc_highest > target.pc_highest)
+			target.pc_highest	= task[i].target.pc_highest;
+
+		if (task[i].fp_list != NULL)
+			layout_copy(task[i].fp_list, list);
+
+		layout_copy(task[i].fp_msg, (fp_msg != NULL) ? fp_msg : stderr);
+		mem_free(task[i].p_stack);
+	}
+
+	target.addr		= task[chunks - 1].target.addr;
+	target.pc		= task[chunks - 1].target.pc;
+	codeline[0]		= first + lines;
+}
+
+
+/*	*************************************************************************
+ *	Function name:	layout_emit
+ *	Description:	Assemble lines, and process barriers (assembler pass #2).
+ *	Author(s):
+ *	Created:			18 October 2026
+ *	Last modified:
+ *
+ *	Parameters:		struct layout_line_t *p_line:
+ *							Lines array.
+ *
+ *						int lines:
+ *							Number of lines.
+ *
+ *						int threads:
+ *							Maximum number of threads to use.
+ *
+ *	Returns:			void
+ *	Globals:
+ *
+ *	Notes:			- Barriers (and lines of a macro definition) are
+ *						  safe points: they are assembled alone, once all
+ *						  previous lines are assembled.
+ *	************************************************************************* */
+
+static void layout_emit(struct layout_line_t *p_line, int lines, int threads)
+{
+	char	text[SRC_LINE_WIDTH_MAX];
+	int	i	= 0;
+
+
+	while (i < lines)
+	{
+		int	last;
+
+		/*	Sequential processing.
+		 *	---------------------- */
+		if (	((p_line[i].flags & LLF_BARRIER) != 0) ||
+				(fp_macro != NULL) || (inside_macro != 0))
+		{
+			int	status;
+
+			codeline[0]	= i + 1;
+
+			strcpy(text, p_line[i].text);
+			status	= do_asm_line(text);
+
+			/*	- If an include file or a macro was openned, assemble
+			 *	  it now.
+			 *	----------------------------------------------------- */
+			if ((status != PROCESSED_END) && (file_level > 0))
+				status	= do_asm_files(1);
+
+			if (status == PROCESSED_END)
+				return;
+
+			i++;
+			continue;
+		}
+
+		/*	Search for the next barrier.
+		 *	---------------------------- */
+		for (last = i; last < lines; last++)
+		{
+			if ((p_line[last].flags & LLF_BARRIER) != 0)
+				break;
+		}
+
+		layout_emit_run(p_line, i, last - i, threads);
+		i	= last;
+	}
+
+	/*	End of main source file.
+	 *	------------------------ */
+	codeline[0]	= lines + 1;
+	do_asm_end();
+}
+
+
+/*	*************************************************************************
+ *	Function name:	layout_threads_default
+ *	Description:	Get the default number of layout threads.
+ *	Author(s):
+ *	Created:			18 October 2026
+ *	Last modified:
+ *	Parameters:		void
+ *
+ *	Returns:			int:
+ *							Number of online processors (1 if unknown).
+ *
+ *	Globals:
+ *	Notes:
+ *	************************************************************************* */
+
+int layout_threads_default(void)
+{
+	long	n	= 1;
+
+#if USE_PTHREAD && defined (_SC_NPROCESSORS_ONLN)
+	n	= sysconf(_SC_NPROCESSORS_ONLN);
+#endif
+
+	if (n < 1)
+		n	= 1;
+	else if (n > LAYOUT_THREADS_MAX)
+		n	= LAYOUT_THREADS_MAX;
+
+	return ((int) n);
+}
+
+
+/*	*************************************************************************
+ *	Function name:	layout_pass1
+ *	Description:	Assembler pass #1, using parallel layout.
+ *	Author(s):
+ *	Created:			18 October 2026
+ *	Last modified:
+ *
+ *	Parameters:		int threads:
+ *							Maximum number of threads to use.
+ *
+ *	Returns:			int:
+ *							- (-1) if parallel layout can not be done.  In
+ *							  that case, nothing was assembled, and main source
+ *							  file is rewinded.
+ *							- 0 if operation successfull.
+ *
+ *	Globals:
+ *	Notes:			- Classified lines are kept for "layout_pass2()", and
+ *						  for following layout passes ("-m" option).
+ *	************************************************************************* */
+
+int layout_pass1(int threads)
+{
+	/*	- Line sizes do not depend on label values.  So, on following
+	 *	  layout passes, only barriers and labels are processed again.
+	 *	*/
+	if ((asm_iter > 0) && (layout_line != NULL))
+	{
+		layout_walk(layout_line, layout_lines);
+		return (0);
+	}
+
+	layout_release(layout_line, layout_lines, layout_text);
+
+	layout_line		= NULL;
+	layout_text		= NULL;
+	layout_lines	= layout_prepare(threads, &layout_line, &layout_text);
+
+	if (layout_lines < 0)
+	{
+		layout_lines	= 0;
+		return (-1);
+	}
+
+	layout_walk(layout_line, layout_lines);
+
+	return (0);
+}
+
+
+/*	*************************************************************************
+ *	Function name:	layout_pass2
+ *	Description:	Assembler pass #2, using parallel encoding.
+ *	Author(s):
+ *	Created:			18 October 2026
+ *	Last modified:
+ *
+ *	Parameters:		int threads:
+ *							Maximum number of threads to use.
+ *
+ *	Returns:			int:
+ *							- (-1) if parallel encoding can not be done
+ *							  ("layout_pass1()" was not used).  In that
+ *							  case, nothing was assembled.
+ *							- 0 if operation successfull.
+ *
+ *	Globals:
+ *
+ *	Notes:			- Label values are known from assembler pass #1.  So,
+ *						  lines between barriers can be assembled in any
+ *						  order.
+ *						- Use lines classified by "layout_pass1()".
+ *	************************************************************************* */
+
+int layout_pass2(int threads)
+{
+	/*	Lines must come from assembler pass #1.
+	 *	--------------------------------------- */
+	if (layout_line == NULL)
+		return (-1);
+
+	layout_emit(layout_line, layout_lines, threads);
+	layout_release(layout_line, layout_lines, layout_text);
+
+	layout_line		= NULL;
+	layout_text		= NULL;
+	layout_lines	= 0;
+
+	return (0);
+}
+
+
+/*	*************************************************************************
+ *	Function name:	layout_cleanup
+ *	Description:	"layout" module Cleanup.
+ *	Author(s):
+ *	Created:			18 October 2026
+ *	Last modified:
+ *	Parameters:		void
+ *	Returns:			void
+ *	Globals:
+ *
+ *	Notes:			- Release lines kept by "layout_pass1()", if assembler
+ *						  pass #2 did not use them.
+ *	************************************************************************* */
+
+void layout_cleanup(void)
+{
+	layout_release(layout_line, layout_lines, layout_text);
+
+	layout_line		= NULL;
+	layout_text		= NULL;
+	layout_lines	= 0;
+}
+
@@ -0,0 +1,456 @@
+/*	*************************************************************************
+ *	Module Name:	lint.c
+ *	Description:	Performance Lint ("-Wperf" option).
+ *	Copyright(c):	See below...
+ *	Author(s):
+ *	Created:			18 October 2026
+ *	Last modified:
+ *
+ *	Notes:			- Instructions are checked on assembler pass #2, in
+ *						  order, when operands are known.  Warnings are only
+ *						  given for straight-line code: state is forgotten
+ *						  on labels, directives, macros, calls, returns and
+ *						  jumps.
+ *						- Nothing is changed in the code (See "-O" option).
+ *	************************************************************************* */
+
+/*
+ * Copyright (c) <2007-2017> Jay Cotton <lbmgmusic@gmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+
+/*	*************************************************************************
+ *	                              INCLUDE FILES
+ *	************************************************************************* */
+
+#include <stdio.h>
+
+#include "project.h"
+#include "war_code.h"		/*	Warning Codes. */
+#include "main.h"
+#include "msg.h"
+#include "opcode.h"
+#include "lint.h"
+
+
+/*	*************************************************************************
+ *											  CONSTANTS
+ *	************************************************************************* */
+
+#define LINT_MSG_SIZE_MAX		128
+
+/*	Opcodes.
+ *	-------- */
+#define OP_LXI_H					0x21
+#define OP_SHLD					0x22
+#define OP_LHLD					0x2A
+#define OP_STA						0x32
+#define OP_LDA						0x3A
+#define OP_MOV_H_A				0x67
+#define OP_MOV_L_A				0x6F
+#define OP_MOV_A_H				0x7C
+#define OP_MOV_A_L				0x7D
+#define OP_ORA_A					0xB7
+#define OP_CPI						0xFE
+#define OP_PUSH_MASK				0xCF		/*	"PUSH" / "POP", register pair field. */
+#define OP_PUSH					0xC5
+#define OP_POP						0xC1
+
+
+/*	*************************************************************************
+ *	                                VARIABLES
+ *	************************************************************************* */
+
+/*	Public variables.
+ *	***************** */
+
+int	lint_enable	= 0;		/*	"-Wperf" option. */
+
+
+/*	Private variables.
+ *	****************** */
+
+/*	- State of the straight-line code since the last label, call,
+ *	  return or jump.
+ *	*/
+static int	lda_prev		= -1;		/*	"LDA" address of the previous instruction. */
+static int	mov_prev		= -1;		/*	"MOV A,L" (0) / "MOV A,H" (1) previous. */
+static int	load_addr[2]	= {-1, -1};	/*	Byte loaded in L, H through "A". */
+static int	store_addr[2]	= {-1, -1};	/*	Byte L, H stored to through "A". */
+static int	hl_value		= -1;		/*	Value loaded by the last "LXI H". */
+static int	push_op		= -1;		/*	"PUSH" of the previous instruction. */
+
+
+/*	*************************************************************************
+ *									  FUNCTIONS DECLARATION
+ *	************************************************************************* */
+
+static int cycles(int byte);
+static int is_hl_write(int byte);
+static void forget_hl(void);
+static void warn(const char *what, const char *better, int cycles_saved, int bytes_saved);
+
+
+/*	*************************************************************************
+ *	                                FUNCTIONS
+ *	************************************************************************* */
+
+/*	*************************************************************************
+ *	Function name:	cycles
+ *	Description:	Get the number of cycles of an instruction.
+ *	Author(s):
+ *	Created:			18 October 2026
+ *	Last modified:
+ *
+ *	Parameters:		int byte:
+ *							Opcode.
+ *
+ *	Returns:			int:
+ *							Number of cycles (not taken, if conditional).
+ *
+ *	Globals:
+ *	Notes:
+ *	************************************************************************* */
+
+static int cycles(int byte)
+{
+	uint8_t	cyc[2]	= {0, 0};
+
+	opcode_decode(byte, cyc);
+
+	return (cyc[0]);
+}
+
+
+/*	*************************************************************************
+ *	Function name:	is_hl_write
+ *	Description:	Check if an instruction writes "H" or "L".
+ *	Author(s):
+ *	Created:			18 October 2026
+ *	Last modified:
+ *
+ *	Parameters:		int byte:
+ *							Opcode.
+ *
+ *	Returns:			int:
+ *							1 if "H" or "L" is written, 0 otherwise.
+ *
+ *	Globals:
+ *	Notes:			- Calls, returns and jumps are handled elsewhere.
+ *	************************************************************************* */
+
+static int is_hl_write(int byte)
+{
+	/*	"MOV H,r" and "MOV L,r".
+	 *	------------------------ */
+	if ((byte >= 0x60) && (byte <= 0x6F))
+		return (1);
+
+	/*	"DAD rp".
+	 *	--------- */
+	if ((byte & 0xCF) == 0x09)
+		return (1);
+
+	switch (byte)
+	{
+		case 0x21:		/*	LXI H */
+		case 0x23:		/*	INX H */
+		case 0x24:		/*	INR H */
+		case 0x25:		/*	DCR H */
+		case 0x26:		/*	MVI H */
+		case 0x2A:		/*	LHLD */
+		case 0x2B:		/*	DCX H */
+		case 0x2C:		/*	INR L */
+		case 0x2D:		/*	DCR L */
+		case 0x2E:		/*	MVI L */
+		case 0xE1:		/*	POP H */
+		case 0xE3:		/*	XTHL */
+		case 0xEB:		/*	XCHG */
+			return (1);
+
+		default:
+			return (0);
+	}
+}
+
+
+/*	*************************************************************************
+ *	Function name:	forget_hl
+ *	Description:	"HL" was written.  Forget what it holds.
+ *	Author(s):
+ *	Created:			18 October 2026
+ *	Last modified:
+ *	Parameters:		void
+ *	Returns:			void
+ *	Globals:
+ *	Notes:
+ *	************************************************************************* */
+
+static void forget_hl(void)
+{
+	hl_value			= -1;
+	load_addr[0]	= -1;
+	load_addr[1]	= -1;
+	store_addr[0]	= -1;
+	store_addr[1]	= -1;
+}
+
+
+/*	*************************************************************************
+ *	Function name:	warn
+ *	Description:	Print a performance warning.
+ *	Author(s):
+ *	Created:			18 October 2026
+ *	Last modified:
+ *
+ *	Parameters:		const char *what:
+ *							Instruction(s) found.
+ *
+ *						const char *better:
+ *							Cheaper equivalent, or NULL if not needed at all.
+ *
+ *						int cycles_saved:
+ *							Estimated cycles saved.
+ *
+ *						int bytes_saved:
+ *							Bytes saved.
+ *
+ *	Returns:			void
+ *	Globals:
+ *	Notes:
+ *	************************************************************************* */
+
+static void warn(const char *what, const char *better, int cycles_saved, int bytes_saved)
+{
+	char	msg[LINT_MSG_SIZE_MAX];
+	int	n;
+
+	if (better != NULL)
+		n	= sprintf(msg, "%s: %s is cheaper", what, better);
+	else
+		n	= sprintf(msg, "%s: not needed", what);
+
+	sprintf(	msg + n, " (%d cycles, %d byte%s saved)!", cycles_saved, bytes_saved,
+				(bytes_saved != 1) ? "s" : "");
+
+	msg_warning(msg, WC_CSE);
+}
+
+
+/*	*************************************************************************
+ *	Function name:	lint_reset
+ *	Description:	Start of assembler pass #2.
+ *	Author(s):
+ *	Created:			18 October 2026
+ *	Last modified:
+ *	Parameters:		void
+ *	Returns:			void
+ *	Globals:
+ *	Notes:
+ *	************************************************************************* */
+
+void lint_reset(void)
+{
+	lint_flush();
+}
+
+
+/*	*************************************************************************
+ *	Function name:	lint_flush
+ *	Description:	Forget the straight-line code state.
+ *	Author(s):
+ *	Created:			18 October 2026
+ *	Last modified:
+ *	Parameters:		void
+ *	Returns:			void
+ *	Globals:
+ *
+ *	Notes:			- Called on labels, directives and macros, as the
+ *						  registers are not known anymore.
+ *	************************************************************************* */
+
+void lint_flush(void)
+{
+	lda_prev	= -1;
+	mov_prev	= -1;
+	push_op	= -1;
+
+	forget_hl();
+}
+
+
+/*	*************************************************************************
+ *	Function name:	lint_inst
+ *	Description:	Check an instruction (assembler pass #2).
+ *	Author(s):
+ *	Created:			18 October 2026
+ *	Last modified:
+ *
+ *	Parameters:		const opcode_t *p_opcode:
+ *							Instruction, already encoded.
+ *
+ *						char *label:
+ *							Label of the line.
+ *
+ *	Returns:			void
+ *	Globals:			int b1, b2, b3
+ *
+ *	Notes:			- Savings are computed from the cycle table.
+ *	************************************************************************* */
+
+void lint_inst(const opcode_t *p_opcode, char *label)
+{
+	int	value	= b2 | (b3 << 8);
+	int	prev_push;
+	int	prev_lda;
+	int	prev_mov;
+	int	half;
+	int	prev;
+
+
+	if (asm_pass == 0)
+		return;
+
+	/*	A label can be jumped to.
+	 *	------------------------- */
+	if (*label != '\0')
+		lint_flush();
+
+	prev_push	= push_op;
+	prev_lda		= lda_prev;
+	prev_mov		= mov_prev;
+	push_op		= -1;
+	lda_prev		= -1;
+	mov_prev		= -1;
+
+	switch (b1)
+	{
+		/*	- "LDA x", "MOV L,A" ... "LDA x+1", "MOV H,A".
+		 *	  "MOV" writes HL, so other HL state is lost.
+		 *	*/
+		case OP_LDA:
+			lda_prev	= value;
+			break;
+
+		case OP_MOV_L_A:
+		case OP_MOV_H_A:
+			half	= (b1 == OP_MOV_H_A);
+			prev	= load_addr[!half];
+
+			forget_hl();
+
+			load_addr[!half]	= prev;
+			load_addr[half]	= prev_lda;
+
+			if ((load_addr[0] >= 0) && (load_addr[1] == load_addr[0] + 1))
+			{
+				warn(	"\"LDA\" / \"MOV\" of consecutive bytes to HL", "\"LHLD\"",
+						2 * (cycles(OP_LDA) + cycles(b1)) - cycles(OP_LHLD), 5);
+
+				load_addr[0]	= -1;
+				load_addr[1]	= -1;
+			}
+
+			return;
+
+		/*	"MOV A,L", "STA x" ... "MOV A,H", "STA x+1".
+		 *	-------------------------------------------- */
+		case OP_MOV_A_L:
+		case OP_MOV_A_H:
+			mov_prev	= (b1 == OP_MOV_A_H);
+			break;
+
+		case OP_STA:
+			if (prev_mov < 0)
+				break;
+
+			store_addr[prev_mov]	= value;
+
+			if ((store_addr[0] >= 0) && (store_addr[1] == store_addr[0] + 1))
+			{
+				warn(	"\"MOV\" / \"STA\" of HL to consecutive bytes", "\"SHLD\"",
+						2 * (cycles(OP_STA) + cycles(OP_MOV_A_L)) - cycles(OP_SHLD), 5);
+
+				store_addr[0]	= -1;
+				store_addr[1]	= -1;
+			}
+
+			break;
+
+		/*	"ORA A" set the same flags, except "AC".
+		 *	---------------------------------------- */
+		case OP_CPI:
+			if ((b2 & 0xFF) == 0)
+			{
+				warn(	"\"CPI 0\"", "\"ORA A\"",
+						cycles(OP_CPI) - cycles(OP_ORA_A), 1);
+			}
+
+			break;
+
+		/*	HL already loaded.
+		 *	------------------ */
+		case OP_LXI_H:
+			if (hl_value == value)
+				warn("\"LXI H\" of the value in HL", NULL, cycles(OP_LXI_H), 3);
+
+			forget_hl();
+			hl_value	= value;
+
+			return;
+
+		default:
+			break;
+	}
+
+	/*	"PUSH" / "POP" of the same register pair.
+	 *	----------------------------------------- */
+	if ((b1 & OP_PUSH_MASK) == OP_PUSH)
+		push_op	= b1;
+	else if (	((b1 & OP_PUSH_MASK) == OP_POP) && (prev_push >= 0) &&
+					(prev_push - OP_PUSH == b1 - OP_POP))
+	{
+		warn("\"PUSH\" / \"POP\" of the same pair", NULL, cycles(prev_push) + cycles(b1), 2);
+	}
+
+	/*	- Calls, returns and jumps end the straight-line code.
+	 *	  Conditional ones fall through with the same registers.
+	 *	*/
+	switch (p_opcode->flow)
+	{
+		case OF_NEXT:
+		case OF_JUMP_COND:
+		case OF_RET_COND:
+		case OF_DI:
+		case OF_EI:
+			if (is_hl_write(b1) != 0)
+				forget_hl();
+
+			break;
+
+		default:
+			lint_flush();
+			break;
+	}
+}
+
+
+
@@ -52,6 +52,17 @@
 #include "opcode.h"
 #include "exp_parser.h"
 #include "msg.h"
+#include "layout.h"
+#include "mem.h"
+#include "stats.h"
+#include "trace.h"
+#include "cycles.h"
+#include "codegen.h"
+#include "peep.h"
+#include "lint.h"
+#include "sim.h"
+#include "profile.h"
+#include "depth.h"
 #include "main.h"
 
 
@@ -63,6 +74,8 @@
 #define FN_IN_SIZE					80
 #define FN_OUT_SIZE					(FN_BASE_SIZE + 4)
 
+#define BENCH_RUNS_MAX				1000		/*	"--bench" maximum runs. */
+
 
 /*	*************************************************************************
  *	STRUCT
@@ -109,8 +122,15 @@ static int update_pc(int count);
 static void print_symbols_table(void);
 static void init(void);
 static int process_option_i(char *text);
+static int process_option_j(char *text);
+static int process_option_m(char *text);
 static int process_option_l(char *text);
 static int process_option_o(char *text);
+static int process_option_long(char *text, char *next);
+static void symbols_clear(void);
+static void bench_reset(void);
+static int bench_compare(const void *p_a, const void *p_b);
+static void bench_run(void);
 static int check_set_output_fn(void);
 static int OpenFiles(void);
 static void CloseFiles(void);
@@ -121,7 +141,7 @@ static int print_symbols_type(	enum symbol_type_t symbol_type,
 	  										int symbol_field_size, int tab_length);
 static void print_list(char *text);
 static void display_help(void);
-static int src_line_parser(char *text);
+static int layout_changes(void);
 static void asm_pass1(void);
 static void asm_pass2(void);
 static void clean_up(void);
@@ -139,25 +159,26 @@ static int cmd_line_parser(int argc, char *argv[]);
 int	if_true[10];
 int	if_nest		= 0;
 
-int	data_size	= 0;
+THREAD_LOCAL int	data_size	= 0;
 
-int	b1	= 0;
-int	b2	= 0;
-int	b3	= 0;
-int	b4	= 0;
+THREAD_LOCAL int	b1	= 0;
+THREAD_LOCAL int	b2	= 0;
+THREAD_LOCAL int	b3	= 0;
+THREAD_LOCAL int	b4	= 0;
 
 int asm_pass;			/* Assembler Pass. */
+int asm_iter	= 0;	/* Assembler Pass #1 Iteration (0 == first). */
 
-FILE	*list		= NULL;
+THREAD_LOCAL FILE	*list		= NULL;
 
-STACK	*ByteWordStack;
-TARG	target;
+THREAD_LOCAL STACK	*ByteWordStack;
+THREAD_LOCAL TARG		target;
 
-int	type;
+THREAD_LOCAL int	type;
 
 FILE	*in_fp[FILES_LEVEL_MAX];
 char	*in_fn[FILES_LEVEL_MAX];		/*	Input File Name. */
-int	codeline[FILES_LEVEL_MAX];
+THREAD_LOCAL int	codeline[FILES_LEVEL_MAX];
 
 FILE	*bin;
 FILE	*hex;
@@ -198,6 +219,23 @@ static struct	option_i_t	option_i	= {NULL, NULL};
  *	*/
 static char	print_inc	= 0;
 
+/*	- Number of threads used by assembler passes ("-j" option).
+ *	  0 = No parallel layout/encoding.
+ *	*/
+static int	layout_threads	= 0;
+
+/*	- Maximum number of assembler pass #1 iterations ("-m" option).
+ *	  1 means no iteration.
+ *	*/
+static int	layout_passes_max	= 1;
+
+/*	- Number of timed runs ("--bench" option).
+ *	  0 = No benchmark.
+ *	*/
+static int	bench_runs	= 0;
+
+static long long	bench_time[BENCH_RUNS_MAX];	/*	Run times (ns). */
+
 
 /*	*************************************************************************
  *	                           FUNCTIONS DEFINITION
@@ -654,6 +692,38 @@ static void print_symbols_table(void)
 
 static int OpenFiles(void)
 {
+	/*	- With "--bench" option, output files are not written.
+	 *	  Output goes to the null device.
+	 *	------------------------------------------------------ */
+	if (bench_runs > 0)
+	{
+		if (list_file != NULL)
+			list	= fopen(NULL_DEVICE, "w");
+
+		bin	= fopen(NULL_DEVICE, "wb");
+		hex	= fopen(NULL_DEVICE, "w");
+
+		if ((in_fp[0] = fopen(in_fn[0], "r")) == NULL)
+		{
+			fprintf(	stderr,
+				  		"*** Error %d: Can't open input file (\"%s\")!\n",
+					  	EC_COINF, in_fn[0]);
+
+			return (-1);
+		}
+
+		if (((list_file != NULL) && (list == NULL)) || (bin == NULL) || (hex == NULL))
+		{
+			fprintf(	stderr,
+				  		"*** Error %d: Can't open binary file (\"%s\")!\n",
+					  	EC_COBF, NULL_DEVICE);
+
+			return (-1);
+		}
+
+		return (0);
+	}
+
 	/* Remove old output files, if any.
 	 *	-------------------------------- */
 	if (list_file != NULL)	remove(list_file);
@@ -758,12 +828,266 @@ static void CloseFiles(void)
 }
 
 
+/*	*************************************************************************
+ *	Function name:	src_line_split
+ *	Description:	Split a source line into its fields.
+ *	Author(s):		Jay Cotton, Claude Sylvain
+ *	Created:			2007
+ *	Last modified:	18 October 2026
+ *
+ *	Parameters:		char *text:
+ *							Source line to split.
+ *
+ *						char *p_label:
+ *							- Buffer that receive the label/name.
+ *							  Size must be "LABEL_SIZE_MAX".
+ *
+ *						char *p_string:
+ *							- Buffer that receive the keyword.
+ *							  Size must be "SRC_LINE_KEYWORD_SIZE".
+ *
+ *						char *p_string_uc:
+ *							- Buffer that receive the keyword, in upper case.
+ *							  Size must be "SRC_LINE_KEYWORD_SIZE".
+ *
+ *						char *p_equation:
+ *							- Buffer that receive the equation (operand).
+ *							  Size must be "EQUATION_SIZE_MAX".
+ *
+ *	Returns:			int:
+ *							SLS_COMMENT	: Comment line.
+ *							SLS_SPECIAL	: Special command ('$').
+ *							SLS_LABEL	: Nothing else than a label/name.
+ *							SLS_KEYWORD	: A keyword was found.
+ *
+ *	Globals:
+ *
+ *	Notes:			- Was part of "src_line_parser()".
+ *						- Do not modify any global variable, and messages are
+ *						  only printed on assembler pass #2.  So, on pass #1,
+ *						  this function can be called concurrently (see
+ *						  "layout.c").
+ *	************************************************************************* */
+
+int src_line_split(	char *text, char *p_label, char *p_string,
+	  						char *p_string_uc, char *p_equation)
+{
+	int	i					= 0;
+	int	msg_displayed	= 0;
+
+
+	memset(p_label, 0, LABEL_SIZE_MAX);
+	memset(p_string, 0, SRC_LINE_KEYWORD_SIZE);
+	memset(p_string_uc, 0, SRC_LINE_KEYWORD_SIZE);
+	memset(p_equation, 0, EQUATION_SIZE_MAX * sizeof (char));
+
+	/*	Comment line.
+	 *	------------- */
+	if (text[0] == ';')
+		return (SLS_COMMENT);
+
+	/*	Special command.
+	 *	---------------- */
+	if (text[0] == '$')
+		return (SLS_SPECIAL);
+
+
+	/*	Grab the label/name, if any.
+	 *	**************************** */
+
+	/*	If there is a label/name, process it.
+	 * ------------------------------------- */
+	if (isspace((int) *text) == 0)
+	{
+		/*	Check for non valid first label/name character.
+		 *	----------------------------------------------- */
+		if (	(isdigit((int) *text) != 0) ||
+		  		((isalpha((int) *text) == 0) &&
+				((*text != '?') && (*text != '@') && (*text != '&') &&
+				(*text != '%')))
+			)
+		{
+			msg_warning_c(	"Bad first character on label/name!", WC_LNBFC,
+				  				*text);
+
+			/*	- Bypass all character(s) that can not be used as first
+			 *	  label/name character.
+			 *	*/
+			while (	(isdigit((int) *text) != 0) ||
+				  		((isalpha((int) *text) == 0) &&
+						((*text != '?') && (*text != '@') && (*text != '&') &&
+						(*text != '%')))
+					)
+			{
+				text++;
+			}
+		}
+
+		/*	TODO: Is this standard Intel assembler code?
+		 *	-------------------------------------------- */	
+		if (*text == '&')	p_label[i++] = *(text++);
+		if (*text == '%')	p_label[i++] = *(text++);
+
+		/*	- First label/name character can be '?' or '@'
+		 *	  special character.
+		 *	---------------------------------------------- */
+		if ((*text == '?') || (*text == '@'))
+			p_label[i++] = *(text++);
+
+		/*	Grab remaining of label/name characters.
+		 *	---------------------------------------- */	
+		while (1)
+		{
+			if (islabelchar((int) *text) != 0)
+			{
+				if (i < (LABEL_SIZE_MAX - 3))
+				{
+					p_label[i]	= *(text++);
+					i++;
+				}
+				else
+				{
+					text++;
+
+					/*	- Display/Print error message, if not already done,
+					 *	  and necessary.
+					 *	--------------------------------------------------- */
+					if (!msg_displayed && (asm_pass == 1))
+					{
+						msg_displayed	= 1;	/*	No more message. */
+
+						msg_warning_s("Label too long!", WC_LTL, p_label);
+					}
+				}
+			}
+			else
+			{
+				/*	If this is the end of label.
+				 *	---------------------------- */
+				if (	(isspace((int) *text) != 0) || (*text == '\0') ||
+					  	(*text == ':'))
+				{
+					/*	- TODO: Add the possibility to make "asm8080" check
+					 *	  for the presence of ':' at end of labels.
+					 *	- Notes: "Name" do not need to end with ':'.
+					 *	*/
+
+					/*	Destroy ':', if necessary.
+					 *	-------------------------- */
+					if (*text == ':')
+						text++;
+					/* Some times labels have :: at the end
+					 * this may be important is certain situations....
+					 * for now, just eat the symbol and move along.
+					 * ---------------------------------------------*/
+					if (*text == ':') text++;
+
+					break;
+				}
+				/*	This is not a valid label/name character.
+				 *	Bypass the invalid character.
+				 *	----------------------------------------- */
+				else
+				{
+					msg_warning_c(	"Invalid label/name character!", WC_ILNC,
+						  				*text);
+
+					text++;
+				}
+			}
+		}
+	}
+
+	/*	Bypass space character(s).
+	 *	-------------------------- */
+	while (isspace((int) *text) != 0)
+		text++;
+
+	/*	If nothing else than the label/name on the line...
+	 *	-------------------------------------------------- */	
+	if ((*text == '\0') || (*text == ';')&&(*(text-1)!=';'))
+		return (SLS_LABEL);
+
+
+	/*	Grab the keyword (assembler directive or opcode).
+	 *	************************************************* */
+
+	i					= 0;
+	msg_displayed	= 0;
+
+	while ((isalnum((int) *text)) || (*text == '_'))
+	{
+		if (i < (SRC_LINE_KEYWORD_SIZE - 1))
+		{
+			p_string[i]		= *text;
+			p_string_uc[i]	= toupper((int) *text);
+
+			text++;
+			i++;
+		}
+		else
+		{
+			text++;
+
+			/*	- Display/Print error message, if not already done,
+			 *	  and necessary.
+			 *	--------------------------------------------------- */
+			if (!msg_displayed && (asm_pass == 1))
+			{
+				msg_displayed	= 1;	/*	No more message. */
+
+				msg_error_s("Keyword too long!", EC_KTL, p_string);
+			}
+		}
+	}
+
+	/*	Bypass delimitors, if necessary.
+	 *	-------------------------------- */
+	while (isspace((int) *text))
+		text++;
+
+	/*	Copy third field to equation buffer.
+	 *	************************************	*/
+
+	if ((*text != '\0') || (*text != ';')&&(*(text-1)!=';'))
+	{
+		i					= 0;
+		msg_displayed	= 0;
+
+		while ((iscntrl((int) *text) == 0) && ((*text != ';')||(*(text-1)==';')))
+		{
+			if (i < ((EQUATION_SIZE_MAX * sizeof (char)) - 1))
+			{
+				p_equation[i]	= *(text++);
+				i++;
+			}
+			else
+			{
+				text++;
+
+				/*	- Display/Print error message, if not already done,
+				 *	  and necessary.
+				 *	--------------------------------------------------- */
+				if (!msg_displayed && (asm_pass == 1))
+				{
+					msg_displayed	= 1;	/*	No more message. */
+
+					msg_error_s("Equation too long!", EC_ETL, p_equation);
+				}
+			}
+		}
+	}
+
+	return (SLS_KEYWORD);
+}
+
+
 /*	*************************************************************************
  *	Function name:	src_line_parser
  *	Description:	Break down a source line.
  *	Author(s):		Jay Cotton, Claude Sylvain
  *	Created:			2007
- *	Last modified:	2015-10-18
+ *	Last modified:	18 October 2026
  *
  *	Parameters:		char *text:
  *							...
@@ -777,38 +1101,33 @@ static void CloseFiles(void)
  *						  do not check for empty line.
  *	************************************************************************* */
 
-static int src_line_parser(char *text)
+int src_line_parser(char *text)
 {
-/*	"p_string" and "p_string_uc" size (the allocated memory).
- *	*/
-#define SCR_LINE_PARSER_P_STRING_SIZE		SYMBOL_SIZE_MAX
-
-
 char	*p_string;
 char	*p_string_uc;							/*	String in Upper Case. */
 char	*p_equation;
 char	*p_label;
 
 int	i		= 0;
-int	msg_displayed	= 0;
+int	sls;										/*	Source Line Split status. */
 int	status		= LIST_ONLY;
 
 
 	/*	Allocate space for "Key Word".
 	 *	*/
-	p_string = (char *) malloc(SCR_LINE_PARSER_P_STRING_SIZE * sizeof (char));
+	p_string = (char *) mem_alloc(MT_LINE, SRC_LINE_KEYWORD_SIZE * sizeof (char));
 
 	/*	Allocate space for "Key Word, Upper Case".
 	 *	*/
-	p_string_uc = (char *) malloc(SCR_LINE_PARSER_P_STRING_SIZE * sizeof (char));
+	p_string_uc = (char *) mem_alloc(MT_LINE, SRC_LINE_KEYWORD_SIZE * sizeof (char));
 
 	/*	Allocate space for "Equation".
 	 *	*/
-	p_equation = (char *) malloc(EQUATION_SIZE_MAX * sizeof (char));
+	p_equation = (char *) mem_alloc(MT_LINE, EQUATION_SIZE_MAX * sizeof (char));
 
 	/*	Allocate space for "Label".
 	 *	*/
-	p_label = (char *) malloc(LABEL_SIZE_MAX * sizeof (char));
+	p_label = (char *) mem_alloc(MT_LINE, LABEL_SIZE_MAX * sizeof (char));
 
 	/*	If unable to allocate space for some objects, abort operation.
 	 *	-------------------------------------------------------------- */
@@ -817,17 +1136,21 @@ int	status		= LIST_ONLY;
 	{
 		msg_error("Memory allocation error!", EC_MAE);
 
-		free(p_string);
-		free(p_string_uc);
-		free(p_equation);
-		free(p_label);
+		mem_free(p_string);
+		mem_free(p_string_uc);
+		mem_free(p_equation);
+		mem_free(p_label);
 
 		return (status);
 	}
 
+	/*	Split source line into its fields.
+	 *	*/
+	sls	= src_line_split(text, p_label, p_string, p_string_uc, p_equation);
+
 	/*	If this is a comment, don't do anything.
 	 *	---------------------------------------- */	
-	if (text[0] == ';')
+	if (sls == SLS_COMMENT)
 	{
 		/*	TODO: Why "type" and "status" are not the same ???
 		 *	*/
@@ -841,7 +1164,7 @@ int	status		= LIST_ONLY;
 	 *	  For the moment, just ignore lines that contain such special
 	 *	  command.
 	 *	------------------------------------------------------------------ */
-	else if (text[0] == '$')
+	else if (sls == SLS_SPECIAL)
 	{
 		if (inside_macro == 0)
 			msg_error_s("Special command not supported!", WC_SCNS, text);
@@ -856,127 +1179,11 @@ int	status		= LIST_ONLY;
   	else
   	{
 		keyword_t   *p_keyword;
-
-		memset(p_label, 0, LABEL_SIZE_MAX);
-		memset(p_string, 0, SCR_LINE_PARSER_P_STRING_SIZE);
-		memset(p_string_uc, 0, SCR_LINE_PARSER_P_STRING_SIZE);
-		memset(p_equation, 0, EQUATION_SIZE_MAX * sizeof (char));
-
-
-		/*	Grab the label/name, if any.
-		 *	**************************** */
-
-		/*	If there is a label/name, process it.
-		 * ------------------------------------- */
-		if (isspace((int) *text) == 0)
-		{
-			/*	Check for non valid first label/name character.
-			 *	----------------------------------------------- */
-			if (	(isdigit((int) *text) != 0) ||
-			  		((isalpha((int) *text) == 0) &&
-					((*text != '?') && (*text != '@') && (*text != '&') &&
-					(*text != '%')))
-				)
-			{
-				msg_warning_c(	"Bad first character on label/name!", WC_LNBFC,
-					  				*text);
-
-				/*	- Bypass all character(s) that can not be used as first
-				 *	  label/name character.
-				 *	*/
-				while (	(isdigit((int) *text) != 0) ||
-					  		((isalpha((int) *text) == 0) &&
-							((*text != '?') && (*text != '@') && (*text != '&') &&
-							(*text != '%')))
-						)
-				{
-					text++;
-				}
-			}
-
-			/*	TODO: Is this standard Intel assembler code?
-			 *	-------------------------------------------- */	
-			if (*text == '&')	p_label[i++] = *(text++);
-			if (*text == '%')	p_label[i++] = *(text++);
-
-			/*	- First label/name character can be '?' or '@'
-			 *	  special character.
-			 *	---------------------------------------------- */
-			if ((*text == '?') || (*text == '@'))
-				p_label[i++] = *(text++);
-
-			/*	Grab remaining of label/name characters.
-			 *	---------------------------------------- */	
-			while (1)
-			{
-				if (islabelchar((int) *text) != 0)
-				{
-					if (i < (LABEL_SIZE_MAX - 3))
-					{
-						p_label[i]	= *(text++);
-						i++;
-					}
-					else
-					{
-						text++;
-
-						/*	- Display/Print error message, if not already done,
-						 *	  and necessary.
-						 *	--------------------------------------------------- */
-						if (!msg_displayed && (asm_pass == 1))
-						{
-							msg_displayed	= 1;	/*	No more message. */
-
-							msg_warning_s("Label too long!", WC_LTL, p_label);
-						}
-					}
-				}
-				else
-				{
-					/*	If this is the end of label.
-					 *	---------------------------- */
-					if (	(isspace((int) *text) != 0) || (*text == '\0') ||
-						  	(*text == ':'))
-					{
-						/*	- TODO: Add the possibility to make "asm8080" check
-						 *	  for the presence of ':' at end of labels.
-						 *	- Notes: "Name" do not need to end with ':'.
-						 *	*/
-
-						/*	Destroy ':', if necessary.
-						 *	-------------------------- */
-						if (*text == ':')
-							text++;
-						/* Some times labels have :: at the end
-						 * this may be important is certain situations....
-						 * for now, just eat the symbol and move along.
-						 * ---------------------------------------------*/
-						if (*text == ':') text++;
-
-						break;
-					}
-					/*	This is not a valid label/name character.
-					 *	Bypass the invalid character.
-					 *	----------------------------------------- */
-					else
-					{
-						msg_warning_c(	"Invalid label/name character!", WC_ILNC,
-							  				*text);
-
-						text++;
-					}
-				}
-			}
-		}
-
-		/*	Bypass space character(s).
-		 *	-------------------------- */
-		while (isspace((int) *text) != 0)
-			text++;
+		const opcode_t	*p_opcode;
 
 		/*	If nothing else than the label/name on the line...
 		 *	-------------------------------------------------- */	
-		if ((*text == '\0') || (*text == ';')&&(*(text-1)!=';'))
+		if (sls == SLS_LABEL)
 		{
 			/*	- If code section is activated and there is no macro
 			 *	  definition processed, process label.
@@ -986,7 +1193,15 @@ int	status		= LIST_ONLY;
 			 *	  processing here.
 			 *	---------------------------------------------------------- */
 			if ((util_is_cs_enable() != 0) && (inside_macro == 0))
+			{
+				if (peep_enable != 0)
+					peep_label(p_label);
+
+				if (lint_enable != 0)
+					lint_flush();
+
 				process_label(p_label);
+			}
 
 			/*	TODO: Why "type" and "status" are not the same ???
 			 *	*/
@@ -995,84 +1210,15 @@ int	status		= LIST_ONLY;
 			 * */
 			type		= COMMENT;
 
-			free(p_string);
-			free(p_string_uc);
-			free(p_equation);
-			free(p_label);
+			mem_free(p_string);
+			mem_free(p_string_uc);
+			mem_free(p_equation);
+			mem_free(p_label);
 
 			return (LIST_ONLY);
 		}
 
 
-		/*	Grab the keyword (assembler directive or opcode).
-		 *	************************************************* */
-
-		i					= 0;
-		msg_displayed	= 0;
-
-		while ((isalnum((int) *text)) || (*text == '_'))
-		{
-			if (i < (SCR_LINE_PARSER_P_STRING_SIZE - 1))
-			{
-				p_string[i]		= *text;
-				p_string_uc[i]	= toupper((int) *text);
-
-				text++;
-				i++;
-			}
-			else
-			{
-				text++;
-
-				/*	- Display/Print error message, if not already done,
-				 *	  and necessary.
-				 *	--------------------------------------------------- */
-				if (!msg_displayed && (asm_pass == 1))
-				{
-					msg_displayed	= 1;	/*	No more message. */
-
-					msg_error_s("Keyword too long!", EC_KTL, p_string);
-				}
-			}
-		}
-
-		/*	Bypass delimitors, if necessary.
-		 *	-------------------------------- */
-		while (isspace((int) *text))
-			text++;
-
-		/*	Copy third field to equation buffer.
-		 *	************************************	*/
-
-		if ((*text != '\0') || (*text != ';')&&(*(text-1)!=';'))
-		{
-			i					= 0;
-			msg_displayed	= 0;
-
-			while ((iscntrl((int) *text) == 0) && ((*text != ';')||(*(text-1)==';')))
-			{
-				if (i < ((EQUATION_SIZE_MAX * sizeof (char)) - 1))
-				{
-					p_equation[i]	= *(text++);
-					i++;
-				}
-				else
-				{
-					text++;
-
-					/*	- Display/Print error message, if not already done,
-					 *	  and necessary.
-					 *	--------------------------------------------------- */
-					if (!msg_displayed && (asm_pass == 1))
-					{
-						msg_displayed	= 1;	/*	No more message. */
-
-						msg_error_s("Equation too long!", EC_ETL, p_equation);
-					}
-				}
-			}
-		}
-
 		/*	- Lookup for assembler directives, and call associated
 		 *	  function if necessary.
 		 *	****************************************************** */
@@ -1087,15 +1233,21 @@ int	status		= LIST_ONLY;
 		  	{
 				if (inside_macro == 0)
 				{
+					if (peep_enable != 0)
+						peep_flush();
+
+					if (lint_enable != 0)
+						lint_flush();
+
 					status	= p_keyword->fnc(p_label, p_equation);
 					type		= status;
 
 					if (status == PROCESSED_END)
 					{
-						free(p_string);
-						free(p_string_uc);
-						free(p_equation);
-						free(p_label);
+						mem_free(p_string);
+						mem_free(p_string_uc);
+						mem_free(p_equation);
+						mem_free(p_label);
 
 						return (status);
 					}
@@ -1118,10 +1270,10 @@ int	status		= LIST_ONLY;
 		 *	----------------------------------------------------- */	
 		if (p_keyword->Name != NULL)
 		{
-			free(p_string);
-			free(p_string_uc);
-			free(p_equation);
-			free(p_label);
+			mem_free(p_string);
+			mem_free(p_string_uc);
+			mem_free(p_equation);
+			mem_free(p_label);
 
 			return (status);
 		}
@@ -1135,43 +1287,83 @@ int	status		= LIST_ONLY;
 			type		= LIST_ONLY;
 			status	= LIST_ONLY;
 
-			free(p_string);
-			free(p_string_uc);
-			free(p_equation);
-			free(p_label);
+			mem_free(p_string);
+			mem_free(p_string_uc);
+			mem_free(p_equation);
+			mem_free(p_label);
 
 			return (status);
 		}
 
 
-		/* - Lookup for opcodes, and call associated
-		 *  function if necessary.
-		 * ***************************************** */
+		/* - Lookup for opcodes, and encode it if necessary.
+		 * ************************************************* */
 
-		p_keyword = (keyword_t *) OpCodes;
+		p_opcode = OpCodes;
 
-		while (p_keyword->Name)
+		while (p_opcode->Name)
 		{
-			/* If keyword is found, call the associated function.
-			 * -------------------------------------------------- */	
-			if (!strcmp(p_keyword->Name, p_string_uc))
+			/* If opcode is found, encode it.
+			 * ------------------------------ */	
+			if (!strcmp(p_opcode->Name, p_string_uc))
 			{
-				status	= p_keyword->fnc(p_label, p_equation);
-				type	= status;
+				/*	- On assembler pass #1, only instruction size matters.
+				 *	  Operand is evaluated on assembler pass #2 only.
+				 *	------------------------------------------------------ */
+				if (asm_pass == 0)
+				{
+					int	removed	= (peep_enable != 0) ?
+						  				peep_layout(p_opcode, p_label, p_equation) : 0;
+
+					status	= opcode_layout(p_opcode, p_label);
+
+					/*	Removed by the peephole optimizer.
+					 *	*/
+					if (removed != 0)
+					{
+						data_size	= 0;
+						status		= COMMENT;
+					}
+				}
+				else
+				{
+					const opcode_t	*p_emit	= p_opcode;
+
+					status	= opcode_encode(p_opcode, p_label, p_equation);
+
+					if (peep_enable != 0)
+						p_emit	= peep_encode(p_opcode, p_equation);
+
+					if (p_emit == NULL)
+						status	= COMMENT;
+					else
+					{
+						if (cycles_enable != 0)
+							cycles_note(target.pc, p_emit, text);
+
+						if (depth_enable != 0)
+							depth_note(target.pc, p_emit, text);
+
+						if (lint_enable != 0)
+							lint_inst(p_emit, p_label);
+					}
+				}
+
+				type	= status;
 				break;
 			}
 			else
-				p_keyword++;
+				p_opcode++;
 		}
 
 		/* If opcode was found and processed, exit.
 		 * ---------------------------------------- */	
-		if (p_keyword->Name != NULL)
+		if (p_opcode->Name != NULL)
 		{
-			free(p_string);
-			free(p_string_uc);
-			free(p_equation);
-			free(p_label);
+			mem_free(p_string);
+			mem_free(p_string_uc);
+			mem_free(p_equation);
+			mem_free(p_label);
 			return (status);
 		}
 
@@ -1179,6 +1371,12 @@ int	status		= LIST_ONLY;
 		/*	Try with a macro.
 		 *	***************** */
 
+		if (peep_enable != 0)
+			peep_flush();
+
+		if (lint_enable != 0)
+			lint_flush();
+
 		/* Remember actual File Level.
 		 * This will serve us later to see if macro was found or not.
 		 * */
@@ -1194,7 +1392,7 @@ int	status		= LIST_ONLY;
 			/*	Open include file.
 			 *	****************** */	
 
-			fn_macro = (char *) malloc(strlen(p_string_uc) + 3);
+			fn_macro = (char *) mem_alloc(MT_MACROS, strlen(p_string_uc) + 3);
 
 			if (fn_macro != NULL)
 			{
@@ -1212,7 +1410,7 @@ int	status		= LIST_ONLY;
 				{
 					/* Allocate memory for the input file name.
 					 * */	
-					in_fn[file_level] = (char *) malloc(strlen(fn_macro) + 1);
+					in_fn[file_level] = (char *) mem_alloc(MT_FILES, strlen(fn_macro) + 1);
 
 					/* Check for memory allocation error.
 					 * --------------------------------- */	
@@ -1220,6 +1418,11 @@ int	status		= LIST_ONLY;
 					{
 						strcpy(in_fn[file_level], fn_macro);	/*	Save input file name. */
 						codeline[file_level]	= 0;
+
+						trace_begin("macro", in_fn[file_level]);
+
+						if (asm_pass == 1)
+							STATS_COUNT(SC_MACROS, 1);
 #if 0
 						/* - Check if macro have paramaters.
 						 * - If macro have parameters, warn user that macro
@@ -1240,7 +1443,7 @@ int	status		= LIST_ONLY;
 					}
 				}
 
-				free(fn_macro);
+				mem_free(fn_macro);
 			}
 			else
 			{
@@ -1275,10 +1478,10 @@ int	status		= LIST_ONLY;
 		}
 	}
 
-	free(p_string);
-	free(p_string_uc);
-	free(p_equation);
-	free(p_label);
+	mem_free(p_string);
+	mem_free(p_string_uc);
+	mem_free(p_equation);
+	mem_free(p_label);
 
 	return (status);
 }
@@ -1321,7 +1524,7 @@ static void print_list(char *text)
 		case COMMENT:
 			if (list != NULL)
 			{
-				char	str_gap[8];
+				char	str_gap[8 + PROFILE_COLUMN_SIZE];
 
 				/*	- Check if we have to print Instruction Number of
 				 *	  Cycles, and prepare to print accordingly.
@@ -1331,6 +1534,8 @@ static void print_list(char *text)
 				else
 					*str_gap = '\0';
 
+				strcat(str_gap, profile_gap());
+
 				fprintf(	list, "%6d %s\t\t\t%s\n", codeline[file_level],
 					  		str_gap, text);
 			}
@@ -1346,6 +1551,7 @@ static void print_list(char *text)
 					if (list != NULL)
 					{
 						char		str_inc[16];
+						char		str_prof[PROFILE_COLUMN_SIZE];
 
 						/*	- Check if we have to print Instruction Number of
 						 *	  Cycles, and prepare to print accordingly.
@@ -1366,8 +1572,10 @@ static void print_list(char *text)
 						else
 							*str_inc	= '\0';
 
-						fprintf(	list, "%6d %s%04X %02X\t\t%s\n",
-							  		codeline[file_level], str_inc, target.pc,
+						profile_column(str_prof, target.pc, data_size, b1);
+
+						fprintf(	list, "%6d %s%s%04X %02X\t\t%s\n",
+							  		codeline[file_level], str_inc, str_prof, target.pc,
 								  	b1, text);
 					}
 
@@ -1378,6 +1586,7 @@ static void print_list(char *text)
 					if (list != NULL)
 					{
 						char		str_inc[16];
+						char		str_prof[PROFILE_COLUMN_SIZE];
 
 						/*	- Check if we have to print Instruction Number of
 						 *	  Cycles, and prepare to print accordingly.
@@ -1398,9 +1607,11 @@ static void print_list(char *text)
 						else
 							*str_inc	= '\0';
 
+						profile_column(str_prof, target.pc, data_size, b1);
+
 						/*fprintf(list,"%6d %s%04X %02X %02X\t\t%s\n",*/
-						fprintf(list,"%6d %s%04X %02X %02X\t%s\n",
-							  		codeline[file_level], str_inc, target.pc,
+						fprintf(list,"%6d %s%s%04X %02X %02X\t%s\n",
+							  		codeline[file_level], str_inc, str_prof, target.pc,
 								  	b1, b2, text);
 					}
 					break;
@@ -1411,6 +1622,7 @@ static void print_list(char *text)
 					if (list != NULL)
 					{
 						char		str_inc[16];
+						char		str_prof[PROFILE_COLUMN_SIZE];
 
 						/*	- Check if we have to print Instruction Number of
 						 *	  Cycles, and prepare to print accordingly.
@@ -1431,8 +1643,10 @@ static void print_list(char *text)
 						else
 							*str_inc	= '\0';
 
-						fprintf(	list, "%6d %s%04X %02X %02X %02X\t%s\n",
-							  		codeline[file_level], str_inc, target.pc,
+						profile_column(str_prof, target.pc, data_size, b1);
+
+						fprintf(	list, "%6d %s%s%04X %02X %02X %02X\t%s\n",
+							  		codeline[file_level], str_inc, str_prof, target.pc,
 								  	b1, b2, b3, text);
 					}
 
@@ -1444,7 +1658,7 @@ static void print_list(char *text)
 				default:
 					if (list != NULL)
 					{
-						char	str_gap[8];
+						char	str_gap[8 + PROFILE_COLUMN_SIZE];
 
 						/*	- Check if we have to print Instruction Number of
 						 *	  Cycles, and prepare to print accordingly.
@@ -1454,6 +1668,8 @@ static void print_list(char *text)
 						else
 							*str_gap = '\0';
 
+						strcat(str_gap, profile_gap());
+
 						fprintf(	list, "%6d %s     %02X %02X\t%s\n",
 							  		codeline[file_level], str_gap, b2, b1, text);
 					}
@@ -1466,7 +1682,7 @@ static void print_list(char *text)
 		case PROCESSED_END:
 			if (list != NULL)
 			{
-				char	str_gap[8];
+				char	str_gap[8 + PROFILE_COLUMN_SIZE];
 				int	src_line;
 
 				/*	- Set the source line to display.
@@ -1492,6 +1708,8 @@ static void print_list(char *text)
 				else
 					*str_gap = '\0';
 
+				strcat(str_gap, profile_gap());
+
 				/*	Check if "text" contain something, and print accordingly.
 				 *	--------------------------------------------------------- */
 				if (strlen(text) > 0)
@@ -1518,7 +1736,39 @@ static void print_list(char *text)
 
 			if (list != NULL)
 			{
-				char	str_gap[8];
+				char	str_gap[8 + PROFILE_COLUMN_SIZE];
+
+				/*	- Check if we have to print Instruction Number of
+				 *	  Cycles, and prepare to print accordingly.
+				 *	------------------------------------------------- */
+				if (print_inc != 0)
+					strcpy(str_gap, "      ");
+				else
+					*str_gap = '\0';
+
+				strcat(str_gap, profile_gap());
+
+				fprintf(	list, "%6d %s%04X\t\t%s\n", codeline[file_level],
+					  		str_gap, target.pc, text);
+			}
+
+			break;
+
+		case LIST_CODE:
+			/*	Generated code: Bytes are stocked as "LIST_BYTES".
+			 *	-------------------------------------------------- */
+			for (data_size = 0; LStack->next; data_size++)
+				LStack = (STACK *) LStack->next;
+
+			check_new_pc(data_size);		/*	Check the new PC value. */
+
+			/*	Restore stack pointer.
+			 *	*/
+			LStack	= ByteWordStack;
+
+			if (list != NULL)
+			{
+				char	str_gap[8 + PROFILE_COLUMN_SIZE];
 
 				/*	- Check if we have to print Instruction Number of
 				 *	  Cycles, and prepare to print accordingly.
@@ -1528,8 +1778,12 @@ static void print_list(char *text)
 				else
 					*str_gap = '\0';
 
+				strcat(str_gap, profile_gap());
+
 				fprintf(	list, "%6d %s%04X\t\t%s\n", codeline[file_level],
 					  		str_gap, target.pc, text);
+
+				codegen_list(list, print_inc);
 			}
 
 			break;
@@ -1564,7 +1818,7 @@ static void print_list(char *text)
 
 			if (list != NULL)
 			{
-				char	str_gap[8];
+				char	str_gap[8 + PROFILE_COLUMN_SIZE];
 
 				/*	- Check if we have to print Instruction Number of
 				 *	  Cycles, and prepare to print accordingly.
@@ -1574,6 +1828,8 @@ static void print_list(char *text)
 				else
 					*str_gap = '\0';
 
+				strcat(str_gap, profile_gap());
+
 				fprintf(	list, "%6d %s%04X\t\t%s\n", codeline[file_level],
 					  		str_gap, target.pc, text);
 
@@ -1619,9 +1875,9 @@ static void print_list(char *text)
 						 *	  Cycles, and print accordingly.
 						 *	------------------------------------------------- */
 						if (print_inc != 0)
-							fprintf(list, "\n                  ");
+							fprintf(list, "\n                  %s", profile_gap());
 						else
-							fprintf(list, "\n            ");
+							fprintf(list, "\n            %s", profile_gap());
 					}
 
 					space = 0;
@@ -1666,10 +1922,18 @@ void ProcessDumpBin(void)
 	 *	--------------------------------- */
 	if ((target.pc_highest > 0) && (asm_pass == 1))
 	{
+		struct stats_clock_t	clk;
+
+		stats_start(ST_BIN, &clk);
+		trace_begin("output", "Binary file");
+
 		/*	Write binary.
 		 *	*/
 		fwrite(	&Image[target.pc_lowest],
 			  		target.pc_highest - target.pc_lowest, 1, bin);
+
+		trace_end("Binary file");
+		stats_stop(ST_BIN, &clk);
 	}
 }
 
@@ -1698,10 +1962,16 @@ void ProcessDumpHex(char end_of_asm)
 {
 	int	addr_end;
 
+	struct stats_clock_t	clk;
+
+
 	/*	Process only on assembler pass #2.
 	 *	*/
 	if (asm_pass != 1)	return;
 
+	stats_start(ST_HEX, &clk);
+	trace_begin("output", "HEX file");
+
 	/*	Set Highest Address accordingly to "target.addr".
 	 *	------------------------------------------------- */	
 	if (target.addr <= 0x10000)
@@ -1775,6 +2045,9 @@ void ProcessDumpHex(char end_of_asm)
 	 *	------------------------------------------------------------- */	  
 	if (end_of_asm != 0)
 		fprintf(hex, ":00000001FF\n");
+
+	trace_end("HEX file");
+	stats_stop(ST_HEX, &clk);
 }
 
 
@@ -1798,6 +2071,7 @@ static void DumpBin(void)
 {
 STACK	*DLStack;
 STACK	*LStack	= ByteWordStack;
+int	addr		= target.addr;
 
 
 	switch (type)
@@ -1862,11 +2136,12 @@ STACK	*LStack	= ByteWordStack;
 		case LIST_BYTES:
 		case LIST_WORDS:
 		case LIST_STRINGS:
+		case LIST_CODE:
 			/* Don't count last byte/word.
 			 *	--------------------------- */
 			while (LStack->next)
 			{
-				if ((type == LIST_BYTES) || (type == LIST_STRINGS))
+				if ((type == LIST_BYTES) || (type == LIST_STRINGS) || (type == LIST_CODE))
 				{
 					Image[target.pc] = LStack->word & 0xFF;
 					update_pc(1);
@@ -1895,7 +2170,7 @@ STACK	*LStack	= ByteWordStack;
 				do
 				{
 					LStack	= (STACK *) LStack->next;
-					free(DLStack);
+					mem_free(DLStack);
 					DLStack	= LStack;
 				} while (LStack);
 
@@ -1907,45 +2182,233 @@ STACK	*LStack	= ByteWordStack;
 		default:
 			break;	
 	}
+
+	/*	Count emitted bytes ("DS" only reserve space).
+	 *	---------------------------------------------- */
+	if ((asm_pass == 1) && (type != LIST_DS))
+	{
+		STATS_COUNT(SC_BYTES, target.addr - addr);
+		TRACE_COUNT(TC_BYTES, target.addr - addr);
+	}
 }
 
 
 /*	*************************************************************************
- *	Function name:	do_asm
- *	Description:	Assemble source file.
+ *	Function name:	do_asm_end
+ *	Description:	End of Assembly process.
  *	Author(s):		Jay Cotton, Claude Sylvain
  *	Created:			2007
- *	Last modified:	1 June 2013
+ *	Last modified:	18 October 2026
  *	Parameters:		void
  *	Returns:			void
  *	Globals:
- *	Notes:
+ *
+ *	Notes:			- Called when end of main source file is reached, or
+ *						  when "END" directive is processed.
+ *						- Was part of "do_asm()".
  *	************************************************************************* */
 
-static void do_asm(void)
+void do_asm_end(void)
+{
+	ProcessDumpBin();
+	ProcessDumpHex(1);
+
+	/*	Check "CYCLES" directive budgets, now that all code is known.
+	 *	------------------------------------------------------------- */
+	if (asm_pass == 1)
+		cycles_check();
+
+	/*	Print symbols table, if necessary.
+	 *	---------------------------------- */	
+	if ((list != NULL) && (asm_pass == 1))
+	{
+		struct stats_clock_t	clk;
+
+		stats_start(ST_LIST, &clk);
+		trace_begin("output", "Symbols table");
+		print_symbols_table();
+		trace_end("Symbols table");
+		stats_stop(ST_LIST, &clk);
+	}
+}
+
+
+/*	*************************************************************************
+ *	Function name:	do_asm_line
+ *	Description:	Assemble one source line.
+ *	Author(s):		Jay Cotton, Claude Sylvain
+ *	Created:			2007
+ *	Last modified:	18 October 2026
+ *
+ *	Parameters:		char *p_text:
+ *							- Source line, as read by "fgets()" (New Line
+ *							  character included, if any).
+ *
+ *	Returns:			int:
+ *							- PROCESSED_END if an "END" directive was
+ *							  processed (assembly process is terminated).
+ *							- Otherwise, processing status of the line.
+ *
+ *	Globals:
+ *	Notes:			- Was part of "do_asm()".
+ *	************************************************************************* */
+
+int do_asm_line(char *p_text)
+{
+int		EmitBin	= LIST_ONLY;
+size_t	str_len;
+
+struct stats_clock_t	clk;
+
+
+	type 	= LIST_ONLY;
+
+	if (asm_pass == 1)
+		STATS_COUNT(SC_LINES, 1);
+
+	/*	If there is an active macro, save line to the macro file.
+	 *	--------------------------------------------------------- */
+	if (fp_macro != NULL)
+		fputs(p_text, fp_macro);
+
+	str_len	= strlen(p_text);		/*	Get the length of the source line. */
+
+	/*	Destroy New Line character, if necessary.
+	 *	----------------------------------------- */
+	if ((str_len > 0) && (p_text[str_len - 1] == '\n'))
+		p_text[--str_len] = '\0';
+
+	/*	- If source line contain something, process it.
+	 *	- Notes: Do not parse line that only contain
+	 *	  Ctrl+Z ASCII control code, because this is
+	 *	  the end of file mark for CP/M text file; and
+	 *	  that such files comming from the old age can
+	 *	  be processed by "asm8080".
+	 *	----------------------------------------------- */
+	if ((str_len >= 1) && ((str_len > 2) || ((*p_text != 0x1A))))
+	{
+		EmitBin = src_line_parser(p_text);
+
+		if (util_is_cs_enable() == 0)
+			type = LIST_ONLY;
+	}
+
+	/*	- When "END" directive was processed, don't print list
+	 *	  immediatly.  This will be done later...
+	 *	------------------------------------------------------ */	 
+	if (EmitBin != PROCESSED_END)
+	{
+		stats_start(ST_LIST, &clk);
+		print_list(p_text);
+		stats_stop(ST_LIST, &clk);
+	}
+
+	if (util_is_cs_enable() == 1)
+		DumpBin();
+
+	/*	If an "END" directive was executed...
+	 *	------------------------------------- */	
+	if (EmitBin == PROCESSED_END)
+	{
+		/*	If the "END" directive was found inside an include file...
+		 *	---------------------------------------------------------- */
+		if ((file_level > 0) && (asm_pass == 1))
+		{
+			msg_warning(	"\"END\" directive found inside an include file!",
+				  				WC_EDFIIF);
+		}
+
+		stats_start(ST_LIST, &clk);
+		print_list(p_text);
+		stats_stop(ST_LIST, &clk);
+
+		do_asm_end();
+
+		/*	If the "END" directive was found inside an include file...
+		 *	---------------------------------------------------------- */
+		if (file_level > 0)
+		{
+			int	i;
+
+			/*	- Close all openned included files, and free associated
+			 *	  resources.
+			 *	------------------------------------------------------- */	
+			for (i = file_level; i > 0; i--)
+			{
+				trace_end(in_fn[i]);
+
+				/*	Close input file handle.
+				 *	------------------------ */
+				fclose(in_fp[i]);
+				in_fp[i]	= NULL;
+
+				/*	Free memory allocated for the input file name.
+				 *	---------------------------------------------- */
+				mem_free(in_fn[i]);
+				in_fn[i]	= NULL;
+			}
+
+			file_level	= 0;		/*	We are now at level 0. */
+		}
+
+		return (EmitBin);			/*	Terminate assembly process. */
+	}
+
+	data_size=
+  	b1	=
+  	b2	=
+  	b3	=
+  	b4	= 0;
+
+	return (EmitBin);
+}
+
+
+/*	*************************************************************************
+ *	Function name:	do_asm_files
+ *	Description:	Assemble source files.
+ *	Author(s):		Jay Cotton, Claude Sylvain
+ *	Created:			2007
+ *	Last modified:	18 October 2026
+ *
+ *	Parameters:		int level:
+ *							- Lowest file level to process.  Processing stop
+ *							  when end of file at that level is reached.
+ *							  Use 0 to assemble up to the end of the main
+ *							  source file.
+ *
+ *	Returns:			int:
+ *							- PROCESSED_END if assembly process is
+ *							  terminated ("END" directive, or end of main
+ *							  source file).
+ *							- KWPS_NONE if file level went below "level".
+ *
+ *	Globals:
+ *	Notes:			- Was "do_asm()".
+ *	************************************************************************* */
+
+int do_asm_files(int level)
 {
 char	*p_text;
 char	*p_text_1;
-int	EmitBin;
 int	eol_found;			/*	End Of Line Found. */
-size_t	str_len;
+int	rv	= PROCESSED_END;
 
 
 	/*	- Allocated memory for source line buffer, and check for
 	 *	  memory allocation error.
 	 *	-------------------------------------------------------- */	  
-	if ((p_text = (char *) malloc(SRC_LINE_WIDTH_MAX)) == NULL)
+	if ((p_text = (char *) mem_alloc(MT_LINE, SRC_LINE_WIDTH_MAX)) == NULL)
 	{
 		fprintf(stderr, "*** Error %d: Can't allocate memory!\n", EC_CAM);
 
-		return;
+		return (rv);
 	}
 
 	/*	Assemble source file.
 	 *	--------------------- */
 	while (1)
 	{
-		EmitBin	= LIST_ONLY;
 		type 	= LIST_ONLY;
 		codeline[file_level]++;
 
@@ -1960,6 +2423,8 @@ size_t	str_len;
 			 *	--------------------------------------- */		  
 			if (file_level > 0)
 			{
+				trace_end(in_fn[file_level]);
+
 				/*	Close input file handle.
 				 *	------------------------ */	
 				fclose(in_fp[file_level]);
@@ -1967,10 +2432,19 @@ size_t	str_len;
 
 				/*	Free memory allocated for the input file name.
 				 *	---------------------------------------------- */	
-				free(in_fn[file_level]);
+				mem_free(in_fn[file_level]);
 				in_fn[file_level] = NULL;
 
 				file_level--;
+
+				/*	Back below the requested level.  Stop here.
+				 *	------------------------------------------- */
+				if (file_level < level)
+				{
+					rv	= KWPS_NONE;
+					break;
+				}
+
 				continue;			/*	Restart assembly process at lower level. */
 			}
 			/*	- We are at level 0 (main source file), and there is no
@@ -1980,23 +2454,11 @@ size_t	str_len;
 		 	 *	----------------------------------------------------------- */	 
 			else
 			{
-				ProcessDumpBin();
-				ProcessDumpHex(1);
-
-				/*	Print symbols table, if necessary.
-				 *	---------------------------------- */	
-				if (list != NULL)
-					print_symbols_table();
-
+				do_asm_end();
 				break;
 			}
 		}
 
-		/*	If there is an active macro, save line to the macro file.
-		 *	--------------------------------------------------------- */
-		if (fp_macro != NULL)
-			fputs(p_text, fp_macro);
-
 		/*	Check if we was able to grab all the source line.
 		 *	************************************************* */
 
@@ -2030,94 +2492,33 @@ size_t	str_len;
 			msg_error("Line too long!", EC_SLTL);
 		}
 
-		/*	Destroy New Line character, if necessary.
-		 *	----------------------------------------- */
-		if (eol_found)			
-			p_text[strlen(p_text) - 1] = '\0';
-
-		str_len	= strlen(p_text);		/*	Get the length of the source line. */
-
-		/*	- If source line contain something, process it.
-		 *	- Notes: Do not parse line that only contain
-		 *	  Ctrl+Z ASCII control code, because this is
-		 *	  the end of file mark for CP/M text file; and
-		 *	  that such files comming from the old age can
-		 *	  be processed by "asm8080".
-		 *	----------------------------------------------- */
-		if ((str_len >= 1) && ((str_len > 2) || ((*p_text != 0x1A))))
-		{
-			EmitBin = src_line_parser(p_text);
-
-			if (util_is_cs_enable() == 0)
-				type = LIST_ONLY;
-		}
-
-		/*	- When "END" directive was processed, don't print list
-		 *	  immediatly.  This will be done later...
-	 	 *	------------------------------------------------------ */	 
-		if (EmitBin != PROCESSED_END)
-			print_list(p_text);
-
-		if (util_is_cs_enable() == 1)
-			DumpBin();
-
-		/*	If an "END" directive was executed...
-		 *	------------------------------------- */	
-		if (EmitBin == PROCESSED_END)
-		{
-			/*	If the "END" directive was found inside an include file...
-			 *	---------------------------------------------------------- */
-			if ((file_level > 0) && (asm_pass == 1))
-			{
-				msg_warning(	"\"END\" directive found inside an include file!",
-					  				WC_EDFIIF);
-			}
-
-			print_list(p_text);
-			ProcessDumpBin();
-			ProcessDumpHex(1);
-
-			/*	Print symbols table, if necessary.
-			 *	---------------------------------- */	
-			if (list != NULL)
-				print_symbols_table();
-
-			/*	If the "END" directive was found inside an include file...
-			 *	---------------------------------------------------------- */
-			if (file_level > 0)
-			{
-				int	i;
+		/*	Assemble the line.  Exit if an "END" directive was processed.
+		 *	------------------------------------------------------------- */
+		if (do_asm_line(p_text) == PROCESSED_END)
+			break;						/*	Terminate assembly process. */
+	}
 
-				/*	- Close all openned included files, and free associated
-				 *	  resources.
-				 *	------------------------------------------------------- */	
-				for (i = file_level; i > 0; i--)
-				{
-					/*	Close input file handle.
-					 *	------------------------ */
-					fclose(in_fp[i]);
-					in_fp[i]	= NULL;
-
-					/*	Free memory allocated for the input file name.
-					 *	---------------------------------------------- */
-					free(in_fn[i]);
-					in_fn[i]	= NULL;
-				}
+	mem_free(p_text);		/*	Free allocated memory. */
 
-				file_level	= 0;		/*	We are now at level 0. */
-			}
+	return (rv);
+}
 
-			break;						/*	Terminate assembly process. */
-		}
 
-		data_size=
-	  	b1	=
-	  	b2	=
-	  	b3	=
-	  	b4	= 0;
-	}
+/*	*************************************************************************
+ *	Function name:	do_asm
+ *	Description:	Assemble source file.
+ *	Author(s):		Jay Cotton, Claude Sylvain
+ *	Created:			2007
+ *	Last modified:	18 October 2026
+ *	Parameters:		void
+ *	Returns:			void
+ *	Globals:
+ *	Notes:
+ *	************************************************************************* */
 
-	free(p_text);		/*	Free allocated memory. */
+static void do_asm(void)
+{
+	do_asm_files(0);
 }
 
 
@@ -2126,7 +2527,7 @@ size_t	str_len;
  *	Description:		Display Help.
  *	Author(s):			Jay Cotton, Claude Sylvain
  *	Created:				2007
- *	Last modified:		30 May 2013
+ *	Last modified:		18 October 2026
  *	Parameters:			void
  *	Returns:				void
  *	Globals:
@@ -2139,10 +2540,24 @@ static void display_help(void)
 	printf("Options:\n");
 	printf("  -h           : Display Help.\n");
 	printf("  -I<dir>      : Add directory to the include file search path.\n");
+	printf("  -j[<n>]      : Assemble using <n> threads (default: #CPUs).\n");
 	printf("  -l<filename> : Generate listing file.\n");
+	printf("  -m<n>        : Repeat layout until labels are stable (max. <n> passes).\n");
 	printf("  -o<filename> : Define output files (optionnal).\n");
+	printf("  -O           : Optimize instruction sequences (peephole).\n");
 	printf("  -P           : Print instruction #cycles in listing file.\n");
 	printf("  -v           : Display version.\n");
+	printf("  -Wperf       : Warn on instruction sequences with cheaper equivalents.\n");
+	printf("  --stats      : Print phase times and counters at exit.\n");
+	printf("  --mem-report : Print memory use by subsystem at exit.\n");
+	printf("  --bench <n>  : Time <n> assemblies in process. No output files.\n");
+	printf("  --trace <filename> : Write a trace of assembler activity (JSON).\n");
+	printf("  --cycles <all|label|label1,label2> : Report best/worst case cycles.\n");
+	printf("  --latency <max> : Check DI..EI regions (max. cycles, 0: report only).\n");
+	printf("  --run <start>[,<max cycles>] : Run the program, and print its profile.\n");
+	printf("  --run-io <port>,<address> : Map an I/O port to memory (\"--run\").\n");
+	printf("  --profile <trace file> : Print trace execution counts in listing file.\n");
+	printf("  --stack <all|label|label1,label2> : Report worst-case stack depth.\n");
 }
 
 
@@ -2166,53 +2581,177 @@ static void display_version(void)
 
 
 /*	*************************************************************************
- *	Function name:	asm_pass1
- *	Description:	Assembler Pass #1.
- *	Author(s):		Jay Cotton, Claude Sylvain
- *	Created:			2007
- *	Last modified:	1 June 2013
+ *	Function name:	layout_changes
+ *	Description:	Compare symbols with the previous layout pass.
+ *	Author(s):
+ *	Created:			18 October 2026
+ *	Last modified:
  *	Parameters:		void
- *	Returns:			void
- *	Globals:
- *	Notes:
+ *
+ *	Returns:			int:
+ *							Number of symbols that changed (or are new).
+ *
+ *	Globals:			SYMBOL *Symbols
+ *
+ *	Notes:			- Changed symbols are printed with the messages, after
+ *						  a layout pass header, except on the first layout
+ *						  pass (all symbols are new).
+ *						- Current values are kept for the next layout pass.
  *	************************************************************************* */
 
-static void asm_pass1(void)
+static int layout_changes(void)
 {
-	int	i;
+	SYMBOL	*Local	= Symbols;
+	FILE		*fp		= (fp_msg != NULL) ? fp_msg : stderr;
+	int		changes	= 0;
 
-	/*	- Notes: Only "codeline" level 0 need to be clear, since
-	 *	  all other "codeline" level are cleared at time file "INCLUDE"
-	 *	  directive is processed.
-	 *	*/
-	codeline[0]	= 0;
 
-	target.addr			= 0;
-	target.pc			= 0x0000;
-	target.pc_org		= 0x0000;
-	target.pc_lowest	= 0xFFFF;
-	target.pc_highest	= 0;
-	type					= LIST_ONLY;
-	asm_pass 			= 0;
+	while (Local->next != NULL)
+	{
+		if ((Local->prev_valid == 0) || (Local->prev_value != Local->Symbol_Value))
+		{
+			changes++;
 
-	memset(Image, 0, sizeof (Image));
-	do_asm();
+			if (asm_iter > 0)
+			{
+				if (changes == 1)
+					fprintf(fp, "Layout pass #%d:\n", asm_iter + 1);
+
+				if (Local->prev_valid != 0)
+				{
+					fprintf(	fp, "    %s: %04Xh -> %04Xh\n", Local->Symbol_Name,
+						  		Local->prev_value & 0xFFFF,
+								Local->Symbol_Value & 0xFFFF);
+				}
+				else
+				{
+					fprintf(	fp, "    %s: (new) -> %04Xh\n", Local->Symbol_Name,
+						  		Local->Symbol_Value & 0xFFFF);
+				}
+			}
+		}
+
+		Local->prev_value	= Local->Symbol_Value;
+		Local->prev_valid	= 1;
+
+		Local	= (SYMBOL *) Local->next;
+	}
+
+	return (changes);
 }
 
 
 /*	*************************************************************************
- *	Function name:	asm_pass2
- *	Description:	Assembler Pass #2.
+ *	Function name:	asm_pass1
+ *	Description:	Assembler Pass #1.
  *	Author(s):		Jay Cotton, Claude Sylvain
  *	Created:			2007
- *	Last modified:	1 June 2013
+ *	Last modified:	18 October 2026
  *	Parameters:		void
  *	Returns:			void
  *	Globals:
- *	Notes:
+ *
+ *	Notes:			- With "-m" option, layout is repeated until no label
+ *						  change (fixpoint), or maximum number of passes is
+ *						  reached.  Each layout pass use label values found
+ *						  by the previous one.
+ *						- With "-m" option, lines are classified once (by
+ *						  "layout_pass1()", with one thread if "-j" is not
+ *						  used), so following layout passes only process
+ *						  barriers and labels again.
  *	************************************************************************* */
 
-static void asm_pass2(void)
+static void asm_pass1(void)
+{
+	int	i;
+	int	changes	= 0;
+	int	threads	= layout_threads;
+
+
+	if ((threads == 0) && (layout_passes_max > 1))
+		threads	= 1;
+
+
+	asm_iter	= 0;
+
+	do
+	{
+		/*	- Notes: Only "codeline" level 0 need to be clear, since
+		 *	  all other "codeline" level are cleared at time file "INCLUDE"
+		 *	  directive is processed.
+		 *	*/
+		codeline[0]	= 0;
+
+		target.addr			= 0;
+		target.pc			= 0x0000;
+		target.pc_org		= 0x0000;
+		target.pc_lowest	= 0xFFFF;
+		target.pc_highest	= 0;
+		type					= LIST_ONLY;
+		asm_pass 			= 0;
+
+		memset(Image, 0, sizeof (Image));
+
+		if (asm_iter > 0)
+			RewindFiles();
+
+		peep_reset();
+
+		/*	- Use parallel layout if requested.  Fall back on regular
+		 *	  processing if parallel layout can not be done.
+		 *	- Notes: Peephole optimizer need lines in order.
+		 *	*/
+		if (	(threads == 0) || (peep_enable != 0) ||
+				(layout_pass1(threads) == -1))
+		{
+			do_asm();
+		}
+
+		/*	- All labels are now known.  Evaluate "EQU" not used yet, so
+		 *	  symbols do not change anymore.
+		 *	*/
+		exp_parser_resolve_equ();
+
+		/*	Single layout pass.  Nothing to compare.
+		 *	---------------------------------------- */
+		if (layout_passes_max < 2)
+			break;
+
+		changes	= layout_changes();
+		asm_iter++;
+	}
+	while ((changes != 0) && (asm_iter < layout_passes_max));
+
+	if (layout_passes_max < 2)
+		return;
+
+	if (changes == 0)
+	{
+		fprintf(	(fp_msg != NULL) ? fp_msg : stderr,
+			  		"Layout converged after %d passes.\n", asm_iter);
+	}
+	else
+	{
+		fprintf(	stderr,
+			  		"*** Warning %d: Layout did not converge after %d passes!\n",
+					WC_LDNC, asm_iter);
+	}
+}
+
+
+/*	*************************************************************************
+ *	Function name:	asm_pass2
+ *	Description:	Assembler Pass #2.
+ *	Author(s):		Jay Cotton, Claude Sylvain
+ *	Created:			2007
+ *	Last modified:	18 October 2026
+ *	Parameters:		void
+ *	Returns:			void
+ *	Globals:
+ *	Notes:
+ *	************************************************************************* */
+
+static void asm_pass2(void)
 {
 	int	i;
 
@@ -2232,7 +2771,20 @@ static void asm_pass2(void)
 
 	memset(Image, 0, sizeof (Image));
 	RewindFiles();
-	do_asm();
+
+	peep_reset();
+	lint_reset();
+
+	/*	- Use parallel encoding if requested.  Fall back on regular
+	 *	  processing if parallel encoding can not be done.
+	 *	- Notes: Peephole optimizer and performance lint need lines
+	 *	  in order.
+	 *	*/
+	if (	(layout_threads == 0) || (peep_enable != 0) || (lint_enable != 0) ||
+			(layout_pass2(layout_threads) == -1))
+	{
+		do_asm();
+	}
 }
 
 
@@ -2306,7 +2858,7 @@ static int process_option_i(char *text)
 	while (p_option_i->next != NULL)
 		p_option_i	= p_option_i->next;
 
-	if ((p_option_i->path = (char *) malloc(string_len + 1)) != NULL)
+	if ((p_option_i->path = (char *) mem_alloc(MT_OPTIONS, string_len + 1)) != NULL)
 	{
 		strcpy(p_option_i->path, text);		/*	Save path. */
 
@@ -2318,7 +2870,7 @@ static int process_option_i(char *text)
 		/*	Allocate memory for the next "option_i" structure.
 		 *	*/	
 		p_option_i->next	=
-		  	(struct option_i_t *) malloc(sizeof (struct option_i_t));
+		  	(struct option_i_t *) mem_alloc(MT_OPTIONS, sizeof (struct option_i_t));
 
 		if (p_option_i->next != NULL)
 		{
@@ -2333,7 +2885,7 @@ static int process_option_i(char *text)
 		else
 		{
 			fprintf(stderr, "*** Error %d: Can't allocate memory!\n", EC_MAE);
-			free(p_option_i->path);		/*	Make structure available. */
+			mem_free(p_option_i->path);		/*	Make structure available. */
 		}
 	}
 	else
@@ -2345,6 +2897,108 @@ static int process_option_i(char *text)
 }
 
 
+/*	*************************************************************************
+ *	Function name:	process_option_j
+ *	Description:	Process Option "-j".
+ *	Author(s):
+ *	Created:			18 October 2026
+ *	Last modified:
+ *
+ *	Parameters:		char *text:
+ *							Pointer to text that hold "-j" option.
+ *
+ *	Returns:			int:
+ *							-1	: Operation failed.
+ *							0	: Operation successfull.
+ *
+ *	Globals:			int layout_threads
+ *
+ *	Notes:			- Without a number, use one thread per online
+ *						  processor.
+ *	************************************************************************* */
+
+static int process_option_j(char *text)
+{
+	char	*p_end;
+	long	threads;
+
+
+	text	+= 2;						/*	Bypass "-j". */
+
+	/*	No number.  Use default.
+	 *	------------------------ */
+	if (*text == '\0')
+	{
+		layout_threads	= layout_threads_default();
+		return (0);
+	}
+
+	threads	= strtol(text, &p_end, 10);
+
+	if ((*p_end != '\0') || (threads < 1) || (threads > LAYOUT_THREADS_MAX))
+	{
+		fprintf(	stderr,
+			  		"*** Error %d: Bad \"-j\" option (\"%s\")!\n",
+					EC_BJO, text);
+
+		fprintf(	stderr,
+			  		"    Number of threads must be 1 to %d.\n",
+				  	LAYOUT_THREADS_MAX);
+
+		return (-1);
+	}
+
+	layout_threads	= (int) threads;
+
+	return (0);
+}
+
+
+/*	*************************************************************************
+ *	Function name:	process_option_m
+ *	Description:	Process Option "-m".
+ *	Author(s):
+ *	Created:			18 October 2026
+ *	Last modified:
+ *
+ *	Parameters:		char *text:
+ *							Pointer to text that hold "-m" option.
+ *
+ *	Returns:			int:
+ *							-1	: Operation failed.
+ *							0	: Operation successfull.
+ *
+ *	Globals:			int layout_passes_max
+ *	Notes:
+ *	************************************************************************* */
+
+static int process_option_m(char *text)
+{
+	char	*p_end;
+	long	passes;
+
+
+	text	+= 2;						/*	Bypass "-m". */
+
+	passes	= strtol(text, &p_end, 10);
+
+	if ((*text == '\0') || (*p_end != '\0') || (passes < 1) || (passes > 100))
+	{
+		fprintf(	stderr,
+			  		"*** Error %d: Bad \"-m\" option (\"%s\")!\n",
+					EC_BMO, text);
+
+		fprintf(stderr, "    Number of passes must be 1 to 100.\n");
+
+		return (-1);
+	}
+
+	layout_passes_max	= (int) passes;
+
+	return (0);
+}
+
+
 /*	*************************************************************************
  *	Function name:	process_option_l
  *	Description:	Process Option "-l".
@@ -2414,7 +3068,7 @@ static int process_option_l(char *text)
 		{
 			/*	Allocate memory for the listing file name.
 			 *	*/
-			list_file	= (char *) malloc(string_len + 1);
+			list_file	= (char *) mem_alloc(MT_FILES, string_len + 1);
 
 			/*	Built list file name, if possible.
 			 *	---------------------------------- */	
@@ -2435,7 +3089,7 @@ static int process_option_l(char *text)
 		{
 			/*	Allocate memory for the listing file name.
 			 *	*/
-			list_file	= (char *) malloc(string_len + 4 + 1);
+			list_file	= (char *) mem_alloc(MT_FILES, string_len + 4 + 1);
 
 			/*	Built list file name, if possible.
 			 *	---------------------------------- */	
@@ -2462,7 +3116,7 @@ static int process_option_l(char *text)
 		{
 			/*	Allocate memory for the listing file name.
 			 *	*/
-			list_file	= (char *) malloc(strlen(fn_base) + 4 + 1);
+			list_file	= (char *) mem_alloc(MT_FILES, strlen(fn_base) + 4 + 1);
 
 			/*	Built list file name, if possible.
 			 *	---------------------------------- */	
@@ -2492,7 +3146,7 @@ static int process_option_l(char *text)
 
 			/*	Allocate memory for the listing file name.
 			 *	*/
-			list_file	= (char *) malloc(strlen(default_lst_file_name) + 1);
+			list_file	= (char *) mem_alloc(MT_FILES, strlen(default_lst_file_name) + 1);
 
 			/*	Built list file name, if possible.
 			 *	---------------------------------- */	
@@ -2594,11 +3248,11 @@ static int process_option_o(char *text)
 
 		/*	Allocate memory for the binary file name.
 		 *	*/
-		bin_file	= (char *) malloc(string_len + 4 + 1);
+		bin_file	= (char *) mem_alloc(MT_FILES, string_len + 4 + 1);
 
 		/*	Allocate memory for the Intel hexadecimal file name.
 		 *	*/
-		hex_file	= (char *) malloc(string_len + 4 + 1);
+		hex_file	= (char *) mem_alloc(MT_FILES, string_len + 4 + 1);
 
 		/*	Built binary file name, if possible.
 		 *	------------------------------------ */	
@@ -2630,11 +3284,11 @@ static int process_option_o(char *text)
 		{
 			/*	Allocate memory for the binary file name.
 			 *	*/
-			bin_file	= (char *) malloc(strlen(fn_base) + 4 + 1);
+			bin_file	= (char *) mem_alloc(MT_FILES, strlen(fn_base) + 4 + 1);
 
 			/*	Allocate memory for the Intel hexadecimal file name.
 			 *	*/
-			hex_file	= (char *) malloc(strlen(fn_base) + 4 + 1);
+			hex_file	= (char *) mem_alloc(MT_FILES, strlen(fn_base) + 4 + 1);
 
 			/*	Built binary and Intel hexadecimal file names, if possible.
 			 *	----------------------------------------------------------- */	
@@ -2670,11 +3324,11 @@ static int process_option_o(char *text)
 
 			/*	Allocate memory for the binary file name.
 			 *	*/
-			bin_file	= (char *) malloc(strlen(default_bin_file_name) + 1);
+			bin_file	= (char *) mem_alloc(MT_FILES, strlen(default_bin_file_name) + 1);
 
 			/*	Allocate memory for the Intel hexadecimal file name.
 			 *	*/
-			hex_file	= (char *) malloc(strlen(default_hex_file_name) + 1);
+			hex_file	= (char *) mem_alloc(MT_FILES, strlen(default_hex_file_name) + 1);
 
 			/*	- Built binary file name and Intel hexadecimal
 			 *	  file name, if possible.
@@ -2737,7 +3391,7 @@ static int check_set_output_fn(void)
 	{
 		/*	Allocate memory for the binary file name.
 		 *	*/
-		bin_file	= (char *) malloc(strlen(fn_base) + 4 + 1);
+		bin_file	= (char *) mem_alloc(MT_FILES, strlen(fn_base) + 4 + 1);
 
 		/*	Built binary file name, if possible.
 		 *	------------------------------------ */	
@@ -2759,7 +3413,7 @@ static int check_set_output_fn(void)
 	{
 		/*	Allocate memory for the Intel hexadecimal file name.
 		 *	*/
-		hex_file	= (char *) malloc(strlen(fn_base) + 4 + 1);
+		hex_file	= (char *) mem_alloc(MT_FILES, strlen(fn_base) + 4 + 1);
 
 		/*	Built Intel hexadecimal file name, if possible.
 		 *	----------------------------------------------- */	
@@ -2779,6 +3433,191 @@ static int check_set_output_fn(void)
 }
 
 
+/*	*************************************************************************
+ *	Function name:	symbols_clear
+ *	Description:	Empty the symbols table.
+ *	Author(s):
+ *	Created:			18 October 2026
+ *	Last modified:
+ *	Parameters:		void
+ *	Returns:			void
+ *	Globals:			SYMBOL *Symbols
+ *
+ *	Notes:			- Root symbol (end of list mark) is kept, and
+ *						  cleared.
+ *	************************************************************************* */
+
+static void symbols_clear(void)
+{
+	SYMBOL	*Local	= Symbols;
+	SYMBOL	*Next;
+
+
+	do {
+		Next	= (SYMBOL *) Local->next;
+
+		mem_free(Local->Symbol_Name);
+		mem_free(Local->src_filename);
+		mem_free(Local->equ_expr);
+
+		if (Local != Symbols)
+			mem_free(Local);
+
+	} while ((Local = Next) != NULL);
+
+	memset(Symbols, 0, sizeof (SYMBOL));
+}
+
+
+/*	*************************************************************************
+ *	Function name:	bench_reset
+ *	Description:	Reset assembler state before a benchmark run.
+ *	Author(s):
+ *	Created:			18 October 2026
+ *	Last modified:
+ *	Parameters:		void
+ *	Returns:			void
+ *
+ *	Globals:			SYMBOL *Symbols
+ *						STACK *ByteWordStack
+ *						int if_true[]
+ *						int if_nest
+ *
+ *	Notes:			- "target", "Image", "codeline" and "type" are reset
+ *						  by the assembler passes themselves.
+ *	************************************************************************* */
+
+static void bench_reset(void)
+{
+	STACK	*p_stack;
+
+
+	symbols_clear();
+
+	/*	Release "DB"/"DW" list left by a line in error, if any.
+	 *	------------------------------------------------------- */
+	while ((p_stack = (STACK *) ByteWordStack->next) != NULL)
+	{
+		ByteWordStack->next	= p_stack->next;
+		mem_free(p_stack);
+	}
+
+	memset(if_true, 0, sizeof (if_true));
+	if_true[0]	= 1;		/*	"IF" nesting base level (always TRUE). */
+	if_nest		= 0;
+
+	asm_dir_cleanup();		/*	Macro file left open, if any. */
+	RewindFiles();
+}
+
+
+/*	*************************************************************************
+ *	Function name:	bench_compare
+ *	Description:	Compare two run times ("qsort()").
+ *	Author(s):
+ *	Created:			18 October 2026
+ *	Last modified:
+ *
+ *	Parameters:		const void *p_a:
+ *							Point to first time.
+ *
+ *						const void *p_b:
+ *							Point to second time.
+ *
+ *	Returns:			int:
+ *							<0, 0 or >0, as "strcmp()".
+ *
+ *	Globals:
+ *	Notes:
+ *	************************************************************************* */
+
+static int bench_compare(const void *p_a, const void *p_b)
+{
+	long long	a	= *(const long long *) p_a;
+	long long	b	= *(const long long *) p_b;
+
+	return ((a > b) - (a < b));
+}
+
+
+/*	*************************************************************************
+ *	Function name:	bench_run
+ *	Description:	Assemble the input several times, and report times.
+ *	Author(s):
+ *	Created:			18 October 2026
+ *	Last modified:
+ *	Parameters:		void
+ *	Returns:			void
+ *
+ *	Globals:			int bench_runs
+ *						long long bench_time[]
+ *
+ *	Notes:			- A first run (not timed) print messages, and count
+ *						  source lines.  Messages of timed runs are
+ *						  discarded.
+ *	************************************************************************* */
+
+static void bench_run(void)
+{
+	int			stats_save	= stats_enable;
+	FILE			*fp_null;
+	long long	lines;
+	long long	median;
+	int			i;
+
+
+	/*	First run.
+	 *	---------- */
+	stats_enable	= 1;
+	lines				= stats_get(SC_LINES);
+
+	asm_pass1();
+	asm_pass2();
+
+	lines				= stats_get(SC_LINES) - lines;
+	stats_enable	= stats_save;
+
+	/*	Timed runs.
+	 *	----------- */
+	fp_null	= fopen(NULL_DEVICE, "w");
+	fp_msg	= fp_null;
+
+	for (i = 0; i < bench_runs; i++)
+	{
+		long long	start;
+
+		bench_reset();
+
+		start	= stats_time();
+		asm_pass1();
+		asm_pass2();
+		bench_time[i]	= stats_time() - start;
+	}
+
+	fp_msg	= NULL;
+
+	if (fp_null != NULL)
+		fclose(fp_null);
+
+	/*	Report.
+	 *	------- */
+	qsort(bench_time, (size_t) bench_runs, sizeof (long long), bench_compare);
+
+	median	= bench_time[bench_runs / 2];
+
+	if ((bench_runs & 1) == 0)
+		median	= (median + bench_time[(bench_runs / 2) - 1]) / 2;
+
+	printf("Benchmark: %d runs, %lld lines.\n", bench_runs, lines);
+
+	printf(	"  min %.3f ms, median %.3f ms, max %.3f ms\n",
+		  		bench_time[0] / 1e6, median / 1e6, bench_time[bench_runs - 1] / 1e6);
+
+	if (median > 0)
+		printf("  %.0f lines/s (median)\n", lines / (median / 1e9));
+}
+
+
 /*	*************************************************************************
  *	Function name:	clean_up
  *	Description:	Clean Up before exiting.
@@ -2796,26 +3635,22 @@ static void clean_up(void)
 	struct option_i_t	*p_option_i_cur;
 	struct option_i_t	*p_option_i_next;
 
-	SYMBOL	*Local	= Symbols;
-
-
 	/* Free symbols linked list.
 	 *	************************* */
 
-	do {
-		free(Local->Symbol_Name);
-		free(Local->src_filename);
-	} while ((Local = (SYMBOL *) Local->next) != NULL);
-
-	free(Symbols);
+	if (Symbols != NULL)
+	{
+		symbols_clear();
+		mem_free(Symbols);
+	}
 
 
-	free(ByteWordStack);
+	mem_free(ByteWordStack);
 
 	/*	- Since "in_fn[0]" is no more used, we do not have to init.
 	 *	  it to NULL.
 	 *	*/		  
-	free(in_fn[0]);
+	mem_free(in_fn[0]);
 
 
 	/*	- Free memory allocated for "-I" option structures.
@@ -2827,7 +3662,7 @@ static void clean_up(void)
 
 	/*	Notes: "NULL" if no option "-I" found.
 	 *	*/	
-	free(option_i.path);
+	mem_free(option_i.path);
 
 	/*	Free memory associated with option "-I" dynamic structures.
 	 *	----------------------------------------------------------- */	
@@ -2836,16 +3671,18 @@ static void clean_up(void)
 		p_option_i_cur		= p_option_i_next;
 		p_option_i_next	= p_option_i_cur->next;
 
-		free(p_option_i_cur->path);
-		free(p_option_i_cur);
+		mem_free(p_option_i_cur->path);
+		mem_free(p_option_i_cur);
 	}
 
 	/*	Notes: "NULL" if no option "-l" found.
 	 *	*/	
-	free(list_file);
+	mem_free(list_file);
+
+	mem_free(bin_file);
+	mem_free(hex_file);
 
-	free(bin_file);
-	free(hex_file);
+	trace_close();		/*	Complete trace file, if any. */
 }
 
 
@@ -2955,7 +3792,7 @@ static int process_input_file(char *text)
 
 	/*	Allocate memory for the input file name.
 	 *	*/	
-	in_fn[0]	= (char *) malloc(in_fn_len);
+	in_fn[0]	= (char *) mem_alloc(MT_FILES, in_fn_len);
 
 	/*	Check for memory allocation error.
 	 *	--------------------------------- */	
@@ -2983,12 +3820,288 @@ static int process_input_file(char *text)
 }
 
 
+/*	*************************************************************************
+ *	Function name:	process_option_long
+ *	Description:	Process a long option ("--<name>").
+ *	Author(s):
+ *	Created:			18 October 2026
+ *	Last modified:
+ *
+ *	Parameters:		char *text:
+ *							Pointer to text that hold the option.
+ *
+ *						char *next:
+ *							- Next program parameter (option argument), or
+ *							  NULL if there is none.
+ *
+ *	Returns:			int:
+ *							-1	: Unknown option.
+ *							>=0: Number of option arguments used.
+ *
+ *	Globals:			int stats_enable
+ *						int mem_report_enable
+ *						int bench_runs
+ *						int cycles_enable
+ *						int sim_enable
+ *						int profile_enable
+ *						int depth_enable
+ *	Notes:			- Option errors are reported, and the option is
+ *						  ignored (same as short options).
+ *	************************************************************************* */
+
+static int process_option_long(char *text, char *next)
+{
+	text	+= 2;						/*	Bypass "--". */
+
+	/*	"--stats" option.
+	 *	----------------- */
+	if (strcmp(text, "stats") == 0)
+	{
+		stats_enable	= 1;
+		return (0);
+	}
+
+	/*	"--mem-report" option.
+	 *	---------------------- */
+	if (strcmp(text, "mem-report") == 0)
+	{
+		mem_report_enable	= 1;
+		return (0);
+	}
+
+	/*	"--bench <n>" option.
+	 *	--------------------- */
+	if (strcmp(text, "bench") == 0)
+	{
+		char	*p_end;
+		long	runs;
+
+		if (next == NULL)
+		{
+			fprintf(	stderr,
+				  		"*** Error %d: Missing \"--bench\" number of runs!\n", EC_MOA);
+
+			return (0);
+		}
+
+		runs	= strtol(next, &p_end, 10);
+
+		if ((*next == '\0') || (*p_end != '\0') || (runs < 1) || (runs > BENCH_RUNS_MAX))
+		{
+			fprintf(	stderr,
+				  		"*** Error %d: Bad \"--bench\" option (\"%s\")!\n",
+						EC_BBO, next);
+
+			fprintf(stderr, "    Number of runs must be 1 to %d.\n", BENCH_RUNS_MAX);
+		}
+		else
+			bench_runs	= (int) runs;
+
+		return (1);
+	}
+
+	/*	"--trace <filename>" option.
+	 *	---------------------------- */
+	if (strcmp(text, "trace") == 0)
+	{
+		if (next == NULL)
+		{
+			fprintf(	stderr,
+				  		"*** Error %d: Missing \"--trace\" file name!\n", EC_MOA);
+
+			return (0);
+		}
+
+		if (trace_open(next) == -1)
+		{
+			fprintf(	stderr,
+				  		"*** Error %d: Can't open trace file (\"%s\")!\n",
+						EC_COTF, next);
+		}
+
+		return (1);
+	}
+
+	/*	"--cycles <spec>" option.
+	 *	------------------------- */
+	if (strcmp(text, "cycles") == 0)
+	{
+		if (next == NULL)
+		{
+			fprintf(	stderr,
+				  		"*** Error %d: Missing \"--cycles\" routine or labels!\n", EC_MOA);
+
+			return (0);
+		}
+
+		if (cycles_option(next) == -1)
+			fprintf(stderr, "*** Error %d: Can't allocate memory!\n", EC_CAM);
+
+		return (1);
+	}
+
+	/*	"--latency <max>" option.
+	 *	------------------------- */
+	if (strcmp(text, "latency") == 0)
+	{
+		char	*p_end;
+		long	max;
+
+		if (next == NULL)
+		{
+			fprintf(	stderr,
+				  		"*** Error %d: Missing \"--latency\" maximum cycles!\n", EC_MOA);
+
+			return (0);
+		}
+
+		max	= strtol(next, &p_end, 10);
+
+		if ((*next == '\0') || (*p_end != '\0') || (max < 0))
+		{
+			fprintf(	stderr,
+				  		"*** Error %d: Bad \"--latency\" option (\"%s\")!\n",
+						EC_BLO, next);
+		}
+		else if (cycles_latency_option(max) == -1)
+			fprintf(stderr, "*** Error %d: Can't allocate memory!\n", EC_CAM);
+
+		return (1);
+	}
+
+	/*	"--run <start>[,<max cycles>]" option.
+	 *	-------------------------------------- */
+	if (strcmp(text, "run") == 0)
+	{
+		if (next == NULL)
+		{
+			fprintf(	stderr,
+				  		"*** Error %d: Missing \"--run\" start address!\n", EC_MOA);
+
+			return (0);
+		}
+
+		switch (sim_option(next))
+		{
+			case -2:
+				fprintf(	stderr,
+					  		"*** Error %d: Bad \"--run\" option (\"%s\")!\n",
+							EC_BRO, next);
+
+				break;
+
+			case -1:
+				fprintf(stderr, "*** Error %d: Can't allocate memory!\n", EC_CAM);
+				break;
+
+			default:
+				break;
+		}
+
+		return (1);
+	}
+
+	/*	"--run-io <port>,<address>" option.
+	 *	----------------------------------- */
+	if (strcmp(text, "run-io") == 0)
+	{
+		if (next == NULL)
+		{
+			fprintf(	stderr,
+				  		"*** Error %d: Missing \"--run-io\" port and address!\n", EC_MOA);
+
+			return (0);
+		}
+
+		switch (sim_io_option(next))
+		{
+			case -2:
+				fprintf(	stderr,
+					  		"*** Error %d: Bad \"--run-io\" option (\"%s\")!\n",
+							EC_BRIO, next);
+
+				break;
+
+			case -1:
+				fprintf(stderr, "*** Error %d: Can't allocate memory!\n", EC_CAM);
+				break;
+
+			default:
+				break;
+		}
+
+		return (1);
+	}
+
+	/*	"--profile <trace file>" option.
+	 *	-------------------------------- */
+	if (strcmp(text, "profile") == 0)
+	{
+		int	line;
+
+		if (next == NULL)
+		{
+			fprintf(	stderr,
+				  		"*** Error %d: Missing \"--profile\" trace file name!\n", EC_MOA);
+
+			return (0);
+		}
+
+		switch (profile_option(next, &line))
+		{
+			case -3:
+				fprintf(	stderr,
+					  		"*** Error %d: Can't open trace file (\"%s\")!\n",
+							EC_COTF, next);
+
+				break;
+
+			case -2:
+				fprintf(	stderr,
+					  		"*** Error %d: Bad trace file (\"%s\", line %d)!\n",
+							EC_BTF, next, line);
+
+				break;
+
+			case -1:
+				fprintf(stderr, "*** Error %d: Can't allocate memory!\n", EC_CAM);
+				break;
+
+			default:
+				break;
+		}
+
+		return (1);
+	}
+
+	/*	"--stack <all|label|label1,label2,...>" option.
+	 *	----------------------------------------------- */
+	if (strcmp(text, "stack") == 0)
+	{
+		if (next == NULL)
+		{
+			fprintf(	stderr,
+				  		"*** Error %d: Missing \"--stack\" entry points!\n", EC_MOA);
+
+			return (0);
+		}
+
+		if (depth_option(next) == -1)
+			fprintf(stderr, "*** Error %d: Can't allocate memory!\n", EC_CAM);
+
+		return (1);
+	}
+
+	return (-1);
+}
+
+
 /*	*************************************************************************
  *	Function name:	cmd_line_parser
  *	Description:	Command Line Parser.
  *	Author(s):		Claude Sylvain
  *	Created:		31 December 2010
- *	Last modified:	1 January 2012
+ *	Last modified:	18 October 2026
  *
  *	Parameters:		int argv:
  *							...
@@ -3033,12 +4146,24 @@ static int cmd_line_parser(int argc, char *argv[])
 							process_option_i(*argv);
 							break;
 
+						/*	"-j" option.
+						 *	------------ */
+						case 'j':
+							process_option_j(*argv);
+							break;
+
 						/*	"-l" option.
 						 *	------------ */
 						case 'l':
 							process_option_l(*argv);
 							break;
 
+						/*	"-m" option.
+						 *	------------ */
+						case 'm':
+							process_option_m(*argv);
+							break;
+
 						/*	"-o" option.
 						 *	------------ */
 						case 'o':
@@ -3052,6 +4177,52 @@ static int cmd_line_parser(int argc, char *argv[])
 							print_inc	= 1;
 							break;
 
+						/*	"-O" option.
+						 *	Peephole Optimizer.
+						 *	------------------- */
+						case 'O':
+							peep_enable	= 1;
+							break;
+
+						/*	"-Wperf" option.
+						 *	Performance Lint.
+						 *	----------------- */
+						case 'W':
+							if (strcmp(*argv, "-Wperf") == 0)
+								lint_enable	= 1;
+							else
+							{
+								display_help();
+								rv				= 0;		/*	Just display.  Do not assemble. */
+								pgm_par_cnt	= 0;		/*	Force Exit. */
+							}
+
+							break;
+
+						/*	- Long option ("--<name>").
+						 *	- On unknown option, display help and exit.
+						 *	------------------------------------------- */	 
+						case '-':
+						{
+							int	n	= process_option_long(	*argv,
+								  									(pgm_par_cnt > 1) ?
+																	argv[1] : NULL);
+
+							if (n < 0)
+							{
+								display_help();
+								rv				= 0;		/*	Just display.  Do not assemble. */
+								pgm_par_cnt	= 0;		/*	Force Exit. */
+							}
+							else
+							{
+								pgm_par_cnt	-= n;		/*	Bypass option arguments. */
+								argv			+= n;
+							}
+
+							break;
+						}
+
 						/*	- On "-h" option of unknown option, display
 						 *	  help and exit.
 						 *	------------------------------------------- */	 
@@ -3098,11 +4269,11 @@ static int cmd_line_parser(int argc, char *argv[])
 
 
 /*	*************************************************************************
- *	Function name:	main
- *	Description:	Main function.
+ *	Function name:	asm_main
+ *	Description:	Assembler main function.
  *	Author(s):		Jay Cotton, Claude Sylvain
  *	Created:			2007
- *	Last modified:	28 December 2011
+ *	Last modified:	18 October 2026
  *
  *	Parameters:		int argv:
  *							...
@@ -3114,16 +4285,16 @@ static int cmd_line_parser(int argc, char *argv[])
  *							...
  *
  *	Globals:
- *	Notes:
+ *	Notes:			- Called by "main()" (see "asm8080.c").
  *	************************************************************************* */
 
-int main(int argc, char *argv[])
+int asm_main(int argc, char *argv[])
 {
 	init();				/*	Initialize module. */
 	if_true[0]	= 1;		/*	"IF" nesting base level (always TRUE). */ 
 
-	Symbols		= (SYMBOL *) calloc(1, sizeof(SYMBOL));
-	ByteWordStack	= (STACK *) calloc(1, sizeof(STACK));
+	Symbols		= (SYMBOL *) mem_calloc(MT_SYMBOLS, 1, sizeof(SYMBOL));
+	ByteWordStack	= (STACK *) mem_calloc(MT_STACK, 1, sizeof(STACK));
 
 	/*	Check for memory allocation error.
 	 *	---------------------------------- */	
@@ -3151,13 +4322,58 @@ int main(int argc, char *argv[])
 			return (-1);
 		}
 
-		asm_pass1();
-		asm_pass2();
+		struct stats_clock_t	clk;
+
+		if (bench_runs > 0)
+			bench_run();
+		else
+		{
+			stats_start(ST_PASS1, &clk);
+			trace_begin("pass", "Pass #1");
+			asm_pass1();
+			trace_end("Pass #1");
+			stats_stop(ST_PASS1, &clk);
+
+			stats_start(ST_PASS2, &clk);
+			trace_begin("pass", "Pass #2");
+			asm_pass2();
+			trace_end("Pass #2");
+			stats_stop(ST_PASS2, &clk);
+
+			/*	Cycles analysis report, after the listing.
+			 *	*/
+			if (cycles_enable != 0)
+				cycles_report((list != NULL) ? list : stdout);
+
+			if (sim_enable != 0)
+				sim_report((list != NULL) ? list : stdout);
+
+			if (profile_enable != 0)
+				profile_report((list != NULL) ? list : stdout);
+
+			if (depth_enable != 0)
+				depth_report((list != NULL) ? list : stdout);
+
+			if (peep_enable != 0)
+				peep_report(stdout);
+		}
+
 		CloseFiles();
+		stats_print();
 	}
 
 	asm_dir_cleanup();		/*	"asm_dir" module Cleanup. */
+	cycles_cleanup();		/*	"cycles" module Cleanup. */
+	peep_cleanup();		/*	"peep" module Cleanup. */
+	sim_cleanup();			/*	"sim" module Cleanup. */
+	profile_cleanup();	/*	"profile" module Cleanup. */
+	depth_cleanup();		/*	"depth" module Cleanup. */
+	layout_cleanup();		/*	"layout" module Cleanup. */
 	clean_up();			/*	Clean Up module. */
+	mem_report();		/*	After clean up, to show what was not freed. */
 
-	return (0);
+	/*	A violated "CYCLES" budget, or a phasing error (the image does
+	 *	not match the listing), fail the build.
+	 *	*/
+	return (((cycles_errors != 0) || (util_phasing != 0)) ? -1 : 0);
 }
@@ -63,6 +63,18 @@
 #define LIST_BYTES					7
 #define LIST_WORDS					8
 #define LIST_STRINGS					9
+#define LIST_CODE						10			/*	Generated code ("DELAY", ...). */
+
+/*	Source Line Split status (see "src_line_split()").
+ *	-------------------------------------------------- */
+#define SLS_COMMENT					0			/*	Comment line. */
+#define SLS_SPECIAL					1			/*	Special command ('$'). */
+#define SLS_LABEL						2			/*	Label/name only. */
+#define SLS_KEYWORD					3			/*	Keyword found. */
+
+/*	Keyword buffer size, for "src_line_split()".
+ *	*/
+#define SRC_LINE_KEYWORD_SIZE		SYMBOL_SIZE_MAX
 
 
 /*	*************************************************************************
@@ -80,27 +92,31 @@ extern int	if_true[10];
 extern int	if_nest;
 
 extern int	addr;
-extern int	data_size;
+extern THREAD_LOCAL int	data_size;
 
-extern int	b1;
-extern int	b2;
-extern int	b3;
-extern int	b4;
+extern THREAD_LOCAL int	b1;
+extern THREAD_LOCAL int	b2;
+extern THREAD_LOCAL int	b3;
+extern THREAD_LOCAL int	b4;
 
 extern int	asm_pass;		/* Assembler Pass. */
+extern int	asm_iter;		/* Assembler Pass #1 Iteration (0 == first). */
 
-extern FILE	*list;
+extern THREAD_LOCAL FILE	*list;
 
-extern STACK	*ByteWordStack;
-extern TARG		target;
+extern THREAD_LOCAL STACK	*ByteWordStack;
+extern THREAD_LOCAL TARG		target;
 
-extern int	type;
+extern THREAD_LOCAL int	type;
 extern int	file_level;
 extern FILE	*in_fp[FILES_LEVEL_MAX];
 extern char	*in_fn[FILES_LEVEL_MAX];		/*	Input File Name. */
-extern int codeline[FILES_LEVEL_MAX];
+extern THREAD_LOCAL int codeline[FILES_LEVEL_MAX];
+
+extern FILE	*hex;
 
 extern SYMBOL	*Symbols;
+extern char		Image[1024 * 64];
 
 extern char	*empty_string;
 
@@ -113,6 +129,13 @@ int set_pc(int pc_value);
 int get_file_from_path(char *fn, char* fn_path, size_t fn_path_size);
 void ProcessDumpBin(void);
 void ProcessDumpHex(char end_of_asm);
+void do_asm_end(void);
+int do_asm_line(char *p_text);
+int do_asm_files(int level);
+int src_line_split(	char *text, char *p_label, char *p_string,
+	  						char *p_string_uc, char *p_equation);
+int src_line_parser(char *text);
+int asm_main(int argc, char *argv[]);
 
 
 
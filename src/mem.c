@@ -0,0 +1,433 @@
+/*	*************************************************************************
+ *	Module Name:	mem.c
+ *	Description:	Memory Allocation.
+ *	Copyright(c):	See below...
+ *	Author(s):
+ *	Created:			18 October 2026
+ *	Last modified:
+ *
+ *	Notes:			- All assembler allocations go through this module, so
+ *						  they can be counted ("--stats" option), and
+ *						  accounted by subsystem ("--mem-report" option).
+ *						- Each block starts with a header that hold its size
+ *						  and tag.  So, memory must be released with
+ *						  "mem_free()", not "free()".
+ *						- Accounting is done only when "--mem-report" is
+ *						  given.  Blocks allocated before (or without) it
+ *						  are marked as such, and are not accounted when
+ *						  freed.
+ *						- Counters may be updated by the threads of the
+ *						  parallel assembler pass #2.  So, they are
+ *						  updated atomically.
+ *	************************************************************************* */
+
+/*
+ * Copyright (c) <2007-2017> Jay Cotton <lbmgmusic@gmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+
+/*	*************************************************************************
+ *	                              INCLUDE FILES
+ *	************************************************************************* */
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "project.h"
+#include "stats.h"
+#include "mem.h"
+
+
+/*	*************************************************************************
+ *											  CONSTANTS
+ *	************************************************************************* */
+
+/*	Tag of the blocks that are not accounted.
+ *	*/
+#define MEM_TAG_NONE					(-1)
+
+/*	Atomic operations.
+ *	*/
+#if USE_PTHREAD
+#define MEM_ATOMIC_ADD(var, n)		__sync_add_and_fetch(&(var), (n))
+#define MEM_ATOMIC_CAS(var, o, n)	__sync_bool_compare_and_swap(&(var), (o), (n))
+#else
+#define MEM_ATOMIC_ADD(var, n)		((var) += (n))
+#define MEM_ATOMIC_CAS(var, o, n)	(((var) = (n)), 1)
+#endif
+
+
+/*	*************************************************************************
+ *	                                 TYPEDEF
+ *	************************************************************************* */
+
+/*	- Block header.
+ *	- Notes: Union keep the user memory aligned as "malloc()" does.
+ *	*/
+union mem_header_t
+{
+	struct
+	{
+		size_t	size;			/*	User size. */
+		int		tag;			/*	Tag, or MEM_TAG_NONE. */
+	} h;
+
+	long double	align_ld;
+	long long	align_ll;
+	void			*align_p;
+};
+
+/*	Accounting of a tag.
+ *	-------------------- */
+struct mem_account_t
+{
+	long long	current;		/*	Bytes in use. */
+	long long	peak;			/*	Highest "current". */
+	long long	allocs;		/*	Number of allocations. */
+	long long	live;			/*	Number of blocks in use. */
+};
+
+
+/*	*************************************************************************
+ *	                                VARIABLES
+ *	************************************************************************* */
+
+/*	Public variables.
+ *	***************** */
+
+int	mem_report_enable	= 0;
+
+
+/*	Private variables.
+ *	****************** */
+
+/*	Notes: Last entry accounts for all tags.
+ *	*/
+static struct mem_account_t	mem_account[MT_TAGS + 1];
+
+static const char	*mem_tag_name[MT_TAGS]	=
+{
+	"Symbols", "Byte/word stack", "Expressions", "File names",
+	"Macros", "Line buffers", "Layout", "Options", "Cycles analysis",
+	"Code generators", "Peephole", "Simulator", "Trace profile",
+	"Stack depth"
+};
+
+
+/*	*************************************************************************
+ *									  FUNCTIONS DECLARATION
+ *	************************************************************************* */
+
+static void mem_account_add(struct mem_account_t *p_account, long long size, int n);
+static void *mem_setup(union mem_header_t *p_header, enum mem_tag_t tag, size_t size);
+
+
+/*	*************************************************************************
+ *	                                FUNCTIONS
+ *	************************************************************************* */
+
+/*	*************************************************************************
+ *	Function name:	mem_account_add
+ *	Description:	Update an account.
+ *	Author(s):
+ *	Created:			18 October 2026
+ *	Last modified:
+ *
+ *	Parameters:		struct mem_account_t *p_account:
+ *							Account to update.
+ *
+ *						long long size:
+ *							Bytes allocated (> 0) or freed (< 0).
+ *
+ *						int n:
+ *							Blocks allocated (1), freed (-1), or resized (0).
+ *
+ *	Returns:			void
+ *	Globals:
+ *	Notes:
+ *	************************************************************************* */
+
+static void mem_account_add(struct mem_account_t *p_account, long long size, int n)
+{
+	long long	current	= MEM_ATOMIC_ADD(p_account->current, size);
+	long long	peak;
+
+
+	if (n > 0)
+		MEM_ATOMIC_ADD(p_account->allocs, 1);
+
+	if (n != 0)
+		MEM_ATOMIC_ADD(p_account->live, n);
+
+	/*	Update peak, unless an other thread set it higher.
+	 *	-------------------------------------------------- */
+	while (current > (peak = p_account->peak))
+	{
+		if (MEM_ATOMIC_CAS(p_account->peak, peak, current))
+			break;
+	}
+}
+
+
+/*	*************************************************************************
+ *	Function name:	mem_setup
+ *	Description:	Set up header of a new block, and account it.
+ *	Author(s):
+ *	Created:			18 October 2026
+ *	Last modified:
+ *
+ *	Parameters:		union mem_header_t *p_header:
+ *							Block (header), or NULL.
+ *
+ *						enum mem_tag_t tag:
+ *							Tag.
+ *
+ *						size_t size:
+ *							User size.
+ *
+ *	Returns:			void *:
+ *							User memory, or NULL.
+ *
+ *	Globals:			int mem_report_enable
+ *	Notes:
+ *	************************************************************************* */
+
+static void *mem_setup(union mem_header_t *p_header, enum mem_tag_t tag, size_t size)
+{
+	if (p_header == NULL)
+		return (NULL);
+
+	p_header->h.size	= size;
+	p_header->h.tag	= MEM_TAG_NONE;
+
+	if (mem_report_enable)
+	{
+		p_header->h.tag	= (int) tag;
+
+		mem_account_add(&mem_account[tag], (long long) size, 1);
+		mem_account_add(&mem_account[MT_TAGS], (long long) size, 1);
+	}
+
+	return (p_header + 1);
+}
+
+
+/*	*************************************************************************
+ *	Function name:	mem_alloc
+ *	Description:	Allocate memory ("malloc()").
+ *	Author(s):
+ *	Created:			18 October 2026
+ *	Last modified:
+ *
+ *	Parameters:		enum mem_tag_t tag:
+ *							Subsystem the memory is allocated for.
+ *
+ *						size_t size:
+ *							Number of bytes.
+ *
+ *	Returns:			void *:
+ *							Allocated memory, or NULL.
+ *
+ *	Globals:
+ *	Notes:
+ *	************************************************************************* */
+
+void *mem_alloc(enum mem_tag_t tag, size_t size)
+{
+	STATS_COUNT(SC_MALLOC, 1);
+
+	return (mem_setup(malloc(sizeof (union mem_header_t) + size), tag, size));
+}
+
+
+/*	*************************************************************************
+ *	Function name:	mem_calloc
+ *	Description:	Allocate memory, cleared ("calloc()").
+ *	Author(s):
+ *	Created:			18 October 2026
+ *	Last modified:
+ *
+ *	Parameters:		enum mem_tag_t tag:
+ *							Subsystem the memory is allocated for.
+ *
+ *						size_t n:
+ *							Number of elements.
+ *
+ *						size_t size:
+ *							Size of an element.
+ *
+ *	Returns:			void *:
+ *							Allocated memory, or NULL.
+ *
+ *	Globals:
+ *	Notes:
+ *	************************************************************************* */
+
+void *mem_calloc(enum mem_tag_t tag, size_t n, size_t size)
+{
+	STATS_COUNT(SC_MALLOC, 1);
+
+	/*	Check for size overflow.
+	 *	------------------------ */
+	if ((size != 0) && (n > (((size_t) -1) - sizeof (union mem_header_t)) / size))
+		return (NULL);
+
+	return (mem_setup(calloc(1, sizeof (union mem_header_t) + (n * size)), tag, n * size));
+}
+
+
+/*	*************************************************************************
+ *	Function name:	mem_realloc
+ *	Description:	Resize allocated memory ("realloc()").
+ *	Author(s):
+ *	Created:			18 October 2026
+ *	Last modified:
+ *
+ *	Parameters:		enum mem_tag_t tag:
+ *							Subsystem the memory is allocated for (used
+ *							if "p" is NULL).
+ *
+ *						void *p:
+ *							Memory to resize (may be NULL).
+ *
+ *						size_t size:
+ *							New number of bytes.
+ *
+ *	Returns:			void *:
+ *							Allocated memory, or NULL.
+ *
+ *	Globals:
+ *	Notes:			- Block keep its tag.
+ *	************************************************************************* */
+
+void *mem_realloc(enum mem_tag_t tag, void *p, size_t size)
+{
+	union mem_header_t	*p_header;
+	long long				delta;
+
+
+	if (p == NULL)
+		return (mem_alloc(tag, size));
+
+	STATS_COUNT(SC_MALLOC, 1);
+
+	p_header	= (union mem_header_t *) p - 1;
+	delta		= (long long) size - (long long) p_header->h.size;
+
+	p_header	= (union mem_header_t *) realloc(p_header, sizeof (union mem_header_t) + size);
+
+	if (p_header == NULL)
+		return (NULL);
+
+	p_header->h.size	= size;
+
+	if (p_header->h.tag != MEM_TAG_NONE)
+	{
+		mem_account_add(&mem_account[p_header->h.tag], delta, 0);
+		mem_account_add(&mem_account[MT_TAGS], delta, 0);
+	}
+
+	return (p_header + 1);
+}
+
+
+/*	*************************************************************************
+ *	Function name:	mem_free
+ *	Description:	Release memory ("free()").
+ *	Author(s):
+ *	Created:			18 October 2026
+ *	Last modified:
+ *
+ *	Parameters:		void *p:
+ *							Memory to release (may be NULL).
+ *
+ *	Returns:			void
+ *	Globals:
+ *	Notes:
+ *	************************************************************************* */
+
+void mem_free(void *p)
+{
+	union mem_header_t	*p_header;
+
+
+	if (p == NULL)
+		return;
+
+	p_header	= (union mem_header_t *) p - 1;
+
+	if (p_header->h.tag != MEM_TAG_NONE)
+	{
+		long long	size	= (long long) p_header->h.size;
+
+		mem_account_add(&mem_account[p_header->h.tag], -size, -1);
+		mem_account_add(&mem_account[MT_TAGS], -size, -1);
+	}
+
+	free(p_header);
+}
+
+
+/*	*************************************************************************
+ *	Function name:	mem_report
+ *	Description:	Print memory report.
+ *	Author(s):
+ *	Created:			18 October 2026
+ *	Last modified:
+ *	Parameters:		void
+ *	Returns:			void
+ *	Globals:
+ *
+ *	Notes:			- Called at exit, after clean up.  So, "Current" and
+ *						  "Live" show memory that was not released.
+ *						- Header overhead is not included.
+ *	************************************************************************* */
+
+void mem_report(void)
+{
+	int	i;
+
+
+	if (mem_report_enable == 0)
+		return;
+
+	fprintf(stderr, "\nMemory report:\n");
+
+	fprintf(	stderr, "  %-16s %14s %14s %10s %8s\n",
+		  		"Tag", "Current (B)", "Peak (B)", "Allocs", "Live");
+
+	for (i = 0; i <= MT_TAGS; i++)
+	{
+		struct mem_account_t	*p_account	= &mem_account[i];
+
+		if (i == MT_TAGS)
+			fprintf(stderr, "\n");
+
+		fprintf(	stderr, "  %-16s %14lld %14lld %10lld %8lld\n",
+			  		(i < MT_TAGS) ? mem_tag_name[i] : "Total",
+					p_account->current, p_account->peak, p_account->allocs,
+					p_account->live);
+	}
+}
+
+
+
+
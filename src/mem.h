@@ -0,0 +1,99 @@
+/*	*************************************************************************
+ *	Module Name:	mem.h
+ *	Description:	Memory Allocation.
+ *	Copyright(c):	See below...
+ *	Author(s):
+ *	Created:			18 October 2026
+ *	Last modified:
+ *	Notes:
+ *	************************************************************************* */
+
+/*
+ * Copyright (c) <2007-2017> Jay Cotton <lbmgmusic@gmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+
+
+/*	*************************************************************************
+ *	************************************************************************* */
+
+#ifndef _MEM_H
+#define _MEM_H
+
+
+/*	*************************************************************************
+ *	                              INCLUDE FILES
+ *	************************************************************************* */
+
+#include <stddef.h>
+
+#include "project.h"
+
+
+/*	*************************************************************************
+ *	                                 TYPEDEF
+ *	************************************************************************* */
+
+/*	Allocation tags (subsystems).
+ *	----------------------------- */
+enum mem_tag_t
+{
+	MT_SYMBOLS,					/*	Symbols: nodes, names, file names, "EQU". */
+	MT_STACK,					/*	"ByteWordStack" nodes. */
+	MT_EXP,						/*	Expression parser: stack frames, text. */
+	MT_FILES,					/*	Input, include and output file names. */
+	MT_MACROS,					/*	Macro file names and buffers. */
+	MT_LINE,						/*	Source line buffers. */
+	MT_LAYOUT,					/*	Parallel layout ("-j" option). */
+	MT_OPTIONS,					/*	Command line options. */
+	MT_CYCLES,					/*	Cycles analysis ("--cycles" option). */
+	MT_CODEGEN,					/*	Code generators ("DELAY" directive). */
+	MT_PEEP,						/*	Peephole optimizer ("-O" option). */
+	MT_SIM,						/*	Simulator ("--run" option). */
+	MT_PROFILE,					/*	Trace profile ("--profile" option). */
+	MT_DEPTH,					/*	Stack depth analysis ("--stack" option). */
+	MT_TAGS
+};
+
+
+/*	*************************************************************************
+ *	                                VARIABLES
+ *	************************************************************************* */
+
+extern int	mem_report_enable;	/*	"--mem-report" option. */
+
+
+/*	*************************************************************************
+ *	                          FUNCTIONS DECLARATION
+ *	************************************************************************* */
+
+void *mem_alloc(enum mem_tag_t tag, size_t size);
+void *mem_calloc(enum mem_tag_t tag, size_t n, size_t size);
+void *mem_realloc(enum mem_tag_t tag, void *p, size_t size);
+void mem_free(void *p);
+void mem_report(void);
+
+
+
+#endif
+
+
+
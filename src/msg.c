@@ -4,7 +4,7 @@
  *	Copyright(c):	See below...
  *	Author(s):		Claude Sylvain
  *	Created:			1 January 2012
- *	Last modified:	4 January 2012
+ *	Last modified:	18 October 2026
  *	************************************************************************* */
 
 /*
@@ -44,6 +44,13 @@
 #include "msg.h"
 
 
+/*	*************************************************************************
+ *												 MACROS
+ *	************************************************************************* */
+
+#define MSG_FP			((fp_msg != NULL) ? fp_msg : stderr)
+
+
 /*	*************************************************************************
  *												 CONST
  *	************************************************************************* */
@@ -53,6 +60,18 @@
 
 static const char	*str_err	= "Error";
 static const char	*str_war	= "Warning";
+static const char	*str_note	= "Note";
+
+
+/*	*************************************************************************
+ *	                                VARIABLES
+ *	************************************************************************* */
+
+/*	- Messages File Pointer.  When NULL, messages are printed
+ *	  to "stderr".  Used by "layout.c" to keep messages of
+ *	  concurrently assembled lines in order.
+ *	*/
+THREAD_LOCAL FILE	*fp_msg	= NULL;
 
 
 /*	*************************************************************************
@@ -106,7 +125,7 @@ static void print_msg(const char *str_type, char *msg, int code)
 					code, in_fn[file_level], msg);
 	}
 
-	fprintf(stderr, "*** %s %d in \"%s\" @%d: %s\n", str_type,
+	fprintf(MSG_FP, "*** %s %d in \"%s\" @%d: %s\n", str_type,
 				code, in_fn[file_level], codeline[file_level],
 				msg);
 }
@@ -151,7 +170,7 @@ static void print_msg_c(const char *str_type, char *msg, int code, char c)
 					code, in_fn[file_level], msg, c);
 	}
 
-	fprintf(stderr, "*** %s %d in \"%s\" @%d: %s (\"%c\")\n", str_type,
+	fprintf(MSG_FP, "*** %s %d in \"%s\" @%d: %s (\"%c\")\n", str_type,
 				code, in_fn[file_level], codeline[file_level], msg, c);
 }
 
@@ -195,7 +214,7 @@ static void print_msg_s(const char *str_type, char *msg, int code, char *s)
 					code, in_fn[file_level], msg, s);
 	}
 
-	fprintf(stderr, "*** %s %d in \"%s\" @%d: %s (\"%s\")\n", str_type,
+	fprintf(MSG_FP, "*** %s %d in \"%s\" @%d: %s (\"%s\")\n", str_type,
 				code, in_fn[file_level], codeline[file_level], msg, s);
 }
 
@@ -239,7 +258,7 @@ static void print_msg_d(const char *str_type, char *msg, int code, int d)
 					code, in_fn[file_level], msg, d);
 	}
 
-	fprintf(stderr, "*** %s %d in \"%s\" @%d: %s (%d)\n", str_type,
+	fprintf(MSG_FP, "*** %s %d in \"%s\" @%d: %s (%d)\n", str_type,
 				code, in_fn[file_level], codeline[file_level], msg, d);
 }
 
@@ -358,6 +377,45 @@ void msg_error_d(char *msg, int err_code, int d)
 }
 
 
+/*	*************************************************************************
+ *	Function name:	msg_error_at
+ *	Description:	Print Error Message, for a given source line.
+ *	Author(s):
+ *	Created:			18 October 2026
+ *	Last modified:
+ *
+ *	Parameters:		char *msg:
+ *							Message to display.
+ *
+ *						int err_code:
+ *							Error Code.
+ *
+ *						const char *fn:
+ *							Source file name.
+ *
+ *						int line:
+ *							Source line number.
+ *
+ *	Returns:			void
+ *	Globals:
+ *
+ *	Notes:			- For errors found after the source line was
+ *						  assembled (e.g. "CYCLES" directive).
+ *	************************************************************************* */
+
+void msg_error_at(char *msg, int err_code, const char *fn, int line)
+{
+	/*	Print message only on second assembly pass.
+	 *	*/	
+	if (asm_pass != 1)	return;
+
+	if (list != NULL)
+		fprintf(list, "*** %s %d in \"%s\": %s\n", str_err, err_code, fn, msg);
+
+	fprintf(MSG_FP, "*** %s %d in \"%s\" @%d: %s\n", str_err, err_code, fn, line, msg);
+}
+
+
 /*	*************************************************************************
  *	Function name:	msg_warning
  *	Description:	Print Warning Message, without additionnal information.
@@ -442,6 +500,37 @@ void msg_warning_s(char *msg, int war_code, char *s)
 }
 
 
+/*	*************************************************************************
+ *	Function name:	msg_note
+ *	Description:	Print Note Message (no code).
+ *	Author(s):
+ *	Created:			18 October 2026
+ *	Last modified:
+ *
+ *	Parameters:		char *msg:
+ *							Message to display.
+ *
+ *	Returns:			void
+ *	Globals:
+ *
+ *	Notes:			- For information that is neither an error, nor a
+ *						  warning (e.g. "-O" option changes).
+ *	************************************************************************* */
+
+void msg_note(char *msg)
+{
+	/*	Print message only on second assembly pass.
+	 *	*/	
+	if (asm_pass != 1)	return;
+
+	if (list != NULL)
+		fprintf(list, "*** %s in \"%s\": %s\n", str_note, in_fn[file_level], msg);
+
+	fprintf(	MSG_FP, "*** %s in \"%s\" @%d: %s\n", str_note, in_fn[file_level],
+				codeline[file_level], msg);
+}
+
+
 
 
 
@@ -42,9 +42,18 @@
  *	                              INCLUDE FILES
  *	************************************************************************* */
 
+#include <stdio.h>
+
 #include "project.h"
 
 
+/*	*************************************************************************
+ *	                                VARIABLES
+ *	************************************************************************* */
+
+extern THREAD_LOCAL FILE	*fp_msg;		/*	Messages File Pointer. */
+
+
 /*	*************************************************************************
  *	                          FUNCTIONS DECLARATION
  *	************************************************************************* */
@@ -53,10 +62,12 @@ void msg_error(char *msg, int err_code);
 void msg_error_c(char *msg, int err_code, char c);
 void msg_error_s(char *msg, int err_code, char *s);
 void msg_error_d(char *msg, int err_code, int d);
+void msg_error_at(char *msg, int err_code, const char *fn, int line);
 
 void msg_warning(char *msg, int war_code);
 void msg_warning_c(char *msg, int war_code, char c);
 void msg_warning_s(char *msg, int war_code, char *s);
+void msg_note(char *msg);
 
 
 
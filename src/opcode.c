@@ -54,13 +54,43 @@
  *											  CONSTANTS
  *	************************************************************************* */
 
-/*	"parse_reg16bits()" Allowed 16-bit Register bit mask.
- *	----------------------------------------------------- */
-#define PR16_AR_BC			0x01
-#define PR16_AR_DE			0x02
-#define PR16_AR_HL			0x04
-#define PR16_AR_SP			0x08
-#define PR16_AR_PSW			0x10
+/*	8-bit Register codes.
+ *	--------------------- */
+#define REG8_B				0
+#define REG8_C				1
+#define REG8_D				2
+#define REG8_E				3
+#define REG8_H				4
+#define REG8_L				5
+#define REG8_M				6
+#define REG8_A				7
+
+/*	16-bit Register (register pair) codes.
+ *	-------------------------------------- */
+#define RP_BC					0
+#define RP_DE					1
+#define RP_HL					2
+#define RP_SP					3
+#define RP_PSW					4
+
+#define RP_NAME_LEN_MAX		3		/*	Longest register pair name ("PSW"). */
+
+/*	"reg16_field()" Allowed 16-bit Register bit mask.
+ *	------------------------------------------------- */
+#define PR16_AR_BC			(1 << RP_BC)
+#define PR16_AR_DE			(1 << RP_DE)
+#define PR16_AR_HL			(1 << RP_HL)
+#define PR16_AR_SP			(1 << RP_SP)
+#define PR16_AR_PSW			(1 << RP_PSW)
+
+/*	"reg_class[]" bits.
+ *	------------------- */
+#define RC_CODE				0x07		/*	8-bit register code ("REG8_x"). */
+#define RC_REG8				0x08		/*	8-bit register name. */
+#define RC_RP					0x10		/*	Register pair name ("B", "D", "H"). */
+#define RC_DELIM				0x20		/*	Operand delimiter. */
+
+
 
 
 /*	*************************************************************************
@@ -70,103 +100,12 @@
 /*	Private functions.
  *	****************** */
 
-static char *parse_reg16bits(char *text, unsigned char ar);
-static char is_str_reg(char *text);
-static char *DestReg(char *text);
-static char *SourceReg(char *text);
-
-static int proc_add(char *, char *);
-static int proc_adi(char *, char *);
-static int proc_adc(char *, char *);
-static int proc_aci(char *, char *);
-static int proc_ana(char *, char *);
-static int proc_ani(char *, char *);
-
-static int proc_cmp(char *, char *);
-static int proc_cpi(char *, char *);
-static int proc_cma(char *, char *);
-static int proc_cmc(char *, char *);
-static int proc_call(char *, char *);
-static int proc_cnz(char *, char *);
-static int proc_cz(char *, char *);
-static int proc_cnc(char *, char *);
-static int proc_cc(char *, char *);
-static int proc_cpo(char *, char *);
-static int proc_cpe(char *, char *);
-static int proc_cp(char *, char *);
-static int proc_cm(char *, char *);
-
-static int proc_dcr(char *, char *);
-static int proc_dcx(char *, char *);
-static int proc_daa(char *, char *);
-static int proc_dad(char *, char *);
-static int proc_di(char *, char *);
-
-static int proc_ei(char *, char *);
-
-static int proc_hlt(char *, char *);
-
-static int proc_in(char *label, char *equation);
-static int proc_inr(char *, char *);
-static int proc_inx(char *, char *);
-
-static int proc_jmp(char *, char *);
-static int proc_jnz(char *, char *);
-static int proc_jz(char *, char *);
-static int proc_jnc(char *, char *);
-static int proc_jc(char *, char *);
-static int proc_jpo(char *, char *);
-static int proc_jpe(char *, char *);
-static int proc_jp(char *, char *);
-static int proc_jm(char *, char *);
-
-static int proc_lxi(char *, char *);
-static int proc_lhld(char *, char *);
-static int proc_lda(char *, char *);
-static int proc_ldax(char *, char *);
-
-static int proc_mov(char *, char *);
-static int proc_mvi(char *, char *);
-
-static int proc_nop(char *label, char *equation);
-
-static int proc_ora(char *, char *);
-static int proc_ori(char *, char *);
-static int proc_out(char *label, char *equation);
-
-static int proc_pchl(char *, char *);
-static int proc_pop(char *, char *);
-static int proc_push(char *, char *);
-
-static int proc_rlc(char *, char *);
-static int proc_rrc(char *, char *);
-static int proc_ral(char *, char *);
-static int proc_rar(char *, char *);
-static int proc_ret(char *, char *);
-static int proc_rnz(char *, char *);
-static int proc_rz(char *, char *);
-static int proc_rnc(char *, char *);
-static int proc_rc(char *, char *);
-static int proc_rpo(char *, char *);
-static int proc_rpe(char *, char *);
-static int proc_rp(char *, char *);
-static int proc_rm(char *, char *);
-static int proc_rst(char *label, char *equation);
-
-static int proc_sta(char *, char *);
-static int proc_shld(char *, char *);
-static int proc_stax(char *, char *);
-static int proc_sub(char *, char *);
-static int proc_sui(char *, char *);
-static int proc_sbb(char *, char *);
-static int proc_sbi(char *, char *);
-static int proc_stc(char *, char *);
-static int proc_sphl(char *, char *);
-
-static int proc_xchg(char *, char *);
-static int proc_xra(char *, char *);
-static int proc_xri(char *, char *);
-static int proc_xthl(char *, char *);
+static int reg8_decode(const char *text, int *p_len);
+static int reg16_decode(const char *text, int *p_len);
+static char *reg8_field(char *text, int shift, char *p_is_reg);
+static char *reg16_field(char *text, unsigned char ar, int shift);
+static void decode_init(void);
+static char *disasm_hex(char *buf, int value, int digits);
 
 
 /*	*************************************************************************
@@ -177,36 +116,118 @@ static int proc_xthl(char *, char *);
  *	*************** */
 
 /*	Opcodes.
- *	-------- */	
-const keyword_t	OpCodes[] =
-{
-	{"MOV", proc_mov},			{"MVI", proc_mvi},	{"LXI", proc_lxi},
-	{"LDA", proc_lda},			{"STA", proc_sta},	{"LHLD", proc_lhld},
-	{"SHLD", proc_shld},			{"LDAX", proc_ldax},	{"STAX", proc_stax},
-	{"XCHG", proc_xchg},			{"ADD", proc_add},	{"ADI", proc_adi},
-	{"ADC", proc_adc},			{"ACI", proc_aci},	{"SUB", proc_sub},
-	{"SUI", proc_sui},			{"SBB", proc_sbb},	{"SBI", proc_sbi},
-	{"INR", proc_inr},			{"DCR", proc_dcr},	{"INX", proc_inx},
-	{"DCX", proc_dcx},			{"DAD", proc_dad},	{"DAA", proc_daa},
-	{"ANA", proc_ana},			{"ANI", proc_ani},	{"ORA", proc_ora},
-	{"ORI", proc_ori},			{"XRA", proc_xra},	{"XRI", proc_xri},
-	{"CMP", proc_cmp},			{"CPI", proc_cpi},	{"RLC", proc_rlc},
-	{"RRC", proc_rrc},			{"RAL", proc_ral},	{"RAR", proc_rar},
-	{"CMA", proc_cma},			{"CMC", proc_cmc},	{"STC", proc_stc},
-	{"JMP", proc_jmp},			{"JNZ", proc_jnz},	{"JZ", proc_jz},
-	{"JNC", proc_jnc},			{"JC", proc_jc},	{"JPO", proc_jpo},
-	{"JPE", proc_jpe},			{"JP", proc_jp},	{"JM", proc_jm},
-	{"CALL", proc_call},			{"CNZ", proc_cnz},	{"CZ", proc_cz},
-	{"CNC", proc_cnc},			{"CC", proc_cc},	{"CPO", proc_cpo},
-	{"CPE", proc_cpe},			{"CP", proc_cp},	{"CM", proc_cm},
-	{"RET", proc_ret},			{"RNZ", proc_rnz},	{"RZ", proc_rz},
-	{"RNC", proc_rnc},			{"RC", proc_rc},	{"RPO", proc_rpo},
-	{"RPE", proc_rpe},			{"RP", proc_rp},	{"RM", proc_rm},
-	{"RST", proc_rst},			{"PCHL", proc_pchl},	{"PUSH", proc_push},
-	{"POP", proc_pop},			{"XTHL", proc_xthl},	{"SPHL", proc_sphl},
-	{"IN", proc_in},			{"OUT", proc_out},	{"EI", proc_ei},
-	{"DI", proc_di},			{"HLT", proc_hlt},	{"NOP", proc_nop},
-	{0, NULL}
+ *	Notes:	- Name, base opcode, operand class, register field shift,
+ *				  size, cycles and control flow.  Used by "opcode_layout()",
+ *				  "opcode_encode()" and "opcode_decode()".
+ *	---------------------------------------------------------------- */
+const opcode_t	OpCodes[] =
+{
+	{"MOV",	0x40, OC_MOV,			3, 1, {5, 7}, OF_NEXT},
+	{"MVI",	0x06, OC_REG8_IMM8,	3, 2, {7, 10}, OF_NEXT},
+	{"LXI",	0x01, OC_RP_IMM16,	4, 3, {10, 10}, OF_NEXT},
+	{"LDA",	0x3A, OC_IMM16,		0, 3, {13, 13}, OF_NEXT},
+	{"STA",	0x32, OC_IMM16,		0, 3, {13, 13}, OF_NEXT},
+	{"LHLD",	0x2A, OC_IMM16,		0, 3, {16, 16}, OF_NEXT},
+	{"SHLD",	0x22, OC_IMM16,		0, 3, {16, 16}, OF_NEXT},
+	{"LDAX",	0x0A, OC_RP_BD,		4, 1, {7, 7}, OF_NEXT},
+	{"STAX",	0x02, OC_RP_BD,		4, 1, {7, 7}, OF_NEXT},
+	{"XCHG",	0xEB, OC_NONE,			0, 1, {4, 4}, OF_NEXT},
+	{"ADD",	0x80, OC_REG8,			0, 1, {4, 7}, OF_NEXT},
+	{"ADI",	0xC6, OC_IMM8,			0, 2, {7, 7}, OF_NEXT},
+	{"ADC",	0x88, OC_REG8,			0, 1, {4, 7}, OF_NEXT},
+	{"ACI",	0xCE, OC_IMM8,			0, 2, {7, 7}, OF_NEXT},
+	{"SUB",	0x90, OC_REG8,			0, 1, {4, 7}, OF_NEXT},
+	{"SUI",	0xD6, OC_IMM8,			0, 2, {7, 7}, OF_NEXT},
+	{"SBB",	0x98, OC_REG8,			0, 1, {4, 7}, OF_NEXT},
+	{"SBI",	0xDE, OC_IMM8,			0, 2, {7, 7}, OF_NEXT},
+	{"INR",	0x04, OC_REG8,			3, 1, {5, 10}, OF_NEXT},
+	{"DCR",	0x05, OC_REG8,			3, 1, {5, 10}, OF_NEXT},
+	{"INX",	0x03, OC_RP,			4, 1, {5, 5}, OF_NEXT},
+	{"DCX",	0x0B, OC_RP,			4, 1, {5, 5}, OF_NEXT},
+	{"DAD",	0x09, OC_RP,			4, 1, {10, 10}, OF_NEXT},
+	{"DAA",	0x27, OC_NONE,			0, 1, {4, 4}, OF_NEXT},
+	{"ANA",	0xA0, OC_REG8,			0, 1, {4, 7}, OF_NEXT},
+	{"ANI",	0xE6, OC_IMM8,			0, 2, {7, 7}, OF_NEXT},
+	{"ORA",	0xB0, OC_REG8,			0, 1, {4, 7}, OF_NEXT},
+	{"ORI",	0xF6, OC_IMM8,			0, 2, {7, 7}, OF_NEXT},
+	{"XRA",	0xA8, OC_REG8,			0, 1, {4, 7}, OF_NEXT},
+	{"XRI",	0xEE, OC_IMM8,			0, 2, {7, 7}, OF_NEXT},
+	{"CMP",	0xB8, OC_REG8,			0, 1, {4, 7}, OF_NEXT},
+	{"CPI",	0xFE, OC_IMM8,			0, 2, {7, 7}, OF_NEXT},
+	{"RLC",	0x07, OC_NONE,			0, 1, {4, 4}, OF_NEXT},
+	{"RRC",	0x0F, OC_NONE,			0, 1, {4, 4}, OF_NEXT},
+	{"RAL",	0x17, OC_NONE,			0, 1, {4, 4}, OF_NEXT},
+	{"RAR",	0x1F, OC_NONE,			0, 1, {4, 4}, OF_NEXT},
+	{"CMA",	0x2F, OC_NONE,			0, 1, {4, 4}, OF_NEXT},
+	{"CMC",	0x3F, OC_NONE,			0, 1, {4, 4}, OF_NEXT},
+	{"STC",	0x37, OC_NONE,			0, 1, {4, 4}, OF_NEXT},
+	{"JMP",	0xC3, OC_IMM16,		0, 3, {10, 10}, OF_JUMP},
+	{"JNZ",	0xC2, OC_IMM16,		0, 3, {10, 10}, OF_JUMP_COND},
+	{"JZ",	0xCA, OC_IMM16,		0, 3, {10, 10}, OF_JUMP_COND},
+	{"JNC",	0xD2, OC_IMM16,		0, 3, {10, 10}, OF_JUMP_COND},
+	{"JC",	0xDA, OC_IMM16,		0, 3, {10, 10}, OF_JUMP_COND},
+	{"JPO",	0xE2, OC_IMM16,		0, 3, {10, 10}, OF_JUMP_COND},
+	{"JPE",	0xEA, OC_IMM16,		0, 3, {10, 10}, OF_JUMP_COND},
+	{"JP",	0xF2, OC_IMM16,		0, 3, {10, 10}, OF_JUMP_COND},
+	{"JM",	0xFA, OC_IMM16,		0, 3, {10, 10}, OF_JUMP_COND},
+	{"CALL",	0xCD, OC_IMM16,		0, 3, {17, 17}, OF_CALL},
+	{"CNZ",	0xC4, OC_IMM16,		0, 3, {11, 17}, OF_CALL_COND},
+	{"CZ",	0xCC, OC_IMM16,		0, 3, {11, 17}, OF_CALL_COND},
+	{"CNC",	0xD4, OC_IMM16,		0, 3, {11, 17}, OF_CALL_COND},
+	{"CC",	0xDC, OC_IMM16,		0, 3, {11, 17}, OF_CALL_COND},
+	{"CPO",	0xE4, OC_IMM16,		0, 3, {11, 17}, OF_CALL_COND},
+	{"CPE",	0xEC, OC_IMM16,		0, 3, {11, 17}, OF_CALL_COND},
+	{"CP",	0xF4, OC_IMM16,		0, 3, {11, 17}, OF_CALL_COND},
+	{"CM",	0xFC, OC_IMM16,		0, 3, {11, 17}, OF_CALL_COND},
+	{"RET",	0xC9, OC_NONE,			0, 1, {10, 10}, OF_RET},
+	{"RNZ",	0xC0, OC_NONE,			0, 1, {5, 11}, OF_RET_COND},
+	{"RZ",	0xC8, OC_NONE,			0, 1, {5, 11}, OF_RET_COND},
+	{"RNC",	0xD0, OC_NONE,			0, 1, {5, 11}, OF_RET_COND},
+	{"RC",	0xD8, OC_NONE,			0, 1, {5, 11}, OF_RET_COND},
+	{"RPO",	0xE0, OC_NONE,			0, 1, {5, 11}, OF_RET_COND},
+	{"RPE",	0xE8, OC_NONE,			0, 1, {5, 11}, OF_RET_COND},
+	{"RP",	0xF0, OC_NONE,			0, 1, {5, 11}, OF_RET_COND},
+	{"RM",	0xF8, OC_NONE,			0, 1, {5, 11}, OF_RET_COND},
+	{"RST",	0xC7, OC_RST,			3, 1, {11, 11}, OF_RST},
+	{"PCHL",	0xE9, OC_NONE,			0, 1, {5, 5}, OF_PCHL},
+	{"PUSH",	0xC5, OC_RP_PSW,		4, 1, {11, 11}, OF_NEXT},
+	{"POP",	0xC1, OC_RP_PSW,		4, 1, {10, 10}, OF_NEXT},
+	{"XTHL",	0xE3, OC_NONE,			0, 1, {18, 18}, OF_NEXT},
+	{"SPHL",	0xF9, OC_NONE,			0, 1, {5, 5}, OF_NEXT},
+	{"IN",	0xDB, OC_IMM8,			0, 2, {10, 10}, OF_NEXT},
+	{"OUT",	0xD3, OC_IMM8,			0, 2, {10, 10}, OF_NEXT},
+	{"EI",	0xFB, OC_NONE,			0, 1, {4, 4}, OF_EI},
+	{"DI",	0xF3, OC_NONE,			0, 1, {4, 4}, OF_DI},
+	{"HLT",	0x76, OC_NONE,			0, 1, {7, 7}, OF_HLT},
+	{"NOP",	0x00, OC_NONE,			0, 1, {4, 4}, OF_NEXT},
+	{NULL, 0, 0, 0, 0, {0, 0}, 0}
+};
+
+
+/*	Private "const".
+ *	**************** */
+
+/*	- Character class, for register operand decoding.
+ *	  See "RC_x" defines.
+ *	------------------------------------------------- */
+static const uint8_t	reg_class[256] =
+{
+	0x20, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x20, 0x20, 0x20, 0x20, 0x20, 0x00, 0x00,		/*	0x00 */
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,		/*	0x10 */
+	0x20, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x20, 0x00, 0x00, 0x00,		/*	0x20 */
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,		/*	0x30 */
+	0x00, 0x0F, 0x18, 0x09, 0x1A, 0x0B, 0x00, 0x00, 0x1C, 0x00, 0x00, 0x00, 0x0D, 0x0E, 0x00, 0x00,		/*	0x40 */
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,		/*	0x50 */
+	0x00, 0x0F, 0x18, 0x09, 0x1A, 0x0B, 0x00, 0x00, 0x1C, 0x00, 0x00, 0x00, 0x0D, 0x0E, 0x00, 0x00,		/*	0x60 */
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,		/*	0x70 */
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,		/*	0x80 */
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,		/*	0x90 */
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,		/*	0xA0 */
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,		/*	0xB0 */
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,		/*	0xC0 */
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,		/*	0xD0 */
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,		/*	0xE0 */
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00		/*	0xF0 */
 };
 
 
@@ -217,7 +238,13 @@ const keyword_t	OpCodes[] =
 /*	Private variables.
  *	****************** */
 
-static uint8_t	inst_cyc[2];
+static THREAD_LOCAL uint8_t	inst_cyc[2];
+
+/*	"opcode_decode()" tables (built on first use).
+ *	---------------------------------------------- */
+static const opcode_t	*decode_op[256];
+static uint8_t				decode_cyc[256][2];
+static int					decode_ready	= 0;
 
 
 /*	*************************************************************************
@@ -249,3495 +276,658 @@ void opcode_get_inst_cyc(uint8_t inst_cyc_p[])
 
 
 /*	*************************************************************************
- *	Function name:	parse_reg16bits
- *	Description:	Parse 16-bit Register.
- *	Author(s):		Jay Cotton, Claude Sylvain
- *	Created:			2007
- *	Last modified:	27 December 2011
+ *	Function name:	opcode_layout
+ *	Description:	Process an opcode for Layout only (size, no operand).
+ *	Author(s):
+ *	Created:			18 October 2026
+ *	Last modified:
  *
- *	Parameters:		char *text: 
- *				...
+ *	Parameters:		const keyword_t *p_opcode:
+ *							Point to the "OpCodes[]" entry of the opcode.
  *
- *				unsigned char ar:
- *				Allowed 16-bit Registers (See "PR16_AR_x" defines).
+ *						char *label:
+ *							Label found on the source line.
  *
- *	Returns:			char *:
- *				...
+ *	Returns:			int:
+ *							TEXT
  *
- *	Globals:
- *	Notes:
+ *	Globals:			int data_size
+ *
+ *	Notes:			- Used on assembler pass #1, where only label addresses
+ *						  are needed.  Instruction size does not depend on its
+ *						  operand, so operand is not evaluated at all.  Opcode
+ *						  bytes are left to 0, and are generated on pass #2 by
+ *						  "opcode_encode()".
  *	************************************************************************* */
 
-static char *parse_reg16bits(char *text, unsigned char ar)
+int opcode_layout(const opcode_t *p_opcode, char *label)
 {
-#define PARSE_REG16BITS_BUF_SIZE		4
+	process_label(label);		/*	Process Label. */
 
-	char	buf[PARSE_REG16BITS_BUF_SIZE];
-	char	buf_ori[PARSE_REG16BITS_BUF_SIZE];	/*	Buffer for original text. */
+	data_size	= p_opcode->size;
 
-	int	i		= 0;
-	int	text_len	= 0;
-	char	*p_text		= text;
-	int	reg_not_allowed	= 0;
+	return (TEXT);
+}
 
 
-	/*	Get register pair name.
-	 *	----------------------- */
-	while (	(*p_text != '\0') && (*p_text != ',') &&
-		  		(isspace((int) *p_text)) == 0)
-	{
-		text_len++;
-		p_text++;
-	}
+/*	*************************************************************************
+ *	Function name:	reg8_decode
+ *	Description:	Decode an 8-bit Register operand.
+ *	Author(s):
+ *	Created:			18 October 2026
+ *	Last modified:
+ *
+ *	Parameters:		const char *text:
+ *							Point to the operand.
+ *
+ *						int *p_len:
+ *							Point to a variable that will be filled with the
+ *							operand length, in characters.
+ *
+ *	Returns:			int:
+ *							- Register code ("REG8_x").
+ *							- (-1) if this is not an 8-bit register.
+ *
+ *	Globals:			None.
+ *	Notes:			- 8-bit register names are one character long, so
+ *						  operand length is always 1.
+ *	************************************************************************* */
 
-	/*	Check for name validity.
-	 *	------------------------ */	
-	if ((text_len <= 0) || (text_len > (sizeof (buf) - 1)))
-	{
-		msg_error_s("Bad 16-bit register!", EC_B16BR, text);
-		return (text);
-	}
+static int reg8_decode(const char *text, int *p_len)
+{
+	uint8_t	rc	= reg_class[(uint8_t) *text];
 
-	/*	- Make a uppercase working copy of string.
-	 *	- Notes: Not necessary to check for buffer overflow, since
-	 *	  string length check have already been done.
-	 *	---------------------------------------------------------- */	
-	while (	(*text != '\0') && (*text != ',') &&
-		  		(isspace((int) *text)) == 0)
-	{
-		buf_ori[i]	= *text;
-		buf[i]		= toupper((int) *text);
-		i++;
-		text++;
-	}
+	*p_len	= 1;
 
-	buf_ori[i]	= '\0';
-	buf[i]		= '\0';
+	return (((rc & RC_REG8) != 0) ? (rc & RC_CODE) : -1);
+}
 
-	if ((strcmp("BC", buf) == 0) || (*buf == 'B'))
-  	{
-		if ((ar & PR16_AR_BC) != 0)
-			return (text);
-		else
-			reg_not_allowed	= 1;
-	}
 
-	if ((strcmp("DE", buf) == 0) || (*buf == 'D'))
-  	{
-		if ((ar & PR16_AR_DE) != 0)
-		{
-			b1	+= 0x10;
-			return (text);
-		}
-		else
-			reg_not_allowed	= 1;
-	}
+/*	*************************************************************************
+ *	Function name:	reg16_decode
+ *	Description:	Decode a 16-bit Register (register pair) operand.
+ *	Author(s):
+ *	Created:			18 October 2026
+ *	Last modified:
+ *
+ *	Parameters:		const char *text:
+ *							Point to the operand.
+ *
+ *						int *p_len:
+ *							Point to a variable that will be filled with the
+ *							operand length, in characters.
+ *
+ *	Returns:			int:
+ *							- Register pair code ("RP_x").
+ *							- (-1) if this is not a 16-bit register.
+ *
+ *	Globals:			None.
+ *	Notes:			- Operand ends on a space, ',' or end of string.
+ *						- Like Intel assemblers, any name that begins with
+ *						  'B', 'D' or 'H' is "BC", "DE" or "HL".  "SP" and
+ *						  "PSW" must be complete.
+ *	************************************************************************* */
 
-	if ((strcmp("HL", buf) == 0) || (*buf == 'H'))
-  	{
-		if ((ar & PR16_AR_HL) != 0)
-		{
-			b1	+= 0x20;
-			return (text);
-		}
-		else
-			reg_not_allowed	= 1;
-	}
+static int reg16_decode(const char *text, int *p_len)
+{
+	uint8_t	rc	= reg_class[(uint8_t) *text];
+	int		len	= 0;
 
-	if (strcmp("SP", buf) == 0)
-  	{
-		if ((ar & PR16_AR_SP) != 0)
-		{
-			b1	+= 0x30;
-			return (text);
-		}
-		else
-			reg_not_allowed	= 1;
-	}
+	while ((reg_class[(uint8_t) text[len]] & RC_DELIM) == 0)
+		len++;
 
-	if (strcmp("PSW", buf) == 0)
-  	{
-		if ((ar & PR16_AR_PSW) != 0)
-		{
-			b1	+= 0x30;
-			return (text);
-		}
-		else
-			reg_not_allowed	= 1;
-	}
+	*p_len	= len;
+
+	if ((len < 1) || (len > RP_NAME_LEN_MAX))
+		return (-1);
 
-#if 0
-	/*	Print/Display error on pass #2 only.
-	 *	------------------------------------ */
-	if (asm_pass == 1)
+	/*	"BC", "DE" or "HL".
+	 *	------------------- */
+	if ((rc & RC_RP) != 0)
+		return ((rc & RC_CODE) >> 1);
+
+	if (	(len == 2) && (toupper((int) text[0]) == 'S') &&
+			(toupper((int) text[1]) == 'P'))
 	{
-		/*	If register not allowed...
-		 *	-------------------------- */
-		if (reg_not_allowed)
-		{
-			msg_error_s("Register not allowed!", EC_RNA, buf_ori);
-		}
-		/*	Bad register.
-		 *	------------- */
-		else
-		{
-			msg_error_s("Bad 16-bit register!", EC_B16BR, buf_ori);
-		}
+		return (RP_SP);
 	}
-#endif
 
-	/*	- Print error message if register is not allowed
-	 *	  or bad.
-	 *	------------------------------------------------ */
-	if (reg_not_allowed)
-		msg_error_s("Register not allowed!", EC_RNA, buf_ori);
-	else
-		msg_error_s("Bad 16-bit register!", EC_B16BR, buf_ori);
+	if (	(len == 3) && (toupper((int) text[0]) == 'P') &&
+			(toupper((int) text[1]) == 'S') && (toupper((int) text[2]) == 'W'))
+	{
+		return (RP_PSW);
+	}
 
-	return (text);
+	return (-1);
 }
 
 
 /*	*************************************************************************
- *	Function name:	is_str_reg
- *	Description:	Tell if "text" hold a Register name.
- *	Author(s):		Claude Sylvain
- *	Created:			26 May 2013
+ *	Function name:	reg8_field
+ *	Description:	Encode an 8-bit Register operand.
+ *	Author(s):
+ *	Created:			18 October 2026
  *	Last modified:
  *
  *	Parameters:		char *text:
- *							- Point to somewhere in a string that possibly
- *							  hold a register name.
+ *							Point to the operand.
  *
- *	Returns:			char:
- *							0:	No register name found.
- *							1:	A register name was found.
+ *						int shift:
+ *							Register field shift (0: Source, 3: Destination).
  *
- *	Globals:			None.
+ *						char *p_is_reg:
+ *							Point to a variable that is cleared if operand
+ *							is "M" (or bad).
+ *
+ *	Returns:			char *:
+ *							Point after the operand.
+ *
+ *	Globals:			int b1
  *	Notes:
  *	************************************************************************* */
 
-static char is_str_reg(char *text)
+static char *reg8_field(char *text, int shift, char *p_is_reg)
 {
-	char	rv	= 1;
-	int	c	= toupper((int) *text);
-
-	switch (c)
-  	{
-		case 'A':
-		case 'B':
-		case 'C':
-		case 'D':
-		case 'E':
-		case 'H':
-		case 'L':
-			break;
+	int	len;
+	int	reg	= reg8_decode(text, &len);
 
-		default:
-			rv	= 0;		/*	Not a register name. */
-			break;
+	if (reg < 0)
+	{
+		if (shift == 0)
+			msg_error_c("Bad source register!", EC_BSR, *text);
+		else
+			msg_error_c("Bad destination register!", EC_BDR, *text);
 	}
+	else
+		b1	+= reg << shift;
+
+	if ((reg < 0) || (reg == REG8_M))
+		*p_is_reg	= 0;
 
-	return (rv);
+	return (text + len);
 }
 
 
 /*	*************************************************************************
- *	Function name:	DestReg
- *	Description:	Parse Destination Register.
- *	Author(s):		Claude Sylvain
+ *	Function name:	reg16_field
+ *	Description:	Encode a 16-bit Register (register pair) operand.
+ *	Author(s):		Jay Cotton, Claude Sylvain
  *	Created:			2007
- *	Last modified:	27 December 2011
+ *	Last modified:	18 October 2026
  *
  *	Parameters:		char *text:
- *							...
+ *							Point to the operand.
+ *
+ *						unsigned char ar:
+ *							Allowed 16-bit Registers (See "PR16_AR_x" defines).
+ *
+ *						int shift:
+ *							Register field shift.
  *
  *	Returns:			char *:
- *							...
+ *							Point after the operand.
  *
- *	Globals:			None.
- *	Notes:
+ *	Globals:			int b1
+ *	Notes:			- Was "parse_reg16bits()".
  *	************************************************************************* */
 
-static char *DestReg(char *text)
+static char *reg16_field(char *text, unsigned char ar, int shift)
 {
-	int	c	= toupper((int) *text);
-
-	switch (c)
-  	{
-		case 'A':
-			b1 += 0x7 << 3;
-			break;
-
-		case 'B':
-			b1 += 0x0 << 3;
-			break;
-
-		case 'C':
-			b1 += 0x1 << 3;
-			break;
-
-		case 'D':
-			b1 += 0x2 << 3;
-			break;
-
-		case 'E':
-			b1 += 0x3 << 3;
-			break;
+	char	buf_ori[RP_NAME_LEN_MAX + 1];	/*	Buffer for original text. */
+	int	len;
+	int	rp	= reg16_decode(text, &len);
 
-		case 'H':
-			b1 += 0x4 << 3;
-			break;
 
-		case 'L':
-			b1 += 0x5 << 3;
-			break;
+	/*	Check for name validity.
+	 *	------------------------ */	
+	if ((len < 1) || (len > RP_NAME_LEN_MAX))
+	{
+		msg_error_s("Bad 16-bit register!", EC_B16BR, text);
+		return (text);
+	}
 
-		case 'M':
-			b1 += 0x6 << 3;
-			break;
+	if ((rp >= 0) && ((ar & (1 << rp)) != 0))
+	{
+		/*	"PSW" use the same field value as "SP".
+		 *	--------------------------------------- */
+		b1	+= ((rp == RP_PSW) ? RP_SP : rp) << shift;
 
-		default:
-			msg_error_c("Bad destination register!", EC_BDR, *text);
-			break;
+		return (text + len);
 	}
 
-	text++;
+	memcpy(buf_ori, text, len);
+	buf_ori[len]	= '\0';
+
+	/*	- Print error message if register is not allowed
+	 *	  or bad.
+	 *	------------------------------------------------ */
+	if (rp >= 0)
+		msg_error_s("Register not allowed!", EC_RNA, buf_ori);
+	else
+		msg_error_s("Bad 16-bit register!", EC_B16BR, buf_ori);
 
-	return (text);
+	return (text + len);
 }
 
 
 /*	*************************************************************************
- *	Function name:	SourceReg
- *	Description:	Parse Source Register.
- *	Author(s):		Claude Sylvain
- *	Created:			2007
- *	Last modified:	27 December 2011
+ *	Function name:	opcode_encode
+ *	Description:	Encode an opcode.
+ *	Author(s):
+ *	Created:			18 October 2026
+ *	Last modified:
  *
- *	Parameters:		char *text:
- *							...
+ *	Parameters:		const opcode_t *p_opcode:
+ *							Point to the "OpCodes[]" entry of the opcode.
  *
- *	Returns:			char *:
- *							...
+ *						char *label:
+ *							Label found on the source line.
  *
- *	Globals:			None.
- *	Notes:
+ *						char *equation:
+ *							Operand(s) found on the source line.
+ *
+ *	Returns:			int:
+ *							TEXT
+ *
+ *	Globals:			int b1, b2, b3
+ *						int data_size
+ *
+ *	Notes:			- Generic encoder for all opcodes.  Operand is parsed
+ *						  according to the operand class of the opcode, and
+ *						  register (or restart) field is merged into "b1".
  *	************************************************************************* */
 
-static char *SourceReg(char *text)
+int opcode_encode(const opcode_t *p_opcode, char *label, char *equation)
 {
-	int	c;
+	int	tmp;
+	char	is_reg	= 1;		/*	8-bit register operand(s) are not "M". */
 
-	/*	Bypass space if necessary.
-	 *	-------------------------- */
-	while (isspace((int) *text))
-		text++;
+	process_label(label);		/*	Process Label. */
 
-	c	= toupper((int) *text);
+	b1				= p_opcode->base;
+	data_size	= p_opcode->size;
 
-	switch (c)
-  	{
-		case 'A':
-			b1 += 0x7;
+	switch (p_opcode->oc)
+	{
+		case OC_REG8:
+			reg8_field(equation, p_opcode->shift, &is_reg);
 			break;
 
-		case 'B':
-			b1 += 0x0;
+		case OC_REG8_IMM8:
+			equation	= reg8_field(equation, p_opcode->shift, &is_reg);
+			equation	= AdvancePast(equation, ',');
+			tmp		= exp_parser(equation);
+
+			check_oor(tmp, 0xFF);		/*	Check Operand Over Range. */
+
+			b2	= tmp & 0xFF;
 			break;
 
-		case 'C':
-			b1 += 0x1;
+		case OC_MOV:
+			/*	Proc dest reg.
+			 *	-------------- */
+			equation	= reg8_field(equation, p_opcode->shift, &is_reg);
+
+			/*	Proc source reg.
+			 *	---------------- */
+			equation	= AdvancePastSpace(AdvancePast(equation, ','));
+			reg8_field(equation, 0, &is_reg);
+
+			/*	- Check for 'M' register used both as destination and
+			 *	  source (this is the "HLT" opcode).
+			 *	------------------------------------------------------ */
+			if (b1 == (p_opcode->base | (REG8_M << p_opcode->shift) | REG8_M))
+			{
+				msg_error(	"'M' can't be used as both destination and source!",
+					  			EC_MRCBUBDS);
+			}
+
 			break;
 
-		case 'D':
-			b1 += 0x2;
+		case OC_RP:
+			reg16_field(	equation,
+								PR16_AR_BC | PR16_AR_DE | PR16_AR_HL | PR16_AR_SP,
+				  				p_opcode->shift);
 			break;
 
-		case 'E':
-			b1 += 0x3;
+		case OC_RP_BD:
+			reg16_field(equation, PR16_AR_BC | PR16_AR_DE, p_opcode->shift);
 			break;
 
-		case 'H':
-			b1 += 0x4;
+		case OC_RP_PSW:
+			reg16_field(	equation,
+								PR16_AR_BC | PR16_AR_DE | PR16_AR_HL | PR16_AR_PSW,
+				  				p_opcode->shift);
 			break;
 
-		case 'L':
-			b1 += 0x5;
+		case OC_RP_IMM16:
+			equation = reg16_field(	equation,
+					  						PR16_AR_BC | PR16_AR_DE | PR16_AR_HL | PR16_AR_SP,
+											p_opcode->shift);
+
+			equation	= AdvancePast(equation, ',');
+			tmp		= exp_parser(equation);
+
+			check_oor(tmp, 0xFFFF);		/*	Check Operand Over Range. */
+
+			b2	= tmp & 0xFF;
+			b3	= (tmp >> 8) & 0xFF;
 			break;
 
-		case 'M':
-			b1 += 0x6;
+		case OC_IMM8:
+			tmp	= exp_parser(equation);
+
+			check_oor(tmp, 0xFF);		/*	Check Operand Over Range. */
+
+			b2	= tmp & 0xFF;
 			break;
 
-		default:
-			msg_error_c("Bad source register!", EC_BSR, *text);
+		case OC_IMM16:
+			tmp	= exp_parser(equation);
+
+			check_oor(tmp, 0xFFFF);		/*	Check Operand Over Range. */
+
+			b2	= tmp & 0xFF;
+			b3	= (tmp >> 8) & 0xFF;
 			break;
-	}
 
-	text++;
+		case OC_RST:
+			tmp	= exp_parser(equation);
 
-	return (text);
-}
+			check_oor(tmp, 0x07);		/*	Check Operand Over Range. */
 
+			b1	|= (tmp & 0x7) << p_opcode->shift;
+			break;
 
-/*	*************************************************************************
- *	Function name:	proc_nop
- *	Description:
- *	Author(s):		Jay Cotton, Claude Sylvain
- *	Created:			2007
- *	Last modified:	26 May 2013
- *
- *	Parameters:		char *label:
- *							...
- *
- *						char *equation:
- *							...
- *
- *	Returns:			int:
- *							...
- *
- *	Globals:
- *	Notes:
- *	************************************************************************* */
+		default:
+			break;
+	}
 
-int proc_nop(char *label, char *equation)
-{
-	process_label(label);		/*	Process Label. */
+	/*	- 8-bit register operand: Cycles depend on "M" use.
+	 *	  Others: Cycles are taken as is.
+	 *	--------------------------------------------------- */
+	switch (p_opcode->oc)
+	{
+		case OC_REG8:
+		case OC_REG8_IMM8:
+		case OC_MOV:
+			inst_cyc[0]	= p_opcode->cyc[(is_reg != 0) ? 0 : 1];
+			inst_cyc[1]	= inst_cyc[0];
+			break;
 
-	data_size	= 1;
-	b1				= 0;
-	inst_cyc[0]	= 4;
-	inst_cyc[1]	= 4;
+		default:
+			inst_cyc[0]	= p_opcode->cyc[0];
+			inst_cyc[1]	= p_opcode->cyc[1];
+			break;
+	}
 
 	return (TEXT);
 }
 
 
 /*	*************************************************************************
- *	Function name:	proc_in
- *	Description:
- *	Author(s):		Jay Cotton, Claude Sylvain
- *	Created:			2007
- *	Last modified:	26 May 2013
- *
- *	Parameters:		char *label:
- *							...
- *
- *						char *equation:
- *							...
+ *	Function name:	decode_init
+ *	Description:	Build "opcode_decode()" tables.
+ *	Author(s):
+ *	Created:			18 October 2026
+ *	Last modified:
+ *	Parameters:		void
+ *	Returns:			void
  *
- *	Returns:			int:
- *							...
+ *	Globals:			const opcode_t *decode_op[]
+ *						uint8_t decode_cyc[][]
  *
- *	Globals:
- *	Notes:
+ *	Notes:			- Every operand combination of every "OpCodes[]" entry
+ *						  is encoded, so tables are the exact reverse of
+ *						  "opcode_encode()".
  *	************************************************************************* */
 
-int proc_in(char *label, char *equation)
+static void decode_init(void)
 {
-	int		tmp;
-
-	process_label(label);		/*	Process Label. */
-
-	b1 = 0xDB;
-
-	tmp		= exp_parser(equation);
+	const opcode_t	*p_opcode;
+	int				n;
+	int				i;
+	int				j;
+	int				byte;
 
-	check_oor(tmp, 0xFF);		/*	Check Operand Over Range. */
 
-	b2				= tmp & 0xFF;
-	data_size	= 2;
-	inst_cyc[0]	= 10;
-	inst_cyc[1]	= 10;
+	for (p_opcode = OpCodes; p_opcode->Name != NULL; p_opcode++)
+	{
+		switch (p_opcode->oc)
+		{
+			/*	Cycles depend on "M" use.
+			 *	------------------------- */
+			case OC_REG8:
+			case OC_REG8_IMM8:
+				for (i = REG8_B; i <= REG8_A; i++)
+				{
+					byte	= p_opcode->base + (i << p_opcode->shift);
+
+					decode_op[byte]		= p_opcode;
+					decode_cyc[byte][0]	= p_opcode->cyc[(i == REG8_M) ? 1 : 0];
+					decode_cyc[byte][1]	= decode_cyc[byte][0];
+				}
+
+				break;
+
+			/*	Notes: "MOV M,M" is "HLT".
+			 *	-------------------------- */
+			case OC_MOV:
+				for (i = REG8_B; i <= REG8_A; i++)
+				{
+					for (j = REG8_B; j <= REG8_A; j++)
+					{
+						if ((i == REG8_M) && (j == REG8_M))
+							continue;
+
+						byte	= p_opcode->base + (i << p_opcode->shift) + j;
+
+						decode_op[byte]		= p_opcode;
+						decode_cyc[byte][0]	=
+							p_opcode->cyc[((i == REG8_M) || (j == REG8_M)) ? 1 : 0];
+						decode_cyc[byte][1]	= decode_cyc[byte][0];
+					}
+				}
+
+				break;
+
+			default:
+				switch (p_opcode->oc)
+				{
+					case OC_RP:
+					case OC_RP_PSW:
+					case OC_RP_IMM16:	n	= 4;	break;
+					case OC_RP_BD:		n	= 2;	break;
+					case OC_RST:		n	= 8;	break;
+					default:				n	= 1;	break;
+				}
+
+				for (i = 0; i < n; i++)
+				{
+					byte	= p_opcode->base + (i << p_opcode->shift);
+
+					decode_op[byte]		= p_opcode;
+					decode_cyc[byte][0]	= p_opcode->cyc[0];
+					decode_cyc[byte][1]	= p_opcode->cyc[1];
+				}
+
+				break;
+		}
+	}
 
-	return (TEXT);
+	decode_ready	= 1;
 }
 
 
 /*	*************************************************************************
- *	Function name:	proc_out
- *	Description:
- *	Author(s):		Jay Cotton, Claude Sylvain
- *	Created:			2007
- *	Last modified:	26 May 2013
+ *	Function name:	opcode_decode
+ *	Description:	Decode an opcode byte.
+ *	Author(s):
+ *	Created:			18 October 2026
+ *	Last modified:
  *
- *	Parameters:		char *label:
- *							...
+ *	Parameters:		int byte:
+ *							Opcode byte (first instruction byte).
  *
- *						char *equation:
- *							...
+ *						uint8_t inst_cyc_p[]:
+ *							- Pointer to an array that will be filled with
+ *							  the instruction number of cycles (same as
+ *							  "opcode_get_inst_cyc()").  Can be NULL.
  *
- *	Returns:			int:
- *							...
+ *	Returns:			const opcode_t *:
+ *							- "OpCodes[]" entry of the opcode.
+ *							- NULL if byte is not a valid opcode.
  *
  *	Globals:
- *	Notes:
+ *	Notes:			- Tables are built on first call, which must not be
+ *						  done by assembler threads.
  *	************************************************************************* */
 
-int proc_out(char *label, char *equation)
+const opcode_t *opcode_decode(int byte, uint8_t inst_cyc_p[])
 {
-	int		tmp;
+	if (decode_ready == 0)
+		decode_init();
 
-	process_label(label);		/*	Process Label. */
+	byte	&= 0xFF;
 
-	b1 = 0xD3;
+	if (inst_cyc_p != NULL)
+		memcpy(inst_cyc_p, decode_cyc[byte], sizeof (decode_cyc[byte]));
 
-	tmp	= exp_parser(equation);
+	return (decode_op[byte]);
+}
 
-	check_oor(tmp, 0xFF);		/*	Check Operand Over Range. */
 
-	b2				= tmp & 0xFF;
-	data_size	= 2;
-	inst_cyc[0]	= 10;
-	inst_cyc[1]	= 10;
 
-	return (TEXT);
-}
 
 
 /*	*************************************************************************
- *	Function name:	proc_rst
- *	Description:
- *	Author(s):		Jay Cotton, Claude Sylvain
- *	Created:			2007
- *	Last modified:	26 May 2013
+ *	Function name:	disasm_hex
+ *	Description:	Format a hexadecimal number, as an operand.
+ *	Author(s):
+ *	Created:			18 October 2026
+ *	Last modified:
  *
- *	Parameters:		char *label:
- *							...
+ *	Parameters:		char *buf:
+ *							Text (at least 8 bytes).
  *
- *						char *equation:
- *							...
+ *						int value:
+ *							Number.
  *
- *	Returns:			int:
- *							...
+ *						int digits:
+ *							Number of digits (2 or 4).
+ *
+ *	Returns:			char *:
+ *							"buf".
  *
  *	Globals:
- *	Notes:
+ *	Notes:			- A leading '0' is added if number begin with a
+ *						  letter.
  *	************************************************************************* */
 
-int proc_rst(char *label, char *equation)
+static char *disasm_hex(char *buf, int value, int digits)
 {
-	int		tmp;
-
-	process_label(label);		/*	Process Label. */
-
-	b1 = 0xC7;
+	sprintf(buf + 1, "%0*XH", digits, value);
 
-	tmp	= exp_parser(equation);
+	if (isdigit((int) buf[1]))
+		return (buf + 1);
 
-	check_oor(tmp, 0x07);		/*	Check Operand Over Range. */
+	buf[0]	= '0';
 
-	tmp			= tmp & 0x7;
-	b1				|= tmp << 3;
-	data_size	= 1;
-	inst_cyc[0]	= 11;
-	inst_cyc[1]	= 11;
-
-	return (TEXT);
+	return (buf);
 }
 
 
 /*	*************************************************************************
- *	Function name:	proc_mov
- *	Description:
- *	Author(s):		Jay Cotton, Claude Sylvain
- *	Created:			2007
- *	Last modified:	26 May 2013
+ *	Function name:	opcode_disasm
+ *	Description:	Disassemble an instruction.
+ *	Author(s):
+ *	Created:			18 October 2026
+ *	Last modified:
  *
- *	Parameters:		char *label:
- *							...
+ *	Parameters:		const uint8_t *p_code:
+ *							Instruction bytes.
  *
- *						char *equation:
- *							...
+ *						char *text:
+ *							- Instruction text ("<mnemonic>\t<operands>").
+ *							  "OPCODE_DISASM_SIZE_MAX" bytes.
  *
  *	Returns:			int:
- *							...
+ *							- Instruction size, in bytes.
+ *							- (-1) if this is not a valid opcode.
  *
  *	Globals:
- *	Notes:
+ *	Notes:			- Operands are written the way the assembler read
+ *						  them ("0FFH", "1234H", ...).
  *	************************************************************************* */
 
-static int proc_mov(char *label, char *equation)
+int opcode_disasm(const uint8_t *p_code, char *text)
 {
-	char	src_is_reg;
-	char	dst_is_reg;
-	char	rn_dst;					/*	Register Name, Destination. */
-	char	rn_src;					/*	Register Name, Source. */
-
-	process_label(label);		/*	Process Label. */
-
-	b1 = 0x040;
-
-	/*	Proc dest reg.
-	 *	-------------- */
-	dst_is_reg	= is_str_reg(equation);
-	rn_dst		= (char) toupper(*equation);
-	equation		= DestReg(equation);
+	static const char	*reg8_name	= "BCDEHLMA";
+	static const char	*rp_name[]	= {"B", "D", "H", "SP", "PSW"};
 
-	/*	Proc source reg.
-	 *	---------------- */
-	equation		= AdvancePastSpace(AdvancePast(equation, ','));
-	src_is_reg	= is_str_reg(equation);
-	rn_src		= (char) toupper(*equation);
-	equation		= SourceReg(equation);
+	const opcode_t	*p_opcode	= opcode_decode(p_code[0], NULL);
+	char				hex[8];
+	int				field;
+	int				value;
 
-	data_size = 1;
 
-	/*	If instruction use register for both destination and source...
-	 *	-------------------------------------------------------------- */
-	if ((dst_is_reg != 0) && (src_is_reg != 0))
+	if (p_opcode == NULL)
 	{
-		inst_cyc[0]	= 5;
-		inst_cyc[1]	= 5;
-	}
-	/*	Instruction use "M" for destination or source.
-	 *	---------------------------------------------- */
-	else
-	{
-		inst_cyc[0]	= 7;
-		inst_cyc[1]	= 7;
+		*text	= '\0';
+		return (-1);
 	}
 
-	/*	Check for 'M' register used both as destination and source.
-	 *	----------------------------------------------------------- */
-	if ((rn_dst == 'M') && (rn_src == 'M'))
+	field	= (p_code[0] >> p_opcode->shift);
+
+	switch (p_opcode->oc)
 	{
-		msg_error(	"'M' can't be used as both destination and source!",
-			  			EC_MRCBUBDS);
-	}
+		case OC_REG8:
+			sprintf(text, "%s\t%c", p_opcode->Name, reg8_name[field & 0x07]);
+			break;
 
-	return (TEXT);
-}
+		case OC_REG8_IMM8:
+			sprintf(	text, "%s\t%c,%s", p_opcode->Name, reg8_name[field & 0x07],
+						disasm_hex(hex, p_code[1], 2));
+			break;
 
+		case OC_MOV:
+			sprintf(	text, "%s\t%c,%c", p_opcode->Name, reg8_name[field & 0x07],
+						reg8_name[p_code[0] & 0x07]);
+			break;
 
-/*	*************************************************************************
- *	Function name:	proc_mvi
- *	Description:
- *	Author(s):		Jay Cotton, Claude Sylvain
- *	Created:			2007
- *	Last modified:	26 May 2013
- *
- *	Parameters:		char *label:
- *							...
- *
- *						char *equation:
- *							...
- *
- *	Returns:			int:
- *							...
- *
- *	Globals:
- *	Notes:
- *	************************************************************************* */
-
-static int proc_mvi(char *label, char *equation)
-{
-char	dst_is_reg;
-int	tmp;
-
-	process_label(label);	/*	Process Label. */
-
-	b1 = 0x06;
-
-	/* Process destination register.
-	 *	Notes: This can modify "b1".
-	 *	----------------------------- */
-	dst_is_reg = is_str_reg(equation);
-	equation   = DestReg(equation);
-
-	equation = AdvancePast(equation, ',');
-	tmp	 = exp_parser(equation);
-
-	check_oor(tmp, 0xFF);		/*	Check Operand Over Range. */
-
-	b2 = tmp & 0xFF;
-	data_size = 2;
-
-	/*	If instruction use register for destination...
-	 *	---------------------------------------------- */
-	if (dst_is_reg != 0)
-	{
-		inst_cyc[0] = 7;
-		inst_cyc[1] = 7;
-	}
-	/*	Instruction use "M" for destination.
-	 *	------------------------------------ */
-	else
-	{
-		inst_cyc[0] = 10;
-		inst_cyc[1] = 10;
-	}
-
-	return (TEXT);
-}
-
-
-/*	*************************************************************************
- *	Function name:	proc_lxi
- *	Description:
- *	Author(s):		Jay Cotton, Claude Sylvain
- *	Created:			2007
- *	Last modified:	26 May 2013
- *
- *	Parameters:		char *label:
- *							...
- *
- *						char *equation:
- *							...
- *
- *	Returns:			int:
- *							...
- *
- *	Globals:
- *	Notes:
- *	************************************************************************* */
-
-static int proc_lxi(char *label, char *equation)
-{
-	int		tmp;
-
-	process_label(label);		/*	Process Label. */
-
-	b1 = 0x01;
-
-	/* Process destination register pair.
-	 *	Notes: This can modify "b1".
-	 *	*/
-	equation = parse_reg16bits(
-		equation, PR16_AR_BC | PR16_AR_DE | PR16_AR_HL | PR16_AR_SP);
-
-	equation = AdvancePast(equation, ',');
-	tmp		= exp_parser(equation);
-
-	check_oor(tmp, 0xFFFF);		/*	Check Operand Over Range. */
-
-	b2		= tmp & 0xFF;
-	b3		= (tmp >> 8) & 0xFF;
-	data_size	= 3;
-	inst_cyc[0]	= 10;
-	inst_cyc[1]	= 10;
-
-	return (TEXT);
-}
-
-
-/*	*************************************************************************
- *	Function name:	proc_lda
- *	Description:
- *	Author(s):		Jay Cotton, Claude Sylvain
- *	Created:			2007
- *	Last modified:	26 May 2013
- *
- *	Parameters:		char *label:
- *							...
- *
- *						char *equation:
- *							...
- *
- *	Returns:			int:
- *							...
- *
- *	Globals:
- *	Notes:
- *	************************************************************************* */
-
-static int proc_lda(char *label, char *equation)
-{
-	int		tmp;
-
-	process_label(label);		/*	Process Label. */
-
-	b1 = 0x3A;
-
-	tmp	= exp_parser(equation);
-
-	check_oor(tmp, 0xFFFF);		/*	Check Operand Over Range. */
-
-	b2				= tmp & 0xFF;
-	b3				= (tmp >> 8) & 0xFF;
-	data_size	= 3;
-	inst_cyc[0]	= 13;
-	inst_cyc[1]	= 13;
-
-	return (TEXT);
-}
-
-
-/*	*************************************************************************
- *	Function name:	proc_sta
- *	Description:
- *	Author(s):		Jay Cotton, Claude Sylvain
- *	Created:			2007
- *	Last modified:	26 May 2013
- *
- *	Parameters:		char *label:
- *							...
- *
- *						char *equation:
- *							...
- *
- *	Returns:			int:
- *							...
- *
- *	Globals:
- *	Notes:
- *	************************************************************************* */
-
-static int proc_sta(char *label, char *equation)
-{
-	int		tmp;
-
-	process_label(label);		/*	Process Label. */
-
-	b1 = 0x32;
-
-	tmp	= exp_parser(equation);
-
-	check_oor(tmp, 0xFFFF);		/*	Check Operand Over Range. */
-
-	b2				= tmp & 0xFF;
-	b3				= (tmp >> 8) & 0xFF;
-	data_size	= 3;
-	inst_cyc[0]	= 13;
-	inst_cyc[1]	= 13;
-
-	return (TEXT);
-}
-
-
-/*	*************************************************************************
- *	Function name:	proc_lhld
- *	Description:
- *	Author(s):		Jay Cotton, Claude Sylvain
- *	Created:			2007
- *	Last modified:	26 May 2013
- *
- *	Parameters:		char *label:
- *							...
- *
- *						char *equation:
- *							...
- *
- *	Returns:			int:
- *							...
- *
- *	Globals:
- *	Notes:
- *	************************************************************************* */
-
-static int proc_lhld(char *label, char *equation)
-{
-	int		tmp;
-
-	process_label(label);		/*	Process Label. */
-
-	b1 = 0x2A;
-
-	tmp	= exp_parser(equation);
-
-	check_oor(tmp, 0xFFFF);		/*	Check Operand Over Range. */
-
-	b2				= tmp & 0xFF;
-	b3				= (tmp >> 8) & 0xFF;
-	data_size	= 3;
-	inst_cyc[0]	= 16;
-	inst_cyc[1]	= 16;
-
-	return (TEXT);
-}
-
-
-/*	*************************************************************************
- *	Function name:	proc_shld
- *	Description:
- *	Author(s):		Jay Cotton, Claude Sylvain
- *	Created:			2007
- *	Last modified:	26 May 2013
- *
- *	Parameters:		char *label:
- *							...
- *
- *						char *equation:
- *							...
- *
- *	Returns:			int:
- *							...
- *
- *	Globals:
- *	Notes:
- *	************************************************************************* */
-
-static int proc_shld(char *label, char *equation)
-{
-	int		tmp;
-
-	process_label(label);		/*	Process Label. */
-
-	b1 = 0x22;
-
-	tmp	= exp_parser(equation);
-
-	check_oor(tmp, 0xFFFF);		/*	Check Operand Over Range. */
-
-	b2				= tmp & 0xFF;
-	b3				= (tmp >> 8) & 0xFF;
-	data_size	= 3;
-	inst_cyc[0]	= 16;
-	inst_cyc[1]	= 16;
-
-	return (TEXT);
-}
-
-
-/*	*************************************************************************
- *	Function name:	proc_ldax
- *	Description:
- *	Author(s):	Jay Cotton, Claude Sylvain
- *	Created:	2007
- *	Last modified:	26 May 2013
- *
- *	Parameters:	char *label:
- *			...
- *
- *			char *equation:
- *			...
- *
- *	Returns:	int:
- *			...
- *
- *	Globals:
- *	Notes:
- *	************************************************************************* */
-
-static int proc_ldax(char *label, char *equation)
-{
-	process_label(label);		/*	Process Label. */
-
-	b1	= 0x0A;
-
-	/* Process destination pair.
-	 * */
-	parse_reg16bits(equation, PR16_AR_BC | PR16_AR_DE);
-
-	data_size	= 1;		/*	Now the value. */
-	inst_cyc[0]	= 7;
-	inst_cyc[1]	= 7;
-
-	return (TEXT);
-}
-
-
-/*	*************************************************************************
- *	Function name:	proc_stax
- *	Description:
- *	Author(s):		Jay Cotton, Claude Sylvain
- *	Created:			2007
- *	Last modified:	26 May 2013
- *
- *	Parameters:		char *label:
- *							...
- *
- *						char *equation:
- *							...
- *
- *	Returns:			int:
- *							...
- *
- *	Globals:
- *	Notes:
- *	************************************************************************* */
-
-static int proc_stax(char *label, char *equation)
-{
-	process_label(label);		/*	Process Label. */
-
-	b1	= 0x02;
-
-	/* Process destination pair.
-	 * */
-	parse_reg16bits(equation, PR16_AR_BC | PR16_AR_DE);
-
-	data_size	= 1;		/* Now the value. */
-	inst_cyc[0]	= 7;
-	inst_cyc[1]	= 7;
-
-	return (TEXT);
-}
-
-
-/*	*************************************************************************
- *	Function name:	proc_xchg
- *	Description:
- *	Author(s):		Jay Cotton, Claude Sylvain
- *	Created:			2007
- *	Last modified:	26 May 2013
- *
- *	Parameters:		char *label:
- *							...
- *
- *						char *equation:
- *							...
- *
- *	Returns:			int:
- *							...
- *
- *	Globals:
- *	Notes:
- *	************************************************************************* */
-
-static int proc_xchg(char *label, char *equation)
-{
-	process_label(label);		/*	Process Label. */
-
-	b1				= 0xEB;
-	data_size	= 1;
-	inst_cyc[0]	= 4;
-	inst_cyc[1]	= 4;
-
-	return (TEXT);
-}
-
-
-/*	*************************************************************************
- *	Function name:	proc_add
- *	Description:
- *	Author(s):		Jay Cotton, Claude Sylvain
- *	Created:			2007
- *	Last modified:	26 May 2013
- *
- *	Parameters:		char *label:
- *							...
- *
- *						char *equation:
- *							...
- *
- *	Returns:			int:
- *							...
- *
- *	Globals:
- *	Notes:
- *	************************************************************************* */
+		case OC_RP:
+		case OC_RP_BD:
+			sprintf(text, "%s\t%s", p_opcode->Name, rp_name[field & 0x03]);
+			break;
 
-static int proc_add(char *label, char *equation)
-{
-	char	src_is_reg;
+		case OC_RP_PSW:
+			sprintf(	text, "%s\t%s", p_opcode->Name,
+						rp_name[((field & 0x03) == RP_SP) ? RP_PSW : (field & 0x03)]);
+			break;
 
-	process_label(label);		/*	Process Label. */
+		case OC_RP_IMM16:
+			value	= p_code[1] | (p_code[2] << 8);
+			sprintf(	text, "%s\t%s,%s", p_opcode->Name, rp_name[field & 0x03],
+						disasm_hex(hex, value, 4));
+			break;
 
-	b1				= 0x80;
+		case OC_IMM8:
+			sprintf(text, "%s\t%s", p_opcode->Name, disasm_hex(hex, p_code[1], 2));
+			break;
 
-	src_is_reg	= is_str_reg(equation);
-	SourceReg(equation);
+		case OC_IMM16:
+			value	= p_code[1] | (p_code[2] << 8);
+			sprintf(text, "%s\t%s", p_opcode->Name, disasm_hex(hex, value, 4));
+			break;
 
-	data_size	= 1;
+		case OC_RST:
+			sprintf(text, "%s\t%d", p_opcode->Name, field & 0x07);
+			break;
 
-	/*	If instruction use register for source...
-	 *	----------------------------------------- */
-	if (src_is_reg != 0)
-	{
-		inst_cyc[0]	= 4;
-		inst_cyc[1]	= 4;
-	}
-	/*	Instruction use "M" for source.
-	 *	------------------------------- */
-	else
-	{
-		inst_cyc[0]	= 7;
-		inst_cyc[1]	= 7;
+		default:
+			strcpy(text, p_opcode->Name);
+			break;
 	}
 
-	return (TEXT);
+	return (p_opcode->size);
 }
-
-
-/*	*************************************************************************
- *	Function name:	proc_adi
- *	Description:
- *	Author(s):		Jay Cotton, Claude Sylvain
- *	Created:			2007
- *	Last modified:	26 May 2013
- *
- *	Parameters:		char *label:
- *							...
- *
- *						char *equation:
- *							...
- *
- *	Returns:			int:
- *							...
- *
- *	Globals:
- *	Notes:
- *	************************************************************************* */
-
-static int proc_adi(char *label, char *equation)
-{
-	int		tmp;
-
-	process_label(label);		/*	Process Label. */
-
-	tmp	= exp_parser(equation);
-
-	check_oor(tmp, 0xFF);		/*	Check Operand Over Range. */
-
-	b1				= 0xC6;
-	b2				= tmp & 0xFF;
-	data_size	= 2;
-	inst_cyc[0]	= 7;
-	inst_cyc[1]	= 7;
-
-	return (TEXT);
-}
-
-
-/*	*************************************************************************
- *	Function name:	proc_adc
- *	Description:
- *	Author(s):		Jay Cotton, Claude Sylvain
- *	Created:			2007
- *	Last modified:	26 May 2013
- *
- *	Parameters:		char *label:
- *							...
- *
- *						char *equation:
- *							...
- *
- *	Returns:			int:
- *							...
- *
- *	Globals:
- *	Notes:
- *	************************************************************************* */
-
-static int proc_adc(char *label, char *equation)
-{
-	char	src_is_reg;
-
-	process_label(label);		/*	Process Label. */
-
-	b1				= 0x88;
-
-	src_is_reg	= is_str_reg(equation);
-	SourceReg(equation);
-
-	data_size	= 1;
-
-	/*	If instruction use register for source...
-	 *	----------------------------------------- */
-	if (src_is_reg != 0)
-	{
-		inst_cyc[0]	= 4;
-		inst_cyc[1]	= 4;
-	}
-	/*	Instruction use "M" for source.
-	 *	------------------------------- */
-	else
-	{
-		inst_cyc[0]	= 7;
-		inst_cyc[1]	= 7;
-	}
-
-	return (TEXT);
-}
-
-
-/*	*************************************************************************
- *	Function name:	proc_aci
- *	Description:
- *	Author(s):		Jay Cotton, Claude Sylvain
- *	Created:			2007
- *	Last modified:	26 May 2013
- *
- *	Parameters:		char *label:
- *							...
- *
- *						char *equation:
- *							...
- *
- *	Returns:			int:
- *							...
- *
- *	Globals:
- *	Notes:
- *	************************************************************************* */
-
-static int proc_aci(char *label, char *equation)
-{
-	int		tmp;
-
-	process_label(label);		/*	Process Label. */
-
-	tmp	= exp_parser(equation);
-
-	check_oor(tmp, 0xFF);		/*	Check Operand Over Range. */
-
-	b1 			= 0xCE;
-	b2				= tmp & 0xFF;
-	data_size	= 2;
-	inst_cyc[0]	= 7;
-	inst_cyc[1]	= 7;
-
-	return (TEXT);
-}
-
-
-/*	*************************************************************************
- *	Function name:	proc_sub
- *	Description:
- *	Author(s):		Jay Cotton, Claude Sylvain
- *	Created:			2007
- *	Last modified:	26 May 2013
- *
- *	Parameters:		char *label:
- *							...
- *
- *						char *equation:
- *							...
- *
- *	Returns:			int:
- *							...
- *
- *	Globals:
- *	Notes:
- *	************************************************************************* */
-
-static int proc_sub(char *label, char *equation)
-{
-	char	src_is_reg;
-
-	process_label(label);		/*	Process Label. */
-
-	b1				= 0x90;
-
-	src_is_reg	= is_str_reg(equation);
-	SourceReg(equation);
-
-	data_size	= 1;
-
-	/*	If instruction use register for source...
-	 *	----------------------------------------- */
-	if (src_is_reg != 0)
-	{
-		inst_cyc[0]	= 4;
-		inst_cyc[1]	= 4;
-	}
-	/*	Instruction use "M" for source.
-	 *	------------------------------- */
-	else
-	{
-		inst_cyc[0]	= 7;
-		inst_cyc[1]	= 7;
-	}
-
-	return (TEXT);
-}
-
-
-/*	*************************************************************************
- *	Function name:	proc_sui
- *	Description:
- *	Author(s):		Jay Cotton, Claude Sylvain
- *	Created:			2007
- *	Last modified:	26 May 2013
- *
- *	Parameters:		char *label:
- *							...
- *
- *						char *equation:
- *							...
- *
- *	Returns:			int:
- *							...
- *
- *	Globals:
- *	Notes:
- *	************************************************************************* */
-
-static int proc_sui(char *label, char *equation)
-{
-	int		tmp;
-
-	process_label(label);		/*	Process Label. */
-
-	tmp	= exp_parser(equation);
-
-	check_oor(tmp, 0xFF);		/*	Check Operand Over Range. */
-
-	b1				= 0xD6;
-	b2				= tmp & 0xFF;
-	data_size	= 2;
-	inst_cyc[0]	= 7;
-	inst_cyc[1]	= 7;
-
-	return (TEXT);
-}
-
-
-/*	*************************************************************************
- *	Function name:	proc_sbb
- *	Description:
- *	Author(s):		Jay Cotton, Claude Sylvain
- *	Created:			2007
- *	Last modified:	26 May 2013
- *
- *	Parameters:		char *label:
- *							...
- *
- *						char *equation:
- *							...
- *
- *	Returns:			int:
- *							...
- *
- *	Globals:
- *	Notes:
- *	************************************************************************* */
-
-static int proc_sbb(char *label, char *equation)
-{
-	char	src_is_reg;
-
-	process_label(label);		/*	Process Label. */
-
-	b1				= 0x98;
-
-	src_is_reg	= is_str_reg(equation);
-	SourceReg(equation);
-
-	data_size	= 1;
-
-	/*	If instruction use register for source...
-	 *	----------------------------------------- */
-	if (src_is_reg != 0)
-	{
-		inst_cyc[0]	= 4;
-		inst_cyc[1]	= 4;
-	}
-	/*	Instruction use "M" for source.
-	 *	------------------------------- */
-	else
-	{
-		inst_cyc[0]	= 7;
-		inst_cyc[1]	= 7;
-	}
-
-	return (TEXT);
-}
-
-
-/*	*************************************************************************
- *	Function name:	proc_sbi
- *	Description:
- *	Author(s):		Jay Cotton, Claude Sylvain
- *	Created:			2007
- *	Last modified:	26 May 2013
- *
- *	Parameters:		char *label:
- *							...
- *
- *						char *equation:
- *							...
- *
- *	Returns:			int:
- *							...
- *
- *	Globals:
- *	Notes:
- *	************************************************************************* */
-
-static int proc_sbi(char *label, char *equation)
-{
-	int		tmp;
-
-	process_label(label);		/*	Process Label. */
-
-	tmp	= exp_parser(equation);
-
-	check_oor(tmp, 0xFF);		/*	Check Operand Over Range. */
-
-	b1				= 0xDE;
-	b2				= tmp & 0xFF;
-	data_size	= 2;
-	inst_cyc[0]	= 7;
-	inst_cyc[1]	= 7;
-
-	return (TEXT);
-}
-
-
-/*	*************************************************************************
- *	Function name:	proc_inr
- *	Description:
- *	Author(s):		Jay Cotton, Claude Sylvain
- *	Created:			2007
- *	Last modified:	26 May 2013
- *
- *	Parameters:		char *label:
- *							...
- *
- *						char *equation:
- *							...
- *
- *	Returns:			int:
- *							...
- *
- *	Globals:
- *	Notes:
- *	************************************************************************* */
-
-static int proc_inr(char *label, char *equation)
-{
-	char	dst_is_reg;
-
-	process_label(label);		/*	Process Label. */
-
-	b1				= 0x04;
-
-	dst_is_reg	= is_str_reg(equation);
-	DestReg(equation);
-
-	data_size	= 1;
-
-	/*	If instruction use register for destination...
-	 *	---------------------------------------------- */
-	if (dst_is_reg != 0)
-	{
-		inst_cyc[0]	= 5;
-		inst_cyc[1]	= 5;
-	}
-	/*	Instruction use "M" for destination.
-	 *	------------------------------------ */
-	else
-	{
-		inst_cyc[0]	= 10;
-		inst_cyc[1]	= 10;
-	}
-
-	return (TEXT);
-}
-
-
-/*	*************************************************************************
- *	Function name:	proc_dcr
- *	Description:
- *	Author(s):		Jay Cotton, Claude Sylvain
- *	Created:			2007
- *	Last modified:	26 May 2013
- *
- *	Parameters:		char *label:
- *							...
- *
- *						char *equation:
- *							...
- *
- *	Returns:			int:
- *							...
- *
- *	Globals:
- *	Notes:
- *	************************************************************************* */
-
-static int proc_dcr(char *label, char *equation)
-{
-	char	dst_is_reg;
-
-	process_label(label);		/*	Process Label. */
-
-	b1				= 0x05;
-
-	dst_is_reg	= is_str_reg(equation);
-	DestReg(equation);
-
-	data_size	= 1;
-
-	/*	If instruction use register for destination...
-	 *	---------------------------------------------- */
-	if (dst_is_reg != 0)
-	{
-		inst_cyc[0]	= 5;
-		inst_cyc[1]	= 5;
-	}
-	/*	Instruction use "M" for destination.
-	 *	------------------------------------ */
-	else
-	{
-		inst_cyc[0]	= 10;
-		inst_cyc[1]	= 10;
-	}
-
-	return (TEXT);
-}
-
-
-/*	*************************************************************************
- *	Function name:	proc_inx
- *	Description:
- *	Author(s):		Jay Cotton, Claude Sylvain
- *	Created:			2007
- *	Last modified:	26 May 2013
- *
- *	Parameters:		char *label:
- *							...
- *
- *						char *equation:
- *							...
- *
- *	Returns:			int:
- *							...
- *
- *	Globals:
- *	Notes:
- *	************************************************************************* */
-
-static int proc_inx(char *label, char *equation)
-{
-	process_label(label);		/*	Process Label. */
-
-	b1	= 0x03;
-
-	/* Process destination pair.
-	 * */
-	parse_reg16bits(equation, PR16_AR_BC | PR16_AR_DE | PR16_AR_HL | PR16_AR_SP);
-
-	data_size	= 1;			/* Now the value. */
-	inst_cyc[0]	= 5;
-	inst_cyc[1]	= 5;
-
-	return (TEXT);
-}
-
-
-/*	*************************************************************************
- *	Function name:	proc_dcx
- *	Description:
- *	Author(s):		Jay Cotton, Claude Sylvain
- *	Created:			2007
- *	Last modified:	26 May 2013
- *
- *	Parameters:		char *label:
- *							...
- *
- *						char *equation:
- *							...
- *
- *	Returns:			int:
- *							...
- *
- *	Globals:
- *	Notes:
- *	************************************************************************* */
-
-static int proc_dcx(char *label, char *equation)
-{
-	process_label(label);		/*	Process Label. */
-
-	b1	= 0x0B;
-
-	/* Process destination pair.
-	 * */
-	parse_reg16bits(equation, PR16_AR_BC | PR16_AR_DE | PR16_AR_HL | PR16_AR_SP);
-
-	data_size	= 1;			/* Now the value. */
-	inst_cyc[0]	= 5;
-	inst_cyc[1]	= 5;
-
-	return (TEXT);
-}
-
-
-/*	*************************************************************************
- *	Function name:	proc_dad
- *	Description:
- *	Author(s):		Jay Cotton, Claude Sylvain
- *	Created:			2007
- *	Last modified:	26 May 2013
- *
- *	Parameters:		char *label:
- *							...
- *
- *						char *equation:
- *							...
- *
- *	Returns:			int:
- *							...
- *
- *	Globals:
- *	Notes:
- *	************************************************************************* */
-
-static int proc_dad(char *label, char *equation)
-{
-	process_label(label);		/*	Process Label. */
-
-	b1	= 0x09;
-
-	/* Process destination pair.
-	 * */
-	parse_reg16bits(equation, PR16_AR_BC | PR16_AR_DE | PR16_AR_HL | PR16_AR_SP);
-
-	data_size	= 1;			/* Now the value. */
-	inst_cyc[0]	= 10;
-	inst_cyc[1]	= 10;
-
-	return (TEXT);
-}
-
-
-/*	*************************************************************************
- *	Function name:	proc_daa
- *	Description:
- *	Author(s):		Jay Cotton, Claude Sylvain
- *	Created:			2007
- *	Last modified:	26 May 2013
- *
- *	Parameters:		char *label:
- *							...
- *
- *						char *equation:
- *							...
- *
- *	Returns:			int:
- *							...
- *
- *	Globals:
- *	Notes:
- *	************************************************************************* */
-
-static int proc_daa(char *label, char *equation)
-{
-	process_label(label);		/*	Process Label. */
-
-	b1				= 0x27;
-	data_size	= 1;
-	inst_cyc[0]	= 4;
-	inst_cyc[1]	= 4;
-
-	return (TEXT);
-}
-
-
-/*	*************************************************************************
- *	Function name:	proc_ana
- *	Description:
- *	Author(s):		Jay Cotton, Claude Sylvain
- *	Created:			2007
- *	Last modified:	26 May 2013
- *
- *	Parameters:		char *label:
- *							...
- *
- *						char *equation:
- *							...
- *
- *	Returns:			int:
- *							...
- *
- *	Globals:
- *	Notes:
- *	************************************************************************* */
-
-static int proc_ana(char *label, char *equation)
-{
-	char	src_is_reg;
-
-	process_label(label);		/*	Process Label. */
-
-	b1				= 0xA0;
-
-	src_is_reg	= is_str_reg(equation);
-	SourceReg(equation);
-
-	data_size	= 1;
-
-	/*	If instruction use register for source...
-	 *	----------------------------------------- */
-	if (src_is_reg != 0)
-	{
-		inst_cyc[0]	= 4;
-		inst_cyc[1]	= 4;
-	}
-	/*	Instruction use "M" for source.
-	 *	------------------------------- */
-	else
-	{
-		inst_cyc[0]	= 7;
-		inst_cyc[1]	= 7;
-	}
-
-	return (TEXT);
-}
-
-
-/*	*************************************************************************
- *	Function name:	proc_ani
- *	Description:
- *	Author(s):		Jay Cotton, Claude Sylvain
- *	Created:			2007
- *	Last modified:	26 May 2013
- *
- *	Parameters:		char *label:
- *							...
- *
- *						char *equation:
- *							...
- *
- *	Returns:			int:
- *							...
- *
- *	Globals:
- *	Notes:
- *	************************************************************************* */
-
-static int proc_ani(char *label, char *equation)
-{
-	int		tmp;
-
-	process_label(label);		/*	Process Label. */
-
-	tmp	= exp_parser(equation);
-
-	check_oor(tmp, 0xFF);		/*	Check Operand Over Range. */
-
-	b1				= 0xE6;
-	b2				= tmp & 0xFF;
-	data_size	= 2;
-	inst_cyc[0]	= 7;
-	inst_cyc[1]	= 7;
-
-	return (TEXT);
-}
-
-
-/*	*************************************************************************
- *	Function name:	proc_ora
- *	Description:
- *	Author(s):		Jay Cotton, Claude Sylvain
- *	Created:			2007
- *	Last modified:	26 May 2013
- *
- *	Parameters:		char *label:
- *							...
- *
- *						char *equation:
- *							...
- *
- *	Returns:			int:
- *							...
- *
- *	Globals:
- *	Notes:
- *	************************************************************************* */
-
-static int proc_ora(char *label, char *equation)
-{
-	char	src_is_reg;
-
-	process_label(label);		/*	Process Label. */
-
-	b1				= 0xB0;
-
-	src_is_reg	= is_str_reg(equation);
-	SourceReg(equation);
-
-	data_size	= 1;
-
-	/*	If instruction use register for source...
-	 *	----------------------------------------- */
-	if (src_is_reg != 0)
-	{
-		inst_cyc[0]	= 4;
-		inst_cyc[1]	= 4;
-	}
-	/*	Instruction use "M" for source.
-	 *	------------------------------- */
-	else
-	{
-		inst_cyc[0]	= 7;
-		inst_cyc[1]	= 7;
-	}
-
-	return (TEXT);
-}
-
-
-/*	*************************************************************************
- *	Function name:	proc_ori
- *	Description:
- *	Author(s):		Jay Cotton, Claude Sylvain
- *	Created:			2007
- *	Last modified:	26 May 2013
- *
- *	Parameters:		char *label:
- *							...
- *
- *						char *equation:
- *							...
- *
- *	Returns:			int:
- *							...
- *
- *	Globals:
- *	Notes:
- *	************************************************************************* */
-
-static int proc_ori(char *label, char *equation)
-{
-	int		tmp;
-
-	process_label(label);		/*	Process Label. */
-
-	tmp	= exp_parser(equation);
-
-	check_oor(tmp, 0xFF);		/*	Check Operand Over Range. */
-
-	b1				= 0xF6;
-	b2				= tmp & 0xFF;
-	data_size	= 2;
-	inst_cyc[0]	= 7;
-	inst_cyc[1]	= 7;
-
-	return (TEXT);
-}
-
-
-/*	*************************************************************************
- *	Function name:	proc_xra
- *	Description:
- *	Author(s):		Jay Cotton, Claude Sylvain
- *	Created:			2007
- *	Last modified:	26 May 2013
- *
- *	Parameters:		char *label:
- *							...
- *
- *						char *equation:
- *							...
- *
- *	Returns:			int:
- *							...
- *
- *	Globals:
- *	Notes:
- *	************************************************************************* */
-
-static int proc_xra(char *label, char *equation)
-{
-	char	src_is_reg;
-
-	process_label(label);		/*	Process Label. */
-
-	b1				= 0xA8;
-
-	src_is_reg	= is_str_reg(equation);
-	SourceReg(equation);
-
-	data_size	= 1;
-
-	/*	If instruction use register for source...
-	 *	----------------------------------------- */
-	if (src_is_reg != 0)
-	{
-		inst_cyc[0]	= 4;
-		inst_cyc[1]	= 4;
-	}
-	/*	Instruction use "M" for source.
-	 *	------------------------------- */
-	else
-	{
-		inst_cyc[0]	= 7;
-		inst_cyc[1]	= 7;
-	}
-
-	return (TEXT);
-}
-
-
-/*	*************************************************************************
- *	Function name:	proc_xri
- *	Description:
- *	Author(s):		Jay Cotton, Claude Sylvain
- *	Created:			2007
- *	Last modified:	26 May 2013
- *
- *	Parameters:		char *label:
- *							...
- *
- *						char *equation:
- *							...
- *
- *	Returns:			int:
- *							...
- *
- *	Globals:
- *	Notes:
- *	************************************************************************* */
-
-static int proc_xri(char *label, char *equation)
-{
-	int		tmp;
-
-	process_label(label);		/*	Process Label. */
-
-	tmp	= exp_parser(equation);
-
-	check_oor(tmp, 0xFF);		/*	Check Operand Over Range. */
-
-	b1				= 0xEE;
-	b2				= tmp & 0xFF;
-	data_size	= 2;
-	inst_cyc[0]	= 7;
-	inst_cyc[1]	= 7;
-
-	return (TEXT);
-}
-
-
-/*	*************************************************************************
- *	Function name:	proc_cmp
- *	Description:
- *	Author(s):		Jay Cotton, Claude Sylvain
- *	Created:			2007
- *	Last modified:	26 May 2013
- *
- *	Parameters:		char *label:
- *							...
- *
- *						char *equation:
- *							...
- *
- *	Returns:			int:
- *							...
- *
- *	Globals:
- *	Notes:
- *	************************************************************************* */
-
-static int proc_cmp(char *label, char *equation)
-{
-	char	src_is_reg;
-
-	process_label(label);		/*	Process Label. */
-
-	b1				= 0xB8;
-
-	src_is_reg	= is_str_reg(equation);
-	SourceReg(equation);
-
-	data_size	= 1;
-
-	/*	If instruction use register for source...
-	 *	----------------------------------------- */
-	if (src_is_reg != 0)
-	{
-		inst_cyc[0]	= 4;
-		inst_cyc[1]	= 4;
-	}
-	/*	Instruction use "M" for source.
-	 *	------------------------------- */
-	else
-	{
-		inst_cyc[0]	= 7;
-		inst_cyc[1]	= 7;
-	}
-
-	return (TEXT);
-}
-
-
-/*	*************************************************************************
- *	Function name:	proc_cpi
- *	Description:
- *	Author(s):		Jay Cotton, Claude Sylvain
- *	Created:			2007
- *	Last modified:	26 May 2013
- *
- *	Parameters:		char *label:
- *							...
- *
- *						char *equation:
- *							...
- *
- *	Returns:			int:
- *							...
- *
- *	Globals:
- *	Notes:
- *	************************************************************************* */
-
-static int proc_cpi(char *label, char *equation)
-{
-	int		tmp;
-
-	process_label(label);		/*	Process Label. */
-
-	tmp	= exp_parser(equation);
-
-	check_oor(tmp, 0xFF);		/*	Check Operand Over Range. */
-
-	b1				= 0xFE;
-	b2				= tmp & 0xFF;
-	data_size	= 2;
-	inst_cyc[0]	= 7;
-	inst_cyc[1]	= 7;
-
-	return (TEXT);
-}
-
-
-/*	*************************************************************************
- *	Function name:	proc_rlc
- *	Description:
- *	Author(s):		Jay Cotton, Claude Sylvain
- *	Created:			2007
- *	Last modified:	26 May 2013
- *
- *	Parameters:		char *label:
- *							...
- *
- *						char *equation:
- *							...
- *
- *	Returns:			int:
- *							...
- *
- *	Globals:
- *	Notes:
- *	************************************************************************* */
-
-static int proc_rlc(char *label, char *equation)
-{
-	process_label(label);		/*	Process Label. */
-
-	b1				= 0x07;
-	data_size	= 1;
-	inst_cyc[0]	= 4;
-	inst_cyc[1]	= 4;
-
-	return (TEXT);
-}
-
-
-/*	*************************************************************************
- *	Function name:	proc_rrc
- *	Description:
- *	Author(s):		Jay Cotton, Claude Sylvain
- *	Created:			2007
- *	Last modified:	26 May 2013
- *
- *	Parameters:		char *label:
- *							...
- *
- *						char *equation:
- *							...
- *
- *	Returns:			int:
- *							...
- *
- *	Globals:
- *	Notes:
- *	************************************************************************* */
-
-static int proc_rrc(char *label, char *equation)
-{
-	process_label(label);		/*	Process Label. */
-
-	b1				= 0x0F;
-	data_size	= 1;
-	inst_cyc[0]	= 4;
-	inst_cyc[1]	= 4;
-
-	return (TEXT);
-}
-
-
-/*	*************************************************************************
- *	Function name:	proc_ral
- *	Description:
- *	Author(s):		Jay Cotton, Claude Sylvain
- *	Created:			2007
- *	Last modified:	26 May 2013
- *
- *	Parameters:		char *label:
- *							...
- *
- *						char *equation:
- *							...
- *
- *	Returns:			int:
- *							...
- *
- *	Globals:
- *	Notes:
- *	************************************************************************* */
-
-static int proc_ral(char *label, char *equation)
-{
-	process_label(label);		/*	Process Label. */
-
-	b1				= 0x17;
-	data_size	= 1;
-	inst_cyc[0]	= 4;
-	inst_cyc[1]	= 4;
-
-	return (TEXT);
-}
-
-
-/*	*************************************************************************
- *	Function name:	proc_rar
- *	Description:
- *	Author(s):		Jay Cotton, Claude Sylvain
- *	Created:			2007
- *	Last modified:	26 May 2013
- *
- *	Parameters:		char *label:
- *							...
- *
- *						char *equation:
- *							...
- *
- *	Returns:			int:
- *							...
- *
- *	Globals:
- *	Notes:
- *	************************************************************************* */
-
-static int proc_rar(char *label, char *equation)
-{
-	process_label(label);		/*	Process Label. */
-
-	b1				= 0x1F;
-	data_size	= 1;
-	inst_cyc[0]	= 4;
-	inst_cyc[1]	= 4;
-
-	return (TEXT);
-}
-
-
-/*	*************************************************************************
- *	Function name:	proc_cma
- *	Description:
- *	Author(s):		Jay Cotton, Claude Sylvain
- *	Created:			2007
- *	Last modified:	26 May 2013
- *
- *	Parameters:		char *label:
- *							...
- *
- *						char *equation:
- *							...
- *
- *	Returns:			int:
- *							...
- *
- *	Globals:
- *	Notes:
- *	************************************************************************* */
-
-static int proc_cma(char *label, char *equation)
-{
-	process_label(label);		/*	Process Label. */
-
-	b1				= 0x2F;
-	data_size	= 1;
-	inst_cyc[0]	= 4;
-	inst_cyc[1]	= 4;
-
-	return (TEXT);
-}
-
-
-/*	*************************************************************************
- *	Function name:	proc_cmc
- *	Description:
- *	Author(s):		Jay Cotton, Claude Sylvain
- *	Created:			2007
- *	Last modified:	26 May 2013
- *
- *	Parameters:		char *label:
- *							...
- *
- *						char *equation:
- *							...
- *
- *	Returns:			int:
- *							...
- *
- *	Globals:
- *	Notes:
- *	************************************************************************* */
-
-static int proc_cmc(char *label, char *equation)
-{
-	process_label(label);		/*	Process Label. */
-
-	b1				= 0x3F;
-	data_size	= 1;
-	inst_cyc[0]	= 4;
-	inst_cyc[1]	= 4;
-
-	return (TEXT);
-}
-
-
-/*	*************************************************************************
- *	Function name:	proc_stc
- *	Description:
- *	Author(s):		Jay Cotton, Claude Sylvain
- *	Created:			2007
- *	Last modified:	26 May 2013
- *
- *	Parameters:		char *label:
- *							...
- *
- *						char *equation:
- *							...
- *
- *	Returns:			int:
- *							...
- *
- *	Globals:
- *	Notes:
- *	************************************************************************* */
-
-static int proc_stc(char *label, char *equation)
-{
-	process_label(label);		/*	Process Label. */
-
-	b1				= 0x37;
-	data_size	= 1;
-	inst_cyc[0]	= 4;
-	inst_cyc[1]	= 4;
-
-	return (TEXT);
-}
-
-
-/*	*************************************************************************
- *	Function name:	proc_jmp
- *	Description:
- *	Author(s):		Jay Cotton, Claude Sylvain
- *	Created:			2007
- *	Last modified:	26 May 2013
- *
- *	Parameters:		char *label:
- *							...
- *
- *						char *equation:
- *							...
- *
- *	Returns:			int:
- *							...
- *
- *	Globals:
- *	Notes:
- *	************************************************************************* */
-
-static int proc_jmp(char *label, char *equation)
-{
-	int	tmp;
-
-	process_label(label);		/*	Process Label. */
-
-	b1				= 0xC3;
-
-	tmp = exp_parser(equation);
-
-	check_oor(tmp, 0xFFFF);		/*	Check Operand Over Range. */
-
-	b2				= tmp & 0xFF;
-	b3				= (tmp >> 8) & 0xFF;
-	data_size	= 3;
-	inst_cyc[0]	= 10;
-	inst_cyc[1]	= 10;
-
-	return (TEXT);
-}
-
-
-/*	*************************************************************************
- *	Function name:	proc_jnz
- *	Description:
- *	Author(s):		Jay Cotton, Claude Sylvain
- *	Created:			2007
- *	Last modified:	26 May 2013
- *
- *	Parameters:		char *label:
- *							...
- *
- *						char *equation:
- *							...
- *
- *	Returns:			int:
- *							...
- *
- *	Globals:
- *	Notes:
- *	************************************************************************* */
-
-static int proc_jnz(char *label, char *equation)
-{
-	int		tmp;
-
-	process_label(label);		/*	Process Label. */
-
-	b1 = 0xC2;
-
-	tmp	= exp_parser(equation);
-
-	check_oor(tmp, 0xFFFF);		/*	Check Operand Over Range. */
-
-	b2				= tmp & 0xFF;
-	b3				= (tmp >> 8) & 0xFF;
-	data_size	= 3;
-	inst_cyc[0]	= 10;
-	inst_cyc[1]	= 10;
-
-	return (TEXT);
-}
-
-
-/*	*************************************************************************
- *	Function name:	proc_jz
- *	Description:
- *	Author(s):		Jay Cotton, Claude Sylvain
- *	Created:			2007
- *	Last modified:	26 May 2013
- *
- *	Parameters:		char *label:
- *							...
- *
- *						char *equation:
- *							...
- *
- *	Returns:			int:
- *							...
- *
- *	Globals:
- *	Notes:
- *	************************************************************************* */
-
-static int proc_jz(char *label, char *equation)
-{
-	int		tmp;
-
-	process_label(label);		/*	Process Label. */
-
-	b1 = 0xC2 + (1 << 3);
-
-	tmp	= exp_parser(equation);
-
-	check_oor(tmp, 0xFFFF);		/*	Check Operand Over Range. */
-
-	b2				= tmp & 0xFF;
-	b3				= (tmp >> 8) & 0xFF;
-	data_size	= 3;
-	inst_cyc[0]	= 10;
-	inst_cyc[1]	= 10;
-
-	return (TEXT);
-}
-
-
-/*	*************************************************************************
- *	Function name:	proc_jnc
- *	Description:
- *	Author(s):		Jay Cotton, Claude Sylvain
- *	Created:			2007
- *	Last modified:	26 May 2013
- *
- *	Parameters:		char *label:
- *							...
- *
- *						char *equation:
- *							...
- *
- *	Returns:			int:
- *							...
- *
- *	Globals:
- *	Notes:
- *	************************************************************************* */
-
-static int proc_jnc(char *label, char *equation)
-{
-	int		tmp;
-
-	process_label(label);		/*	Process Label. */
-
-	b1 = 0xC2 + (2 << 3);
-
-	tmp	= exp_parser(equation);
-
-	check_oor(tmp, 0xFFFF);		/*	Check Operand Over Range. */
-
-	b2				= tmp & 0xFF;
-	b3				= (tmp >> 8) & 0xFF;
-	data_size	= 3;
-	inst_cyc[0]	= 10;
-	inst_cyc[1]	= 10;
-
-	return (TEXT);
-}
-
-
-/*	*************************************************************************
- *	Function name:	proc_jc
- *	Description:
- *	Author(s):		Jay Cotton, Claude Sylvain
- *	Created:			2007
- *	Last modified:	26 May 2013
- *
- *	Parameters:		char *label:
- *							...
- *
- *						char *equation:
- *							...
- *
- *	Returns:			int:
- *							...
- *
- *	Globals:
- *	Notes:
- *	************************************************************************* */
-
-static int proc_jc(char *label, char *equation)
-{
-	int		tmp;
-
-	process_label(label);		/*	Process Label. */
-
-	b1 = 0xC2 + (3 << 3);
-
-	tmp	= exp_parser(equation);
-
-	check_oor(tmp, 0xFFFF);		/*	Check Operand Over Range. */
-
-	b2				= tmp & 0xFF;
-	b3				= (tmp >> 8) & 0xFF;
-	data_size	= 3;
-	inst_cyc[0]	= 10;
-	inst_cyc[1]	= 10;
-
-	return (TEXT);
-}
-
-
-/*	*************************************************************************
- *	Function name:	proc_jpo
- *	Description:
- *	Author(s):		Jay Cotton, Claude Sylvain
- *	Created:			2007
- *	Last modified:	26 May 2013
- *
- *	Parameters:		char *label:
- *							...
- *
- *						char *equation:
- *							...
- *
- *	Returns:			int:
- *							...
- *
- *	Globals:
- *	Notes:
- *	************************************************************************* */
-
-static int proc_jpo(char *label, char *equation)
-{
-	int		tmp;
-
-	process_label(label);		/*	Process Label. */
-
-	b1 = 0xC2 + (4 << 3);
-
-	tmp	= exp_parser(equation);
-
-	check_oor(tmp, 0xFFFF);		/*	Check Operand Over Range. */
-
-	b2				= tmp & 0xFF;
-	b3				= (tmp >> 8) & 0xFF;
-	data_size	= 3;
-	inst_cyc[0]	= 10;
-	inst_cyc[1]	= 10;
-
-	return (TEXT);
-}
-
-
-/*	*************************************************************************
- *	Function name:	proc_jpe
- *	Description:
- *	Author(s):		Jay Cotton, Claude Sylvain
- *	Created:			2007
- *	Last modified:	26 May 2013
- *
- *	Parameters:		char *label:
- *							...
- *
- *						char *equation:
- *							...
- *
- *	Returns:			int:
- *							...
- *
- *	Globals:
- *	Notes:
- *	************************************************************************* */
-
-static int proc_jpe(char *label, char *equation)
-{
-	int		tmp;
-
-	process_label(label);		/*	Process Label. */
-
-	b1 = 0xC2 + (5 << 3);
-
-	tmp	= exp_parser(equation);
-
-	check_oor(tmp, 0xFFFF);		/*	Check Operand Over Range. */
-
-	b2				= tmp & 0xFF;
-	b3				= (tmp >> 8) & 0xFF;
-	data_size	= 3;
-	inst_cyc[0]	= 10;
-	inst_cyc[1]	= 10;
-
-	return (TEXT);
-}
-
-
-/*	*************************************************************************
- *	Function name:	proc_jp
- *	Description:
- *	Author(s):		Jay Cotton, Claude Sylvain
- *	Created:			2007
- *	Last modified:	26 May 2013
- *
- *	Parameters:		char *label:
- *							...
- *
- *						char *equation:
- *							...
- *
- *	Returns:			int:
- *							...
- *
- *	Globals:
- *	Notes:
- *	************************************************************************* */
-
-static int proc_jp(char *label, char *equation)
-{
-	int		tmp;
-
-	process_label(label);		/*	Process Label. */
-
-	b1 = 0xC2 + (6 << 3);
-
-	tmp	= exp_parser(equation);
-
-	check_oor(tmp, 0xFFFF);		/*	Check Operand Over Range. */
-
-	b2				= tmp & 0xFF;
-	b3				= (tmp >> 8) & 0xFF;
-	data_size	= 3;
-	inst_cyc[0]	= 10;
-	inst_cyc[1]	= 10;
-
-	return (TEXT);
-}
-
-
-/*	*************************************************************************
- *	Function name:	proc_jm
- *	Description:
- *	Author(s):		Jay Cotton, Claude Sylvain
- *	Created:			2007
- *	Last modified:	26 May 2013
- *
- *	Parameters:		char *label:
- *							...
- *
- *						char *equation:
- *							...
- *
- *	Returns:			int:
- *							...
- *
- *	Globals:
- *	Notes:
- *	************************************************************************* */
-
-static int proc_jm(char *label, char *equation)
-{
-	int		tmp;
-
-	process_label(label);		/*	Process Label. */
-
-	b1 = 0xC2 + (7 << 3);
-
-	tmp	= exp_parser(equation);
-
-	check_oor(tmp, 0xFFFF);		/*	Check Operand Over Range. */
-
-	b2				= tmp & 0xFF;
-	b3				= (tmp >> 8) & 0xFF;
-	data_size	= 3;
-	inst_cyc[0]	= 10;
-	inst_cyc[1]	= 10;
-
-	return (TEXT);
-}
-
-
-/*	*************************************************************************
- *	Function name:	proc_call
- *	Description:
- *	Author(s):		Jay Cotton, Claude Sylvain
- *	Created:			2007
- *	Last modified:	26 May 2013
- *
- *	Parameters:		char *label:
- *							...
- *
- *						char *equation:
- *							...
- *
- *	Returns:			int:
- *							...
- *
- *	Globals:
- *	Notes:
- *	************************************************************************* */
-
-static int proc_call(char *label, char *equation)
-{
-	int		tmp;
-
-	process_label(label);		/*	Process Label. */
-
-	b1 = 0xCD;
-
-	tmp	= exp_parser(equation);
-
-	check_oor(tmp, 0xFFFF);		/*	Check Operand Over Range. */
-
-	b2				= tmp & 0xFF;
-	b3				= (tmp >> 8) & 0xFF;
-	data_size	= 3;
-	inst_cyc[0]	= 17;
-	inst_cyc[1]	= 17;
-
-	return (TEXT);
-}
-
-
-/*	*************************************************************************
- *	Function name:	proc_cnz
- *	Description:
- *	Author(s):		Jay Cotton, Claude Sylvain
- *	Created:			2007
- *	Last modified:	26 May 2013
- *
- *	Parameters:		char *label:
- *							...
- *
- *						char *equation:
- *							...
- *
- *	Returns:			int:
- *							...
- *
- *	Globals:
- *	Notes:
- *	************************************************************************* */
-
-static int proc_cnz(char *label, char *equation)
-{
-	int		tmp;
-
-	process_label(label);		/*	Process Label. */
-
-	b1 = 0xC4;
-
-	tmp	= exp_parser(equation);
-
-	check_oor(tmp, 0xFFFF);		/*	Check Operand Over Range. */
-
-	b2				= tmp & 0xFF;
-	b3				= (tmp >> 8) & 0xFF;
-	data_size	= 3;
-	inst_cyc[0]	= 11;
-	inst_cyc[1]	= 17;
-
-	return (TEXT);
-}
-
-
-/*	*************************************************************************
- *	Function name:	proc_cz
- *	Description:
- *	Author(s):		Jay Cotton, Claude Sylvain
- *	Created:			2007
- *	Last modified:	26 May 2013
- *
- *	Parameters:		char *label:
- *							...
- *
- *						char *equation:
- *							...
- *
- *	Returns:			int:
- *							...
- *
- *	Globals:
- *	Notes:
- *	************************************************************************* */
-
-static int proc_cz(char *label, char *equation)
-{
-	int		tmp;
-
-	process_label(label);		/*	Process Label. */
-
-	b1 = 0xC4 + (1 << 3);
-
-	tmp	= exp_parser(equation);
-
-	check_oor(tmp, 0xFFFF);		/*	Check Operand Over Range. */
-
-	b2				= tmp & 0xFF;
-	b3				= (tmp >> 8) & 0xFF;
-	data_size	= 3;
-	inst_cyc[0]	= 11;
-	inst_cyc[1]	= 17;
-
-	return (TEXT);
-}
-
-
-/*	*************************************************************************
- *	Function name:	proc_cnc
- *	Description:
- *	Author(s):		Jay Cotton, Claude Sylvain
- *	Created:			2007
- *	Last modified:	26 May 2013
- *
- *	Parameters:		char *label:
- *							...
- *
- *						char *equation:
- *							...
- *
- *	Returns:			int:
- *							...
- *
- *	Globals:
- *	Notes:
- *	************************************************************************* */
-
-static int proc_cnc(char *label, char *equation)
-{
-	int		tmp;
-
-	process_label(label);		/*	Process Label. */
-
-	b1 = 0xC4 + (2 << 3);
-
-	tmp	= exp_parser(equation);
-
-	check_oor(tmp, 0xFFFF);		/*	Check Operand Over Range. */
-
-	b2				= tmp & 0xFF;
-	b3				= (tmp >> 8) & 0xFF;
-	data_size	= 3;
-	inst_cyc[0]	= 11;
-	inst_cyc[1]	= 17;
-
-	return (TEXT);
-}
-
-
-/*	*************************************************************************
- *	Function name:	proc_cc
- *	Description:
- *	Author(s):		Jay Cotton, Claude Sylvain
- *	Created:			2007
- *	Last modified:	26 May 2013
- *
- *	Parameters:		char *label:
- *							...
- *
- *						char *equation:
- *							...
- *
- *	Returns:			int:
- *							...
- *
- *	Globals:
- *	Notes:
- *	************************************************************************* */
-
-static int proc_cc(char *label, char *equation)
-{
-	int		tmp;
-
-	process_label(label);		/*	Process Label. */
-
-	b1 = 0xC4 + (3 << 3);
-
-	tmp	= exp_parser(equation);
-
-	check_oor(tmp, 0xFFFF);		/*	Check Operand Over Range. */
-
-	b2				= tmp & 0xFF;
-	b3				= (tmp >> 8) & 0xFF;
-	data_size	= 3;
-	inst_cyc[0]	= 11;
-	inst_cyc[1]	= 17;
-
-	return (TEXT);
-}
-
-
-/*	*************************************************************************
- *	Function name:	proc_cpo
- *	Description:
- *	Author(s):		Jay Cotton, Claude Sylvain
- *	Created:			2007
- *	Last modified:	26 May 2013
- *
- *	Parameters:		char *label:
- *							...
- *
- *						char *equation:
- *							...
- *
- *	Returns:			int:
- *							...
- *
- *	Globals:
- *	Notes:
- *	************************************************************************* */
-
-static int proc_cpo(char *label, char *equation)
-{
-	int		tmp;
-
-	process_label(label);		/*	Process Label. */
-
-	b1 = 0xC4 + (4 << 3);
-
-	tmp	= exp_parser(equation);
-
-	check_oor(tmp, 0xFFFF);		/*	Check Operand Over Range. */
-
-	b2				= tmp & 0xFF;
-	b3				= (tmp >> 8) & 0xFF;
-	data_size	= 3;
-	inst_cyc[0]	= 11;
-	inst_cyc[1]	= 17;
-
-	return (TEXT);
-}
-
-
-/*	*************************************************************************
- *	Function name:	proc_cpe
- *	Description:
- *	Author(s):		Jay Cotton, Claude Sylvain
- *	Created:			2007
- *	Last modified:	26 May 2013
- *
- *	Parameters:		char *label:
- *							...
- *
- *						char *equation:
- *							...
- *
- *	Returns:			int:
- *							...
- *
- *	Globals:
- *	Notes:
- *	************************************************************************* */
-
-static int proc_cpe(char *label, char *equation)
-{
-	int		tmp;
-
-	process_label(label);		/*	Process Label. */
-
-	b1 = 0xC4 + (5 << 3);
-
-	tmp	= exp_parser(equation);
-
-	check_oor(tmp, 0xFFFF);		/*	Check Operand Over Range. */
-
-	b2				= tmp & 0xFF;
-	b3				= (tmp >> 8) & 0xFF;
-	data_size	= 3;
-	inst_cyc[0]	= 11;
-	inst_cyc[1]	= 17;
-
-	return (TEXT);
-}
-
-
-/*	*************************************************************************
- *	Function name:	proc_cp
- *	Description:
- *	Author(s):		Jay Cotton, Claude Sylvain
- *	Created:			2007
- *	Last modified:	26 May 2013
- *
- *	Parameters:		char *label:
- *							...
- *
- *						char *equation:
- *							...
- *
- *	Returns:			int:
- *							...
- *
- *	Globals:
- *	Notes:
- *	************************************************************************* */
-
-static int proc_cp(char *label, char *equation)
-{
-	int		tmp;
-
-	process_label(label);		/*	Process Label. */
-
-	b1 = 0xC4 + (6 << 3);
-
-	tmp	= exp_parser(equation);
-
-	check_oor(tmp, 0xFFFF);		/*	Check Operand Over Range. */
-
-	b2				= tmp & 0xFF;
-	b3				= (tmp >> 8) & 0xFF;
-	data_size	= 3;
-	inst_cyc[0]	= 11;
-	inst_cyc[1]	= 17;
-
-	return (TEXT);
-}
-
-
-/*	*************************************************************************
- *	Function name:	proc_cm
- *	Description:
- *	Author(s):		Jay Cotton, Claude Sylvain
- *	Created:			2007
- *	Last modified:	26 May 2013
- *
- *	Parameters:		char *label:
- *							...
- *
- *						char *equation:
- *							...
- *
- *	Returns:			int:
- *							...
- *
- *	Globals:
- *	Notes:
- *	************************************************************************* */
-
-static int proc_cm(char *label, char *equation)
-{
-	int		tmp;
-
-	process_label(label);		/*	Process Label. */
-
-	b1 = 0xC4 + (7 << 3);
-
-	tmp	= exp_parser(equation);
-
-	check_oor(tmp, 0xFFFF);		/*	Check Operand Over Range. */
-
-	b2				= tmp & 0xFF;
-	b3				= (tmp >> 8) & 0xFF;
-	data_size	= 3;
-	inst_cyc[0]	= 11;
-	inst_cyc[1]	= 17;
-
-	return (TEXT);
-}
-
-
-/*	*************************************************************************
- *	Function name:	proc_ret
- *	Description:
- *	Author(s):		Jay Cotton, Claude Sylvain
- *	Created:			2007
- *	Last modified:	26 May 2013
- *
- *	Parameters:		char *label:
- *							...
- *
- *						char *equation:
- *							...
- *
- *	Returns:			int:
- *							...
- *
- *	Globals:
- *	Notes:
- *	************************************************************************* */
-
-static int proc_ret(char *label, char *equation)
-{
-	process_label(label);		/*	Process Label. */
-
-	b1				= 0xC9;
-	data_size	= 1;
-	inst_cyc[0]	= 10;
-	inst_cyc[1]	= 10;
-
-	return (TEXT);
-}
-
-
-/*	*************************************************************************
- *	Function name:	proc_rnz
- *	Description:
- *	Author(s):		Jay Cotton, Claude Sylvain
- *	Created:			2007
- *	Last modified:	26 May 2013
- *
- *	Parameters:		char *label:
- *							...
- *
- *						char *equation:
- *							...
- *
- *	Returns:			int:
- *							...
- *
- *	Globals:
- *	Notes:
- *	************************************************************************* */
-
-static int proc_rnz(char *label, char *equation)
-{
-	process_label(label);		/*	Process Label. */
-
-	b1				= 0xC0;
-	data_size	= 1;
-	inst_cyc[0]	= 5;
-	inst_cyc[1]	= 11;
-
-	return (TEXT);
-}
-
-
-/*	*************************************************************************
- *	Function name:	proc_rz
- *	Description:
- *	Author(s):		Jay Cotton, Claude Sylvain
- *	Created:			2007
- *	Last modified:	26 May 2013
- *
- *	Parameters:		char *label:
- *							...
- *
- *						char *equation:
- *							...
- *
- *	Returns:			int:
- *							...
- *
- *	Globals:
- *	Notes:
- *	************************************************************************* */
-
-static int proc_rz(char *label, char *equation)
-{
-	process_label(label);		/*	Process Label. */
-
-	b1				= 0xC0 + (1 << 3);
-	data_size	= 1;
-	inst_cyc[0]	= 5;
-	inst_cyc[1]	= 11;
-
-	return (TEXT);
-}
-
-
-/*	*************************************************************************
- *	Function name:	proc_rnc
- *	Description:
- *	Author(s):		Jay Cotton, Claude Sylvain
- *	Created:			2007
- *	Last modified:	26 May 2013
- *
- *	Parameters:		char *label:
- *							...
- *
- *						char *equation:
- *							...
- *
- *	Returns:			int:
- *							...
- *
- *	Globals:
- *	Notes:
- *	************************************************************************* */
-
-static int proc_rnc(char *label, char *equation)
-{
-	process_label(label);		/*	Process Label. */
-
-	b1				= 0xC0 + (2 << 3);
-	data_size	= 1;
-	inst_cyc[0]	= 5;
-	inst_cyc[1]	= 11;
-
-	return (TEXT);
-}
-
-
-/*	*************************************************************************
- *	Function name:	proc_rc
- *	Description:
- *	Author(s):		Jay Cotton, Claude Sylvain
- *	Created:			2007
- *	Last modified:	26 May 2013
- *
- *	Parameters:		char *label:
- *							...
- *
- *						char *equation:
- *							...
- *
- *	Returns:			int:
- *							...
- *
- *	Globals:
- *	Notes:
- *	************************************************************************* */
-
-static int proc_rc(char *label, char *equation)
-{
-	process_label(label);		/*	Process Label. */
-
-	b1				= 0xC0 + (3 << 3);
-	data_size	= 1;
-	inst_cyc[0]	= 5;
-	inst_cyc[1]	= 11;
-
-	return (TEXT);
-}
-
-
-/*	*************************************************************************
- *	Function name:	proc_rpo
- *	Description:
- *	Author(s):		Jay Cotton, Claude Sylvain
- *	Created:			2007
- *	Last modified:	26 May 2013
- *
- *	Parameters:		char *label:
- *							...
- *
- *						char *equation:
- *							...
- *
- *	Returns:			int:
- *							...
- *
- *	Globals:
- *	Notes:
- *	************************************************************************* */
-
-static int proc_rpo(char *label, char *equation)
-{
-	process_label(label);		/*	Process Label. */
-
-	b1				= 0xC0 + (4 << 3);
-	data_size	= 1;
-	inst_cyc[0]	= 5;
-	inst_cyc[1]	= 11;
-
-	return (TEXT);
-}
-
-
-/*	*************************************************************************
- *	Function name:	proc_rpe
- *	Description:
- *	Author(s):		Jay Cotton, Claude Sylvain
- *	Created:			2007
- *	Last modified:	26 May 2013
- *
- *	Parameters:		char *label:
- *							...
- *
- *						char *equation:
- *							...
- *
- *	Returns:			int:
- *							...
- *
- *	Globals:
- *	Notes:
- *	************************************************************************* */
-
-static int proc_rpe(char *label, char *equation)
-{
-	process_label(label);		/*	Process Label. */
-
-	b1				= 0xC0 + (5 << 3);
-	data_size	= 1;
-	inst_cyc[0]	= 5;
-	inst_cyc[1]	= 11;
-
-	return (TEXT);
-}
-
-
-/*	*************************************************************************
- *	Function name:	proc_rp
- *	Description:
- *	Author(s):		Jay Cotton, Claude Sylvain
- *	Created:			2007
- *	Last modified:	26 May 2013
- *
- *	Parameters:		char *label:
- *							...
- *
- *						char *equation:
- *							...
- *
- *	Returns:			int:
- *							...
- *
- *	Globals:
- *	Notes:
- *	************************************************************************* */
-
-static int proc_rp(char *label, char *equation)
-{
-	process_label(label);		/*	Process Label. */
-
-	b1				= 0xC0 + (6 << 3);
-	data_size	= 1;
-	inst_cyc[0]	= 5;
-	inst_cyc[1]	= 11;
-
-	return (TEXT);
-}
-
-
-/*	*************************************************************************
- *	Function name:	proc_rm
- *	Description:
- *	Author(s):		Jay Cotton, Claude Sylvain
- *	Created:			2007
- *	Last modified:	26 May 2013
- *
- *	Parameters:		char *label:
- *							...
- *
- *						char *equation:
- *							...
- *
- *	Returns:			int:
- *							...
- *
- *	Globals:
- *	Notes:
- *	************************************************************************* */
-
-static int proc_rm(char *label, char *equation)
-{
-	process_label(label);		/*	Process Label. */
-
-	b1				= 0xC0 + (7 << 3);
-	data_size	= 1;
-	inst_cyc[0]	= 5;
-	inst_cyc[1]	= 11;
-
-	return (TEXT);
-}
-
-
-/*	*************************************************************************
- *	Function name:	proc_pchl
- *	Description:
- *	Author(s):		Jay Cotton, Claude Sylvain
- *	Created:			2007
- *	Last modified:	26 May 2013
- *
- *	Parameters:		char *label:
- *							...
- *
- *						char *equation:
- *							...
- *
- *	Returns:			int:
- *							...
- *
- *	Globals:
- *	Notes:
- *	************************************************************************* */
-
-static int proc_pchl(char *label, char *equation)
-{
-	process_label(label);		/*	Process Label. */
-
-	b1				= 0xE9;
-	data_size	= 1;
-	inst_cyc[0]	= 5;
-	inst_cyc[1]	= 5;
-
-	return (TEXT);
-}
-
-
-/*	*************************************************************************
- *	Function name:	proc_push
- *	Description:
- *	Author(s):		Jay Cotton, Claude Sylvain
- *	Created:			2007
- *	Last modified:	26 May 2013
- *
- *	Parameters:		char *label:
- *							...
- *
- *						char *equation:
- *							...
- *
- *	Returns:			int:
- *							...
- *
- *	Globals:
- *	Notes:
- *	************************************************************************* */
-
-static int proc_push(char *label, char *equation)
-{
-	process_label(label);		/*	Process Label. */
-
-	b1				= 0xC5;
-	data_size	= 1;
-	inst_cyc[0]	= 11;
-	inst_cyc[1]	= 11;
-
-	parse_reg16bits(
-		equation, PR16_AR_BC | PR16_AR_DE | PR16_AR_HL | PR16_AR_PSW);
-
-	return (TEXT);
-}
-
-
-/*	*************************************************************************
- *	Function name:	proc_pop
- *	Description:
- *	Author(s):		Jay Cotton, Claude Sylvain
- *	Created:			2007
- *	Last modified:	26 May 2013
- *
- *	Parameters:		char *label:
- *							...
- *
- *						char *equation:
- *							...
- *
- *	Returns:			int:
- *							...
- *
- *	Globals:
- *	Notes:
- *	************************************************************************* */
-
-static int proc_pop(char *label, char *equation)
-{
-	process_label(label);		/*	Process Label. */
-
-	b1				= 0xC1;
-	data_size	= 1;
-	inst_cyc[0]	= 10;
-	inst_cyc[1]	= 10;
-
-	parse_reg16bits(
-		equation, PR16_AR_BC | PR16_AR_DE | PR16_AR_HL | PR16_AR_PSW);
-
-	return (TEXT);
-}
-
-
-/*	*************************************************************************
- *	Function name:	proc_xthl
- *	Description:
- *	Author(s):		Jay Cotton, Claude Sylvain
- *	Created:			2007
- *	Last modified:	26 May 2013
- *
- *	Parameters:		char *label:
- *							...
- *
- *						char *equation:
- *							...
- *
- *	Returns:			int:
- *							...
- *
- *	Globals:
- *	Notes:
- *	************************************************************************* */
-
-static int proc_xthl(char *label, char *equation)
-{
-	process_label(label);		/*	Process Label. */
-
-	b1				= 0xE3;
-	data_size	= 1;
-	inst_cyc[0]	= 18;
-	inst_cyc[1]	= 18;
-
-	return (TEXT);
-}
-
-
-/*	*************************************************************************
- *	Function name:	proc_sphl
- *	Description:
- *	Author(s):		Jay Cotton, Claude Sylvain
- *	Created:			2007
- *	Last modified:	26 May 2013
- *
- *	Parameters:		char *label:
- *							...
- *
- *						char *equation:
- *							...
- *
- *	Returns:			int:
- *							...
- *
- *	Globals:
- *	Notes:
- *	************************************************************************* */
-
-static int proc_sphl(char *label, char *equation)
-{
-	process_label(label);		/*	Process Label. */
-
-	b1				= 0xF9;
-	data_size	= 1;
-	inst_cyc[0]	= 5;
-	inst_cyc[1]	= 5;
-
-	return (TEXT);
-}
-
-
-/*	*************************************************************************
- *	Function name:	proc_ei
- *	Description:
- *	Author(s):		Jay Cotton, Claude Sylvain
- *	Created:			2007
- *	Last modified:	26 May 2013
- *
- *	Parameters:		char *label:
- *							...
- *
- *						char *equation:
- *							...
- *
- *	Returns:			int:
- *							...
- *
- *	Globals:
- *	Notes:
- *	************************************************************************* */
-
-static int proc_ei(char *label, char *equation)
-{
-	process_label(label);		/*	Process Label. */
-
-	b1				= 0xFB;
-	data_size	= 1;
-	inst_cyc[0]	= 4;
-	inst_cyc[1]	= 4;
-
-	return (TEXT);
-}
-
-
-/*	*************************************************************************
- *	Function name:	proc_di
- *	Description:
- *	Author(s):		Jay Cotton, Claude Sylvain
- *	Created:			2007
- *	Last modified:	26 May 2013
- *
- *	Parameters:		char *label:
- *							...
- *
- *						char *equation:
- *							...
- *
- *	Returns:			int:
- *							...
- *
- *	Globals:
- *	Notes:
- *	************************************************************************* */
-
-static int proc_di(char *label, char *equation)
-{
-	process_label(label);		/*	Process Label. */
-
-	b1				= 0xF3;
-	data_size	= 1;
-	inst_cyc[0]	= 4;
-	inst_cyc[1]	= 4;
-
-	return (TEXT);
-}
-
-
-/*	*************************************************************************
- *	Function name:	proc_hlt
- *	Description:
- *	Author(s):		Jay Cotton, Claude Sylvain
- *	Created:			2007
- *	Last modified:	26 May 2013
- *
- *	Parameters:		char *label:
- *							...
- *
- *						char *equation:
- *							...
- *
- *	Returns:			int:
- *							...
- *
- *	Globals:
- *	Notes:
- *	************************************************************************* */
-
-static int proc_hlt(char *label, char *equation)
-{
-	process_label(label);		/*	Process Label. */
-
-	b1				= 0x76;
-	data_size	= 1;
-	inst_cyc[0]	= 7;
-	inst_cyc[1]	= 7;
-
-	return (TEXT);
-}
-
-
-
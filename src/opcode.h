@@ -45,11 +45,75 @@
 #include "project.h"
 
 
+/*	*************************************************************************
+ *											  CONSTANTS
+ *	************************************************************************* */
+
+#define OPCODE_DISASM_SIZE_MAX	24		/*	"opcode_disasm()" text size. */
+
+/*	Operand Classes.
+ *	---------------- */
+enum
+{
+	OC_NONE,				/*	No operand. */
+	OC_REG8,				/*	8-bit register (or "M"). */
+	OC_REG8_IMM8,		/*	8-bit register (or "M"), 8-bit immediate. */
+	OC_MOV,				/*	8-bit registers, destination and source. */
+	OC_RP,				/*	Register pair: B, D, H, SP. */
+	OC_RP_BD,			/*	Register pair: B, D. */
+	OC_RP_PSW,			/*	Register pair: B, D, H, PSW. */
+	OC_RP_IMM16,		/*	Register pair (B, D, H, SP), 16-bit immediate. */
+	OC_IMM8,				/*	8-bit immediate. */
+	OC_IMM16,			/*	16-bit immediate (address). */
+	OC_RST				/*	Restart number (0 to 7). */
+};
+
+/*	Control Flow.
+ *	------------- */
+enum
+{
+	OF_NEXT,				/*	Next instruction. */
+	OF_JUMP,				/*	Jump. */
+	OF_JUMP_COND,		/*	Conditional jump. */
+	OF_CALL,				/*	Call. */
+	OF_CALL_COND,		/*	Conditional call. */
+	OF_RET,				/*	Return. */
+	OF_RET_COND,		/*	Conditional return. */
+	OF_RST,				/*	Restart (call to restart number * 8). */
+	OF_PCHL,				/*	Jump to address in HL. */
+	OF_HLT,				/*	Halt. */
+	OF_DI,				/*	Disable interrupts (next instruction). */
+	OF_EI					/*	Enable interrupts (next instruction). */
+};
+
+
+/*	*************************************************************************
+ *	                                  TYPES
+ *	************************************************************************* */
+
+/*	Opcode encoding.
+ *	Notes:	- "cyc" is the number of cycles:
+ *				  - Conditional instructions: Not taken, taken.
+ *				  - 8-bit register operand: Register, "M".
+ *				  - Others: Both the same.
+ *	--------------------------------------------------------------- */
+typedef struct opcode
+{
+	const char	*Name;
+	uint8_t		base;			/*	Base Opcode. */
+	uint8_t		oc;			/*	Operand Class (See "OC_x"). */
+	uint8_t		shift;		/*	Register (or restart) field shift. */
+	uint8_t		size;			/*	Instruction Size, in bytes. */
+	uint8_t		cyc[2];		/*	Number of Cycles. */
+	uint8_t		flow;			/*	Control Flow (See "OF_x"). */
+} opcode_t;
+
+
 /*	*************************************************************************
  *												 CONST
  *	************************************************************************* */
 
-extern const keyword_t	OpCodes[];
+extern const opcode_t	OpCodes[];
 
 
 /*	*************************************************************************
@@ -57,6 +121,10 @@ extern const keyword_t	OpCodes[];
  *	************************************************************************* */
 
 void opcode_get_inst_cyc(uint8_t inst_cyc_p[]);
+int opcode_layout(const opcode_t *p_opcode, char *label);
+int opcode_encode(const opcode_t *p_opcode, char *label, char *equation);
+const opcode_t *opcode_decode(int byte, uint8_t inst_cyc_p[]);
+int opcode_disasm(const uint8_t *p_code, char *text);
 
 
 #endif
@@ -0,0 +1,904 @@
+/*	*************************************************************************
+ *	Module Name:	peep.c
+ *	Description:	Peephole Optimizer ("-O" option).
+ *	Copyright(c):	See below...
+ *	Author(s):
+ *	Created:			18 October 2026
+ *	Last modified:
+ *
+ *	Notes:			- Patterns are recognized on consecutive instruction
+ *						  lines, on assembler pass #1, so label addresses
+ *						  take the changes into account.  Each instruction
+ *						  line get a sequence number, and the action decided
+ *						  on pass #1 is applied when the same line is encoded
+ *						  on pass #2.
+ *						- An instruction is only known to be replaceable
+ *						  when the next line is seen.  Its size is then
+ *						  corrected by moving the PC back, before the next
+ *						  line label is set.
+ *						- Patterns:
+ *						    "CALL x" / "RET"    -> "JMP x"
+ *						    "JMP x" / "x:"      -> (nothing)
+ *						    "Jcc x" / "x:"      -> (nothing)
+ *						    "MVI A,0" / <flags set> -> "XRA A"
+ *						    "MOV r,r"           -> (nothing)
+ *						    Jump or call to a "JMP y" -> jump or call to "y"
+ *						- Any directive, macro, or label between lines
+ *						  (except a jump target) stop a pattern.
+ *						- Parallel assembly ("-j") is not used with "-O".
+ *	************************************************************************* */
+
+/*
+ * Copyright (c) <2007-2017> Jay Cotton <lbmgmusic@gmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+
+/*	*************************************************************************
+ *	                              INCLUDE FILES
+ *	************************************************************************* */
+
+#include <stdio.h>
+#include <ctype.h>
+#include <stdlib.h>
+
+#include "project.h"
+#include "err_code.h"		/*	Error Codes. */
+#include "main.h"
+#include "util.h"
+#include "msg.h"
+#include "mem.h"
+#include "opcode.h"
+#include "peep.h"
+
+
+/*	*************************************************************************
+ *											  CONSTANTS
+ *	************************************************************************* */
+
+#define PEEP_ACTION_SIZE_MIN		1024		/*	Actions, first allocation. */
+#define PEEP_JUMP_SIZE_MIN			256		/*	Jumps, first allocation. */
+#define PEEP_HOPS_MAX				8			/*	Jumps followed, at most. */
+#define PEEP_MSG_SIZE_MAX			128
+
+
+/*	*************************************************************************
+ *	                                 TYPEDEF
+ *	************************************************************************* */
+
+/*	Action on an instruction line (decided on pass #1).
+ *	--------------------------------------------------- */
+enum peep_action_t
+{
+	PA_NONE,
+	PA_REMOVE,					/*	Don't emit anything. */
+	PA_CALL_JMP,				/*	"CALL" replaced by "JMP". */
+	PA_XRA						/*	"MVI A,0" replaced by "XRA A". */
+};
+
+/*	Instruction waiting for the next line (pass #1).
+ *	------------------------------------------------ */
+enum peep_pending_t
+{
+	PP_NONE,
+	PP_CALL,						/*	"CALL" (followed by "RET" ?). */
+	PP_JMP,						/*	"JMP" (to the next line ?). */
+	PP_MVI						/*	"MVI A,0" (flags not used ?). */
+};
+
+/*	- Unconditional jump with a name operand, that jumps and
+ *	  calls to it can bypass (if the name is a label, on pass #2).
+ *	--------------------------------------------------------- */
+struct peep_jump_t
+{
+	int	addr;
+	long	seq;
+	char	name[LABEL_SIZE_MAX];
+};
+
+
+/*	*************************************************************************
+ *	                                  CONST
+ *	************************************************************************* */
+
+/*	- Instructions that set all flags, without using them.
+ *	*/
+static const char	*flags_set[]	=
+{
+	"ADD", "SUB", "ANA", "XRA", "ORA", "CMP",
+	"ADI", "SUI", "ANI", "XRI", "ORI", "CPI",
+	NULL
+};
+
+
+/*	*************************************************************************
+ *	                                VARIABLES
+ *	************************************************************************* */
+
+/*	Public variables.
+ *	***************** */
+
+int	peep_enable	= 0;		/*	"-O" option. */
+
+
+/*	Private variables.
+ *	****************** */
+
+static uint8_t					*peep_action	= NULL;	/*	By sequence number. */
+static long						action_size		= 0;
+static long						peep_seq			= 0;		/*	Instruction line number. */
+
+static enum peep_pending_t	pending			= PP_NONE;
+static long						pending_seq		= 0;
+static char						pending_name[LABEL_SIZE_MAX];
+
+static struct peep_jump_t	*peep_jump		= NULL;	/*	Sorted by address on pass #2. */
+static long						jump_num			= 0;
+static long						jump_size		= 0;
+
+static long						peep_changes	= 0;
+static long						peep_cycles		= 0;		/*	Cycles saved. */
+static long						peep_bytes		= 0;		/*	Bytes saved. */
+
+
+/*	*************************************************************************
+ *									  FUNCTIONS DECLARATION
+ *	************************************************************************* */
+
+static int get_name(const char *text, char *name);
+static int is_mov_same(const char *text);
+static int is_mvi_a_0(const char *text);
+static int is_flags_set(const opcode_t *p_opcode);
+static const opcode_t *find_opcode(const char *name);
+static int add_jump(int addr, long seq, const char *name);
+static int jump_compare(const void *p_a, const void *p_b);
+static const struct peep_jump_t *find_jump(int addr);
+static void remove_pending_jmp(void);
+static void note(const char *what, long cycles, long bytes);
+
+
+/*	*************************************************************************
+ *	                                FUNCTIONS
+ *	************************************************************************* */
+
+/*	*************************************************************************
+ *	Function name:	get_name
+ *	Description:	Get an operand that is a label name only.
+ *	Author(s):
+ *	Created:			18 October 2026
+ *	Last modified:
+ *
+ *	Parameters:		const char *text:
+ *							Operand.
+ *
+ *						char *name:
+ *							Name (LABEL_SIZE_MAX characters).
+ *
+ *	Returns:			int:
+ *							-1	: Operand is not a name.
+ *							0	: Success.
+ *
+ *	Globals:
+ *	Notes:
+ *	************************************************************************* */
+
+static int get_name(const char *text, char *name)
+{
+	int	i	= 0;
+
+
+	while (isspace((int) *text))
+		text++;
+
+	if ((*text == '?') || (*text == '@') || (isalpha((int) *text) != 0))
+		name[i++]	= *text++;
+	else
+		return (-1);
+
+	while ((islabelchar((int) *text) != 0) && (i < LABEL_SIZE_MAX - 1))
+		name[i++]	= *text++;
+
+	name[i]	= '\0';
+
+	while (isspace((int) *text))
+		text++;
+
+	return ((*text == '\0') ? 0 : -1);
+}
+
+
+/*	*************************************************************************
+ *	Function name:	is_mov_same
+ *	Description:	Check for a "MOV r,r" operand ("M" excluded).
+ *	Author(s):
+ *	Created:			18 October 2026
+ *	Last modified:
+ *
+ *	Parameters:		const char *text:
+ *							Operand.
+ *
+ *	Returns:			int:
+ *							1 if both registers are the same, 0 otherwise.
+ *
+ *	Globals:
+ *	Notes:
+ *	************************************************************************* */
+
+static int is_mov_same(const char *text)
+{
+	int	dst;
+	int	src;
+
+
+	while (isspace((int) *text))	text++;
+	dst	= toupper((int) *text++);
+	while (isspace((int) *text))	text++;
+
+	if (*text++ != ',')
+		return (0);
+
+	while (isspace((int) *text))	text++;
+	src	= toupper((int) *text++);
+	while (isspace((int) *text))	text++;
+
+	return (	(*text == '\0') && (dst == src) && (dst != '\0') &&
+				(strchr("BCDEHLA", dst) != NULL));
+}
+
+
+/*	*************************************************************************
+ *	Function name:	is_mvi_a_0
+ *	Description:	Check for a "MVI A,0" operand.
+ *	Author(s):
+ *	Created:			18 October 2026
+ *	Last modified:
+ *
+ *	Parameters:		const char *text:
+ *							Operand.
+ *
+ *	Returns:			int:
+ *							1 if operand is "A,0" ("0", "00H", ...),
+ *							0 otherwise.
+ *
+ *	Globals:
+ *	Notes:
+ *	************************************************************************* */
+
+static int is_mvi_a_0(const char *text)
+{
+	while (isspace((int) *text))	text++;
+
+	if (toupper((int) *text++) != 'A')
+		return (0);
+
+	while (isspace((int) *text))	text++;
+
+	if (*text++ != ',')
+		return (0);
+
+	while (isspace((int) *text))	text++;
+
+	if (*text != '0')
+		return (0);
+
+	while (*text == '0')				text++;
+
+	if (toupper((int) *text) == 'H')
+		text++;
+
+	while (isspace((int) *text))	text++;
+
+	return (*text == '\0');
+}
+
+
+/*	*************************************************************************
+ *	Function name:	is_flags_set
+ *	Description:	Check if an instruction set all flags, without using them.
+ *	Author(s):
+ *	Created:			18 October 2026
+ *	Last modified:
+ *
+ *	Parameters:		const opcode_t *p_opcode:
+ *							Instruction.
+ *
+ *	Returns:			int:
+ *							1 if flags are set, 0 otherwise.
+ *
+ *	Globals:
+ *	Notes:
+ *	************************************************************************* */
+
+static int is_flags_set(const opcode_t *p_opcode)
+{
+	int	i;
+
+	for (i = 0; flags_set[i] != NULL; i++)
+	{
+		if (strcmp(flags_set[i], p_opcode->Name) == 0)
+			return (1);
+	}
+
+	return (0);
+}
+
+
+/*	*************************************************************************
+ *	Function name:	find_opcode
+ *	Description:	Find an "OpCodes[]" entry.
+ *	Author(s):
+ *	Created:			18 October 2026
+ *	Last modified:
+ *
+ *	Parameters:		const char *name:
+ *							Mnemonic.
+ *
+ *	Returns:			const opcode_t *:
+ *							Entry, or NULL if not found.
+ *
+ *	Globals:
+ *	Notes:
+ *	************************************************************************* */
+
+static const opcode_t *find_opcode(const char *name)
+{
+	const opcode_t	*p_opcode;
+
+	for (p_opcode = OpCodes; p_opcode->Name != NULL; p_opcode++)
+	{
+		if (strcmp(p_opcode->Name, name) == 0)
+			return (p_opcode);
+	}
+
+	return (NULL);
+}
+
+
+/*	*************************************************************************
+ *	Function name:	add_jump
+ *	Description:	Record an unconditional jump to a label.
+ *	Author(s):
+ *	Created:			18 October 2026
+ *	Last modified:
+ *
+ *	Parameters:		int addr:
+ *							Address of the jump.
+ *
+ *						long seq:
+ *							Sequence number of the jump line.
+ *
+ *						const char *name:
+ *							Label jumped to.
+ *
+ *	Returns:			int:
+ *							-1	: Memory allocation error.
+ *							0	: Success.
+ *
+ *	Globals:
+ *	Notes:
+ *	************************************************************************* */
+
+static int add_jump(int addr, long seq, const char *name)
+{
+	if (jump_num >= jump_size)
+	{
+		long						size	= (jump_size > 0) ? jump_size * 2 : PEEP_JUMP_SIZE_MIN;
+		struct peep_jump_t	*p		= (struct peep_jump_t *)
+			mem_realloc(MT_PEEP, peep_jump, size * sizeof (struct peep_jump_t));
+
+		if (p == NULL)
+			return (-1);
+
+		peep_jump	= p;
+		jump_size	= size;
+	}
+
+	peep_jump[jump_num].addr	= addr & 0xFFFF;
+	peep_jump[jump_num].seq		= seq;
+	strcpy(peep_jump[jump_num].name, name);
+
+	jump_num++;
+
+	return (0);
+}
+
+
+/*	*************************************************************************
+ *	Function name:	jump_compare
+ *	Description:	Compare two jumps addresses ("qsort()", "bsearch()").
+ *	Author(s):
+ *	Created:			18 October 2026
+ *	Last modified:
+ *
+ *	Parameters:		const void *p_a:
+ *							...
+ *
+ *						const void *p_b:
+ *							...
+ *
+ *	Returns:			int:
+ *							...
+ *
+ *	Globals:
+ *	Notes:
+ *	************************************************************************* */
+
+static int jump_compare(const void *p_a, const void *p_b)
+{
+	return (((const struct peep_jump_t *) p_a)->addr - ((const struct peep_jump_t *) p_b)->addr);
+}
+
+
+/*	*************************************************************************
+ *	Function name:	find_jump
+ *	Description:	Find the recorded jump at an address.
+ *	Author(s):
+ *	Created:			18 October 2026
+ *	Last modified:
+ *
+ *	Parameters:		int addr:
+ *							Address.
+ *
+ *	Returns:			const struct peep_jump_t *:
+ *							Jump, or NULL if there is none.
+ *
+ *	Globals:
+ *	Notes:
+ *	************************************************************************* */
+
+static const struct peep_jump_t *find_jump(int addr)
+{
+	struct peep_jump_t	key;
+
+	if (jump_num == 0)
+		return (NULL);
+
+	key.addr	= addr & 0xFFFF;
+
+	return ((const struct peep_jump_t *)
+		bsearch(&key, peep_jump, (size_t) jump_num, sizeof (struct peep_jump_t), jump_compare));
+}
+
+
+/*	*************************************************************************
+ *	Function name:	remove_pending_jmp
+ *	Description:	Remove the pending jump (to the next line).
+ *	Author(s):
+ *	Created:			18 October 2026
+ *	Last modified:
+ *	Parameters:		void
+ *	Returns:			void
+ *
+ *	Globals:			struct target_t target
+ *
+ *	Notes:			- Jump was laid out with its 3 bytes.  Move PC back.
+ *						- "JMP" was the last recorded jump.
+ *	************************************************************************* */
+
+static void remove_pending_jmp(void)
+{
+	peep_action[pending_seq]	= PA_REMOVE;
+	set_pc(target.addr - 3);
+
+	if ((jump_num > 0) && (peep_jump[jump_num - 1].seq == pending_seq))
+		jump_num--;
+
+	pending	= PP_NONE;
+}
+
+
+/*	*************************************************************************
+ *	Function name:	note
+ *	Description:	Report a change.
+ *	Author(s):
+ *	Created:			18 October 2026
+ *	Last modified:
+ *
+ *	Parameters:		const char *what:
+ *							Change.
+ *
+ *						long cycles:
+ *							Cycles saved.
+ *
+ *						long bytes:
+ *							Bytes saved.
+ *
+ *	Returns:			void
+ *	Globals:
+ *	Notes:
+ *	************************************************************************* */
+
+static void note(const char *what, long cycles, long bytes)
+{
+	char	msg[PEEP_MSG_SIZE_MAX];
+
+
+	snprintf(	msg, sizeof (msg), "%s (%ld cycles, %ld byte%s saved).", what, cycles,
+					bytes, (bytes != 1) ? "s" : "");
+
+	msg_note(msg);
+
+	peep_changes++;
+	peep_cycles	+= cycles;
+	peep_bytes	+= bytes;
+}
+
+
+/*	*************************************************************************
+ *	Function name:	peep_reset
+ *	Description:	Prepare an assembler pass.
+ *	Author(s):
+ *	Created:			18 October 2026
+ *	Last modified:
+ *	Parameters:		void
+ *	Returns:			void
+ *
+ *	Globals:			int asm_pass
+ *
+ *	Notes:			- On pass #1 (each layout pass), actions and jumps
+ *						  are found again.  On pass #2, jumps are sorted.
+ *	************************************************************************* */
+
+void peep_reset(void)
+{
+	peep_seq		= 0;
+	pending		= PP_NONE;
+
+	if (asm_pass == 0)
+		jump_num	= 0;
+	else
+	{
+		if (jump_num > 1)
+			qsort(peep_jump, (size_t) jump_num, sizeof (struct peep_jump_t), jump_compare);
+
+		peep_changes	= 0;
+		peep_cycles		= 0;
+		peep_bytes		= 0;
+	}
+}
+
+
+/*	*************************************************************************
+ *	Function name:	peep_layout
+ *	Description:	Look for patterns (assembler pass #1).
+ *	Author(s):
+ *	Created:			18 October 2026
+ *	Last modified:
+ *
+ *	Parameters:		const opcode_t *p_opcode:
+ *							Instruction.
+ *
+ *						char *label:
+ *							Label of the line.
+ *
+ *						char *equation:
+ *							Operand.
+ *
+ *	Returns:			int:
+ *							1 if the instruction is removed, 0 otherwise.
+ *
+ *	Globals:			struct target_t target
+ *
+ *	Notes:			- Called before the line label is set.
+ *	************************************************************************* */
+
+int peep_layout(const opcode_t *p_opcode, char *label, char *equation)
+{
+	long	seq	= peep_seq++;
+
+
+	/*	One action per instruction line.
+	 *	-------------------------------- */
+	if (seq >= action_size)
+	{
+		long		size	= (action_size > 0) ? action_size * 2 : PEEP_ACTION_SIZE_MIN;
+		uint8_t	*p		= (uint8_t *) mem_realloc(MT_PEEP, peep_action, size);
+
+		if (p == NULL)
+		{
+			msg_error("Memory allocation error!", EC_MAE);
+
+			peep_enable	= 0;
+			return (0);
+		}
+
+		peep_action	= p;
+		action_size	= size;
+	}
+
+	peep_action[seq]	= PA_NONE;
+
+	/*	Instruction of the previous line.
+	 *	--------------------------------- */
+	switch (pending)
+	{
+		case PP_JMP:
+			if (strcmp(label, pending_name) == 0)
+				remove_pending_jmp();
+
+			break;
+
+		case PP_MVI:
+			if (is_flags_set(p_opcode) != 0)
+			{
+				peep_action[pending_seq]	= PA_XRA;
+				set_pc(target.addr - 1);
+			}
+
+			break;
+
+		case PP_CALL:
+			/*	- Tail call.  "RET" must not be a jump target.
+			 *	*/
+			if ((p_opcode->flow == OF_RET) && (*label == '\0'))
+			{
+				peep_action[pending_seq]	= PA_CALL_JMP;
+				peep_action[seq]				= PA_REMOVE;
+
+				if (*pending_name != '\0')
+					add_jump(target.pc - 3, pending_seq, pending_name);
+
+				pending	= PP_NONE;
+				return (1);
+			}
+
+			break;
+
+		default:
+			break;
+	}
+
+	pending	= PP_NONE;
+
+	/*	This instruction.
+	 *	----------------- */
+	if ((strcmp(p_opcode->Name, "MOV") == 0) && (is_mov_same(equation) != 0))
+	{
+		peep_action[seq]	= PA_REMOVE;
+		return (1);
+	}
+
+	if ((strcmp(p_opcode->Name, "MVI") == 0) && (is_mvi_a_0(equation) != 0))
+		pending	= PP_MVI;
+	else if (p_opcode->flow == OF_CALL)
+	{
+		pending	= PP_CALL;
+
+		if (get_name(equation, pending_name) == -1)
+			*pending_name	= '\0';
+	}
+	else if (	((p_opcode->flow == OF_JUMP) || (p_opcode->flow == OF_JUMP_COND)) &&
+				(get_name(equation, pending_name) == 0))
+	{
+		pending	= PP_JMP;
+
+		if (p_opcode->flow == OF_JUMP)
+			add_jump(target.pc, seq, pending_name);
+	}
+
+	pending_seq	= seq;
+
+	return (0);
+}
+
+
+/*	*************************************************************************
+ *	Function name:	peep_label
+ *	Description:	Line with only a label (assembler pass #1).
+ *	Author(s):
+ *	Created:			18 October 2026
+ *	Last modified:
+ *
+ *	Parameters:		char *label:
+ *							Label.
+ *
+ *	Returns:			void
+ *	Globals:
+ *
+ *	Notes:			- Called before the label is set.  Other lines
+ *						  than instructions call "peep_flush()".
+ *	************************************************************************* */
+
+void peep_label(char *label)
+{
+	if (asm_pass != 0)
+		return;
+
+	if ((pending == PP_JMP) && (strcmp(label, pending_name) == 0))
+		remove_pending_jmp();
+	else if (pending == PP_CALL)
+		pending	= PP_NONE;
+}
+
+
+/*	*************************************************************************
+ *	Function name:	peep_flush
+ *	Description:	Line that is not an instruction (assembler pass #1).
+ *	Author(s):
+ *	Created:			18 October 2026
+ *	Last modified:
+ *	Parameters:		void
+ *	Returns:			void
+ *	Globals:
+ *	Notes:
+ *	************************************************************************* */
+
+void peep_flush(void)
+{
+	if (asm_pass == 0)
+		pending	= PP_NONE;
+}
+
+
+/*	*************************************************************************
+ *	Function name:	peep_encode
+ *	Description:	Apply changes (assembler pass #2).
+ *	Author(s):
+ *	Created:			18 October 2026
+ *	Last modified:
+ *
+ *	Parameters:		const opcode_t *p_opcode:
+ *							Instruction, already encoded by "opcode_encode()".
+ *
+ *						char *equation:
+ *							Operand.
+ *
+ *	Returns:			const opcode_t *:
+ *							- Instruction emitted.
+ *							- NULL if instruction is removed.
+ *
+ *	Globals:			int b1, b2, b3
+ *						int data_size
+ *
+ *	Notes:			- Replacement instructions are encoded again by
+ *						  "opcode_encode()", so "-P" cycles are right.
+ *						- A "JMP" is bypassed only if its operand is a
+ *						  label: a "SET" name may have another value at
+ *						  the "JMP" line.
+ *	************************************************************************* */
+
+const opcode_t *peep_encode(const opcode_t *p_opcode, char *equation)
+{
+	const opcode_t				*p_new;
+	const struct peep_jump_t	*p_jump;
+	SYMBOL							*p_symbol;
+	char								msg[PEEP_MSG_SIZE_MAX];
+	uint8_t							cyc[2];
+	long								seq	= peep_seq++;
+	int								addr;
+	int								hops;
+
+
+	opcode_get_inst_cyc(cyc);
+
+	switch ((seq < action_size) ? peep_action[seq] : PA_NONE)
+	{
+		case PA_REMOVE:
+			sprintf(msg, "\"%s\" removed", p_opcode->Name);
+			note(msg, cyc[0], data_size);
+
+			data_size	= 0;
+			return (NULL);
+
+		case PA_CALL_JMP:
+			p_new	= find_opcode("JMP");
+			opcode_encode(p_new, "", equation);
+			note("\"CALL\" / \"RET\" replaced by \"JMP\"", cyc[0] - p_new->cyc[0], 0);
+
+			p_opcode	= p_new;
+			break;
+
+		case PA_XRA:
+			p_new	= find_opcode("XRA");
+			opcode_encode(p_new, "", "A");
+			note("\"MVI A,0\" replaced by \"XRA A\"", cyc[0] - p_new->cyc[0], 1);
+
+			return (p_new);
+
+		default:
+			break;
+	}
+
+	/*	Jump or call to a jump.
+	 *	----------------------- */
+	if (	(p_opcode->oc != OC_IMM16) ||
+			((p_opcode->flow != OF_JUMP) && (p_opcode->flow != OF_JUMP_COND) &&
+			(p_opcode->flow != OF_CALL) && (p_opcode->flow != OF_CALL_COND)))
+	{
+		return (p_opcode);
+	}
+
+	addr	= b2 | (b3 << 8);
+
+	for (hops = 0; hops < PEEP_HOPS_MAX; hops++)
+	{
+		if (	((p_jump = find_jump(addr)) == NULL) ||
+				((p_symbol = FindLabel((char *) p_jump->name)) == NULL) ||
+				(p_symbol->Symbol_Type != SYMBOL_LABEL) ||
+				((p_symbol->Symbol_Value & 0xFFFF) == addr))
+		{
+			break;
+		}
+
+		addr	= p_symbol->Symbol_Value & 0xFFFF;
+	}
+
+	if (hops > 0)
+	{
+		b2	= addr & 0xFF;
+		b3	= (addr >> 8) & 0xFF;
+
+		sprintf(msg, "Jump to \"JMP\" bypassed, to %04Xh", addr);
+		note(msg, hops * find_opcode("JMP")->cyc[0], 0);
+	}
+
+	return (p_opcode);
+}
+
+
+/*	*************************************************************************
+ *	Function name:	peep_report
+ *	Description:	Print the changes total.
+ *	Author(s):
+ *	Created:			18 October 2026
+ *	Last modified:
+ *
+ *	Parameters:		FILE *fp:
+ *							Output.
+ *
+ *	Returns:			void
+ *	Globals:
+ *	Notes:			- Cycles are saved each time an instruction run.
+ *	************************************************************************* */
+
+void peep_report(FILE *fp)
+{
+	fprintf(	fp, "Peephole optimizer: %ld change%s, %ld cycles and %ld byte%s saved.\n",
+				peep_changes, (peep_changes != 1) ? "s" : "", peep_cycles, peep_bytes,
+				(peep_bytes != 1) ? "s" : "");
+}
+
+
+/*	*************************************************************************
+ *	Function name:	peep_cleanup
+ *	Description:	"peep" module Cleanup.
+ *	Author(s):
+ *	Created:			18 October 2026
+ *	Last modified:
+ *	Parameters:		void
+ *	Returns:			void
+ *	Globals:
+ *	Notes:
+ *	************************************************************************* */
+
+void peep_cleanup(void)
+{
+	mem_free(peep_action);
+	mem_free(peep_jump);
+
+	peep_action	= NULL;
+	peep_jump	= NULL;
+	action_size	= 0;
+	jump_size	= 0;
+	jump_num		= 0;
+}
+
+
+
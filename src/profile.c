@@ -0,0 +1,526 @@
+/*	*************************************************************************
+ *	Module Name:	profile.c
+ *	Description:	Trace Profile ("--profile" option).
+ *	Copyright(c):	See below...
+ *	Author(s):
+ *	Created:			18 October 2026
+ *	Last modified:
+ *
+ *	Notes:			- A trace file is a list of PC values, as captured by
+ *						  an emulator or a logic analyser.  Each instruction
+ *						  line of the listing is annotated with the number
+ *						  of times it was executed, and the total number of
+ *						  cycles it took.
+ *						- Conditional instructions are "not taken" when the
+ *						  next PC of the trace is the next instruction.
+ *	************************************************************************* */
+
+/*
+ * Copyright (c) <2007-2017> Jay Cotton <lbmgmusic@gmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+
+/*	*************************************************************************
+ *	                              INCLUDE FILES
+ *	************************************************************************* */
+
+#include <stdio.h>
+#include <ctype.h>
+#include <string.h>
+
+#include "project.h"
+#include "main.h"
+#include "mem.h"
+#include "opcode.h"
+#include "cycles.h"
+#include "profile.h"
+
+
+/*	*************************************************************************
+ *											  CONSTANTS
+ *	************************************************************************* */
+
+#define PROFILE_ADDR_NUM		0x10000		/*	Number of addresses. */
+#define PROFILE_TOKEN_SIZE		16				/*	Trace PC text, with '\0'. */
+
+
+/*	*************************************************************************
+ *	                                VARIABLES
+ *	************************************************************************* */
+
+/*	Public variables.
+ *	***************** */
+
+int	profile_enable	= 0;		/*	"--profile" option. */
+
+
+/*	Private variables.
+ *	****************** */
+
+static long long	*prof_count		= NULL;		/*	Times each address was traced. */
+
+/*	- Times the next PC was 1, 2 or 3 bytes after each address
+ *	  (3 per address).  Used to find branches not taken.
+ *	*/
+static long long	*prof_next		= NULL;
+
+static long long	prof_samples	= 0;			/*	Number of PC values read. */
+static int			prof_files		= 0;			/*	Number of trace files read. */
+
+
+/*	*************************************************************************
+ *									  FUNCTIONS DECLARATION
+ *	************************************************************************* */
+
+static int get_token(FILE *fp, char *token, int *p_line);
+static int parse_pc(char *token);
+static long long line_cycles(int addr, int size, int byte);
+
+
+/*	*************************************************************************
+ *	                                FUNCTIONS
+ *	************************************************************************* */
+
+/*	*************************************************************************
+ *	Function name:	get_token
+ *	Description:	Read the next PC value text of a trace file.
+ *	Author(s):
+ *	Created:			18 October 2026
+ *	Last modified:
+ *
+ *	Parameters:		FILE *fp:
+ *							Trace file.
+ *
+ *						char *token:
+ *							Text (filled, "PROFILE_TOKEN_SIZE" bytes).
+ *
+ *						int *p_line:
+ *							Line number (updated).
+ *
+ *	Returns:			int:
+ *							-2	: Text too long.
+ *							-1	: End of file.
+ *							0	: Success.
+ *
+ *	Globals:
+ *	Notes:			- Values are separated by spaces, tabs, new lines or
+ *						  commas.  ';' and '#' start a comment, up to the
+ *						  end of the line.
+ *	************************************************************************* */
+
+static int get_token(FILE *fp, char *token, int *p_line)
+{
+	int	c;
+	int	len	= 0;
+
+
+	/*	Skip separators and comments.
+	 *	----------------------------- */
+	for (;;)
+	{
+		c	= getc(fp);
+
+		if ((c == ';') || (c == '#'))
+		{
+			while ((c != EOF) && (c != '\n'))
+				c	= getc(fp);
+		}
+
+		if (c == EOF)
+			return (-1);
+
+		if (c == '\n')
+			(*p_line)++;
+		else if (!isspace(c) && (c != ','))
+			break;
+	}
+
+	/*	Get the value text.
+	 *	------------------- */
+	while ((c != EOF) && !isspace(c) && (c != ',') && (c != ';') && (c != '#'))
+	{
+		if (len >= PROFILE_TOKEN_SIZE - 1)
+			return (-2);
+
+		token[len++]	= (char) c;
+		c					= getc(fp);
+	}
+
+	token[len]	= '\0';
+
+	if (c != EOF)
+		ungetc(c, fp);
+
+	return (0);
+}
+
+
+/*	*************************************************************************
+ *	Function name:	parse_pc
+ *	Description:	Convert a PC value text.
+ *	Author(s):
+ *	Created:			18 October 2026
+ *	Last modified:
+ *
+ *	Parameters:		char *token:
+ *							- PC value, hexadecimal ("1F00", "0x1F00" or
+ *							  "1F00H").
+ *
+ *	Returns:			int:
+ *							- PC value.
+ *							- -1 if text is not a PC value.
+ *
+ *	Globals:
+ *	Notes:
+ *	************************************************************************* */
+
+static int parse_pc(char *token)
+{
+	int	len	= strlen(token);
+	long	value	= 0;
+
+
+	/*	Remove "0x" prefix, or 'H' suffix.
+	 *	---------------------------------- */
+	if ((token[0] == '0') && (toupper((int) token[1]) == 'X'))
+	{
+		token	+= 2;
+		len	-= 2;
+	}
+	else if ((len > 0) && (toupper((int) token[len - 1]) == 'H'))
+		token[--len]	= '\0';
+
+	if (len == 0)
+		return (-1);
+
+	for (; *token != '\0'; token++)
+	{
+		if (!isxdigit((int) *token))
+			return (-1);
+
+		value	= (value << 4) +
+		  			(isdigit((int) *token) ? (*token - '0') :
+					  							(toupper((int) *token) - 'A' + 10));
+
+		if (value >= PROFILE_ADDR_NUM)
+			return (-1);
+	}
+
+	return ((int) value);
+}
+
+
+/*	*************************************************************************
+ *	Function name:	line_cycles
+ *	Description:	Get the total number of cycles of an instruction.
+ *	Author(s):
+ *	Created:			18 October 2026
+ *	Last modified:
+ *
+ *	Parameters:		int addr:
+ *							Instruction address.
+ *
+ *						int size:
+ *							Instruction size (1 to 3).
+ *
+ *						int byte:
+ *							Opcode.
+ *
+ *	Returns:			long long:
+ *							Cycles, for all the times it was executed.
+ *
+ *	Globals:
+ *	Notes:
+ *	************************************************************************* */
+
+static long long line_cycles(int addr, int size, int byte)
+{
+	uint8_t		cyc[2]		= {0, 0};
+	long long	count			= prof_count[addr];
+	long long	not_taken	= prof_next[(addr * 3) + size - 1];
+
+
+	opcode_decode(byte, cyc);
+
+	if (not_taken > count)
+		not_taken	= count;
+
+	return ((not_taken * cyc[0]) + ((count - not_taken) * cyc[1]));
+}
+
+
+/*	*************************************************************************
+ *	Function name:	profile_option
+ *	Description:	Read a trace file ("--profile" option).
+ *	Author(s):
+ *	Created:			18 October 2026
+ *	Last modified:
+ *
+ *	Parameters:		const char *filename:
+ *							Trace file name.
+ *
+ *						int *p_line:
+ *							Line of the bad PC value (filled, on error -2).
+ *
+ *	Returns:			int:
+ *							-3	: Can't open trace file.
+ *							-2	: Bad PC value.
+ *							-1	: Memory allocation error.
+ *							0	: Success.
+ *
+ *	Globals:
+ *	Notes:			- Many trace files can be given.  Counts are added.
+ *	************************************************************************* */
+
+int profile_option(const char *filename, int *p_line)
+{
+	FILE	*fp;
+	char	token[PROFILE_TOKEN_SIZE];
+	int	pc;
+	int	prev		= -1;
+	int	status	= 0;
+	int	i;
+
+
+	*p_line	= 1;
+
+	if (prof_count == NULL)
+	{
+		prof_count	= (long long *) mem_calloc(MT_PROFILE, PROFILE_ADDR_NUM, sizeof (long long));
+		prof_next	= (long long *) mem_calloc(MT_PROFILE, PROFILE_ADDR_NUM * 3, sizeof (long long));
+
+		if ((prof_count == NULL) || (prof_next == NULL))
+			return (-1);
+	}
+
+	if ((fp = fopen(filename, "r")) == NULL)
+		return (-3);
+
+	while ((status = get_token(fp, token, p_line)) == 0)
+	{
+		if ((pc = parse_pc(token)) == -1)
+		{
+			status	= -2;
+			break;
+		}
+
+		prof_count[pc]++;
+		prof_samples++;
+
+		if (prev >= 0)
+		{
+			int	step	= (pc - prev) & 0xFFFF;
+
+			if ((step >= 1) && (step <= 3))
+				prof_next[(prev * 3) + step - 1]++;
+		}
+
+		prev	= pc;
+	}
+
+	fclose(fp);
+
+	if (status == -2)
+		return (-2);
+
+	/*	- Where the trace ends is not a branch.  Instruction
+	 *	  size is not known yet: count all of them.
+	 *	*/
+	if (prev >= 0)
+	{
+		for (i = 0; i < 3; i++)
+			prof_next[(prev * 3) + i]++;
+	}
+
+	/*	Decoding tables must not be built by assembler threads.
+	 *	------------------------------------------------------- */
+	opcode_decode(0, NULL);
+
+	/*	Opcode addresses are needed by the report.
+	 *	------------------------------------------ */
+	if (cycles_init() == -1)
+		return (-1);
+
+	prof_files++;
+	profile_enable	= 1;
+
+	return (0);
+}
+
+
+/*	*************************************************************************
+ *	Function name:	profile_column
+ *	Description:	Format the listing column of a source line.
+ *	Author(s):
+ *	Created:			18 October 2026
+ *	Last modified:
+ *
+ *	Parameters:		char *str:
+ *							Column text (filled, "PROFILE_COLUMN_SIZE" bytes).
+ *
+ *						int addr:
+ *							Instruction address.
+ *
+ *						int size:
+ *							Instruction size (1 to 3).
+ *
+ *						int byte:
+ *							Opcode.
+ *
+ *	Returns:			void
+ *	Globals:
+ *
+ *	Notes:			- Empty if "--profile" option is not used.
+ *						- Can be called by assembler threads.
+ *	************************************************************************* */
+
+void profile_column(char *str, int addr, int size, int byte)
+{
+	if (profile_enable == 0)
+	{
+		*str	= '\0';
+		return;
+	}
+
+	addr	&= 0xFFFF;
+
+	if (prof_count[addr] == 0)
+		sprintf(str, "%9s %11s ", "-", "-");
+	else
+		sprintf(str, "%9lld %11lld ", prof_count[addr], line_cycles(addr, size, byte));
+}
+
+
+/*	*************************************************************************
+ *	Function name:	profile_gap
+ *	Description:	Get the listing column of a line without instruction.
+ *	Author(s):
+ *	Created:			18 October 2026
+ *	Last modified:
+ *	Parameters:		void
+ *
+ *	Returns:			const char *:
+ *							Spaces, or empty if "--profile" option is not used.
+ *
+ *	Globals:
+ *	Notes:
+ *	************************************************************************* */
+
+const char *profile_gap(void)
+{
+	return ((profile_enable != 0) ? "                      " : "");
+}
+
+
+/*	*************************************************************************
+ *	Function name:	profile_report
+ *	Description:	Print the trace totals.
+ *	Author(s):
+ *	Created:			18 October 2026
+ *	Last modified:
+ *
+ *	Parameters:		FILE *fp:
+ *							Report file.
+ *
+ *	Returns:			void
+ *	Globals:			char Image[]
+ *
+ *	Notes:			- Must be called after assembler pass #2.
+ *						- PC values that are not at an opcode of the program
+ *						  (data, or no code) usually mean the trace is of
+ *						  another program.
+ *	************************************************************************* */
+
+void profile_report(FILE *fp)
+{
+	long long	cycles	= 0;
+	long long	unknown	= 0;
+	long			num		= 0;
+	int			addr;
+
+
+	if (profile_enable == 0)
+		return;
+
+	for (addr = 0; addr < PROFILE_ADDR_NUM; addr++)
+	{
+		const opcode_t	*p_opcode;
+		int				line;
+
+		if (prof_count[addr] == 0)
+			continue;
+
+		num++;
+
+		if (	(cycles_source(addr, &line) == NULL) ||
+				((p_opcode = opcode_decode(Image[addr], NULL)) == NULL))
+		{
+			unknown	+= prof_count[addr];
+		}
+		else
+			cycles	+= line_cycles(addr, p_opcode->size, Image[addr]);
+	}
+
+	fprintf(fp, "\n\n");
+	fprintf(fp, "*******************************************************************************\n");
+	fprintf(fp, "                                 Trace profile\n");
+	fprintf(fp, "*******************************************************************************\n");
+	fprintf(fp, "\n");
+	fprintf(	fp, "%lld PC value%s (%d file%s), %ld address%s, %lld cycle%s.\n",
+				prof_samples, (prof_samples != 1) ? "s" : "",
+				prof_files, (prof_files != 1) ? "s" : "",
+				num, (num != 1) ? "es" : "",
+				cycles, (cycles != 1) ? "s" : "");
+
+	if (unknown != 0)
+	{
+		fprintf(	fp, "%lld PC value%s not at an opcode of the program.\n",
+					unknown, (unknown != 1) ? "s" : "");
+	}
+}
+
+
+/*	*************************************************************************
+ *	Function name:	profile_cleanup
+ *	Description:	Release module memory.
+ *	Author(s):
+ *	Created:			18 October 2026
+ *	Last modified:
+ *	Parameters:		void
+ *	Returns:			void
+ *	Globals:
+ *	Notes:
+ *	************************************************************************* */
+
+void profile_cleanup(void)
+{
+	mem_free(prof_count);
+	mem_free(prof_next);
+
+	prof_count		= NULL;
+	prof_next		= NULL;
+	prof_samples	= 0;
+	prof_files		= 0;
+	profile_enable	= 0;
+}
+
+
+
@@ -4,7 +4,7 @@
  *	Copyright(c):	See below...
  *	Author(s):		Claude Sylvain
  *	Created:			2010-12-11
- *	Last modified:	2015-08-30
+ *	Last modified:	2026-10-18
  *	Notes:
  *	************************************************************************* */
 
@@ -92,6 +92,25 @@
  *	*/
 #define LANG_EXTENSION						1
 
+/*	- Define to 1 to make "asm8080" use POSIX threads (see "layout.c").
+ *	- Notes: Not available on Windows.
+ *	*/
+#if	defined (_TGT_OS_CYGWIN32) || defined (_TGT_OS_CYGWIN64) ||			\
+		defined (_TGT_OS_LINUX32) || defined (_TGT_OS_LINUX64) ||			\
+		defined (_TGT_OS_SOLARIS32) || defined (_TGT_OS_SOLARIS64)
+#define USE_PTHREAD							1
+#else
+#define USE_PTHREAD							0
+#endif
+
+/*	Null device ("--bench" option output).
+ *	*/
+#if	defined (_TGT_OS_WIN32) || defined (_TGT_OS_WIN64)
+#define NULL_DEVICE							"NUL"
+#else
+#define NULL_DEVICE							"/dev/null"
+#endif
+
 /*	Temporary debug.
  *	*/	
 #define DEBUG_TMP_ACTIVE					0
@@ -101,6 +120,15 @@
  *												 MACROS
  *	************************************************************************* */
 
+/*	- Storage class of variables that must have one instance per
+ *	  thread (see "layout.c").
+ *	----------------------------------------------------------- */
+#if USE_PTHREAD
+#define THREAD_LOCAL				__thread
+#else
+#define THREAD_LOCAL
+#endif
+
 /*	Define Path Separator accordingly to the operating system.
  *	---------------------------------------------------------- */
 #if	defined (_TGT_OS_CYGWIN32) || defined (_TGT_OS_CYGWIN64) ||			\
@@ -139,6 +167,19 @@ enum symbol_type_t
 	SYMBOL_NAME_SET
 };
 
+/*	- "EQU" evaluation state.
+ *	- Notes: "EQU" expressions are evaluated at their definition,
+ *	  or on first use if they refer to names not defined yet (see
+ *	  "exp_parser.c").
+ *	--------------------------------------------------------- */
+enum equ_state_t
+{
+	EQU_RESOLVED,			/*	Value is known. */
+	EQU_PENDING,			/*	Expression not evaluated yet. */
+	EQU_RESOLVING,			/*	Expression being evaluated. */
+	EQU_CIRCULAR			/*	Expression depend on itself. */
+};
+
 /*	Symbol table storage.
  *	--------------------- */
 typedef struct Symbol
@@ -148,6 +189,11 @@ typedef struct Symbol
 	enum	symbol_type_t	Symbol_Type;
 	int	code_line;
 	char	*src_filename;
+	char	*equ_expr;						/*	"EQU" expression. */
+	int	equ_pc;							/*	"$" value at "EQU" definition. */
+	enum	equ_state_t		equ_state;
+	int	prev_value;						/*	Value after previous layout pass. */
+	int	prev_valid;						/*	"prev_value" is valid. */
 	void	*next;
 } SYMBOL;
 
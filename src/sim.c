@@ -0,0 +1,1606 @@
+/*	*************************************************************************
+ *	Module Name:	sim.c
+ *	Description:	8080 Simulator and Execution Profile ("--run" option).
+ *	Copyright(c):	See below...
+ *	Author(s):
+ *	Created:			18 October 2026
+ *	Last modified:
+ *
+ *	Notes:			- After assembly, "Image[]" is run from a start address
+ *						  until "HLT", an opcode that is not an 8080 one, or a
+ *						  cycles limit.  Cycles come from "OpCodes[]" (same as
+ *						  "-P" and "--cycles" options).
+ *						- I/O ports are stubs: a port can be mapped to a memory
+ *						  address ("--run-io" option).  Interrupts are not
+ *						  simulated.
+ *						- Instructions and cycles are counted by opcode address,
+ *						  then reported by label and by source line.
+ *	************************************************************************* */
+
+/*
+ * Copyright (c) <2007-2017> Jay Cotton <lbmgmusic@gmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+
+/*	*************************************************************************
+ *	                              INCLUDE FILES
+ *	************************************************************************* */
+
+#include <stdio.h>
+#include <ctype.h>
+#include <stdlib.h>
+
+#include "project.h"
+#include "err_code.h"		/*	Error Codes. */
+#include "main.h"
+#include "util.h"
+#include "mem.h"
+#include "opcode.h"
+#include "cycles.h"
+#include "sim.h"
+
+
+/*	*************************************************************************
+ *											  CONSTANTS
+ *	************************************************************************* */
+
+#define SIM_ADDR_NUM				0x10000		/*	Number of addresses. */
+#define SIM_PORT_NUM				0x100			/*	Number of I/O ports. */
+#define SIM_CYCLES_DEFAULT		10000000		/*	Cycles limit, by default. */
+#define SIM_NO_PORT				(-1)			/*	I/O port not mapped. */
+#define SIM_PORT_IDLE			0xFF			/*	Input of a port not mapped. */
+
+/*	Register numbers (same as the opcode fields).
+ *	--------------------------------------------- */
+#define R_B							0
+#define R_C							1
+#define R_D							2
+#define R_E							3
+#define R_H							4
+#define R_L							5
+#define R_M							6
+#define R_A							7
+
+/*	Flags (bits of "PSW").
+ *	---------------------- */
+#define F_CY						0x01
+#define F_P							0x04
+#define F_AC						0x10
+#define F_Z							0x40
+#define F_S							0x80
+#define F_ONE						0x02			/*	Always 1. */
+
+
+/*	*************************************************************************
+ *	                                 TYPEDEF
+ *	************************************************************************* */
+
+/*	Why the simulation stopped.
+ *	--------------------------- */
+enum sim_stop_t
+{
+	SS_HLT,
+	SS_CYCLES,					/*	Cycles limit. */
+	SS_OPCODE					/*	Not an opcode. */
+};
+
+/*	Processor state.
+ *	---------------- */
+struct sim_cpu_t
+{
+	uint8_t	reg[8];			/*	See "R_x" ("R_M" is not used). */
+	uint8_t	flags;			/*	See "F_x". */
+	int		sp;
+	int		pc;
+	int		inte;				/*	Interrupts enabled (not simulated). */
+	int		halt;				/*	"HLT" executed. */
+};
+
+/*	Profile of a label or a source line.
+ *	------------------------------------ */
+struct sim_entry_t
+{
+	const char	*name;		/*	Label name, or source file name. */
+	int			addr;			/*	Label value, or source line. */
+	long long	count;		/*	Instructions executed. */
+	long long	cycles;
+};
+
+
+/*	*************************************************************************
+ *	                                VARIABLES
+ *	************************************************************************* */
+
+/*	Public variables.
+ *	***************** */
+
+int	sim_enable	= 0;		/*	"--run" option. */
+
+
+/*	Private variables.
+ *	****************** */
+
+static char					*sim_start		= NULL;		/*	Start label or address. */
+static long long			sim_limit		= SIM_CYCLES_DEFAULT;
+static char					*port_text[SIM_PORT_NUM];	/*	Port label or address. */
+static int					sim_port[SIM_PORT_NUM];		/*	Port memory addresses. */
+
+static struct sim_cpu_t	cpu;
+static uint8_t				*sim_mem			= NULL;
+static uint8_t				parity[256];					/*	1 if even parity. */
+
+static long long			*sim_count		= NULL;		/*	By opcode address. */
+static long long			*sim_cycles		= NULL;		/*	By opcode address. */
+static long long			total_count		= 0;
+static long long			total_cycles	= 0;
+
+
+/*	*************************************************************************
+ *									  FUNCTIONS DECLARATION
+ *	************************************************************************* */
+
+static int parse_number(const char *text, long *p_value);
+static int resolve(const char *text, long *p_addr);
+static int get_reg(int r);
+static void set_reg(int r, int value);
+static int get_rp(int rp);
+static void set_rp(int rp, int value);
+static void set_szp(int value);
+static void push(int value);
+static int pop(void);
+static int fetch16(void);
+static int condition(int cc);
+static void alu(int op, int value);
+static int step(void);
+static enum sim_stop_t run(int start);
+static int entry_compare(const void *p_a, const void *p_b);
+static int addr_compare(const void *p_a, const void *p_b);
+static int cycles_compare(const void *p_a, const void *p_b);
+static void print_entries(FILE *fp, struct sim_entry_t *p_entry, int num, int labels);
+static void profile_labels(FILE *fp);
+static void profile_lines(FILE *fp);
+
+
+/*	*************************************************************************
+ *	                                FUNCTIONS
+ *	************************************************************************* */
+
+/*	*************************************************************************
+ *	Function name:	parse_number
+ *	Description:	Parse a number of an option.
+ *	Author(s):
+ *	Created:			18 October 2026
+ *	Last modified:
+ *
+ *	Parameters:		const char *text:
+ *							Number: Decimal, "0x" prefix or "H" suffix for
+ *							hexadecimal.
+ *
+ *						long *p_value:
+ *							Value (filled).
+ *
+ *	Returns:			int:
+ *							-1	: Bad number.
+ *							0	: Success.
+ *
+ *	Globals:
+ *	Notes:
+ *	************************************************************************* */
+
+static int parse_number(const char *text, long *p_value)
+{
+	char	*p_end;
+
+	if (!isdigit((int) *text))
+		return (-1);
+
+	*p_value	= strtol(text, &p_end, 0);
+
+	if (toupper((int) *p_end) == 'H')
+	{
+		*p_value	= strtol(text, &p_end, 16);
+
+		if (toupper((int) *p_end) != 'H')
+			return (-1);
+
+		p_end++;
+	}
+
+	return ((*p_end == '\0') ? 0 : -1);
+}
+
+
+/*	*************************************************************************
+ *	Function name:	resolve
+ *	Description:	Get the address of a label or a number.
+ *	Author(s):
+ *	Created:			18 October 2026
+ *	Last modified:
+ *
+ *	Parameters:		const char *text:
+ *							Label or number.
+ *
+ *						long *p_addr:
+ *							Address (filled).
+ *
+ *	Returns:			int:
+ *							-1	: Unknown label or bad address.
+ *							0	: Success.
+ *
+ *	Globals:
+ *	Notes:			- Must be called after assembly.
+ *	************************************************************************* */
+
+static int resolve(const char *text, long *p_addr)
+{
+	SYMBOL	*p_symbol	= FindLabel((char *) text);
+
+	if (p_symbol != NULL)
+	{
+		*p_addr	= p_symbol->Symbol_Value & 0xFFFF;
+		return (0);
+	}
+
+	if ((parse_number(text, p_addr) == -1) || (*p_addr >= SIM_ADDR_NUM))
+		return (-1);
+
+	return (0);
+}
+
+
+/*	*************************************************************************
+ *	Function name:	get_reg
+ *	Description:	Read an 8-bit register (or "M").
+ *	Author(s):
+ *	Created:			18 October 2026
+ *	Last modified:
+ *
+ *	Parameters:		int r:
+ *							Register (See "R_x").
+ *
+ *	Returns:			int:
+ *							Value.
+ *
+ *	Globals:
+ *	Notes:
+ *	************************************************************************* */
+
+static int get_reg(int r)
+{
+	if (r == R_M)
+		return (sim_mem[get_rp(2)]);
+
+	return (cpu.reg[r]);
+}
+
+
+/*	*************************************************************************
+ *	Function name:	set_reg
+ *	Description:	Write an 8-bit register (or "M").
+ *	Author(s):
+ *	Created:			18 October 2026
+ *	Last modified:
+ *
+ *	Parameters:		int r:
+ *							Register (See "R_x").
+ *
+ *						int value:
+ *							Value.
+ *
+ *	Returns:			void
+ *	Globals:
+ *	Notes:
+ *	************************************************************************* */
+
+static void set_reg(int r, int value)
+{
+	if (r == R_M)
+		sim_mem[get_rp(2)]	= (uint8_t) value;
+	else
+		cpu.reg[r]	= (uint8_t) value;
+}
+
+
+/*	*************************************************************************
+ *	Function name:	get_rp
+ *	Description:	Read a register pair.
+ *	Author(s):
+ *	Created:			18 October 2026
+ *	Last modified:
+ *
+ *	Parameters:		int rp:
+ *							Register pair (0: B, 1: D, 2: H, 3: SP).
+ *
+ *	Returns:			int:
+ *							Value.
+ *
+ *	Globals:
+ *	Notes:
+ *	************************************************************************* */
+
+static int get_rp(int rp)
+{
+	if (rp == 3)
+		return (cpu.sp);
+
+	return ((cpu.reg[rp * 2] << 8) | cpu.reg[(rp * 2) + 1]);
+}
+
+
+/*	*************************************************************************
+ *	Function name:	set_rp
+ *	Description:	Write a register pair.
+ *	Author(s):
+ *	Created:			18 October 2026
+ *	Last modified:
+ *
+ *	Parameters:		int rp:
+ *							Register pair (0: B, 1: D, 2: H, 3: SP).
+ *
+ *						int value:
+ *							Value.
+ *
+ *	Returns:			void
+ *	Globals:
+ *	Notes:
+ *	************************************************************************* */
+
+static void set_rp(int rp, int value)
+{
+	value	&= 0xFFFF;
+
+	if (rp == 3)
+		cpu.sp	= value;
+	else
+	{
+		cpu.reg[rp * 2]			= (uint8_t) (value >> 8);
+		cpu.reg[(rp * 2) + 1]	= (uint8_t) value;
+	}
+}
+
+
+/*	*************************************************************************
+ *	Function name:	set_szp
+ *	Description:	Set sign, zero and parity flags of a result.
+ *	Author(s):
+ *	Created:			18 October 2026
+ *	Last modified:
+ *
+ *	Parameters:		int value:
+ *							Result (8 bits).
+ *
+ *	Returns:			void
+ *	Globals:
+ *	Notes:
+ *	************************************************************************* */
+
+static void set_szp(int value)
+{
+	value			&= 0xFF;
+	cpu.flags	&= ~(F_S | F_Z | F_P);
+
+	if ((value & 0x80) != 0)
+		cpu.flags	|= F_S;
+
+	if (value == 0)
+		cpu.flags	|= F_Z;
+
+	if (parity[value] != 0)
+		cpu.flags	|= F_P;
+}
+
+
+/*	*************************************************************************
+ *	Function name:	push
+ *	Description:	Push a word on the stack.
+ *	Author(s):
+ *	Created:			18 October 2026
+ *	Last modified:
+ *
+ *	Parameters:		int value:
+ *							Word.
+ *
+ *	Returns:			void
+ *	Globals:
+ *	Notes:
+ *	************************************************************************* */
+
+static void push(int value)
+{
+	cpu.sp				= (cpu.sp - 1) & 0xFFFF;
+	sim_mem[cpu.sp]	= (uint8_t) (value >> 8);
+	cpu.sp				= (cpu.sp - 1) & 0xFFFF;
+	sim_mem[cpu.sp]	= (uint8_t) value;
+}
+
+
+/*	*************************************************************************
+ *	Function name:	pop
+ *	Description:	Pop a word from the stack.
+ *	Author(s):
+ *	Created:			18 October 2026
+ *	Last modified:
+ *	Parameters:		void
+ *
+ *	Returns:			int:
+ *							Word.
+ *
+ *	Globals:
+ *	Notes:
+ *	************************************************************************* */
+
+static int pop(void)
+{
+	int	value	= sim_mem[cpu.sp];
+
+	cpu.sp	= (cpu.sp + 1) & 0xFFFF;
+	value		|= sim_mem[cpu.sp] << 8;
+	cpu.sp	= (cpu.sp + 1) & 0xFFFF;
+
+	return (value);
+}
+
+
+/*	*************************************************************************
+ *	Function name:	fetch16
+ *	Description:	Fetch a 16-bit operand.
+ *	Author(s):
+ *	Created:			18 October 2026
+ *	Last modified:
+ *	Parameters:		void
+ *
+ *	Returns:			int:
+ *							Operand.
+ *
+ *	Globals:
+ *	Notes:
+ *	************************************************************************* */
+
+static int fetch16(void)
+{
+	int	value	= sim_mem[cpu.pc] | (sim_mem[(cpu.pc + 1) & 0xFFFF] << 8);
+
+	cpu.pc	= (cpu.pc + 2) & 0xFFFF;
+
+	return (value);
+}
+
+
+/*	*************************************************************************
+ *	Function name:	condition
+ *	Description:	Evaluate a jump, call or return condition.
+ *	Author(s):
+ *	Created:			18 October 2026
+ *	Last modified:
+ *
+ *	Parameters:		int cc:
+ *							Condition field (NZ, Z, NC, C, PO, PE, P, M).
+ *
+ *	Returns:			int:
+ *							1 if condition is true, 0 otherwise.
+ *
+ *	Globals:
+ *	Notes:
+ *	************************************************************************* */
+
+static int condition(int cc)
+{
+	static const uint8_t	flag[4]	= {F_Z, F_CY, F_P, F_S};
+
+	int	set	= ((cpu.flags & flag[cc >> 1]) != 0);
+
+	return (((cc & 1) != 0) ? set : !set);
+}
+
+
+/*	*************************************************************************
+ *	Function name:	alu
+ *	Description:	Arithmetic and logic operation on "A".
+ *	Author(s):
+ *	Created:			18 October 2026
+ *	Last modified:
+ *
+ *	Parameters:		int op:
+ *							Operation field (ADD, ADC, SUB, SBB, ANA, XRA,
+ *							ORA, CMP).
+ *
+ *						int value:
+ *							Operand.
+ *
+ *	Returns:			void
+ *	Globals:
+ *
+ *	Notes:			- Subtraction is an addition of the complement, so
+ *						  "AC" is set as on the 8080.  "CY" is the borrow.
+ *						- "ANA" sets "AC" to the OR of bits 3 of operands.
+ *	************************************************************************* */
+
+static void alu(int op, int value)
+{
+	int	a		= cpu.reg[R_A];
+	int	carry	= ((op == 1) || (op == 3)) ? (cpu.flags & F_CY) : 0;
+	int	result;
+
+
+	switch (op)
+	{
+		/*	ADD, ADC.
+		 *	--------- */
+		case 0:
+		case 1:
+			result		= a + value + carry;
+			cpu.flags	&= ~(F_CY | F_AC);
+
+			if (result > 0xFF)
+				cpu.flags	|= F_CY;
+
+			if (((a & 0x0F) + (value & 0x0F) + carry) > 0x0F)
+				cpu.flags	|= F_AC;
+
+			break;
+
+		/*	SUB, SBB, CMP.
+		 *	-------------- */
+		case 2:
+		case 3:
+		case 7:
+			result		= a - value - carry;
+			cpu.flags	&= ~(F_CY | F_AC);
+
+			if (result < 0)
+				cpu.flags	|= F_CY;
+
+			if (((a & 0x0F) + (~value & 0x0F) + !carry) > 0x0F)
+				cpu.flags	|= F_AC;
+
+			break;
+
+		/*	ANA.
+		 *	---- */
+		case 4:
+			result		= a & value;
+			cpu.flags	&= ~(F_CY | F_AC);
+
+			if (((a | value) & 0x08) != 0)
+				cpu.flags	|= F_AC;
+
+			break;
+
+		/*	XRA, ORA.
+		 *	--------- */
+		default:
+			result		= (op == 5) ? (a ^ value) : (a | value);
+			cpu.flags	&= ~(F_CY | F_AC);
+			break;
+	}
+
+	set_szp(result);
+
+	if (op != 7)
+		cpu.reg[R_A]	= (uint8_t) result;
+}
+
+
+/*	*************************************************************************
+ *	Function name:	step
+ *	Description:	Execute one instruction.
+ *	Author(s):
+ *	Created:			18 October 2026
+ *	Last modified:
+ *	Parameters:		void
+ *
+ *	Returns:			int:
+ *							- Number of cycles.
+ *							- (-1) if it is not an opcode.
+ *
+ *	Globals:
+ *
+ *	Notes:			- Cycles come from "opcode_decode()" (same as "-P"
+ *						  option): Not taken / taken for conditional
+ *						  instructions.
+ *						- "HLT" set "halt".  "PC" stays on it.
+ *	************************************************************************* */
+
+static int step(void)
+{
+	int		op		= sim_mem[cpu.pc];
+	int		taken	= 0;
+	int		value;
+	int		port;
+	uint8_t	cyc[2];
+
+
+	if (opcode_decode(op, cyc) == NULL)
+		return (-1);
+
+	if (op == 0x76)
+	{
+		cpu.halt	= 1;
+		return (cyc[0]);
+	}
+
+	cpu.pc	= (cpu.pc + 1) & 0xFFFF;
+
+	/*	"MOV r1,r2".
+	 *	------------ */
+	if ((op & 0xC0) == 0x40)
+	{
+		set_reg((op >> 3) & 7, get_reg(op & 7));
+		return (cyc[0]);
+	}
+
+	/*	"ADD r" ... "CMP r".
+	 *	-------------------- */
+	if ((op & 0xC0) == 0x80)
+	{
+		alu((op >> 3) & 7, get_reg(op & 7));
+		return (cyc[0]);
+	}
+
+	switch (op & 0xC7)
+	{
+		/*	"INR r".
+		 *	-------- */
+		case 0x04:
+			value			= (get_reg((op >> 3) & 7) + 1) & 0xFF;
+			cpu.flags	&= ~F_AC;
+
+			if ((value & 0x0F) == 0)
+				cpu.flags	|= F_AC;
+
+			set_reg((op >> 3) & 7, value);
+			set_szp(value);
+			return (cyc[0]);
+
+		/*	"DCR r".
+		 *	-------- */
+		case 0x05:
+			value			= (get_reg((op >> 3) & 7) - 1) & 0xFF;
+			cpu.flags	&= ~F_AC;
+
+			if ((value & 0x0F) != 0x0F)
+				cpu.flags	|= F_AC;
+
+			set_reg((op >> 3) & 7, value);
+			set_szp(value);
+			return (cyc[0]);
+
+		/*	"MVI r,data".
+		 *	------------- */
+		case 0x06:
+			set_reg((op >> 3) & 7, sim_mem[cpu.pc]);
+			cpu.pc	= (cpu.pc + 1) & 0xFFFF;
+			return (cyc[0]);
+
+		/*	"ADI data" ... "CPI data".
+		 *	-------------------------- */
+		case 0xC6:
+			alu((op >> 3) & 7, sim_mem[cpu.pc]);
+			cpu.pc	= (cpu.pc + 1) & 0xFFFF;
+			return (cyc[0]);
+
+		/*	"Rcc".
+		 *	------ */
+		case 0xC0:
+			if ((taken = condition((op >> 3) & 7)) != 0)
+				cpu.pc	= pop();
+
+			return (cyc[taken]);
+
+		/*	"Jcc".
+		 *	------ */
+		case 0xC2:
+			value	= fetch16();
+
+			if ((taken = condition((op >> 3) & 7)) != 0)
+				cpu.pc	= value;
+
+			return (cyc[taken]);
+
+		/*	"Ccc".
+		 *	------ */
+		case 0xC4:
+			value	= fetch16();
+
+			if ((taken = condition((op >> 3) & 7)) != 0)
+			{
+				push(cpu.pc);
+				cpu.pc	= value;
+			}
+
+			return (cyc[taken]);
+
+		/*	"RST n".
+		 *	-------- */
+		case 0xC7:
+			push(cpu.pc);
+			cpu.pc	= op & 0x38;
+			return (cyc[0]);
+
+		default:
+			break;
+	}
+
+	switch (op & 0xCF)
+	{
+		/*	"LXI rp,data".
+		 *	-------------- */
+		case 0x01:
+			set_rp((op >> 4) & 3, fetch16());
+			return (cyc[0]);
+
+		/*	"INX rp".
+		 *	--------- */
+		case 0x03:
+			set_rp((op >> 4) & 3, get_rp((op >> 4) & 3) + 1);
+			return (cyc[0]);
+
+		/*	"DAD rp".
+		 *	--------- */
+		case 0x09:
+			value			= get_rp(2) + get_rp((op >> 4) & 3);
+			cpu.flags	&= ~F_CY;
+
+			if (value > 0xFFFF)
+				cpu.flags	|= F_CY;
+
+			set_rp(2, value);
+			return (cyc[0]);
+
+		/*	"DCX rp".
+		 *	--------- */
+		case 0x0B:
+			set_rp((op >> 4) & 3, get_rp((op >> 4) & 3) - 1);
+			return (cyc[0]);
+
+		/*	"POP rp".
+		 *	--------- */
+		case 0xC1:
+			value	= pop();
+
+			if (op == 0xF1)
+			{
+				cpu.reg[R_A]	= (uint8_t) (value >> 8);
+				cpu.flags		= (uint8_t) ((value & (F_S | F_Z | F_AC | F_P | F_CY)) | F_ONE);
+			}
+			else
+				set_rp((op >> 4) & 3, value);
+
+			return (cyc[0]);
+
+		/*	"PUSH rp".
+		 *	---------- */
+		case 0xC5:
+			if (op == 0xF5)
+				push((cpu.reg[R_A] << 8) | cpu.flags);
+			else
+				push(get_rp((op >> 4) & 3));
+
+			return (cyc[0]);
+
+		default:
+			break;
+	}
+
+	switch (op)
+	{
+		case 0x00:		/*	NOP */
+			break;
+
+		case 0x02:		/*	STAX B */
+		case 0x12:		/*	STAX D */
+			sim_mem[get_rp(op >> 4)]	= cpu.reg[R_A];
+			break;
+
+		case 0x0A:		/*	LDAX B */
+		case 0x1A:		/*	LDAX D */
+			cpu.reg[R_A]	= sim_mem[get_rp(op >> 4)];
+			break;
+
+		case 0x22:		/*	SHLD */
+			value								= fetch16();
+			sim_mem[value]					= cpu.reg[R_L];
+			sim_mem[(value + 1) & 0xFFFF]	= cpu.reg[R_H];
+			break;
+
+		case 0x2A:		/*	LHLD */
+			value				= fetch16();
+			cpu.reg[R_L]	= sim_mem[value];
+			cpu.reg[R_H]	= sim_mem[(value + 1) & 0xFFFF];
+			break;
+
+		case 0x32:		/*	STA */
+			sim_mem[fetch16()]	= cpu.reg[R_A];
+			break;
+
+		case 0x3A:		/*	LDA */
+			cpu.reg[R_A]	= sim_mem[fetch16()];
+			break;
+
+		case 0x07:		/*	RLC */
+			value				= cpu.reg[R_A] >> 7;
+			cpu.reg[R_A]	= (uint8_t) ((cpu.reg[R_A] << 1) | value);
+			cpu.flags		= (cpu.flags & ~F_CY) | value;
+			break;
+
+		case 0x0F:		/*	RRC */
+			value				= cpu.reg[R_A] & 1;
+			cpu.reg[R_A]	= (uint8_t) ((cpu.reg[R_A] >> 1) | (value << 7));
+			cpu.flags		= (cpu.flags & ~F_CY) | value;
+			break;
+
+		case 0x17:		/*	RAL */
+			value				= cpu.reg[R_A] >> 7;
+			cpu.reg[R_A]	= (uint8_t) ((cpu.reg[R_A] << 1) | (cpu.flags & F_CY));
+			cpu.flags		= (cpu.flags & ~F_CY) | value;
+			break;
+
+		case 0x1F:		/*	RAR */
+			value				= cpu.reg[R_A] & 1;
+			cpu.reg[R_A]	= (uint8_t) ((cpu.reg[R_A] >> 1) | ((cpu.flags & F_CY) << 7));
+			cpu.flags		= (cpu.flags & ~F_CY) | value;
+			break;
+
+		case 0x27:		/*	DAA */
+		{
+			int	a			= cpu.reg[R_A];
+			int	adjust	= 0;
+			int	carry		= cpu.flags & F_CY;
+
+			if (((a & 0x0F) > 9) || ((cpu.flags & F_AC) != 0))
+				adjust	|= 0x06;
+
+			if ((a > 0x99) || (carry != 0))
+			{
+				adjust	|= 0x60;
+				carry		= F_CY;
+			}
+
+			cpu.flags	&= ~(F_AC | F_CY);
+
+			if (((a & 0x0F) + (adjust & 0x0F)) > 0x0F)
+				cpu.flags	|= F_AC;
+
+			cpu.reg[R_A]	= (uint8_t) (a + adjust);
+			cpu.flags		|= carry;
+			set_szp(cpu.reg[R_A]);
+			break;
+		}
+
+		case 0x2F:		/*	CMA */
+			cpu.reg[R_A]	= (uint8_t) ~cpu.reg[R_A];
+			break;
+
+		case 0x37:		/*	STC */
+			cpu.flags	|= F_CY;
+			break;
+
+		case 0x3F:		/*	CMC */
+			cpu.flags	^= F_CY;
+			break;
+
+		case 0xC3:		/*	JMP */
+			cpu.pc	= fetch16();
+			break;
+
+		case 0xC9:		/*	RET */
+			cpu.pc	= pop();
+			break;
+
+		case 0xCD:		/*	CALL */
+			value	= fetch16();
+			push(cpu.pc);
+			cpu.pc	= value;
+			break;
+
+		case 0xD3:		/*	OUT */
+			port		= sim_mem[cpu.pc];
+			cpu.pc	= (cpu.pc + 1) & 0xFFFF;
+
+			if (sim_port[port] != SIM_NO_PORT)
+				sim_mem[sim_port[port]]	= cpu.reg[R_A];
+
+			break;
+
+		case 0xDB:		/*	IN */
+			port		= sim_mem[cpu.pc];
+			cpu.pc	= (cpu.pc + 1) & 0xFFFF;
+
+			cpu.reg[R_A]	= (sim_port[port] != SIM_NO_PORT) ?
+			  						sim_mem[sim_port[port]] : SIM_PORT_IDLE;
+			break;
+
+		case 0xE3:		/*	XTHL */
+			value	= sim_mem[cpu.sp] | (sim_mem[(cpu.sp + 1) & 0xFFFF] << 8);
+
+			sim_mem[cpu.sp]					= cpu.reg[R_L];
+			sim_mem[(cpu.sp + 1) & 0xFFFF]	= cpu.reg[R_H];
+			set_rp(2, value);
+			break;
+
+		case 0xE9:		/*	PCHL */
+			cpu.pc	= get_rp(2);
+			break;
+
+		case 0xEB:		/*	XCHG */
+			value	= get_rp(1);
+			set_rp(1, get_rp(2));
+			set_rp(2, value);
+			break;
+
+		case 0xF3:		/*	DI */
+			cpu.inte	= 0;
+			break;
+
+		case 0xF9:		/*	SPHL */
+			cpu.sp	= get_rp(2);
+			break;
+
+		case 0xFB:		/*	EI */
+			cpu.inte	= 1;
+			break;
+
+		default:
+			return (-1);
+	}
+
+	return (cyc[0]);
+}
+
+
+/*	*************************************************************************
+ *	Function name:	run
+ *	Description:	Run the program.
+ *	Author(s):
+ *	Created:			18 October 2026
+ *	Last modified:
+ *
+ *	Parameters:		int start:
+ *							Start address.
+ *
+ *	Returns:			enum sim_stop_t:
+ *							Why the program stopped.
+ *
+ *	Globals:			char Image[]
+ *
+ *	Notes:			- Memory is a copy of "Image[]".  Registers are 0,
+ *						  so the stack is at the top of memory.
+ *	************************************************************************* */
+
+static enum sim_stop_t run(int start)
+{
+	int	addr;
+	int	cyc;
+	int	i;
+
+
+	for (i = 0; i < 256; i++)
+	{
+		int	n	= i;
+		int	p	= 1;
+
+		while (n != 0)
+		{
+			p	^= n & 1;
+			n	>>= 1;
+		}
+
+		parity[i]	= (uint8_t) p;
+	}
+
+	memcpy(sim_mem, Image, SIM_ADDR_NUM);
+	memset(&cpu, 0, sizeof (cpu));
+
+	cpu.flags	= F_ONE;
+	cpu.pc		= start & 0xFFFF;
+
+	total_count		= 0;
+	total_cycles	= 0;
+
+	while (total_cycles < sim_limit)
+	{
+		addr	= cpu.pc;
+
+		if ((cyc = step()) < 0)
+			return (SS_OPCODE);
+
+		sim_count[addr]++;
+		sim_cycles[addr]	+= cyc;
+		total_count++;
+		total_cycles		+= cyc;
+
+		if (cpu.halt != 0)
+			return (SS_HLT);
+	}
+
+	return (SS_CYCLES);
+}
+
+
+/*	*************************************************************************
+ *	Function name:	entry_compare
+ *	Description:	Compare two profile entries by name, then address
+ *						("qsort()").
+ *	Author(s):
+ *	Created:			18 October 2026
+ *	Last modified:
+ *
+ *	Parameters:		const void *p_a:
+ *							...
+ *
+ *						const void *p_b:
+ *							...
+ *
+ *	Returns:			int:
+ *							...
+ *
+ *	Globals:
+ *	Notes:			- NULL name is first.
+ *	************************************************************************* */
+
+static int entry_compare(const void *p_a, const void *p_b)
+{
+	const struct sim_entry_t	*p_ea	= (const struct sim_entry_t *) p_a;
+	const struct sim_entry_t	*p_eb	= (const struct sim_entry_t *) p_b;
+	int								n;
+
+
+	if (p_ea->name != p_eb->name)
+	{
+		if (p_ea->name == NULL)
+			return (-1);
+
+		if (p_eb->name == NULL)
+			return (1);
+
+		if ((n = strcmp(p_ea->name, p_eb->name)) != 0)
+			return (n);
+	}
+
+	return (p_ea->addr - p_eb->addr);
+}
+
+
+/*	*************************************************************************
+ *	Function name:	addr_compare
+ *	Description:	Compare two profile entries by address, then name
+ *						("qsort()").
+ *	Author(s):
+ *	Created:			18 October 2026
+ *	Last modified:
+ *
+ *	Parameters:		const void *p_a:
+ *							...
+ *
+ *						const void *p_b:
+ *							...
+ *
+ *	Returns:			int:
+ *							...
+ *
+ *	Globals:
+ *	Notes:
+ *	************************************************************************* */
+
+static int addr_compare(const void *p_a, const void *p_b)
+{
+	const struct sim_entry_t	*p_ea	= (const struct sim_entry_t *) p_a;
+	const struct sim_entry_t	*p_eb	= (const struct sim_entry_t *) p_b;
+
+
+	if (p_ea->addr != p_eb->addr)
+		return (p_ea->addr - p_eb->addr);
+
+	return (entry_compare(p_a, p_b));
+}
+
+
+/*	*************************************************************************
+ *	Function name:	cycles_compare
+ *	Description:	Compare two profile entries by decreasing cycles
+ *						("qsort()").
+ *	Author(s):
+ *	Created:			18 October 2026
+ *	Last modified:
+ *
+ *	Parameters:		const void *p_a:
+ *							...
+ *
+ *						const void *p_b:
+ *							...
+ *
+ *	Returns:			int:
+ *							...
+ *
+ *	Globals:
+ *	Notes:			- Same cycles are in name, then address order.
+ *	************************************************************************* */
+
+static int cycles_compare(const void *p_a, const void *p_b)
+{
+	const struct sim_entry_t	*p_ea	= (const struct sim_entry_t *) p_a;
+	const struct sim_entry_t	*p_eb	= (const struct sim_entry_t *) p_b;
+
+
+	if (p_ea->cycles != p_eb->cycles)
+		return ((p_ea->cycles < p_eb->cycles) ? 1 : -1);
+
+	return (entry_compare(p_a, p_b));
+}
+
+
+/*	*************************************************************************
+ *	Function name:	print_entries
+ *	Description:	Print the executed entries, hottest first.
+ *	Author(s):
+ *	Created:			18 October 2026
+ *	Last modified:
+ *
+ *	Parameters:		FILE *fp:
+ *							Report file.
+ *
+ *						struct sim_entry_t *p_entry:
+ *							Entries (sorted by this function).
+ *
+ *						int num:
+ *							Number of entries.
+ *
+ *						int labels:
+ *							1 for labels, 0 for source lines.
+ *
+ *	Returns:			void
+ *	Globals:
+ *	Notes:
+ *	************************************************************************* */
+
+static void print_entries(FILE *fp, struct sim_entry_t *p_entry, int num, int labels)
+{
+	char	buf[LABEL_SIZE_MAX + 16];
+	int	i;
+
+
+	qsort(p_entry, (size_t) num, sizeof (struct sim_entry_t), cycles_compare);
+
+	fprintf(fp, "\n");
+
+	if (labels != 0)
+	{
+		fprintf(fp, "%-31s %-7s %14s %14s %7s\n", "Label", "Address", "Instructions", "Cycles", "%");
+		fprintf(fp, "%-31s %-7s %14s %14s %7s\n", "-----", "-------", "------------", "------", "-");
+	}
+	else
+	{
+		fprintf(fp, "%-39s %14s %14s %7s\n", "Source line", "Instructions", "Cycles", "%");
+		fprintf(fp, "%-39s %14s %14s %7s\n", "-----------", "------------", "------", "-");
+	}
+
+	for (i = 0; (i < num) && (p_entry[i].count > 0); i++)
+	{
+		double	percent	= (total_cycles > 0) ?
+			  						(100.0 * p_entry[i].cycles) / total_cycles : 0;
+
+		if (labels != 0)
+		{
+			fprintf(	fp, "%-31.*s %04Xh   ", LABEL_SIZE_MAX,
+						(p_entry[i].name != NULL) ? p_entry[i].name : "(no label)",
+						p_entry[i].addr);
+		}
+		else
+		{
+			sprintf(	buf, "\"%.*s\" @%d", LABEL_SIZE_MAX,
+						(p_entry[i].name != NULL) ? p_entry[i].name : "?", p_entry[i].addr);
+
+			fprintf(fp, "%-39s ", buf);
+		}
+
+		fprintf(fp, "%14lld %14lld %7.2f\n", p_entry[i].count, p_entry[i].cycles, percent);
+	}
+}
+
+
+/*	*************************************************************************
+ *	Function name:	profile_labels
+ *	Description:	Print the profile by label.
+ *	Author(s):
+ *	Created:			18 October 2026
+ *	Last modified:
+ *
+ *	Parameters:		FILE *fp:
+ *							Report file.
+ *
+ *	Returns:			void
+ *	Globals:			SYMBOL *Symbols
+ *
+ *	Notes:			- An address belongs to the closest label before
+ *						  it.  Of labels with the same value, the last one
+ *						  (in name order) get the addresses.
+ *	************************************************************************* */
+
+static void profile_labels(FILE *fp)
+{
+	struct sim_entry_t	*p_entry;
+	SYMBOL					*local;
+	int						num		= 1;
+	int						addr;
+	int						end;
+	int						i;
+
+
+	for (local = Symbols; (local != NULL) && (local->next != NULL); local = (SYMBOL *) local->next)
+	{
+		if (local->Symbol_Type == SYMBOL_LABEL)
+			num++;
+	}
+
+	p_entry	= (struct sim_entry_t *) mem_calloc(MT_SIM, num, sizeof (struct sim_entry_t));
+
+	if (p_entry == NULL)
+	{
+		fprintf(stderr, "*** Error %d: Can't allocate memory!\n", EC_CAM);
+		return;
+	}
+
+	/*	First entry: Addresses before any label.
+	 *	---------------------------------------- */
+	num	= 1;
+
+	for (local = Symbols; (local != NULL) && (local->next != NULL); local = (SYMBOL *) local->next)
+	{
+		if (local->Symbol_Type == SYMBOL_LABEL)
+		{
+			p_entry[num].name	= local->Symbol_Name;
+			p_entry[num].addr	= local->Symbol_Value & 0xFFFF;
+			num++;
+		}
+	}
+
+	/*	Sort by address, then add addresses up to the next label.
+	 *	--------------------------------------------------------- */
+	if (num > 2)
+		qsort(p_entry + 1, (size_t) (num - 1), sizeof (struct sim_entry_t), addr_compare);
+
+	for (i = 0; i < num; i++)
+	{
+		end	= (i + 1 < num) ? p_entry[i + 1].addr : SIM_ADDR_NUM;
+
+		for (addr = p_entry[i].addr; addr < end; addr++)
+		{
+			p_entry[i].count	+= sim_count[addr];
+			p_entry[i].cycles	+= sim_cycles[addr];
+		}
+	}
+
+	print_entries(fp, p_entry, num, 1);
+
+	mem_free(p_entry);
+}
+
+
+/*	*************************************************************************
+ *	Function name:	profile_lines
+ *	Description:	Print the profile by source line.
+ *	Author(s):
+ *	Created:			18 October 2026
+ *	Last modified:
+ *
+ *	Parameters:		FILE *fp:
+ *							Report file.
+ *
+ *	Returns:			void
+ *	Globals:
+ *
+ *	Notes:			- Source lines of opcodes are recorded by the cycles
+ *						  analysis ("cycles_source()").  Addresses executed
+ *						  that are not opcodes are shown as "?".
+ *	************************************************************************* */
+
+static void profile_lines(FILE *fp)
+{
+	struct sim_entry_t	*p_entry;
+	int						num	= 0;
+	int						addr;
+	int						i;
+	int						j;
+
+
+	for (addr = 0; addr < SIM_ADDR_NUM; addr++)
+	{
+		if (sim_count[addr] > 0)
+			num++;
+	}
+
+	if (num == 0)
+		return;
+
+	p_entry	= (struct sim_entry_t *) mem_calloc(MT_SIM, num, sizeof (struct sim_entry_t));
+
+	if (p_entry == NULL)
+	{
+		fprintf(stderr, "*** Error %d: Can't allocate memory!\n", EC_CAM);
+		return;
+	}
+
+	for (num = 0, addr = 0; addr < SIM_ADDR_NUM; addr++)
+	{
+		if (sim_count[addr] == 0)
+			continue;
+
+		p_entry[num].name		= cycles_source(addr, &p_entry[num].addr);
+		p_entry[num].count	= sim_count[addr];
+		p_entry[num].cycles	= sim_cycles[addr];
+
+		if (p_entry[num].name == NULL)
+			p_entry[num].addr	= 0;
+
+		num++;
+	}
+
+	/*	- Merge addresses of the same line (a line can hold more than
+	 *	  one opcode, when it calls a macro).
+	 *	------------------------------------------------------------- */
+	qsort(p_entry, (size_t) num, sizeof (struct sim_entry_t), entry_compare);
+
+	for (i = 0, j = 1; j < num; j++)
+	{
+		if (entry_compare(&p_entry[i], &p_entry[j]) == 0)
+		{
+			p_entry[i].count	+= p_entry[j].count;
+			p_entry[i].cycles	+= p_entry[j].cycles;
+		}
+		else
+			p_entry[++i]	= p_entry[j];
+	}
+
+	print_entries(fp, p_entry, i + 1, 0);
+
+	mem_free(p_entry);
+}
+
+
+/*	*************************************************************************
+ *	Function name:	sim_option
+ *	Description:	Set the "--run" option.
+ *	Author(s):
+ *	Created:			18 October 2026
+ *	Last modified:
+ *
+ *	Parameters:		const char *spec:
+ *							"<start>[,<max cycles>]".  <start> is a label
+ *							or an address.
+ *
+ *	Returns:			int:
+ *							-2	: Bad cycles limit.
+ *							-1	: Memory allocation error.
+ *							0	: Success.
+ *
+ *	Globals:			int sim_enable
+ *
+ *	Notes:			- Start label is looked up after assembly.
+ *						- Source lines come from the cycles analysis, so
+ *						  it is enabled.
+ *	************************************************************************* */
+
+int sim_option(const char *spec)
+{
+	const char	*p_comma	= strchr(spec, ',');
+	size_t		len		= (p_comma != NULL) ? (size_t) (p_comma - spec) : strlen(spec);
+	long			limit;
+
+
+	if (p_comma != NULL)
+	{
+		if ((parse_number(p_comma + 1, &limit) == -1) || (limit < 1))
+			return (-2);
+
+		sim_limit	= limit;
+	}
+
+	if (cycles_init() == -1)
+		return (-1);
+
+	mem_free(sim_start);
+
+	if ((sim_start = (char *) mem_alloc(MT_OPTIONS, len + 1)) == NULL)
+		return (-1);
+
+	memcpy(sim_start, spec, len);
+	sim_start[len]	= '\0';
+
+	sim_enable	= 1;
+
+	return (0);
+}
+
+
+/*	*************************************************************************
+ *	Function name:	sim_io_option
+ *	Description:	Add a "--run-io" option (memory-mapped I/O port).
+ *	Author(s):
+ *	Created:			18 October 2026
+ *	Last modified:
+ *
+ *	Parameters:		const char *spec:
+ *							"<port>,<address>".  <address> is a label or
+ *							a number.
+ *
+ *	Returns:			int:
+ *							-2	: Bad port.
+ *							-1	: Memory allocation error.
+ *							0	: Success.
+ *
+ *	Globals:
+ *
+ *	Notes:			- "IN <port>" read the byte at <address>, and
+ *						  "OUT <port>" write it.
+ *						- <address> is looked up after assembly.
+ *	************************************************************************* */
+
+int sim_io_option(const char *spec)
+{
+	const char	*p_comma	= strchr(spec, ',');
+	char			buf[16];
+	long			port;
+
+
+	if ((p_comma == NULL) || (p_comma[1] == '\0') || ((size_t) (p_comma - spec) >= sizeof (buf)))
+		return (-2);
+
+	memcpy(buf, spec, (size_t) (p_comma - spec));
+	buf[p_comma - spec]	= '\0';
+
+	if ((parse_number(buf, &port) == -1) || (port >= SIM_PORT_NUM))
+		return (-2);
+
+	mem_free(port_text[port]);
+
+	if ((port_text[port] = (char *) mem_alloc(MT_OPTIONS, strlen(p_comma))) == NULL)
+		return (-1);
+
+	strcpy(port_text[port], p_comma + 1);
+
+	return (0);
+}
+
+
+/*	*************************************************************************
+ *	Function name:	sim_report
+ *	Description:	Run the program, and print its execution profile.
+ *	Author(s):
+ *	Created:			18 October 2026
+ *	Last modified:
+ *
+ *	Parameters:		FILE *fp:
+ *							Report file.
+ *
+ *	Returns:			void
+ *	Globals:
+ *	Notes:			- Must be called after assembler pass #2.
+ *	************************************************************************* */
+
+void sim_report(FILE *fp)
+{
+	static const char	*stop_text[]	=
+	{
+		"\"HLT\"", "cycles limit", "not an opcode"
+	};
+
+	enum sim_stop_t	stop;
+	long					start;
+	long					addr;
+	int					port;
+
+
+	if (sim_enable == 0)
+		return;
+
+	/*	Start address, and I/O ports addresses.
+	 *	--------------------------------------- */
+	if (resolve(sim_start, &start) == -1)
+	{
+		fprintf(	stderr, "*** Error %d: Bad \"--run\" start address (\"%s\")!\n",
+					EC_BRO, sim_start);
+
+		return;
+	}
+
+	for (port = 0; port < SIM_PORT_NUM; port++)
+	{
+		sim_port[port]	= SIM_NO_PORT;
+
+		if (port_text[port] == NULL)
+			continue;
+
+		if (resolve(port_text[port], &addr) == -1)
+		{
+			fprintf(	stderr, "*** Error %d: Bad \"--run-io\" address (\"%s\")!\n",
+						EC_BRIO, port_text[port]);
+		}
+		else
+			sim_port[port]	= (int) addr;
+	}
+
+	sim_mem		= (uint8_t *) mem_alloc(MT_SIM, SIM_ADDR_NUM);
+	sim_count	= (long long *) mem_calloc(MT_SIM, SIM_ADDR_NUM, sizeof (long long));
+	sim_cycles	= (long long *) mem_calloc(MT_SIM, SIM_ADDR_NUM, sizeof (long long));
+
+	if ((sim_mem == NULL) || (sim_count == NULL) || (sim_cycles == NULL))
+	{
+		fprintf(stderr, "*** Error %d: Can't allocate memory!\n", EC_CAM);
+		return;
+	}
+
+	stop	= run((int) start);
+
+	fprintf(fp, "\n\n");
+	fprintf(fp, "*******************************************************************************\n");
+	fprintf(fp, "                               Execution profile\n");
+	fprintf(fp, "*******************************************************************************\n");
+	fprintf(fp, "\n");
+	fprintf(	fp, "Start at %04Xh, stop (%s) at %04Xh.\n", (int) start,
+				stop_text[stop], cpu.pc);
+	fprintf(	fp, "%lld instruction%s, %lld cycle%s.\n",
+				total_count, (total_count != 1) ? "s" : "",
+				total_cycles, (total_cycles != 1) ? "s" : "");
+	fprintf(	fp, "A=%02Xh BC=%04Xh DE=%04Xh HL=%04Xh SP=%04Xh PSW=%02Xh\n",
+				cpu.reg[R_A], get_rp(0), get_rp(1), get_rp(2), cpu.sp, cpu.flags);
+
+	profile_labels(fp);
+	profile_lines(fp);
+}
+
+
+/*	*************************************************************************
+ *	Function name:	sim_cleanup
+ *	Description:	Release module memory.
+ *	Author(s):
+ *	Created:			18 October 2026
+ *	Last modified:
+ *	Parameters:		void
+ *	Returns:			void
+ *	Globals:
+ *	Notes:
+ *	************************************************************************* */
+
+void sim_cleanup(void)
+{
+	int	port;
+
+	for (port = 0; port < SIM_PORT_NUM; port++)
+	{
+		mem_free(port_text[port]);
+		port_text[port]	= NULL;
+	}
+
+	mem_free(sim_start);
+	mem_free(sim_mem);
+	mem_free(sim_count);
+	mem_free(sim_cycles);
+
+	sim_start	= NULL;
+	sim_mem		= NULL;
+	sim_count	= NULL;
+	sim_cycles	= NULL;
+	sim_limit	= SIM_CYCLES_DEFAULT;
+	sim_enable	= 0;
+}
+
+
+
@@ -0,0 +1,320 @@
+/*	*************************************************************************
+ *	Module Name:	stats.c
+ *	Description:	Assembler Statistics ("--stats" option).
+ *	Copyright(c):	See below...
+ *	Author(s):
+ *	Created:			18 October 2026
+ *	Last modified:
+ *
+ *	Notes:			- Counters and timers may be updated by the threads
+ *						  of the parallel assembler pass #2.  So, they are
+ *						  updated atomically.
+ *						- Pass timers use the process CPU time (all
+ *						  threads).  Other timers use the CPU time of the
+ *						  calling thread, since they are nested inside pass
+ *						  #2, and may run concurrently.
+ *	************************************************************************* */
+
+/*
+ * Copyright (c) <2007-2017> Jay Cotton <lbmgmusic@gmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+
+
+/*	*************************************************************************
+ *	                              INCLUDE FILES
+ *	************************************************************************* */
+
+#include <stdio.h>
+#include <time.h>
+
+#include "project.h"
+#include "stats.h"
+
+
+/*	*************************************************************************
+ *											  CONSTANTS
+ *	************************************************************************* */
+
+/*	Atomic addition.
+ *	*/
+#if USE_PTHREAD
+#define STATS_ATOMIC_ADD(var, n)		__sync_fetch_and_add(&(var), (n))
+#else
+#define STATS_ATOMIC_ADD(var, n)		((var) += (n))
+#endif
+
+
+/*	*************************************************************************
+ *	                                VARIABLES
+ *	************************************************************************* */
+
+/*	Public variables.
+ *	***************** */
+
+int	stats_enable	= 0;
+
+
+/*	Private variables.
+ *	****************** */
+
+static long long	stats_counter[SC_COUNTERS];
+static long long	stats_wall[ST_TIMERS];
+static long long	stats_cpu[ST_TIMERS];
+
+static const char	*stats_timer_name[ST_TIMERS]	=
+{
+	"Pass #1", "Pass #2", "HEX writing", "Binary writing", "Listing"
+};
+
+
+/*	*************************************************************************
+ *									  FUNCTIONS DECLARATION
+ *	************************************************************************* */
+
+static void stats_now(enum stats_timer_t timer, struct stats_clock_t *p_clock);
+
+
+/*	*************************************************************************
+ *	                                FUNCTIONS
+ *	************************************************************************* */
+
+/*	*************************************************************************
+ *	Function name:	stats_now
+ *	Description:	Read wall and CPU clocks.
+ *	Author(s):
+ *	Created:			18 October 2026
+ *	Last modified:
+ *
+ *	Parameters:		enum stats_timer_t timer:
+ *							Timer the clocks are read for.
+ *
+ *						struct stats_clock_t *p_clock:
+ *							Point to a structure that receive the clocks.
+ *
+ *	Returns:			void
+ *	Globals:
+ *	Notes:			- Without POSIX clocks, "clock()" is used for both.
+ *	************************************************************************* */
+
+static void stats_now(enum stats_timer_t timer, struct stats_clock_t *p_clock)
+{
+#if USE_PTHREAD
+	struct timespec	ts;
+
+	p_clock->wall	= stats_time();
+
+	clock_gettime(	(timer <= ST_PASS2) ?
+		  				CLOCK_PROCESS_CPUTIME_ID : CLOCK_THREAD_CPUTIME_ID, &ts);
+
+	p_clock->cpu	= ((long long) ts.tv_sec * 1000000000LL) + ts.tv_nsec;
+#else
+	(void) timer;
+
+	p_clock->wall	= ((long long) clock() * 1000000000LL) / CLOCKS_PER_SEC;
+	p_clock->cpu	= p_clock->wall;
+#endif
+}
+
+
+/*	*************************************************************************
+ *	Function name:	stats_time
+ *	Description:	Read wall clock.
+ *	Author(s):
+ *	Created:			18 October 2026
+ *	Last modified:
+ *	Parameters:		void
+ *
+ *	Returns:			long long:
+ *							Wall time (ns), from an arbitrary origin.
+ *
+ *	Globals:
+ *	Notes:			- Without POSIX clocks, "clock()" is used.
+ *	************************************************************************* */
+
+long long stats_time(void)
+{
+#if USE_PTHREAD
+	struct timespec	ts;
+
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+
+	return (((long long) ts.tv_sec * 1000000000LL) + ts.tv_nsec);
+#else
+	return (((long long) clock() * 1000000000LL) / CLOCKS_PER_SEC);
+#endif
+}
+
+
+/*	*************************************************************************
+ *	Function name:	stats_get
+ *	Description:	Get a counter.
+ *	Author(s):
+ *	Created:			18 October 2026
+ *	Last modified:
+ *
+ *	Parameters:		enum stats_counter_t counter:
+ *							Counter.
+ *
+ *	Returns:			long long:
+ *							Counter value.
+ *
+ *	Globals:
+ *	Notes:
+ *	************************************************************************* */
+
+long long stats_get(enum stats_counter_t counter)
+{
+	return (stats_counter[counter]);
+}
+
+
+/*	*************************************************************************
+ *	Function name:	stats_add
+ *	Description:	Add to a counter.
+ *	Author(s):
+ *	Created:			18 October 2026
+ *	Last modified:
+ *
+ *	Parameters:		enum stats_counter_t counter:
+ *							Counter.
+ *
+ *						long n:
+ *							Value to add.
+ *
+ *	Returns:			void
+ *	Globals:
+ *	Notes:			- Use "STATS_COUNT()", that check "stats_enable".
+ *	************************************************************************* */
+
+void stats_add(enum stats_counter_t counter, long n)
+{
+	STATS_ATOMIC_ADD(stats_counter[counter], (long long) n);
+}
+
+
+/*	*************************************************************************
+ *	Function name:	stats_start
+ *	Description:	Start a timed phase.
+ *	Author(s):
+ *	Created:			18 October 2026
+ *	Last modified:
+ *
+ *	Parameters:		enum stats_timer_t timer:
+ *							Phase.
+ *
+ *						struct stats_clock_t *p_clock:
+ *							Point to a structure that receive the start time.
+ *
+ *	Returns:			void
+ *	Globals:
+ *	Notes:			- Do nothing if statistics are disabled.
+ *	************************************************************************* */
+
+void stats_start(enum stats_timer_t timer, struct stats_clock_t *p_clock)
+{
+	if (stats_enable)
+		stats_now(timer, p_clock);
+}
+
+
+/*	*************************************************************************
+ *	Function name:	stats_stop
+ *	Description:	End a timed phase.
+ *	Author(s):
+ *	Created:			18 October 2026
+ *	Last modified:
+ *
+ *	Parameters:		enum stats_timer_t timer:
+ *							Phase.
+ *
+ *						struct stats_clock_t *p_clock:
+ *							Point to the start time (see "stats_start()").
+ *
+ *	Returns:			void
+ *	Globals:
+ *	Notes:			- Time of all the occurences of a phase is summed.
+ *	************************************************************************* */
+
+void stats_stop(enum stats_timer_t timer, struct stats_clock_t *p_clock)
+{
+	struct stats_clock_t	now;
+
+	if (stats_enable == 0)
+		return;
+
+	stats_now(timer, &now);
+
+	STATS_ATOMIC_ADD(stats_wall[timer], now.wall - p_clock->wall);
+	STATS_ATOMIC_ADD(stats_cpu[timer], now.cpu - p_clock->cpu);
+}
+
+
+/*	*************************************************************************
+ *	Function name:	stats_print
+ *	Description:	Print statistics.
+ *	Author(s):
+ *	Created:			18 October 2026
+ *	Last modified:
+ *	Parameters:		void
+ *	Returns:			void
+ *	Globals:
+ *
+ *	Notes:			- "HEX writing" and "Listing" happen during pass #2,
+ *						  and are included in its time.
+ *	************************************************************************* */
+
+void stats_print(void)
+{
+	long long	find	= stats_counter[SC_FIND_LABEL];
+	int			i;
+
+
+	if (stats_enable == 0)
+		return;
+
+	fprintf(stderr, "\nStatistics:\n");
+	fprintf(stderr, "  %-20s %12s %12s\n", "Phase", "Wall (ms)", "CPU (ms)");
+
+	for (i = 0; i < ST_TIMERS; i++)
+	{
+		fprintf(	stderr, "  %-20s %12.3f %12.3f\n", stats_timer_name[i],
+			  		stats_wall[i] / 1e6, stats_cpu[i] / 1e6);
+	}
+
+	fprintf(stderr, "\n");
+	fprintf(stderr, "  %-28s %12lld\n", "Lines processed", stats_counter[SC_LINES]);
+	fprintf(stderr, "  %-28s %12lld\n", "\"FindLabel()\" calls", find);
+
+	fprintf(	stderr, "  %-28s %12.1f\n", "Average probe length",
+		  		(find > 0) ? ((double) stats_counter[SC_PROBES] / find) : 0.0);
+
+	fprintf(	stderr, "  %-28s %12lld\n", "\"exp_parser()\" calls",
+		  		stats_counter[SC_EXP_PARSER]);
+
+	fprintf(stderr, "  %-28s %12lld\n", "Macro expansions", stats_counter[SC_MACROS]);
+	fprintf(stderr, "  %-28s %12lld\n", "Include files opened", stats_counter[SC_INCLUDES]);
+	fprintf(stderr, "  %-28s %12lld\n", "Memory allocations", stats_counter[SC_MALLOC]);
+	fprintf(stderr, "  %-28s %12lld\n", "Bytes emitted", stats_counter[SC_BYTES]);
+}
+
+
+
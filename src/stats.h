@@ -0,0 +1,122 @@
+/*	*************************************************************************
+ *	Module Name:	stats.h
+ *	Description:	Assembler Statistics ("--stats" option).
+ *	Copyright(c):	See below...
+ *	Author(s):
+ *	Created:			18 October 2026
+ *	Last modified:
+ *	Notes:
+ *	************************************************************************* */
+
+/*
+ * Copyright (c) <2007-2017> Jay Cotton <lbmgmusic@gmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+
+
+/*	*************************************************************************
+ *	************************************************************************* */
+
+#ifndef _STATS_H
+#define _STATS_H
+
+
+/*	*************************************************************************
+ *	                              INCLUDE FILES
+ *	************************************************************************* */
+
+#include "project.h"
+
+
+/*	*************************************************************************
+ *	                                 TYPEDEF
+ *	************************************************************************* */
+
+/*	Timed phases.
+ *	------------- */
+enum stats_timer_t
+{
+	ST_PASS1,					/*	Assembler pass #1. */
+	ST_PASS2,					/*	Assembler pass #2. */
+	ST_HEX,						/*	Intel hexadecimal file writing. */
+	ST_BIN,						/*	Binary file writing. */
+	ST_LIST,						/*	Listing file writing. */
+	ST_TIMERS
+};
+
+/*	Counters.
+ *	--------- */
+enum stats_counter_t
+{
+	SC_LINES,					/*	Source lines assembled (pass #2). */
+	SC_FIND_LABEL,				/*	"FindLabel()" calls. */
+	SC_PROBES,					/*	Symbols compared by "FindLabel()". */
+	SC_EXP_PARSER,				/*	"exp_parser()" calls. */
+	SC_MACROS,					/*	Macro expansions. */
+	SC_INCLUDES,				/*	Include files opened. */
+	SC_MALLOC,					/*	Memory allocation calls. */
+	SC_BYTES,					/*	Bytes emitted (pass #2). */
+	SC_COUNTERS
+};
+
+/*	Start of a timed phase.
+ *	----------------------- */
+struct stats_clock_t
+{
+	long long	wall;			/*	Wall time (ns). */
+	long long	cpu;			/*	CPU time (ns). */
+};
+
+
+/*	*************************************************************************
+ *	                                VARIABLES
+ *	************************************************************************* */
+
+extern int	stats_enable;		/*	"--stats" option. */
+
+
+/*	*************************************************************************
+ *	                                 MACROS
+ *	************************************************************************* */
+
+/*	Count something, if statistics are enabled.
+ *	*/
+#define STATS_COUNT(counter, n)												\
+	do { if (stats_enable) stats_add((counter), (n)); } while (0)
+
+
+/*	*************************************************************************
+ *	                          FUNCTIONS DECLARATION
+ *	************************************************************************* */
+
+long long stats_time(void);
+long long stats_get(enum stats_counter_t counter);
+void stats_add(enum stats_counter_t counter, long n);
+void stats_start(enum stats_timer_t timer, struct stats_clock_t *p_clock);
+void stats_stop(enum stats_timer_t timer, struct stats_clock_t *p_clock);
+void stats_print(void);
+
+
+
+#endif
+
+
+
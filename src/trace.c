@@ -0,0 +1,362 @@
+/*	*************************************************************************
+ *	Module Name:	trace.c
+ *	Description:	Trace Event Export ("--trace" option).
+ *	Copyright(c):	See below...
+ *	Author(s):
+ *	Created:			18 October 2026
+ *	Last modified:
+ *
+ *	Notes:			- Write a JSON file in the "Trace Event Format" (array
+ *						  form), that can be loaded in trace viewers
+ *						  ("chrome://tracing", Perfetto, ...).
+ *						- Spans ("B" and "E" events) are written by the main
+ *						  thread only.  Counters may be updated by the
+ *						  threads of the parallel assembler pass #2, so
+ *						  they are updated atomically.
+ *						- Counter tracks are written at each span
+ *						  boundary, when their value changed.
+ *	************************************************************************* */
+
+/*
+ * Copyright (c) <2007-2017> Jay Cotton <lbmgmusic@gmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+
+/*	*************************************************************************
+ *	                              INCLUDE FILES
+ *	************************************************************************* */
+
+#include <stdio.h>
+#include <time.h>
+
+#include "project.h"
+#include "trace.h"
+
+
+/*	*************************************************************************
+ *											  CONSTANTS
+ *	************************************************************************* */
+
+/*	Atomic addition.
+ *	*/
+#if USE_PTHREAD
+#define TRACE_ATOMIC_ADD(var, n)		__sync_fetch_and_add(&(var), (n))
+#else
+#define TRACE_ATOMIC_ADD(var, n)		((var) += (n))
+#endif
+
+
+/*	*************************************************************************
+ *	                                VARIABLES
+ *	************************************************************************* */
+
+/*	Public variables.
+ *	***************** */
+
+int	trace_enable	= 0;
+
+
+/*	Private variables.
+ *	****************** */
+
+static FILE			*trace_fp		= NULL;
+static long long	trace_origin	= 0;		/*	Time origin (ns). */
+
+static long			trace_counter[TC_COUNTERS];
+static long			trace_counter_written[TC_COUNTERS];
+
+static const char	*trace_counter_name[TC_COUNTERS]	=
+{
+	"Symbols", "Image bytes"
+};
+
+
+/*	*************************************************************************
+ *									  FUNCTIONS DECLARATION
+ *	************************************************************************* */
+
+static long long trace_now(void);
+static void trace_string(const char *text);
+static void trace_counters(void);
+
+
+/*	*************************************************************************
+ *	                                FUNCTIONS
+ *	************************************************************************* */
+
+/*	*************************************************************************
+ *	Function name:	trace_now
+ *	Description:	Read wall clock.
+ *	Author(s):
+ *	Created:			18 October 2026
+ *	Last modified:
+ *	Parameters:		void
+ *
+ *	Returns:			long long:
+ *							Wall time (ns).
+ *
+ *	Globals:
+ *	Notes:			- Without POSIX clocks, "clock()" is used.
+ *	************************************************************************* */
+
+static long long trace_now(void)
+{
+#if USE_PTHREAD
+	struct timespec	ts;
+
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+
+	return (((long long) ts.tv_sec * 1000000000LL) + ts.tv_nsec);
+#else
+	return (((long long) clock() * 1000000000LL) / CLOCKS_PER_SEC);
+#endif
+}
+
+
+/*	*************************************************************************
+ *	Function name:	trace_string
+ *	Description:	Write a JSON string.
+ *	Author(s):
+ *	Created:			18 October 2026
+ *	Last modified:
+ *
+ *	Parameters:		const char *text:
+ *							String to write (quotes are added).
+ *
+ *	Returns:			void
+ *	Globals:
+ *	Notes:			- Escape '"', '\\' and control characters (file
+ *						  names may hold '\\').
+ *	************************************************************************* */
+
+static void trace_string(const char *text)
+{
+	fputc('"', trace_fp);
+
+	for (; *text != '\0'; text++)
+	{
+		if ((*text == '"') || (*text == '\\'))
+			fprintf(trace_fp, "\\%c", *text);
+		else if ((unsigned char) *text < 0x20)
+			fprintf(trace_fp, "\\u%04X", (unsigned char) *text);
+		else
+			fputc(*text, trace_fp);
+	}
+
+	fputc('"', trace_fp);
+}
+
+
+/*	*************************************************************************
+ *	Function name:	trace_counters
+ *	Description:	Write counter events that changed.
+ *	Author(s):
+ *	Created:			18 October 2026
+ *	Last modified:
+ *	Parameters:		void
+ *	Returns:			void
+ *	Globals:
+ *	Notes:
+ *	************************************************************************* */
+
+static void trace_counters(void)
+{
+	int	i;
+
+
+	for (i = 0; i < TC_COUNTERS; i++)
+	{
+		long	value	= trace_counter[i];
+
+		if (value == trace_counter_written[i])
+			continue;
+
+		fprintf(	trace_fp,
+			  		",\n{\"name\":\"%s\",\"ph\":\"C\",\"ts\":%.3f,\"pid\":1,"
+					"\"tid\":1,\"args\":{\"value\":%ld}}",
+					trace_counter_name[i], (trace_now() - trace_origin) / 1e3,
+					value);
+
+		trace_counter_written[i]	= value;
+	}
+}
+
+
+/*	*************************************************************************
+ *	Function name:	trace_open
+ *	Description:	Open the trace file, and enable tracing.
+ *	Author(s):
+ *	Created:			18 October 2026
+ *	Last modified:
+ *
+ *	Parameters:		const char *filename:
+ *							Trace file name.
+ *
+ *	Returns:			int:
+ *							-1	: Can't open trace file.
+ *							0	: Operation successfull.
+ *
+ *	Globals:			int trace_enable
+ *	Notes:
+ *	************************************************************************* */
+
+int trace_open(const char *filename)
+{
+	trace_close();
+
+	if ((trace_fp = fopen(filename, "w")) == NULL)
+		return (-1);
+
+	trace_origin	= trace_now();
+	trace_enable	= 1;
+
+	/*	Name the process and its thread.
+	 *	-------------------------------- */
+	fprintf(	trace_fp,
+		  		"[\n{\"name\":\"process_name\",\"ph\":\"M\",\"pid\":1,"
+				"\"args\":{\"name\":\"asm8080\"}}");
+
+	fprintf(	trace_fp,
+		  		",\n{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":1,"
+				"\"args\":{\"name\":\"main\"}}");
+
+	return (0);
+}
+
+
+/*	*************************************************************************
+ *	Function name:	trace_close
+ *	Description:	Close the trace file.
+ *	Author(s):
+ *	Created:			18 October 2026
+ *	Last modified:
+ *	Parameters:		void
+ *	Returns:			void
+ *	Globals:			int trace_enable
+ *	Notes:			- Can be called even if trace file is not open.
+ *	************************************************************************* */
+
+void trace_close(void)
+{
+	if (trace_fp == NULL)
+		return;
+
+	trace_counters();
+	fprintf(trace_fp, "\n]\n");
+	fclose(trace_fp);
+
+	trace_fp			= NULL;
+	trace_enable	= 0;
+}
+
+
+/*	*************************************************************************
+ *	Function name:	trace_add
+ *	Description:	Add to a counter track.
+ *	Author(s):
+ *	Created:			18 October 2026
+ *	Last modified:
+ *
+ *	Parameters:		enum trace_counter_t counter:
+ *							Counter.
+ *
+ *						long n:
+ *							Value to add.
+ *
+ *	Returns:			void
+ *	Globals:
+ *	Notes:			- Use "TRACE_COUNT()", that check "trace_enable".
+ *	************************************************************************* */
+
+void trace_add(enum trace_counter_t counter, long n)
+{
+	TRACE_ATOMIC_ADD(trace_counter[counter], n);
+}
+
+
+/*	*************************************************************************
+ *	Function name:	trace_begin
+ *	Description:	Begin a span.
+ *	Author(s):
+ *	Created:			18 October 2026
+ *	Last modified:
+ *
+ *	Parameters:		const char *category:
+ *							Span category ("pass", "include", ...).
+ *
+ *						const char *name:
+ *							Span name.
+ *
+ *	Returns:			void
+ *	Globals:
+ *	Notes:			- Spans must be properly nested.
+ *	************************************************************************* */
+
+void trace_begin(const char *category, const char *name)
+{
+	if (trace_fp == NULL)
+		return;
+
+	trace_counters();
+
+	fprintf(trace_fp, ",\n{\"name\":");
+	trace_string(name);
+	fprintf(trace_fp, ",\"cat\":");
+	trace_string(category);
+
+	fprintf(	trace_fp, ",\"ph\":\"B\",\"ts\":%.3f,\"pid\":1,\"tid\":1}",
+		  		(trace_now() - trace_origin) / 1e3);
+}
+
+
+/*	*************************************************************************
+ *	Function name:	trace_end
+ *	Description:	End the last span begun.
+ *	Author(s):
+ *	Created:			18 October 2026
+ *	Last modified:
+ *
+ *	Parameters:		const char *name:
+ *							Span name.
+ *
+ *	Returns:			void
+ *	Globals:
+ *	Notes:			- Viewers match "E" event with the last "B" event
+ *						  of the thread.  So, no category is needed.
+ *	************************************************************************* */
+
+void trace_end(const char *name)
+{
+	if (trace_fp == NULL)
+		return;
+
+	fprintf(trace_fp, ",\n{\"name\":");
+	trace_string(name);
+
+	fprintf(	trace_fp, ",\"ph\":\"E\",\"ts\":%.3f,\"pid\":1,\"tid\":1}",
+		  		(trace_now() - trace_origin) / 1e3);
+
+	trace_counters();
+}
+
+
+
+
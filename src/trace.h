@@ -0,0 +1,95 @@
+/*	*************************************************************************
+ *	Module Name:	trace.h
+ *	Description:	Trace Event Export ("--trace" option).
+ *	Copyright(c):	See below...
+ *	Author(s):
+ *	Created:			18 October 2026
+ *	Last modified:
+ *	Notes:
+ *	************************************************************************* */
+
+/*
+ * Copyright (c) <2007-2017> Jay Cotton <lbmgmusic@gmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+
+
+/*	*************************************************************************
+ *	************************************************************************* */
+
+#ifndef _TRACE_H
+#define _TRACE_H
+
+
+/*	*************************************************************************
+ *	                              INCLUDE FILES
+ *	************************************************************************* */
+
+#include "project.h"
+
+
+/*	*************************************************************************
+ *	                                 TYPEDEF
+ *	************************************************************************* */
+
+/*	Counter tracks.
+ *	--------------- */
+enum trace_counter_t
+{
+	TC_SYMBOLS,					/*	Symbols in the symbols table. */
+	TC_BYTES,					/*	"Image" bytes written (pass #2). */
+	TC_COUNTERS
+};
+
+
+/*	*************************************************************************
+ *	                                VARIABLES
+ *	************************************************************************* */
+
+extern int	trace_enable;		/*	"--trace" option. */
+
+
+/*	*************************************************************************
+ *	                                 MACROS
+ *	************************************************************************* */
+
+/*	Update a counter track, if tracing is enabled.
+ *	*/
+#define TRACE_COUNT(counter, n)												\
+	do { if (trace_enable) trace_add((counter), (n)); } while (0)
+
+
+/*	*************************************************************************
+ *	                          FUNCTIONS DECLARATION
+ *	************************************************************************* */
+
+int trace_open(const char *filename);
+void trace_close(void);
+void trace_add(enum trace_counter_t counter, long n);
+void trace_begin(const char *category, const char *name);
+void trace_end(const char *name);
+
+
+
+#endif
+
+
+
@@ -43,9 +43,22 @@
 #include "err_code.h"
 #include "main.h"
 #include "msg.h"
+#include "mem.h"
+#include "stats.h"
+#include "trace.h"
 #include "util.h"
 
 
+/*	*************************************************************************
+ *	                                VARIABLES
+ *	************************************************************************* */
+
+/*	Public variables.
+ *	***************** */
+
+int	util_phasing	= 0;		/*	Set when a phasing error was found. */
+
+
 /*	*************************************************************************
  *	                           FUNCTIONS DEFINITION
  *	************************************************************************* */
@@ -187,8 +200,11 @@ SYMBOL *FindLabel(char *text)
 
 	SYMBOL	*Local	= Symbols;
 	int		i			= 0;
+	long		probes	= 0;
 
 
+	STATS_COUNT(SC_FIND_LABEL, 1);
+
 	/*	TODO: Is this standard Intel assembler code?
 	 *	-------------------------------------------- */	
 	if (*text == '&')	tmp[i++] = *text++;
@@ -218,12 +234,19 @@ SYMBOL *FindLabel(char *text)
 
 	while (Local->next)
   	{
+		probes++;
+
 		if (!strcmp(Local->Symbol_Name, tmp))
+		{
+			STATS_COUNT(SC_PROBES, probes);
 			return (Local);
+		}
 
 		Local = (SYMBOL *) Local->next;
 	}
 
+	STATS_COUNT(SC_PROBES, probes);
+
 	return (NULL);
 }
 
@@ -303,7 +326,7 @@ int AddLabel(char *label)
 
 	/*	Allocate memory.
 	 *	*/	
-	Local->Symbol_Name = (char *) malloc(strlen(label) + 1);
+	Local->Symbol_Name = (char *) mem_alloc(MT_SYMBOLS, strlen(label) + 1);
 
 	/*	Check for memory allocation error.
 	 *	If no memory allocation error, store the symbol name.
@@ -323,7 +346,7 @@ int AddLabel(char *label)
 
 	/*	Allocate memory.
 	 *	*/	
-	Local->src_filename = (char *) malloc(strlen(in_fn[file_level]) + 1);
+	Local->src_filename = (char *) mem_alloc(MT_SYMBOLS, strlen(in_fn[file_level]) + 1);
 
 	/*	Check for memory allocation error.
 	 *	If no memory allocation error, store the source file name.
@@ -348,9 +371,11 @@ int AddLabel(char *label)
 	 *	  will make the last symbol in the linked list destroyed next
 	 *	  time a symbol will be added :-(
 	 *	-------------------------------------------------------------- */
-	if ((Local->next = (SYMBOL *) calloc(1, sizeof(SYMBOL))) == NULL)
+	if ((Local->next = (SYMBOL *) mem_calloc(MT_SYMBOLS, 1, sizeof(SYMBOL))) == NULL)
 		msg_error_s("Can't allocate memory!", EC_CAM, label);
 
+	TRACE_COUNT(TC_SYMBOLS, 1);
+
 	return (rv);
 }
 
@@ -360,13 +385,13 @@ int AddLabel(char *label)
  *	Description:	Process Label.
  *	Author(s):		Claude Sylvain
  *	Created:			28 December 2010
- *	Last modified:	27 December 2011
+ *	Last modified:	18 October 2026
  *
  *	Parameters:		char *label:
  *							Point to a string that hold label.
  *
  *	Returns:			void
- *	Globals:
+ *	Globals:			int util_phasing
  *	Notes:
  *	************************************************************************* */
 
@@ -382,10 +407,22 @@ void process_label(char *label)
 	 *	---------------------------------------------------- */	
 	if (asm_pass == 0)
 	{
+		/*	- On layout passes following the first one, the label is
+		 *	  already known.  Just update its value.  Duplicate labels
+		 *	  were reported on the first layout pass.
+		 *	--------------------------------------------------------- */
+		if ((asm_iter > 0) && ((Local = FindLabel(label)) != NULL))
+		{
+			if (	(strcmp(in_fn[file_level], Local->src_filename) == 0) &&
+				  	(codeline[file_level] == Local->code_line))
+			{
+				Local->Symbol_Value	= target.pc;
+			}
+		}
 		/*	Add label/name.
 		 *	If able to add it, set its value.
 	 	 *	--------------------------------- */	 
-		if (AddLabel(label) != -1)
+		else if (AddLabel(label) != -1)
 		{
 			Local = FindLabel(label);
 
@@ -399,21 +436,24 @@ void process_label(char *label)
 	/*	We assume we are in second assembler pass...
 	 * Check for phasing error.	
 	 *	In case there is phasing error, synchronize the label.
-	 *	------------------------------------------------------ */	
+	 *	- Notes: A layout directive ("DS", "ORG", "IF", "DELAY") that
+	 *	  used a name not yet known on the first pass can move the
+	 *	  labels that follow.  More layout passes ("-m") fix this.
+	 *	------------------------------------------------------------- */	
 	else
 	{
 		Local = FindLabel(label);
-#if 0
+
 		if ((Local != NULL) && (Local->Symbol_Value != target.pc))
 		{
-			msg_error_s("Phasing error!", EC_PE, label);
+			msg_error_s("Phasing error, use \"-m\" option!", EC_PE, label);
+			util_phasing	= 1;
 
 			/*	Sync label value.
 			 *	----------------- */
 			Local->Symbol_Value	= target.pc;
 			Local->Symbol_Type	= SYMBOL_LABEL;
 		}
-#endif
 	}
 }
 
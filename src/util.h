@@ -45,6 +45,13 @@
 #include "project.h"
 
 
+/*	*************************************************************************
+ *	                                VARIABLES
+ *	************************************************************************* */
+
+extern int	util_phasing;		/*	Phasing error found on pass #2. */
+
+
 /*	*************************************************************************
  *	                          FUNCTIONS DECLARATION
  *	************************************************************************* */
@@ -57,6 +57,12 @@
 #define WC_SAUAL			12		/*	Symbol Already Used As Label. */
 #define WC_MPNS			13		/*	Macro Parameters Not Supported. */
 #define WC_IDERINB		14		/*	"IF" Directive Expression Result Is Not Boolean. */
+#define WC_LDNC			15		/*	Layout Did Not Converge. */
+#define WC_BLB				16		/*	Bad Loop Bound. */
+#define WC_LBNJ			17		/*	Loop Bound on a Non-Jump instruction. */
+#define WC_CSE				18		/*	Cheaper Sequence Exists ("-Wperf" option). */
+#define WC_BSB				19		/*	Bad Stack Bound. */
+#define WC_SBNN			20		/*	Stack Bound Not Needed. */
 
 
 
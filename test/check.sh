@@ -0,0 +1,168 @@
+#!/bin/sh
+# *****************************************************************************
+# Filename:			check.sh
+# Description:		Golden output regression suite.
+# Copyright(c):
+# Author(s):
+# Created:			18 October 2026
+# Last modified:
+#
+# Usage:				check.sh <asm8080> <run_bench>
+#
+# Notes:				- Assemble each "test/*.asm" file, and compare the ".bin",
+#						  ".hex", listing (".lst") and messages (".err") with
+#						  the golden files in "test/golden", byte for byte.
+#						- Options are given on the first line of a file, as
+#						  "; OPTIONS: <options>" (added after "-l").  Trace
+#						  files ("test/*.trc", "--profile" option) are
+#						  copied with the sources.
+#						- Files are assembled in parallel (CHECK_JOBS jobs,
+#						  default: 4), each one in its own directory.
+#						- Assembly time of each file (best of 3 runs) is
+#						  compared with "test/golden/times.txt".  A file is
+#						  flagged "SLOW" if it is more than CHECK_THRESHOLD
+#						  percent (default: 50) and more than CHECK_TIME_MIN
+#						  seconds (default: 0.005) slower than its baseline.
+#						  Slow files fail the suite only if CHECK_TIME_FAIL
+#						  is set to 1.
+#						- CHECK_UPDATE=1 store the current outputs and times
+#						  as the new golden files.
+# *****************************************************************************
+
+if [ $# -lt 2 ]; then
+	echo "Usage: $0 <asm8080> <run_bench>" >&2
+	exit 1
+fi
+
+# Tools are run from the work directories.  Make their paths absolute.
+abs()
+{
+	case $1 in
+		/*)	echo "$1" ;;
+		*)		echo "`pwd`/$1" ;;
+	esac
+}
+
+ASM=`abs "$1"`
+RUN=`abs "$2"`
+TEST=`dirname "$0"`
+TEST=`abs "$TEST"`
+GOLDEN=$TEST/golden
+
+JOBS=${CHECK_JOBS:-4}
+THRESHOLD=${CHECK_THRESHOLD:-50}
+TIME_MIN=${CHECK_TIME_MIN:-0.005}
+
+WORK=${TMPDIR:-/tmp}/asm8080-check.$$
+
+mkdir -p "$WORK" || exit 1
+trap 'rm -rf "$WORK"' 0 1 2 15
+
+
+# Assemble one file, and compare its outputs.
+# Result is written in "$WORK/<name>.result".
+check_one()
+{
+	name=$1
+	dir=$WORK/$name
+
+	mkdir -p "$dir" && cp "$TEST"/*.asm "$dir" || return
+
+	for f in "$TEST"/*.trc; do
+		[ -f "$f" ] && cp "$f" "$dir"
+	done
+
+	opts=`sed -n '1s/^; *OPTIONS: *//p' "$TEST/$name.asm"`
+
+	(cd "$dir" && "$ASM" $name.asm -l $opts > $name.out 2> $name.err)
+
+	time=`cd "$dir" && "$RUN" -i -r3 "$ASM" $name.asm -l $opts 2> /dev/null |
+		sed -n 's/^time: *best \([0-9.]*\) s.*/\1/p'`
+
+	echo "$name ${time:-0}" > "$dir/time"
+
+	if [ "$CHECK_UPDATE" = 1 ]; then
+		echo "UPDATE $name" > "$WORK/$name.result"
+		return
+	fi
+
+	diffs=
+	for ext in bin hex lst err; do
+		if [ -f "$GOLDEN/$name.$ext" ] || [ -f "$dir/$name.$ext" ]; then
+			cmp -s "$GOLDEN/$name.$ext" "$dir/$name.$ext" || diffs="$diffs $ext"
+		fi
+	done
+
+	if [ -n "$diffs" ]; then
+		echo "FAIL $name (differ:$diffs)" > "$WORK/$name.result"
+		return
+	fi
+
+	base=`sed -n "s/^$name \([0-9.]*\)$/\1/p" "$GOLDEN/times.txt" 2> /dev/null`
+
+	echo "${time:-0} ${base:-0}" | awk -v name=$name -v thr=$THRESHOLD \
+		-v min=$TIME_MIN '{
+			if (($2 > 0) && ($1 > $2 * (1 + thr / 100)) && ($1 - $2 > min))
+				printf("SLOW %s (%.4f s, baseline %.4f s)\n", name, $1, $2);
+			else
+				printf("PASS %s (%.4f s)\n", name, $1);
+		}' > "$WORK/$name.result"
+}
+
+
+# Run jobs by groups of $JOBS.
+n=0
+for f in "$TEST"/*.asm; do
+	name=`basename "$f" .asm`
+	check_one $name &
+
+	n=`expr $n + 1`
+	if [ $n -ge $JOBS ]; then
+		wait
+		n=0
+	fi
+done
+wait
+
+
+# Report.
+for f in "$TEST"/*.asm; do
+	name=`basename "$f" .asm`
+	cat "$WORK/$name.result" 2> /dev/null || echo "FAIL $name (not run)"
+done > "$WORK/report"
+
+cat "$WORK/report"
+
+if [ "$CHECK_UPDATE" = 1 ]; then
+	mkdir -p "$GOLDEN"
+
+	for f in "$TEST"/*.asm; do
+		name=`basename "$f" .asm`
+
+		for ext in bin hex lst err; do
+			rm -f "$GOLDEN/$name.$ext"
+			[ -f "$WORK/$name/$name.$ext" ] && cp "$WORK/$name/$name.$ext" "$GOLDEN"
+		done
+
+		cat "$WORK/$name/time"
+	done > "$GOLDEN/times.txt"
+
+	echo "Golden files updated."
+	exit 0
+fi
+
+fail=`grep -c '^FAIL' "$WORK/report"`
+slow=`grep -c '^SLOW' "$WORK/report"`
+total=`grep -c '' "$WORK/report"`
+
+echo "$total files, $fail failed, $slow slow."
+
+if [ $fail -ne 0 ]; then
+	exit 1
+fi
+
+if [ $slow -ne 0 ] && [ "$CHECK_TIME_FAIL" = 1 ]; then
+	exit 1
+fi
+
+exit 0
@@ -0,0 +1,25 @@
+;"CMUL" and "CDIV" code generators.
+;
+	ORG	0
+	CMUL	H,0		;LXI H,0
+	CMUL	H,1		;Nothing
+	CMUL	H,10
+	CMUL	H,10,SIZE
+	CMUL	H,256		;MOV H,L / MVI L,0
+	CMUL	H,768
+	CMUL	H,32768		;DAD H (x7) / MOV H,L / MVI L,0
+	CMUL	H,0FFFFH
+	CMUL	A,0		;XRA A
+	CMUL	A,3
+	CMUL	A,200
+	CMUL	A,255,SIZE
+
+	CDIV	A,1		;Nothing
+	CDIV	A,4
+	CDIV	A,128
+	CDIV	H,2
+	CDIV	H,256		;MOV L,H / MVI H,0
+	CDIV	H,8000H
+	HLT
+
+	END
@@ -0,0 +1,21 @@
+; OPTIONS: --cycles all --cycles START,DONE
+;"CYCLES" directive budgets and "--cycles" report.
+;
+	ORG	0
+START:	MVI	B,10
+DLY:	DCR	B
+	JNZ	DLY		; @LOOP 10
+	CALL	SUB1
+	DELAY	100,C
+DONE:	HLT
+
+SUB1:	ORA	A
+	RZ
+	INR	A
+	RET
+
+	CYCLES	START,DONE,289,298
+	CYCLES	DLY,DONE,100,100	;Error: budget violated
+	CYCLES	START,NOPE,1,2		;Error: label not found, no budget
+
+	END
@@ -0,0 +1,17 @@
+;"DELAY" code generator.
+;
+	ORG	0
+	DELAY	0		;Nothing
+	DELAY	4		;NOP
+	DELAY	7,B		;MOV B,M
+	DELAY	100
+	DELAY	1000,B
+	DELAY	1200		;Loop on "B", saved
+	DELAY	65535,A
+	DELAY	6		;Error: too short
+	DELAY	11		;Error: too short without register
+	DELAY	65536		;Error: out of range
+	DELAY	10,M		;Error: bad register
+	HLT
+
+	END
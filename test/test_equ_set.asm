@@ -0,0 +1,15 @@
+;"EQU" that use a "SET" name take its value at the "EQU" line.
+;
+X	SET	1
+Y	EQU	X
+X	SET	2
+	MVI	A,Y		;3E 01
+	MVI	B,X		;06 02
+
+;Forward reference: evaluated on first use.
+;
+Z	EQU	W+1
+W	EQU	5
+	MVI	C,Z		;0E 06
+
+	END
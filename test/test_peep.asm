@@ -0,0 +1,24 @@
+; OPTIONS: -O
+;Peephole optimizer ("-O") patterns.
+;
+	ORG	0
+	CALL	STUB		;Bypassed: CD 14 00 (WORK)
+	CALL	VEC		;Not bypassed ("SET" name): CD 11 00
+	JNZ	NEXT		;Removed (conditional jump to next line)
+NEXT:	JMP	NEXT2		;Removed (jump to next line)
+NEXT2:	MVI	A,0		;AF (XRA A)
+	ORA	B
+	MOV	B,B		;Removed
+	CALL	WORK		;C3 14 00 (JMP WORK)
+	RET			;Removed
+	MVI	A,0		;3E 00 (flags not set)
+	MOV	C,A
+STUB:	JMP	WORK
+
+T	SET	WORK
+VEC:	JMP	T
+T	SET	1234H
+
+WORK:	HLT
+
+	END
@@ -0,0 +1,22 @@
+; OPTIONS: -Wperf
+;"-Wperf" performance lint.
+;
+	ORG	0
+	LDA	PTR		;LHLD PTR is cheaper
+	MOV	L,A
+	LDA	PTR+1
+	MOV	H,A
+	MOV	A,L		;SHLD PTR is cheaper
+	STA	PTR
+	MOV	A,H
+	STA	PTR+1
+	CPI	0		;ORA A is cheaper
+	PUSH	B		;PUSH / POP of the same pair
+	POP	B
+	LXI	H,1234H
+	LXI	H,1234H		;HL already loaded
+	HLT
+
+PTR:	DW	0
+
+	END
@@ -0,0 +1,11 @@
+;"DS" that use an "EQU" defined later: "START" moves on pass #2.
+;The phasing error tell to use "-m".
+;
+	ORG	0
+	JMP	START
+	DS	SIZE
+START:	NOP
+SIZE	EQU	ENDL-BEG
+BEG:	NOP
+	NOP
+ENDL:	NOP
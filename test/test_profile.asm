@@ -0,0 +1,12 @@
+; OPTIONS: --profile test_profile.trc
+;"--profile": listing annotated from a PC trace ("test_profile.trc").
+;
+	ORG	0
+START:	MVI	B,3
+LOOP:	DCR	B
+	JNZ	LOOP
+	JZ	DONE
+	NOP			;Never executed
+DONE:	HLT
+
+	END
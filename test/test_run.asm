@@ -0,0 +1,21 @@
+; OPTIONS: --run START --run-io 1,RESULT
+;"--run" simulator: sum of 1..10, written to port 1.
+;
+	ORG	0
+START:	LXI	SP,STACK
+	MVI	B,10
+	XRA	A
+LOOP:	CALL	ADDB
+	DCR	B
+	JNZ	LOOP
+	OUT	1		;RESULT = 55 (37H)
+	HLT
+
+ADDB:	ADD	B
+	RET
+
+RESULT:	DB	0
+	DS	16
+STACK:
+
+	END
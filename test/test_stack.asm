@@ -0,0 +1,35 @@
+; OPTIONS: --stack all
+;"--stack": worst case stack depth.
+;
+	ORG	0
+	JMP	START
+	ORG	38H
+	PUSH	PSW		;Interrupt vector (RST 7)
+	CALL	SAVE
+	POP	PSW
+	EI
+	RET
+
+START:	LXI	SP,STACK
+	CALL	SUB1
+	CALL	TABLE
+	HLT
+
+SUB1:	PUSH	B
+	PUSH	D
+	CALL	SAVE
+	POP	D
+	POP	B
+	RET
+
+SAVE:	PUSH	H
+	POP	H
+	RET
+
+TABLE:	LXI	H,SUB1
+	PCHL			; @STACK 8
+
+	DS	32
+STACK:
+
+	END